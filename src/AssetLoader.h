@@ -0,0 +1,72 @@
+﻿#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "JobSystem.h"
+
+// 非同期アセット読み込み
+// decode（ファイル読み込み・デコード）はワーカーで、finish（GPU転送・登録）は Pump を呼んだ
+// メインスレッドで実行する。finish は登録順に呼ばれ、decode が終わったものから順に進む
+class AssetLoader {
+public:
+    using Task = std::function<void()>;
+
+    // threadInit はワーカーごとに最初の decode の前に1回呼ぶ（COM初期化など）
+    explicit AssetLoader(JobSystem* jobs, Task threadInit = nullptr)
+        : m_jobs(jobs), m_threadInit(std::move(threadInit)), m_inFlight(0) {}
+
+    // 実行中の decode が書き込む先より先に消えないよう待つ（finish は呼ばない）
+    ~AssetLoader() { m_jobs->WaitForBackground(m_inFlight); }
+
+    AssetLoader(const AssetLoader&) = delete;
+    AssetLoader& operator=(const AssetLoader&) = delete;
+
+    void Enqueue(Task decode, Task finish) {
+        auto request = std::make_shared<Request>();
+        request->finish = std::move(finish);
+        m_requests.push_back(request);
+
+        m_jobs->Dispatch([this, request, decode = std::move(decode)]() {
+            static thread_local bool t_initialized = false;
+            if (!t_initialized && m_threadInit) {
+                m_threadInit();
+                t_initialized = true;
+            }
+            if (decode) decode();
+            request->decoded.store(true, std::memory_order_release);
+        }, m_inFlight);
+    }
+
+    // デコード済みの先頭から finish を実行し、残り件数を返す（毎フレーム呼ぶ）
+    size_t Pump() {
+        size_t done = 0;
+        while (done < m_requests.size() && m_requests[done]->decoded.load(std::memory_order_acquire)) {
+            if (m_requests[done]->finish) m_requests[done]->finish();
+            done++;
+        }
+        m_requests.erase(m_requests.begin(), m_requests.begin() + done);
+        return m_requests.size();
+    }
+
+    // 残りを全部待って finish まで済ませる（ゲーム開始前など）
+    void Flush() {
+        m_jobs->WaitForBackground(m_inFlight);
+        Pump();
+    }
+
+    size_t GetPendingCount() const { return m_requests.size(); }
+    bool IsIdle() const { return m_requests.empty(); }
+
+private:
+    struct Request {
+        Task finish;
+        std::atomic<bool> decoded{ false };
+    };
+
+    JobSystem* m_jobs;
+    Task m_threadInit;
+    std::vector<std::shared_ptr<Request>> m_requests;  // 登録順
+    std::atomic<uint32_t> m_inFlight;
+};
@@ -0,0 +1,68 @@
+﻿#pragma once
+
+#include <cstdint>
+#include <string>
+#include "AssetPack.h"
+
+// ゲームが読むアセットの一覧（ランタイムとパッカーツールで共有する）
+// パスは assets\textures\ ・ assets\sounds\ からの相対
+namespace AssetManifest {
+
+struct SoundEffect {
+    const wchar_t* name;
+    const wchar_t* file;
+    int priority;  // ボイスが足りないとき、低いものから奪われる
+    bool preload;  // 起動時にデコードする（タイトル画面で使う音）。ほかは初めて鳴らすときに
+};
+
+// 効果音（WAVとMP3両対応）
+inline constexpr SoundEffect SOUND_EFFECTS[] = {
+    { L"shot", L"player_shot.mp3", 0, false },
+    { L"hit", L"enemy_hit.mp3", 0, false },
+    { L"destroy", L"enemy_die.wav", 1, false },
+    { L"player_hit", L"hina_buoo.wav", 3, false },
+    { L"bomb", L"bomb.mp3", 3, false },
+    { L"cursor", L"cursor.mp3", 2, true },
+    { L"confirm", L"confirm.mp3", 2, true },
+    { L"item", L"hina_eyao.wav", 1, false },
+    { L"spellcard", L"stage1_boss_spellcard.wav", 3, false },
+};
+
+// BGM（ストリーミング再生、ループ点は 44.1kHz のフレーム位置。loopEnd = 0 は曲の終わり）
+struct BGMTrack {
+    const wchar_t* file;
+    uint64_t loopStart;
+    uint64_t loopEnd;
+};
+
+inline constexpr BGMTrack BGM_TITLE = { L"bgm_op.mp3", 0, 0 };
+inline constexpr BGMTrack BGM_STAGE = { L"bgm_stage1_normal.mp3", 0, 0 };
+inline constexpr BGMTrack BGM_BOSS = { L"bgm_stage1_boss.mp3", 0, 0 };
+inline constexpr BGMTrack BGM_SCORE = { L"bgm_ed.mp3", 0, 0 };
+
+// アトラスに入らない1枚絵
+inline constexpr const wchar_t* TITLE_TEXTURE = L"title_screen.jpg";
+inline constexpr const wchar_t* CUTIN_TEXTURES[] = {
+    L"cutin_spell1.png",
+    L"cutin_spell2.png",
+    L"cutin_spell3.png",
+    L"cutin_spell4.png",
+    L"cutin_spell5.png",
+};
+inline constexpr const wchar_t* PORTRAIT_HINATA = L"portraits\\hinata.png";
+inline constexpr const wchar_t* PORTRAIT_KAI = L"portraits\\kai.png";
+inline constexpr const wchar_t* STAGE_CLEAR_TEXTURE = L"ui\\stage_clear.png";
+
+// パック内の名前
+// アトラス用スプライトは縮小済みのものを別名で持つ（同じ画像を1枚絵として読む場合と区別する）
+inline std::string TextureName(const std::wstring& relativePath) {
+    return AssetPack::MakeName(L"textures/" + relativePath);
+}
+inline std::string SpriteName(const std::wstring& relativePath) {
+    return AssetPack::MakeName(L"atlas/" + relativePath);
+}
+inline std::string SoundName(const std::wstring& file) {
+    return AssetPack::MakeName(L"sounds/" + file);
+}
+
+} // namespace AssetManifest
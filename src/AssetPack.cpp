@@ -0,0 +1,203 @@
+﻿#include "AssetPack.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace AssetPack {
+
+namespace {
+
+template <typename Char>
+std::string MakeNameImpl(const Char* text, size_t length) {
+    std::string name;
+    name.reserve(length);
+    for (size_t i = 0; i < length; i++) {
+        Char c = text[i];
+        if (c == '\\') c = '/';
+        else if (c >= 'A' && c <= 'Z') c = static_cast<Char>(c - 'A' + 'a');
+        name.push_back(static_cast<char>(c));
+    }
+    return name;
+}
+
+uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+std::string MakeName(std::wstring_view path) { return MakeNameImpl(path.data(), path.size()); }
+std::string MakeName(std::string_view path) { return MakeNameImpl(path.data(), path.size()); }
+
+// ---- Writer ----
+
+void Writer::AddTexture(std::string_view name, uint32_t width, uint32_t height, PixelFormat format,
+                        uint32_t mipLevels, const void* data, size_t size) {
+    PackEntry entry = {};
+    entry.type = AssetType::Texture;
+    entry.format = format;
+    entry.width = width;
+    entry.height = height;
+    entry.mipLevels = mipLevels;
+    Add(name, entry, data, size);
+}
+
+void Writer::AddAudio(std::string_view name, uint32_t channels, uint32_t sampleRate, uint32_t bitsPerSample,
+                      const void* data, size_t size) {
+    PackEntry entry = {};
+    entry.type = AssetType::Audio;
+    entry.channels = channels;
+    entry.sampleRate = sampleRate;
+    entry.bitsPerSample = bitsPerSample;
+    Add(name, entry, data, size);
+}
+
+void Writer::Add(std::string_view name, const PackEntry& entry, const void* data, size_t size) {
+    PendingAsset asset;
+    asset.name = MakeName(name);
+    asset.entry = entry;
+    asset.data.assign(static_cast<const uint8_t*>(data), static_cast<const uint8_t*>(data) + size);
+
+    // 同じ名前は後から追加したもので置き換える
+    for (auto& existing : m_assets) {
+        if (existing.name == asset.name) {
+            existing = std::move(asset);
+            return;
+        }
+    }
+    m_assets.push_back(std::move(asset));
+}
+
+std::vector<uint8_t> Writer::Build() const {
+    std::vector<const PendingAsset*> sorted;
+    for (const auto& asset : m_assets) sorted.push_back(&asset);
+    std::sort(sorted.begin(), sorted.end(), [](const PendingAsset* a, const PendingAsset* b) {
+        return a->name < b->name;
+    });
+
+    // データ領域
+    uint64_t offset = sizeof(PackHeader);
+    std::vector<PackEntry> entries;
+    std::string strings;
+    for (const PendingAsset* asset : sorted) {
+        offset = AlignUp(offset, DATA_ALIGNMENT);
+        PackEntry entry = asset->entry;
+        entry.nameOffset = static_cast<uint32_t>(strings.size());
+        entry.nameLength = static_cast<uint32_t>(asset->name.size());
+        entry.dataOffset = offset;
+        entry.dataSize = asset->data.size();
+        entries.push_back(entry);
+        strings += asset->name;
+        offset += asset->data.size();
+    }
+
+    PackHeader header = {};
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.entryCount = static_cast<uint32_t>(entries.size());
+    header.indexOffset = AlignUp(offset, alignof(PackEntry));
+    header.stringOffset = header.indexOffset + entries.size() * sizeof(PackEntry);
+
+    std::vector<uint8_t> out(header.stringOffset + strings.size(), 0);
+    memcpy(out.data(), &header, sizeof(header));
+    for (size_t i = 0; i < sorted.size(); i++) {
+        if (!sorted[i]->data.empty()) {
+            memcpy(out.data() + entries[i].dataOffset, sorted[i]->data.data(), sorted[i]->data.size());
+        }
+    }
+    if (!entries.empty()) {
+        memcpy(out.data() + header.indexOffset, entries.data(), entries.size() * sizeof(PackEntry));
+    }
+    if (!strings.empty()) {
+        memcpy(out.data() + header.stringOffset, strings.data(), strings.size());
+    }
+    return out;
+}
+
+bool Writer::WriteFile(const std::filesystem::path& path) const {
+    std::vector<uint8_t> bytes = Build();
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) return false;
+    file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    return static_cast<bool>(file);
+}
+
+// ---- Reader ----
+
+bool Reader::Open(const std::filesystem::path& path) {
+    Close();
+    if (!m_file.Open(path)) return false;
+    if (!OpenMemory(m_file.GetData(), m_file.GetSize())) {
+        m_file.Close();
+        return false;
+    }
+    return true;
+}
+
+bool Reader::OpenMemory(const uint8_t* data, size_t size) {
+    m_data = data;
+    m_size = size;
+    if (!Validate()) {
+        m_data = nullptr;
+        m_size = 0;
+        m_entries = nullptr;
+        m_strings = nullptr;
+        m_count = 0;
+        return false;
+    }
+    return true;
+}
+
+void Reader::Close() {
+    m_file.Close();
+    m_data = nullptr;
+    m_size = 0;
+    m_entries = nullptr;
+    m_strings = nullptr;
+    m_stringSize = 0;
+    m_count = 0;
+}
+
+// 壊れた・古いパックを読まないよう、全オフセットが範囲内かを最初に確かめる
+bool Reader::Validate() {
+    if (!m_data || m_size < sizeof(PackHeader)) return false;
+
+    PackHeader header;
+    memcpy(&header, m_data, sizeof(header));
+    if (header.magic != MAGIC || header.version != VERSION) return false;
+    if (header.indexOffset % alignof(PackEntry) != 0) return false;
+    if (header.indexOffset > m_size) return false;
+    if (header.entryCount > (m_size - header.indexOffset) / sizeof(PackEntry)) return false;
+    if (header.stringOffset != header.indexOffset + uint64_t(header.entryCount) * sizeof(PackEntry)) return false;
+    if (header.stringOffset > m_size) return false;
+
+    m_entries = reinterpret_cast<const PackEntry*>(m_data + header.indexOffset);
+    m_strings = reinterpret_cast<const char*>(m_data + header.stringOffset);
+    m_stringSize = m_size - static_cast<size_t>(header.stringOffset);
+    m_count = header.entryCount;
+
+    for (uint32_t i = 0; i < m_count; i++) {
+        const PackEntry& entry = m_entries[i];
+        if (uint64_t(entry.nameOffset) + entry.nameLength > m_stringSize) return false;
+        if (entry.dataOffset > header.indexOffset) return false;
+        if (entry.dataSize > header.indexOffset - entry.dataOffset) return false;
+        if (i > 0 && !(GetName(m_entries[i - 1]) < GetName(entry))) return false;  // 名前順（重複なし）
+    }
+    return true;
+}
+
+std::string_view Reader::GetName(const PackEntry& entry) const {
+    return std::string_view(m_strings + entry.nameOffset, entry.nameLength);
+}
+
+const PackEntry* Reader::Find(std::string_view name) const {
+    const PackEntry* begin = m_entries;
+    const PackEntry* end = m_entries + m_count;
+    const PackEntry* it = std::lower_bound(begin, end, name, [this](const PackEntry& entry, std::string_view key) {
+        return GetName(entry) < key;
+    });
+    if (it == end || GetName(*it) != name) return nullptr;
+    return it;
+}
+
+} // namespace AssetPack
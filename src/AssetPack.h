@@ -0,0 +1,115 @@
+﻿#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "MappedFile.h"
+
+// 事前変換済みアセットをまとめたパックファイル
+// テクスチャはGPUにそのまま渡せるピクセル、音声はPCMで格納し、起動時のデコードを無くす
+//
+// レイアウト: ヘッダ | データ（16バイト境界） | 索引（名前順） | 名前文字列
+// 名前は小文字・区切り '/' の相対パス（例: "sprites/player.png"）
+namespace AssetPack {
+
+constexpr uint32_t MAGIC = 0x4B50534D;  // "MSPK"
+constexpr uint32_t VERSION = 1;
+constexpr uint32_t DATA_ALIGNMENT = 16;
+
+enum class AssetType : uint32_t {
+    Texture = 1,
+    Audio = 2
+};
+
+enum class PixelFormat : uint32_t {
+    RGBA8 = 0,
+    BC1 = 1,  // RGB 4bpp
+    BC3 = 2,  // RGBA 8bpp
+    BC7 = 3   // RGBA 8bpp（高品質）
+};
+
+struct PackHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t reserved;
+    uint64_t indexOffset;
+    uint64_t stringOffset;
+};
+
+struct PackEntry {
+    uint32_t nameOffset;     // 名前文字列領域からの位置
+    uint32_t nameLength;
+    AssetType type;
+    PixelFormat format;      // テクスチャ
+    uint32_t width;          // テクスチャ
+    uint32_t height;         // テクスチャ
+    uint32_t mipLevels;      // テクスチャ（データはミップ0から順に連結）
+    uint32_t channels;       // 音声
+    uint32_t sampleRate;     // 音声
+    uint32_t bitsPerSample;  // 音声
+    uint64_t dataOffset;     // ファイル先頭から
+    uint64_t dataSize;
+};
+
+static_assert(sizeof(PackHeader) == 32, "PackHeader layout");
+static_assert(sizeof(PackEntry) == 56, "PackEntry layout");
+
+// パス → パス内の名前（小文字・'/' 区切り、ASCIIのみ）
+std::string MakeName(std::wstring_view path);
+std::string MakeName(std::string_view path);
+
+// パックの書き出し（パッカーツールとテスト用）
+class Writer {
+public:
+    void AddTexture(std::string_view name, uint32_t width, uint32_t height, PixelFormat format,
+                    uint32_t mipLevels, const void* data, size_t size);
+    void AddAudio(std::string_view name, uint32_t channels, uint32_t sampleRate, uint32_t bitsPerSample,
+                  const void* data, size_t size);
+
+    std::vector<uint8_t> Build() const;
+    bool WriteFile(const std::filesystem::path& path) const;
+
+    size_t GetCount() const { return m_assets.size(); }
+
+private:
+    struct PendingAsset {
+        std::string name;
+        PackEntry entry;
+        std::vector<uint8_t> data;
+    };
+    void Add(std::string_view name, const PackEntry& entry, const void* data, size_t size);
+
+    std::vector<PendingAsset> m_assets;
+};
+
+// パックの読み込み（ファイルはマップするだけでコピーしない、読み取り専用なのでどのスレッドからでも使える）
+class Reader {
+public:
+    bool Open(const std::filesystem::path& path);
+    bool OpenMemory(const uint8_t* data, size_t size);  // 呼び出し側がdataを保持する
+    void Close();
+
+    bool IsOpen() const { return m_data != nullptr; }
+    uint32_t GetCount() const { return m_count; }
+
+    const PackEntry* Find(std::string_view name) const;  // 名前で二分探索（無ければnullptr）
+    const PackEntry* GetEntry(uint32_t index) const { return index < m_count ? &m_entries[index] : nullptr; }
+    std::string_view GetName(const PackEntry& entry) const;
+    const uint8_t* GetData(const PackEntry& entry) const { return m_data + entry.dataOffset; }
+
+private:
+    bool Validate();
+
+    MappedFile m_file;
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+    const PackEntry* m_entries = nullptr;
+    const char* m_strings = nullptr;
+    size_t m_stringSize = 0;
+    uint32_t m_count = 0;
+};
+
+} // namespace AssetPack
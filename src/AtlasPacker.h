@@ -0,0 +1,172 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// テクスチャアトラス用の矩形パッキング（MaxRects、Best Short Side Fit）
+struct AtlasRect {
+    int x;
+    int y;
+    int width;
+    int height;
+};
+
+class MaxRectsPacker {
+public:
+    MaxRectsPacker(int width, int height) { Reset(width, height); }
+
+    void Reset(int width, int height) {
+        m_width = width;
+        m_height = height;
+        m_usedArea = 0;
+        m_free.clear();
+        m_free.push_back({ 0, 0, width, height });
+    }
+
+    // 空き矩形のうち短辺の余りが最小の場所に置く（置けなければfalse）
+    bool Insert(int width, int height, AtlasRect* out) {
+        int best = -1;
+        int bestShort = 0;
+        int bestLong = 0;
+        for (size_t i = 0; i < m_free.size(); i++) {
+            const AtlasRect& f = m_free[i];
+            if (width > f.width || height > f.height) continue;
+            int dw = f.width - width;
+            int dh = f.height - height;
+            int shortSide = std::min(dw, dh);
+            int longSide = std::max(dw, dh);
+            if (best < 0 || shortSide < bestShort || (shortSide == bestShort && longSide < bestLong)) {
+                best = static_cast<int>(i);
+                bestShort = shortSide;
+                bestLong = longSide;
+            }
+        }
+        if (best < 0) return false;
+
+        AtlasRect placed = { m_free[best].x, m_free[best].y, width, height };
+        SplitFreeRects(placed);
+        PruneFreeRects();
+        m_usedArea += static_cast<int64_t>(width) * height;
+        *out = placed;
+        return true;
+    }
+
+    float GetOccupancy() const {
+        return static_cast<float>(m_usedArea) / (static_cast<float>(m_width) * m_height);
+    }
+    int GetWidth() const { return m_width; }
+    int GetHeight() const { return m_height; }
+
+private:
+    // 置いた矩形と重なる空き矩形を、重ならない最大4つの矩形に分割
+    void SplitFreeRects(const AtlasRect& used) {
+        m_split.clear();
+        for (const AtlasRect& f : m_free) {
+            if (used.x >= f.x + f.width || used.x + used.width <= f.x ||
+                used.y >= f.y + f.height || used.y + used.height <= f.y) {
+                m_split.push_back(f);
+                continue;
+            }
+            if (used.x > f.x) m_split.push_back({ f.x, f.y, used.x - f.x, f.height });
+            if (used.x + used.width < f.x + f.width) {
+                m_split.push_back({ used.x + used.width, f.y, f.x + f.width - (used.x + used.width), f.height });
+            }
+            if (used.y > f.y) m_split.push_back({ f.x, f.y, f.width, used.y - f.y });
+            if (used.y + used.height < f.y + f.height) {
+                m_split.push_back({ f.x, used.y + used.height, f.width, f.y + f.height - (used.y + used.height) });
+            }
+        }
+        m_free.swap(m_split);
+    }
+
+    // 他の空き矩形に含まれるものを除く
+    void PruneFreeRects() {
+        for (size_t i = 0; i < m_free.size(); i++) {
+            for (size_t j = i + 1; j < m_free.size(); ) {
+                if (Contains(m_free[i], m_free[j])) {
+                    m_free.erase(m_free.begin() + j);
+                } else if (Contains(m_free[j], m_free[i])) {
+                    m_free.erase(m_free.begin() + i);
+                    j = i + 1;
+                } else {
+                    j++;
+                }
+            }
+        }
+    }
+
+    static bool Contains(const AtlasRect& outer, const AtlasRect& inner) {
+        return inner.x >= outer.x && inner.y >= outer.y &&
+               inner.x + inner.width <= outer.x + outer.width &&
+               inner.y + inner.height <= outer.y + outer.height;
+    }
+
+    int m_width;
+    int m_height;
+    int64_t m_usedArea;
+    std::vector<AtlasRect> m_free;
+    std::vector<AtlasRect> m_split;
+};
+
+struct AtlasLayout {
+    int width = 0;
+    int height = 0;
+    std::vector<AtlasRect> rects;  // 入力と同じ順
+};
+
+// 全矩形が収まる最小の2のべき乗サイズを探して配置する（maxSizeを超えるならfalse）
+inline bool PackAtlas(const std::vector<AtlasRect>& sizes, int maxSize, AtlasLayout* layout) {
+    int64_t area = 0;
+    for (const auto& s : sizes) {
+        if (s.width > maxSize || s.height > maxSize) return false;
+        area += static_cast<int64_t>(s.width) * s.height;
+    }
+
+    // 長辺の大きい順に置くと詰まりやすい
+    std::vector<size_t> order(sizes.size());
+    for (size_t i = 0; i < order.size(); i++) order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return std::max(sizes[a].width, sizes[a].height) > std::max(sizes[b].width, sizes[b].height);
+    });
+
+    int width = 64;
+    int height = 64;
+    while (static_cast<int64_t>(width) * height < area) {
+        if (width <= height) width *= 2; else height *= 2;
+    }
+
+    while (width <= maxSize && height <= maxSize) {
+        MaxRectsPacker packer(width, height);
+        layout->rects.assign(sizes.size(), AtlasRect{ 0, 0, 0, 0 });
+        bool fitted = true;
+        for (size_t index : order) {
+            if (!packer.Insert(sizes[index].width, sizes[index].height, &layout->rects[index])) {
+                fitted = false;
+                break;
+            }
+        }
+        if (fitted) {
+            layout->width = width;
+            layout->height = height;
+            return true;
+        }
+        if (width <= height) width *= 2; else height *= 2;
+    }
+    return false;
+}
+
+// RGBA画像をアトラスの rect 内へ、周囲 padding ピクセルに端の色を引き伸ばしてコピー
+// （バイリニア補間で隣のスプライトの色が滲まないように）
+inline void BlitWithExtrude(uint8_t* atlas, int atlasWidth, const AtlasRect& rect,
+                            const uint8_t* pixels, int width, int height, int padding) {
+    for (int y = -padding; y < height + padding; y++) {
+        int sy = std::clamp(y, 0, height - 1);
+        uint8_t* dst = atlas + (static_cast<size_t>(rect.y + padding + y) * atlasWidth + rect.x) * 4;
+        const uint8_t* src = pixels + static_cast<size_t>(sy) * width * 4;
+        for (int x = 0; x < padding; x++) memcpy(dst + x * 4, src, 4);
+        memcpy(dst + padding * 4, src, static_cast<size_t>(width) * 4);
+        for (int x = 0; x < padding; x++) memcpy(dst + (padding + width + x) * 4, src + (width - 1) * 4, 4);
+    }
+}
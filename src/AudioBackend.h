@@ -0,0 +1,89 @@
+﻿#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// PCMの形式（同じ形式のボイスは使い回せる）
+struct AudioFormat {
+    uint16_t formatTag = 1;  // WAVE_FORMAT_PCM（3 = IEEE float）
+    uint16_t channels = 0;
+    uint32_t sampleRate = 0;
+    uint16_t bitsPerSample = 0;
+
+    bool operator==(const AudioFormat& other) const {
+        return formatTag == other.formatTag && channels == other.channels &&
+               sampleRate == other.sampleRate && bitsPerSample == other.bitsPerSample;
+    }
+};
+
+// 再生APIの抽象（AudioMixer など）。ボイスの割り当て・間引きは VoicePool が上で行う
+// ボイスは作ったら使い回す前提で、再生のたびに作り直さない
+class IAudioBackend {
+public:
+    static constexpr int INVALID_VOICE = -1;
+
+    virtual ~IAudioBackend() = default;
+
+    virtual int CreateVoice(const AudioFormat& format) = 0;  // 失敗なら INVALID_VOICE
+    virtual void DestroyVoice(int voice) = 0;
+    // 鳴っている音を止めて data を頭から鳴らす（data は再生が終わるまで呼び出し側が保持する）
+    // pan は -1（左）〜 1（右）
+    virtual void Start(int voice, const uint8_t* data, size_t size, float volume, float pan) = 0;
+    virtual void Stop(int voice) = 0;
+    virtual bool IsPlaying(int voice) const = 0;
+};
+
+// 何も鳴らさないバックエンド（テスト・音声デバイスが無い環境用）
+// Complete を呼ぶまで鳴り続ける扱い
+class NullAudioBackend : public IAudioBackend {
+public:
+    struct Voice {
+        AudioFormat format;
+        const uint8_t* data = nullptr;
+        size_t size = 0;
+        float volume = 0.0f;
+        float pan = 0.0f;
+        uint32_t startCount = 0;
+        bool isPlaying = false;
+        bool isAlive = false;
+    };
+
+    int CreateVoice(const AudioFormat& format) override {
+        Voice voice;
+        voice.format = format;
+        voice.isAlive = true;
+        m_voices.push_back(voice);
+        m_createCount++;
+        return static_cast<int>(m_voices.size()) - 1;
+    }
+    void DestroyVoice(int voice) override { m_voices[voice] = Voice(); }
+    void Start(int voice, const uint8_t* data, size_t size, float volume, float pan) override {
+        Voice& v = m_voices[voice];
+        v.data = data;
+        v.size = size;
+        v.volume = volume;
+        v.pan = pan;
+        v.startCount++;
+        v.isPlaying = true;
+        m_startCount++;
+    }
+    void Stop(int voice) override { m_voices[voice].isPlaying = false; }
+    bool IsPlaying(int voice) const override { return m_voices[voice].isPlaying; }
+
+    // 再生終了を模擬する
+    void Complete(int voice) { m_voices[voice].isPlaying = false; }
+    void CompleteAll() {
+        for (auto& voice : m_voices) voice.isPlaying = false;
+    }
+
+    const Voice& GetVoice(int voice) const { return m_voices[voice]; }
+    size_t GetVoiceCount() const { return m_voices.size(); }
+    uint32_t GetCreateCount() const { return m_createCount; }
+    uint32_t GetStartCount() const { return m_startCount; }
+
+private:
+    std::vector<Voice> m_voices;
+    uint32_t m_createCount = 0;
+    uint32_t m_startCount = 0;
+};
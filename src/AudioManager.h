@@ -6,41 +6,284 @@
 #include <vector>
 #include <unordered_map>
 #include <memory>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <thread>
 #include <Windows.h>
 #include <mfapi.h>
 #include <mfidl.h>
 #include <mfreadwrite.h>
+#include "AssetLoader.h"
+#include "AssetManifest.h"
+#include "AudioMixer.h"
+#include "AudioOutput.h"
+#include "SoundCache.h"
+#include "StreamDecoder.h"
+#include "VoicePool.h"
 
 #pragma comment(lib, "xaudio2.lib")
 #pragma comment(lib, "mfplat.lib")
 #pragma comment(lib, "mfreadwrite.lib")
 #pragma comment(lib, "mfuuid.lib")
 
-// 音声データ
+// デコードした音声データ
 struct AudioData {
     std::vector<BYTE> buffer;
     WAVEFORMATEX format;
 };
 
-// XAudio2 + Media Foundation ベースのオーディオマネージャー
+// XAudio2 のソースボイス1つにミキサーの出力を流すリアルタイム出力
+// 音声スレッドが BLOCK_FRAMES ずつ Render して、BUFFER_COUNT 個のバッファを順に回す
+class XAudio2Output : public IAudioOutput, private IXAudio2VoiceCallback {
+public:
+    static constexpr size_t BUFFER_COUNT = 3;
+
+    explicit XAudio2Output(IXAudio2* xaudio2)
+        : m_xaudio2(xaudio2), m_source(nullptr), m_mixer(nullptr), m_running(false) {
+        m_bufferEnd = CreateEventW(nullptr, FALSE, FALSE, nullptr);
+    }
+    ~XAudio2Output() override {
+        Stop();
+        CloseHandle(m_bufferEnd);
+    }
+
+    bool Start(AudioMixer* mixer) override {
+        WAVEFORMATEX wfx = {};
+        wfx.wFormatTag = WAVE_FORMAT_IEEE_FLOAT;
+        wfx.nChannels = AudioMixer::CHANNELS;
+        wfx.nSamplesPerSec = mixer->GetSampleRate();
+        wfx.wBitsPerSample = 32;
+        wfx.nBlockAlign = wfx.nChannels * wfx.wBitsPerSample / 8;
+        wfx.nAvgBytesPerSec = wfx.nSamplesPerSec * wfx.nBlockAlign;
+        if (FAILED(m_xaudio2->CreateSourceVoice(&m_source, &wfx, 0, XAUDIO2_DEFAULT_FREQ_RATIO, this))) {
+            m_source = nullptr;
+            return false;
+        }
+
+        m_mixer = mixer;
+        for (auto& buffer : m_buffers) buffer.assign(AudioMixer::BLOCK_FRAMES * AudioMixer::CHANNELS, 0.0f);
+        m_running = true;
+        m_source->Start();
+        m_thread = std::thread([this]() { ThreadMain(); });
+        return true;
+    }
+
+    void Stop() override {
+        if (m_thread.joinable()) {
+            m_running = false;
+            SetEvent(m_bufferEnd);
+            m_thread.join();
+        }
+        if (m_source) {
+            m_source->Stop();
+            m_source->FlushSourceBuffers();
+            m_source->DestroyVoice();
+            m_source = nullptr;
+        }
+        m_mixer = nullptr;
+    }
+
+private:
+    void ThreadMain() {
+        size_t next = 0;
+        while (m_running) {
+            XAUDIO2_VOICE_STATE state;
+            m_source->GetState(&state, XAUDIO2_VOICE_NOSAMPLESPLAYED);
+            if (state.BuffersQueued >= BUFFER_COUNT) {
+                WaitForSingleObject(m_bufferEnd, 100);
+                continue;
+            }
+            // 順番に提出しているので、空きがあれば一番古いバッファは再生し終わっている
+            std::vector<float>& buffer = m_buffers[next];
+            m_mixer->Render(buffer.data(), AudioMixer::BLOCK_FRAMES);
+
+            XAUDIO2_BUFFER submit = { 0 };
+            submit.AudioBytes = static_cast<UINT32>(buffer.size() * sizeof(float));
+            submit.pAudioData = reinterpret_cast<const BYTE*>(buffer.data());
+            m_source->SubmitSourceBuffer(&submit);
+            next = (next + 1) % BUFFER_COUNT;
+        }
+    }
+
+    // IXAudio2VoiceCallback（XAudio2 のスレッドから呼ばれる）
+    void STDMETHODCALLTYPE OnBufferEnd(void*) override { SetEvent(m_bufferEnd); }
+    void STDMETHODCALLTYPE OnVoiceProcessingPassStart(UINT32) override {}
+    void STDMETHODCALLTYPE OnVoiceProcessingPassEnd() override {}
+    void STDMETHODCALLTYPE OnStreamEnd() override {}
+    void STDMETHODCALLTYPE OnBufferStart(void*) override {}
+    void STDMETHODCALLTYPE OnLoopEnd(void*) override {}
+    void STDMETHODCALLTYPE OnVoiceError(void*, HRESULT) override {}
+
+    IXAudio2* m_xaudio2;
+    IXAudio2SourceVoice* m_source;
+    AudioMixer* m_mixer;
+    HANDLE m_bufferEnd;
+    std::thread m_thread;
+    std::atomic<bool> m_running;
+    std::array<std::vector<float>, BUFFER_COUNT> m_buffers;
+};
+
+// Media Foundation で MP3 などを少しずつデコードする（BGMのストリーミング用）
+// 出力はミキサーと同じレートのステレオ float にしてもらう
+class MediaFoundationStreamDecoder : public IStreamDecoder {
+public:
+    MediaFoundationStreamDecoder()
+        : m_reader(nullptr), m_sampleRate(0), m_pendingOffset(0), m_seekTarget(0), m_seeking(false), m_ended(false) {}
+    ~MediaFoundationStreamDecoder() override {
+        if (m_reader) m_reader->Release();
+    }
+
+    bool Open(const std::wstring& filepath, uint32_t sampleRate) {
+        if (FAILED(MFCreateSourceReaderFromURL(filepath.c_str(), nullptr, &m_reader))) {
+            m_reader = nullptr;
+            return false;
+        }
+
+        IMFMediaType* outputType = nullptr;
+        MFCreateMediaType(&outputType);
+        outputType->SetGUID(MF_MT_MAJOR_TYPE, MFMediaType_Audio);
+        outputType->SetGUID(MF_MT_SUBTYPE, MFAudioFormat_Float);
+        outputType->SetUINT32(MF_MT_AUDIO_BITS_PER_SAMPLE, 32);
+        outputType->SetUINT32(MF_MT_AUDIO_NUM_CHANNELS, 2);
+        outputType->SetUINT32(MF_MT_AUDIO_SAMPLES_PER_SECOND, sampleRate);
+        HRESULT hr = m_reader->SetCurrentMediaType(MF_SOURCE_READER_FIRST_AUDIO_STREAM, nullptr, outputType);
+        outputType->Release();
+        if (FAILED(hr)) return false;
+
+        // 実際の出力フォーマットを確認
+        IMFMediaType* actualType = nullptr;
+        m_reader->GetCurrentMediaType(MF_SOURCE_READER_FIRST_AUDIO_STREAM, &actualType);
+        UINT32 channels = 0;
+        actualType->GetUINT32(MF_MT_AUDIO_NUM_CHANNELS, &channels);
+        actualType->GetUINT32(MF_MT_AUDIO_SAMPLES_PER_SECOND, &m_sampleRate);
+        actualType->Release();
+        return channels == 2;
+    }
+
+    uint32_t GetSampleRate() const override { return m_sampleRate; }
+
+    size_t Read(float* out, size_t frames) override {
+        size_t written = 0;
+        while (written < frames) {
+            if (m_pendingOffset >= m_pending.size()) {
+                if (m_ended || !ReadSample()) break;
+                continue;
+            }
+            size_t count = (m_pending.size() - m_pendingOffset) / 2;
+            if (count > frames - written) count = frames - written;
+            std::copy(m_pending.begin() + m_pendingOffset, m_pending.begin() + m_pendingOffset + count * 2,
+                      out + written * 2);
+            m_pendingOffset += count * 2;
+            written += count;
+        }
+        return written;
+    }
+
+    bool Seek(uint64_t frame) override {
+        PROPVARIANT position;
+        PropVariantInit(&position);
+        position.vt = VT_I8;
+        position.hVal.QuadPart = static_cast<LONGLONG>(frame * 10000000ull / m_sampleRate);
+        HRESULT hr = m_reader->SetCurrentPosition(GUID_NULL, position);
+        PropVariantClear(&position);
+        if (FAILED(hr)) return false;
+
+        m_pending.clear();
+        m_pendingOffset = 0;
+        m_seekTarget = frame;
+        m_seeking = true;
+        m_ended = false;
+        return true;
+    }
+
+private:
+    // 次のサンプルを m_pending に読む
+    // MP3 の頭出しはフレーム単位なので、目標より前の分はサンプル時刻を見て捨てる
+    bool ReadSample() {
+        IMFSample* sample = nullptr;
+        DWORD flags = 0;
+        LONGLONG time = 0;
+        HRESULT hr = m_reader->ReadSample(MF_SOURCE_READER_FIRST_AUDIO_STREAM, 0, nullptr, &flags, &time, &sample);
+        if (FAILED(hr) || (flags & MF_SOURCE_READERF_ENDOFSTREAM)) {
+            if (sample) sample->Release();
+            m_ended = true;
+            return false;
+        }
+        if (!sample) return true;
+
+        IMFMediaBuffer* buffer = nullptr;
+        sample->ConvertToContiguousBuffer(&buffer);
+        BYTE* data = nullptr;
+        DWORD length = 0;
+        buffer->Lock(&data, nullptr, &length);
+        m_pending.assign(reinterpret_cast<const float*>(data), reinterpret_cast<const float*>(data + length));
+        buffer->Unlock();
+        buffer->Release();
+        sample->Release();
+        m_pendingOffset = 0;
+
+        if (m_seeking) {
+            uint64_t start = static_cast<uint64_t>(time) * m_sampleRate / 10000000ull;
+            uint64_t end = start + m_pending.size() / 2;
+            if (end <= m_seekTarget) {
+                m_pendingOffset = m_pending.size();
+            } else {
+                if (start < m_seekTarget) m_pendingOffset = static_cast<size_t>(m_seekTarget - start) * 2;
+                m_seeking = false;
+            }
+        }
+        return true;
+    }
+
+    IMFSourceReader* m_reader;
+    uint32_t m_sampleRate;
+    std::vector<float> m_pending;  // 読んだサンプルの残り
+    size_t m_pendingOffset;
+    uint64_t m_seekTarget;
+    bool m_seeking;
+    bool m_ended;
+};
+
+// ソフトウェアミキサー + Media Foundation（デコード）ベースのオーディオマネージャー
+// 効果音は AudioMixer で混ぜ、出力先は XAudio2（通常）か WAV ファイル（オフライン）
 class AudioManager {
 public:
+    static constexpr size_t SFX_VOICES = 32;  // 効果音は全部同じ形式なのでプールは1つ
+
     AudioManager() : m_xaudio2(nullptr), m_masterVoice(nullptr), m_mfInitialized(false) {}
     ~AudioManager() { Shutdown(); }
 
-    bool Initialize() {
+    // 効果音は登録だけして、デコードは初めて鳴らすときか Prefetch のとき（loader があればワーカーで）
+    // pack に変換済みのPCMがある音はデコードせずにそのまま使う
+    // capturePath を渡すとデバイスに出さず、ゲームのフレームに合わせてWAVに書き出す
+    bool Initialize(AssetLoader* loader = nullptr, const AssetPack::Reader* pack = nullptr,
+                    const std::wstring& capturePath = L"") {
         // Media Foundation初期化
         HRESULT hr = MFStartup(MF_VERSION);
         if (SUCCEEDED(hr)) {
             m_mfInitialized = true;
         }
 
-        // XAudio2初期化
-        hr = XAudio2Create(&m_xaudio2, 0, XAUDIO2_DEFAULT_PROCESSOR);
-        if (FAILED(hr)) return false;
-
-        hr = m_xaudio2->CreateMasteringVoice(&m_masterVoice);
-        if (FAILED(hr)) return false;
+        // ボイスは音の形式ごとに先に作っておき、鳴らすたびには作らない
+        m_mixer = std::make_unique<AudioMixer>();
+        m_voices = std::make_unique<VoicePool>(m_mixer.get(), SFX_VOICES);
+        m_cache = std::make_unique<SoundCache>(loader);
+        m_cache->SetReadyCallback([this](int sound) { OnSoundReady(sound); });
+
+        bool started = false;
+        if (!capturePath.empty()) {
+            m_output = std::make_unique<WavFileOutput>(std::filesystem::path(capturePath));
+            started = m_output->Start(m_mixer.get());
+            m_isCapturing = started;
+        } else if (SUCCEEDED(XAudio2Create(&m_xaudio2, 0, XAUDIO2_DEFAULT_PROCESSOR)) &&
+                   SUCCEEDED(m_xaudio2->CreateMasteringVoice(&m_masterVoice))) {
+            m_output = std::make_unique<XAudio2Output>(m_xaudio2);
+            started = m_output->Start(m_mixer.get());
+        }
+        if (!started) {
+            m_output = std::make_unique<NullAudioOutput>();
+        }
 
         // 実行ファイルのパスを取得
         wchar_t path[MAX_PATH];
@@ -49,28 +292,25 @@ public:
         size_t lastSlash = exePath.find_last_of(L"\\/");
         m_soundPath = exePath.substr(0, lastSlash) + L"\\..\\..\\assets\\sounds\\";
 
-        // 音声ファイルをプリロード（WAVとMP3両対応）
-        LoadAudio(L"shot", m_soundPath + L"player_shot.mp3");
-        LoadAudio(L"hit", m_soundPath + L"enemy_hit.mp3");
-        LoadAudio(L"destroy", m_soundPath + L"enemy_die.wav");
-        LoadAudio(L"player_hit", m_soundPath + L"hina_buoo.wav");
-        LoadAudio(L"bomb", m_soundPath + L"bomb.mp3");
-        LoadAudio(L"cursor", m_soundPath + L"cursor.mp3");
-        LoadAudio(L"confirm", m_soundPath + L"confirm.mp3");
-        LoadAudio(L"item", m_soundPath + L"hina_eyao.wav");
-        LoadAudio(L"spellcard", m_soundPath + L"stage1_boss_spellcard.wav");
+        for (const auto& sound : AssetManifest::SOUND_EFFECTS) {
+            AddSound(sound.name, sound.file, sound.priority, pack);
+            if (sound.preload) Prefetch(sound.name);
+        }
 
-        return true;
+        return started;
     }
 
     void Shutdown() {
-        for (auto& voice : m_activeVoices) {
-            if (voice) {
-                voice->Stop();
-                voice->DestroyVoice();
-            }
+        // 出力（音声スレッド）→ ボイス → ミキサーの順に止める
+        if (m_output) {
+            m_output->Stop();
+            m_output.reset();
         }
-        m_activeVoices.clear();
+        m_voices.reset();
+        m_mixer.reset();
+        m_cache.reset();  // ボイスが指していた PCM
+        m_soundIds.clear();
+        m_slots.clear();
 
         if (m_masterVoice) {
             m_masterVoice->DestroyVoice();
@@ -86,41 +326,118 @@ public:
         }
     }
 
-    // 汎用オーディオ読み込み（WAV/MP3対応）
-    bool LoadAudio(const std::wstring& name, const std::wstring& filepath) {
+    // 効果音を登録する（デコードはまだしない）
+    // パックにあればマップを直接指す（パックは AudioManager より長生きさせる）
+    void AddSound(const std::wstring& name, const std::wstring& file, int priority,
+                  const AssetPack::Reader* pack = nullptr) {
+        if (!m_cache || m_soundIds.count(name)) return;
+
+        int sound = SoundCache::INVALID_SOUND;
+        const AssetPack::PackEntry* entry = pack ? pack->Find(AssetManifest::SoundName(file)) : nullptr;
+        if (entry && entry->type == AssetPack::AssetType::Audio && entry->dataSize > 0) {
+            AudioFormat format;
+            format.channels = static_cast<uint16_t>(entry->channels);
+            format.sampleRate = entry->sampleRate;
+            format.bitsPerSample = static_cast<uint16_t>(entry->bitsPerSample);
+            sound = m_cache->AddMapped(format, pack->GetData(*entry), static_cast<size_t>(entry->dataSize));
+        } else {
+            std::wstring filepath = m_soundPath + file;
+            bool useMediaFoundation = m_mfInitialized;
+            sound = m_cache->Add([filepath, useMediaFoundation](std::vector<uint8_t>* pcm, AudioFormat* format) {
+                AudioData audio;
+                if (!DecodeAudio(filepath, useMediaFoundation, &audio)) return false;
+                *format = ToAudioFormat(audio.format);
+                *pcm = std::move(audio.buffer);
+                return true;
+            });
+        }
+
+        m_soundIds[name] = sound;
+        m_slots.push_back({ priority, VoicePool::INVALID_SOUND, false, 0.0f, 0.0f });
+        if (m_cache->GetState(sound) == SoundCache::State::Ready) OnSoundReady(sound);
+    }
+
+    // 鳴らす前にデコードを始めておく（画面の切り替わりなど）
+    void Prefetch(const std::wstring& name) {
+        auto it = m_soundIds.find(name);
+        if (it != m_soundIds.end()) m_cache->Request(it->second);
+    }
+    void PrefetchAll() {
+        for (const auto& entry : m_soundIds) m_cache->Request(entry.second);
+    }
+
+    const SoundCache* GetSoundCache() const { return m_cache.get(); }
+
+    static AudioFormat ToAudioFormat(const WAVEFORMATEX& wfx) {
+        AudioFormat format;
+        format.formatTag = wfx.wFormatTag;
+        format.channels = wfx.nChannels;
+        format.sampleRate = wfx.nSamplesPerSec;
+        format.bitsPerSample = wfx.wBitsPerSample;
+        return format;
+    }
+
+    // 拡張子で振り分けてPCMにデコードする（メンバーに触らないのでどのスレッドからでも呼べる）
+    static bool DecodeAudio(const std::wstring& filepath, bool useMediaFoundation, AudioData* out) {
         // 拡張子を確認
         std::wstring ext = filepath.substr(filepath.find_last_of(L".") + 1);
         for (auto& c : ext) c = towlower(c);
 
         if (ext == L"wav") {
-            return LoadWav(name, filepath);
+            return DecodeWav(filepath, out);
         } else if (ext == L"mp3" || ext == L"m4a" || ext == L"wma" || ext == L"flac") {
-            return LoadWithMediaFoundation(name, filepath);
+            return useMediaFoundation && DecodeWithMediaFoundation(filepath, out);
         }
         return false;
     }
 
-    void PlaySound(const std::wstring& name, float volume = 1.0f) {
-        auto it = m_sounds.find(name);
-        if (it == m_sounds.end()) return;
+    // このフレームに鳴らす音を登録する（実際に鳴るのは EndFrame、同じ音は1回にまとまる）
+    // pan は -1（左）〜 1（右）
+    void PlaySound(const std::wstring& name, float volume = 1.0f, float pan = 0.0f) {
+        auto it = m_soundIds.find(name);
+        if (it == m_soundIds.end() || !m_voices) return;
 
-        const AudioData& audio = it->second;
+        SoundSlot& slot = m_slots[it->second];
+        if (slot.voiceSound != VoicePool::INVALID_SOUND) {
+            m_voices->Play(slot.voiceSound, volume, pan);
+            return;
+        }
+        // 初めて鳴らす音はデコードが済んでから鳴らす（要求は大きいもの1つだけ残す）
+        if (!slot.hasPending || volume > slot.pendingVolume) {
+            slot.pendingVolume = volume;
+            slot.pendingPan = pan;
+        }
+        slot.hasPending = true;
+        m_cache->Request(it->second);
+    }
 
-        IXAudio2SourceVoice* sourceVoice = nullptr;
-        HRESULT hr = m_xaudio2->CreateSourceVoice(&sourceVoice, &audio.format);
-        if (FAILED(hr)) return;
+    // 1フレーム分の要求をまとめて鳴らす（Game::Update の最後に1回）
+    void EndFrame() {
+        if (m_voices) m_voices->EndFrame();
+        if (m_output) m_output->EndFrame();
+    }
 
-        XAUDIO2_BUFFER buffer = { 0 };
-        buffer.AudioBytes = static_cast<UINT32>(audio.buffer.size());
-        buffer.pAudioData = audio.buffer.data();
-        buffer.Flags = XAUDIO2_END_OF_STREAM;
+    const VoicePool* GetVoicePool() const { return m_voices.get(); }
+    AudioMixer* GetMixer() { return m_mixer.get(); }
+    bool IsCapturing() const { return m_isCapturing; }
 
-        sourceVoice->SetVolume(volume);
-        sourceVoice->SubmitSourceBuffer(&buffer);
-        sourceVoice->Start();
+    // BGM 用のデコーダーを開く（WAV は自前、それ以外は Media Foundation）
+    // BGMPlayer のストリームスレッドから呼ばれる
+    static std::unique_ptr<IStreamDecoder> OpenStreamDecoder(const std::filesystem::path& path, uint32_t sampleRate) {
+        std::wstring ext = path.extension().wstring();
+        for (auto& c : ext) c = towlower(c);
+        if (ext == L".wav") {
+            auto decoder = std::make_unique<WavStreamDecoder>();
+            if (decoder->Open(path)) return decoder;
+            return nullptr;
+        }
 
-        m_activeVoices.push_back(sourceVoice);
-        CleanupVoices();
+        // Media Foundation はスレッドごとに COM の初期化が要る（失敗してもメインスレッドなら初期化済み）
+        static thread_local bool comInitialized = SUCCEEDED(CoInitializeEx(nullptr, COINIT_MULTITHREADED));
+        (void)comInitialized;
+        auto decoder = std::make_unique<MediaFoundationStreamDecoder>();
+        if (decoder->Open(path.wstring(), sampleRate)) return decoder;
+        return nullptr;
     }
 
     void PlayShot() { PlaySound(L"shot", 0.5f * m_masterVolume); }
@@ -141,8 +458,9 @@ public:
 
 private:
     float m_masterVolume = 1.0f;  // SE全体の音量
+    bool m_isCapturing = false;   // WAVに書き出し中（デバイスには出さない）
     // WAVファイル読み込み
-    bool LoadWav(const std::wstring& name, const std::wstring& filepath) {
+    static bool DecodeWav(const std::wstring& filepath, AudioData* out) {
         HANDLE file = CreateFileW(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ,
                                    nullptr, OPEN_EXISTING, 0, nullptr);
         if (file == INVALID_HANDLE_VALUE) return false;
@@ -176,10 +494,8 @@ private:
                 fmt.wBitsPerSample = *reinterpret_cast<WORD*>(ptr + 22);
                 fmt.cbSize = 0;
             } else if (memcmp(ptr, "data", 4) == 0) {
-                AudioData audio;
-                audio.format = fmt;
-                audio.buffer.assign(ptr + 8, ptr + 8 + chunkSize);
-                m_sounds[name] = std::move(audio);
+                out->format = fmt;
+                out->buffer.assign(ptr + 8, ptr + 8 + chunkSize);
                 return true;
             }
             ptr += 8 + chunkSize;
@@ -188,9 +504,7 @@ private:
     }
 
     // Media Foundationを使ったMP3/その他形式の読み込み
-    bool LoadWithMediaFoundation(const std::wstring& name, const std::wstring& filepath) {
-        if (!m_mfInitialized) return false;
-
+    static bool DecodeWithMediaFoundation(const std::wstring& filepath, AudioData* out) {
         IMFSourceReader* reader = nullptr;
         HRESULT hr = MFCreateSourceReaderFromURL(filepath.c_str(), nullptr, &reader);
         if (FAILED(hr)) return false;
@@ -248,44 +562,44 @@ private:
         if (audioBuffer.empty()) return false;
 
         // AudioDataに格納
-        AudioData audio;
-        audio.buffer = std::move(audioBuffer);
-        audio.format.wFormatTag = WAVE_FORMAT_PCM;
-        audio.format.nChannels = static_cast<WORD>(channels);
-        audio.format.nSamplesPerSec = sampleRate;
-        audio.format.wBitsPerSample = static_cast<WORD>(bitsPerSample);
-        audio.format.nBlockAlign = audio.format.nChannels * audio.format.wBitsPerSample / 8;
-        audio.format.nAvgBytesPerSec = audio.format.nSamplesPerSec * audio.format.nBlockAlign;
-        audio.format.cbSize = 0;
-
-        m_sounds[name] = std::move(audio);
+        out->buffer = std::move(audioBuffer);
+        out->format.wFormatTag = WAVE_FORMAT_PCM;
+        out->format.nChannels = static_cast<WORD>(channels);
+        out->format.nSamplesPerSec = sampleRate;
+        out->format.wBitsPerSample = static_cast<WORD>(bitsPerSample);
+        out->format.nBlockAlign = out->format.nChannels * out->format.wBitsPerSample / 8;
+        out->format.nAvgBytesPerSec = out->format.nSamplesPerSec * out->format.nBlockAlign;
+        out->format.cbSize = 0;
         return true;
     }
 
-    void CleanupVoices() {
-        auto it = m_activeVoices.begin();
-        while (it != m_activeVoices.end()) {
-            XAUDIO2_VOICE_STATE state;
-            (*it)->GetState(&state);
-            if (state.BuffersQueued == 0) {
-                (*it)->DestroyVoice();
-                it = m_activeVoices.erase(it);
-            } else {
-                ++it;
-            }
-        }
-
-        while (m_activeVoices.size() > 32) {
-            m_activeVoices.front()->Stop();
-            m_activeVoices.front()->DestroyVoice();
-            m_activeVoices.erase(m_activeVoices.begin());
+    struct SoundSlot {
+        int priority;
+        int voiceSound;        // VoicePool の音番号（デコードが済むまで INVALID_SOUND）
+        bool hasPending;       // デコード待ちの間に鳴らそうとした
+        float pendingVolume;
+        float pendingPan;
+    };
+
+    // デコードが済んだ音をボイスプールに登録し、待っていた分を鳴らす
+    void OnSoundReady(int sound) {
+        SoundSlot& slot = m_slots[sound];
+        slot.voiceSound = m_voices->RegisterSound(SoundCache::SFX_FORMAT, m_cache->GetData(sound),
+                                                  m_cache->GetSize(sound), slot.priority);
+        if (slot.voiceSound != VoicePool::INVALID_SOUND && slot.hasPending) {
+            m_voices->Play(slot.voiceSound, slot.pendingVolume, slot.pendingPan);
         }
+        slot.hasPending = false;
     }
 
     IXAudio2* m_xaudio2;
     IXAudio2MasteringVoice* m_masterVoice;
     std::wstring m_soundPath;
-    std::unordered_map<std::wstring, AudioData> m_sounds;
-    std::vector<IXAudio2SourceVoice*> m_activeVoices;
+    std::unordered_map<std::wstring, int> m_soundIds;      // 名前 → SoundCache の音番号（= m_slots の添字）
+    std::vector<SoundSlot> m_slots;
+    std::unique_ptr<SoundCache> m_cache;                   // PCM（ボイスが直接指すので m_voices より後に破棄）
+    std::unique_ptr<AudioMixer> m_mixer;
+    std::unique_ptr<VoicePool> m_voices;                   // m_mixer より先に破棄する
+    std::unique_ptr<IAudioOutput> m_output;                // 音声スレッドが m_mixer を読むので最初に止める
     bool m_mfInitialized;
 };
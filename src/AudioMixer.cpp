@@ -0,0 +1,280 @@
+﻿#include "AudioMixer.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define AUDIO_MIXER_SSE2 1
+#endif
+
+namespace {
+
+constexpr uint64_t FIXED_ONE = 1ull << 32;
+constexpr float FIXED_TO_FLOAT = 1.0f / 4294967296.0f;
+
+// 1サンプルを -1〜1 の float に読む
+struct Pcm8 {
+    static float Load(const uint8_t* p) { return (static_cast<int>(p[0]) - 128) * (1.0f / 128.0f); }
+};
+struct Pcm16 {
+    static float Load(const uint8_t* p) {
+        int16_t v;
+        memcpy(&v, p, sizeof(v));
+        return v * (1.0f / 32768.0f);
+    }
+};
+struct Pcm24 {
+    static float Load(const uint8_t* p) {
+        uint32_t u = static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+                     (static_cast<uint32_t>(p[2]) << 16);
+        int32_t v = static_cast<int32_t>(u << 8) >> 8;
+        return v * (1.0f / 8388608.0f);
+    }
+};
+struct Pcm32 {
+    static float Load(const uint8_t* p) {
+        int32_t v;
+        memcpy(&v, p, sizeof(v));
+        return v * (1.0f / 2147483648.0f);
+    }
+};
+struct Float32 {
+    static float Load(const uint8_t* p) {
+        float v;
+        memcpy(&v, p, sizeof(v));
+        return v;
+    }
+};
+
+enum class SampleKind { Unsupported, Pcm8, Pcm16, Pcm24, Pcm32, Float32 };
+
+SampleKind GetSampleKind(const AudioFormat& format) {
+    if (format.channels < 1 || format.channels > 2 || format.sampleRate == 0) return SampleKind::Unsupported;
+    if (format.formatTag == 1) {
+        switch (format.bitsPerSample) {
+        case 8: return SampleKind::Pcm8;
+        case 16: return SampleKind::Pcm16;
+        case 24: return SampleKind::Pcm24;
+        case 32: return SampleKind::Pcm32;
+        }
+    } else if (format.formatTag == 3 && format.bitsPerSample == 32) {
+        return SampleKind::Float32;
+    }
+    return SampleKind::Unsupported;
+}
+
+// 元データを出力レートのステレオ float（LRLR...）にして scratch に書き、書いたフレーム数を返す
+// モノラルは左右に同じ値を入れる
+template <typename Sample>
+size_t Resample(const uint8_t* data, size_t frameCount, const AudioFormat& format,
+                uint64_t& position, uint64_t step, float* scratch, size_t frames) {
+    const size_t bytesPerSample = format.bitsPerSample / 8;
+    const size_t stride = bytesPerSample * format.channels;
+    const size_t right = format.channels > 1 ? bytesPerSample : 0;
+    const uint64_t end = static_cast<uint64_t>(frameCount) << 32;
+
+    size_t written = 0;
+    if (step == FIXED_ONE) {
+        // 同じレートなら補間しない
+        size_t index = static_cast<size_t>(position >> 32);
+        size_t count = std::min(frames, frameCount - index);
+        for (; written < count; written++, index++) {
+            const uint8_t* p = data + index * stride;
+            scratch[written * 2] = Sample::Load(p);
+            scratch[written * 2 + 1] = Sample::Load(p + right);
+        }
+        position += static_cast<uint64_t>(count) << 32;
+        return written;
+    }
+
+    for (; written < frames && position < end; written++, position += step) {
+        size_t index = static_cast<size_t>(position >> 32);
+        size_t next = index + 1 < frameCount ? index + 1 : index;
+        float t = static_cast<float>(position & (FIXED_ONE - 1)) * FIXED_TO_FLOAT;
+        const uint8_t* a = data + index * stride;
+        const uint8_t* b = data + next * stride;
+        float l0 = Sample::Load(a), l1 = Sample::Load(b);
+        float r0 = Sample::Load(a + right), r1 = Sample::Load(b + right);
+        scratch[written * 2] = l0 + (l1 - l0) * t;
+        scratch[written * 2 + 1] = r0 + (r1 - r0) * t;
+    }
+    return written;
+}
+
+size_t ResampleAny(SampleKind kind, const uint8_t* data, size_t frameCount, const AudioFormat& format,
+                   uint64_t& position, uint64_t step, float* scratch, size_t frames) {
+    switch (kind) {
+    case SampleKind::Pcm8: return Resample<Pcm8>(data, frameCount, format, position, step, scratch, frames);
+    case SampleKind::Pcm16: return Resample<Pcm16>(data, frameCount, format, position, step, scratch, frames);
+    case SampleKind::Pcm24: return Resample<Pcm24>(data, frameCount, format, position, step, scratch, frames);
+    case SampleKind::Pcm32: return Resample<Pcm32>(data, frameCount, format, position, step, scratch, frames);
+    case SampleKind::Float32: return Resample<Float32>(data, frameCount, format, position, step, scratch, frames);
+    case SampleKind::Unsupported: break;
+    }
+    return 0;
+}
+
+uint64_t GetStep(uint32_t sourceRate, uint32_t outputRate) {
+    return (static_cast<uint64_t>(sourceRate) << 32) / outputRate;
+}
+
+// bus += src * (gainL, gainR)
+void Accumulate(float* bus, const float* src, size_t frames, float gainL, float gainR) {
+    const size_t count = frames * 2;
+    size_t i = 0;
+#ifdef AUDIO_MIXER_SSE2
+    const __m128 gain = _mm_setr_ps(gainL, gainR, gainL, gainR);
+    for (; i + 4 <= count; i += 4) {
+        __m128 mixed = _mm_add_ps(_mm_loadu_ps(bus + i), _mm_mul_ps(_mm_loadu_ps(src + i), gain));
+        _mm_storeu_ps(bus + i, mixed);
+    }
+#endif
+    for (; i < count; i += 2) {
+        bus[i] += src[i] * gainL;
+        bus[i + 1] += src[i + 1] * gainR;
+    }
+}
+
+// out = clamp(bus * master, -1, 1)
+void WriteOutput(float* out, const float* bus, size_t count, float master) {
+    size_t i = 0;
+#ifdef AUDIO_MIXER_SSE2
+    const __m128 scale = _mm_set1_ps(master);
+    const __m128 lo = _mm_set1_ps(-1.0f);
+    const __m128 hi = _mm_set1_ps(1.0f);
+    for (; i + 4 <= count; i += 4) {
+        __m128 v = _mm_mul_ps(_mm_loadu_ps(bus + i), scale);
+        _mm_storeu_ps(out + i, _mm_min_ps(_mm_max_ps(v, lo), hi));
+    }
+#endif
+    for (; i < count; i++) {
+        out[i] = std::clamp(bus[i] * master, -1.0f, 1.0f);
+    }
+}
+
+} // namespace
+
+AudioMixer::AudioMixer(uint32_t sampleRate)
+    : m_bus(BLOCK_FRAMES * CHANNELS)
+    , m_scratch(BLOCK_FRAMES * CHANNELS)
+    , m_sampleRate(sampleRate)
+    , m_masterVolume(1.0f)
+    , m_renderedFrames(0)
+{
+}
+
+int AudioMixer::CreateVoice(const AudioFormat& format) {
+    if (GetSampleKind(format) == SampleKind::Unsupported) return INVALID_VOICE;
+
+    Voice voice = {};
+    voice.format = format;
+    voice.step = GetStep(format.sampleRate, m_sampleRate);
+    voice.isAlive = true;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (size_t i = 0; i < m_voices.size(); i++) {
+        if (!m_voices[i].isAlive) {
+            m_voices[i] = voice;
+            return static_cast<int>(i);
+        }
+    }
+    m_voices.push_back(voice);
+    return static_cast<int>(m_voices.size()) - 1;
+}
+
+void AudioMixer::DestroyVoice(int voice) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_voices[voice].isAlive = false;
+    m_voices[voice].isPlaying = false;
+}
+
+void AudioMixer::Start(int voice, const uint8_t* data, size_t size, float volume, float pan) {
+    pan = std::clamp(pan, -1.0f, 1.0f);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Voice& v = m_voices[voice];
+    size_t frameBytes = static_cast<size_t>(v.format.channels) * (v.format.bitsPerSample / 8);
+    v.data = data;
+    v.frameCount = size / frameBytes;
+    v.position = 0;
+    // 中央で左右とも等倍、振った側はそのまま・反対側を絞る
+    v.gainL = volume * std::min(1.0f, 1.0f - pan);
+    v.gainR = volume * std::min(1.0f, 1.0f + pan);
+    v.isPlaying = v.frameCount > 0;
+}
+
+void AudioMixer::Stop(int voice) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_voices[voice].isPlaying = false;
+}
+
+bool AudioMixer::IsPlaying(int voice) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_voices[voice].isPlaying;
+}
+
+void AudioMixer::SetMasterVolume(float volume) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_masterVolume = volume;
+}
+
+void AudioMixer::AddSource(IAudioSource* source) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_sources.push_back(source);
+}
+
+void AudioMixer::RemoveSource(IAudioSource* source) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_sources.erase(std::remove(m_sources.begin(), m_sources.end(), source), m_sources.end());
+}
+
+uint64_t AudioMixer::GetRenderedFrames() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_renderedFrames;
+}
+
+void AudioMixer::Render(float* out, size_t frames) {
+    while (frames > 0) {
+        size_t block = std::min(frames, BLOCK_FRAMES);
+        {
+            // ロックは1ブロックずつ（ゲームスレッドを長く待たせない）
+            std::lock_guard<std::mutex> lock(m_mutex);
+            std::fill(m_bus.begin(), m_bus.begin() + block * CHANNELS, 0.0f);
+            for (auto& voice : m_voices) {
+                if (voice.isPlaying) MixVoice(voice, m_bus.data(), block);
+            }
+            for (IAudioSource* source : m_sources) {
+                source->Mix(m_bus.data(), block);
+            }
+            WriteOutput(out, m_bus.data(), block * CHANNELS, m_masterVolume);
+            m_renderedFrames += block;
+        }
+        out += block * CHANNELS;
+        frames -= block;
+    }
+}
+
+void AudioMixer::MixVoice(Voice& voice, float* bus, size_t frames) {
+    size_t written = ResampleAny(GetSampleKind(voice.format), voice.data, voice.frameCount, voice.format,
+                                 voice.position, voice.step, m_scratch.data(), frames);
+    Accumulate(bus, m_scratch.data(), written, voice.gainL, voice.gainR);
+
+    if (written < frames || voice.position >= (static_cast<uint64_t>(voice.frameCount) << 32)) {
+        voice.isPlaying = false;
+    }
+}
+
+bool AudioMixer::Convert(const AudioFormat& format, const uint8_t* data, size_t size, uint32_t sampleRate,
+                         std::vector<float>* out) {
+    SampleKind kind = GetSampleKind(format);
+    if (kind == SampleKind::Unsupported || sampleRate == 0) return false;
+
+    size_t frameCount = size / (static_cast<size_t>(format.channels) * (format.bitsPerSample / 8));
+    uint64_t step = GetStep(format.sampleRate, sampleRate);
+    uint64_t end = static_cast<uint64_t>(frameCount) << 32;
+    size_t outFrames = static_cast<size_t>((end + step - 1) / step);
+
+    out->resize(outFrames * CHANNELS);
+    uint64_t position = 0;
+    return ResampleAny(kind, data, frameCount, format, position, step, out->data(), outFrames) == outFrames;
+}
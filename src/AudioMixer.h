@@ -0,0 +1,74 @@
+﻿#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include "AudioBackend.h"
+
+// ボイス以外にミキサーへ音を足すもの（BGMのストリームなど）
+// Mix は出力スレッドから、ミキサーのロック中に呼ばれる（frames は BLOCK_FRAMES 以下）
+class IAudioSource {
+public:
+    virtual ~IAudioSource() = default;
+    virtual void Mix(float* bus, size_t frames) = 0;
+};
+
+// ソフトウェアミキサー（OS非依存）
+// 全ボイスを float32 ステレオのミックスバスに足し込み、出力先（IAudioOutput）が
+// ブロック単位で Render を呼んで取り出す。ボイスごとに音量・パン・リサンプリング（線形補間）
+// IAudioBackend として VoicePool から使う
+class AudioMixer : public IAudioBackend {
+public:
+    static constexpr uint32_t DEFAULT_SAMPLE_RATE = 44100;
+    static constexpr uint32_t CHANNELS = 2;
+    static constexpr size_t BLOCK_FRAMES = 512;  // 1回にまとめてミックスする最大フレーム数
+
+    explicit AudioMixer(uint32_t sampleRate = DEFAULT_SAMPLE_RATE);
+
+    // 対応形式: PCM 8/16/24/32bit・float32、1〜2ch（それ以外は INVALID_VOICE）
+    int CreateVoice(const AudioFormat& format) override;
+    void DestroyVoice(int voice) override;
+    void Start(int voice, const uint8_t* data, size_t size, float volume, float pan) override;
+    void Stop(int voice) override;
+    bool IsPlaying(int voice) const override;
+
+    // 破棄する前に RemoveSource すること
+    void AddSource(IAudioSource* source);
+    void RemoveSource(IAudioSource* source);
+
+    // frames 分ミックスして out（LRLR... の float、-1〜1）に書く。出力先のスレッドから呼ぶ
+    void Render(float* out, size_t frames);
+
+    // PCM を sampleRate のステレオ float に変換する（再生時と同じ補間。効果音の形式をそろえる用）
+    static bool Convert(const AudioFormat& format, const uint8_t* data, size_t size, uint32_t sampleRate,
+                        std::vector<float>* out);
+
+    void SetMasterVolume(float volume);
+    uint32_t GetSampleRate() const { return m_sampleRate; }
+    uint64_t GetRenderedFrames() const;
+
+private:
+    struct Voice {
+        AudioFormat format;
+        const uint8_t* data;
+        size_t frameCount;
+        uint64_t position;  // 元データ上の位置（32.32 固定小数点）
+        uint64_t step;      // 出力1フレームあたりの進み（32.32）
+        float gainL;
+        float gainR;
+        bool isAlive;
+        bool isPlaying;
+    };
+
+    void MixVoice(Voice& voice, float* bus, size_t frames);
+
+    mutable std::mutex m_mutex;  // ボイス操作（ゲームスレッド）と Render（出力スレッド）の排他
+    std::vector<Voice> m_voices;
+    std::vector<IAudioSource*> m_sources;
+    std::vector<float> m_bus;      // BLOCK_FRAMES 分のミックスバス
+    std::vector<float> m_scratch;  // 1ボイス分をステレオ float に変換した作業領域
+    uint32_t m_sampleRate;
+    float m_masterVolume;
+    uint64_t m_renderedFrames;
+};
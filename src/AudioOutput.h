@@ -0,0 +1,110 @@
+﻿#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+#include "AudioMixer.h"
+
+// ミキサーの出力先
+// リアルタイム出力（XAudio2 など）は Start で音声スレッドを立てて Render を呼び続ける
+// オフライン出力はゲームのフレームに合わせて EndFrame で進める（実時間に依存しない）
+class IAudioOutput {
+public:
+    virtual ~IAudioOutput() = default;
+
+    virtual bool Start(AudioMixer* mixer) = 0;
+    virtual void Stop() = 0;
+    // ゲームの1フレームの終わりに呼ぶ
+    virtual void EndFrame() {}
+};
+
+// 何も出さない（音声デバイスが無い環境用）
+class NullAudioOutput : public IAudioOutput {
+public:
+    bool Start(AudioMixer*) override { return true; }
+    void Stop() override {}
+};
+
+// WAVファイルに書き出すオフライン出力（16bit ステレオ）
+// 1フレーム = 1/framesPerSecond 秒分をフレームごとに書くので、同じ入力なら毎回同じ音になる
+class WavFileOutput : public IAudioOutput {
+public:
+    explicit WavFileOutput(const std::filesystem::path& path, uint32_t framesPerSecond = 60)
+        : m_path(path), m_mixer(nullptr), m_framesPerSecond(framesPerSecond), m_gameFrame(0), m_writtenFrames(0) {}
+    ~WavFileOutput() override { Stop(); }
+
+    bool Start(AudioMixer* mixer) override {
+        m_file.open(m_path, std::ios::binary | std::ios::trunc);
+        if (!m_file.is_open()) return false;
+        m_mixer = mixer;
+        m_gameFrame = 0;
+        m_writtenFrames = 0;
+        WriteHeader();  // サイズは Stop で書き直す
+        return true;
+    }
+
+    void Stop() override {
+        if (!m_file.is_open()) return;
+        m_file.seekp(0);
+        WriteHeader();
+        m_file.close();
+        m_mixer = nullptr;
+    }
+
+    void EndFrame() override {
+        if (!m_mixer) return;
+        // 端数を溜めないように累積で割る（44100Hz/60fps なら毎フレーム735）
+        uint32_t rate = m_mixer->GetSampleRate();
+        uint64_t from = m_gameFrame * rate / m_framesPerSecond;
+        uint64_t to = (m_gameFrame + 1) * rate / m_framesPerSecond;
+        m_gameFrame++;
+        Write(static_cast<size_t>(to - from));
+    }
+
+    uint64_t GetWrittenFrames() const { return m_writtenFrames; }
+
+private:
+    void Write(size_t frames) {
+        m_mix.resize(frames * AudioMixer::CHANNELS);
+        m_pcm.resize(frames * AudioMixer::CHANNELS);
+        m_mixer->Render(m_mix.data(), frames);
+        for (size_t i = 0; i < m_mix.size(); i++) {
+            m_pcm[i] = static_cast<int16_t>(m_mix[i] * 32767.0f);
+        }
+        m_file.write(reinterpret_cast<const char*>(m_pcm.data()), m_pcm.size() * sizeof(int16_t));
+        m_writtenFrames += frames;
+    }
+
+    void WriteHeader() {
+        const uint16_t channels = AudioMixer::CHANNELS;
+        const uint16_t bits = 16;
+        const uint32_t rate = m_mixer ? m_mixer->GetSampleRate() : AudioMixer::DEFAULT_SAMPLE_RATE;
+        const uint16_t blockAlign = channels * bits / 8;
+        const uint32_t dataSize = static_cast<uint32_t>(m_writtenFrames * blockAlign);
+
+        auto u32 = [this](uint32_t v) { m_file.write(reinterpret_cast<const char*>(&v), 4); };
+        auto u16 = [this](uint16_t v) { m_file.write(reinterpret_cast<const char*>(&v), 2); };
+        m_file.write("RIFF", 4);
+        u32(36 + dataSize);
+        m_file.write("WAVEfmt ", 8);
+        u32(16);
+        u16(1);  // WAVE_FORMAT_PCM
+        u16(channels);
+        u32(rate);
+        u32(rate * blockAlign);
+        u16(blockAlign);
+        u16(bits);
+        m_file.write("data", 4);
+        u32(dataSize);
+    }
+
+    std::filesystem::path m_path;
+    std::ofstream m_file;
+    AudioMixer* m_mixer;
+    uint32_t m_framesPerSecond;
+    uint64_t m_gameFrame;
+    uint64_t m_writtenFrames;
+    std::vector<float> m_mix;
+    std::vector<int16_t> m_pcm;
+};
@@ -0,0 +1,69 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+// ステレオ float（LRLR...）のリングバッファ
+// 書き手1スレッド・読み手1スレッド専用でロックしない（位置は単調増加のカウンタ）
+// windows.h の後から読まれるので min/max マクロとぶつかる std::min は使わない
+class AudioRingBuffer {
+public:
+    static constexpr size_t CHANNELS = 2;
+
+    // 容量は2の冪に切り上げる
+    explicit AudioRingBuffer(size_t frames) : m_readPos(0), m_writePos(0) {
+        size_t capacity = 1;
+        while (capacity < frames) capacity <<= 1;
+        m_data.resize(capacity * CHANNELS);
+        m_mask = capacity - 1;
+    }
+
+    size_t GetCapacity() const { return m_mask + 1; }
+    size_t GetAvailable() const {
+        return m_writePos.load(std::memory_order_acquire) - m_readPos.load(std::memory_order_acquire);
+    }
+    size_t GetFree() const { return GetCapacity() - GetAvailable(); }
+
+    // 書き手側。書けたフレーム数を返す
+    size_t Write(const float* frames, size_t count) {
+        size_t write = m_writePos.load(std::memory_order_relaxed);
+        size_t read = m_readPos.load(std::memory_order_acquire);
+        size_t space = GetCapacity() - (write - read);
+        if (count > space) count = space;
+        CopyIn(frames, count, write);
+        m_writePos.store(write + count, std::memory_order_release);
+        return count;
+    }
+
+    // 読み手側。読めたフレーム数を返す
+    size_t Read(float* out, size_t count) {
+        size_t read = m_readPos.load(std::memory_order_relaxed);
+        size_t write = m_writePos.load(std::memory_order_acquire);
+        if (count > write - read) count = write - read;
+        CopyOut(out, count, read);
+        m_readPos.store(read + count, std::memory_order_release);
+        return count;
+    }
+
+private:
+    // 折り返しを挟んで最大2回に分けてコピーする
+    void CopyIn(const float* src, size_t count, size_t pos) {
+        size_t start = pos & m_mask;
+        size_t first = count < GetCapacity() - start ? count : GetCapacity() - start;
+        std::copy(src, src + first * CHANNELS, m_data.begin() + start * CHANNELS);
+        std::copy(src + first * CHANNELS, src + count * CHANNELS, m_data.begin());
+    }
+    void CopyOut(float* dst, size_t count, size_t pos) const {
+        size_t start = pos & m_mask;
+        size_t first = count < GetCapacity() - start ? count : GetCapacity() - start;
+        std::copy(m_data.begin() + start * CHANNELS, m_data.begin() + (start + first) * CHANNELS, dst);
+        std::copy(m_data.begin(), m_data.begin() + (count - first) * CHANNELS, dst + first * CHANNELS);
+    }
+
+    std::vector<float> m_data;
+    size_t m_mask;
+    std::atomic<size_t> m_readPos;
+    std::atomic<size_t> m_writePos;
+};
@@ -0,0 +1,210 @@
+﻿#include "BGMPlayer.h"
+#include <algorithm>
+#include <chrono>
+
+BGMPlayer::BGMPlayer()
+    : m_mixer(nullptr)
+    , m_hasRequest(false)
+    , m_running(false)
+    , m_volume(0.5f)
+    , m_underrunCount(0)
+{
+}
+
+BGMPlayer::~BGMPlayer() {
+    Shutdown();
+}
+
+bool BGMPlayer::Initialize(AudioMixer* mixer, const std::filesystem::path& soundDir, DecoderOpener opener,
+                           bool threaded) {
+    if (!mixer || !opener) return false;
+    m_mixer = mixer;
+    m_soundDir = soundDir;
+    m_opener = std::move(opener);
+    m_decodeBuffer.resize(DECODE_CHUNK * AudioRingBuffer::CHANNELS);
+    m_mixBuffer.resize(AudioMixer::BLOCK_FRAMES * AudioRingBuffer::CHANNELS);
+    m_mixer->AddSource(this);
+
+    if (threaded) {
+        m_running = true;
+        m_thread = std::thread([this]() { ThreadMain(); });
+    }
+    return true;
+}
+
+void BGMPlayer::Shutdown() {
+    // 出力スレッドから呼ばれなくしてからストリームを片付ける
+    if (m_mixer) {
+        m_mixer->RemoveSource(this);
+        m_mixer = nullptr;
+    }
+    if (m_thread.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(m_requestMutex);
+            m_running = false;
+        }
+        m_wake.notify_one();
+        m_thread.join();
+    }
+    m_streams.clear();
+}
+
+void BGMPlayer::Play(const AssetManifest::BGMTrack& track, float crossfade) {
+    Request request;
+    request.track = track;
+    request.fade = crossfade;
+    Post(request);
+}
+
+void BGMPlayer::Stop(float fadeOut) {
+    Request request;
+    request.stop = true;
+    request.fade = fadeOut;
+    Post(request);
+}
+
+void BGMPlayer::Post(const Request& request) {
+    {
+        std::lock_guard<std::mutex> lock(m_requestMutex);
+        m_request = request;
+        m_hasRequest = true;
+    }
+    m_wake.notify_one();
+}
+
+void BGMPlayer::EndFrame() {
+    if (!m_thread.joinable() && m_mixer) Pump();
+}
+
+size_t BGMPlayer::GetStreamCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_streams.size();
+}
+
+void BGMPlayer::ThreadMain() {
+    while (m_running) {
+        Pump();
+        // リングバッファは0.3秒以上あるので、数ミリ秒ごとに継ぎ足せば足りる
+        std::unique_lock<std::mutex> lock(m_requestMutex);
+        m_wake.wait_for(lock, std::chrono::milliseconds(5), [this]() { return !m_running || m_hasRequest; });
+    }
+}
+
+// ストリームスレッドの1回分: 要求を処理し、各曲のリングバッファを継ぎ足し、鳴り終わった曲を捨てる
+void BGMPlayer::Pump() {
+    Request request;
+    bool hasRequest = false;
+    {
+        std::lock_guard<std::mutex> lock(m_requestMutex);
+        if (m_hasRequest) {
+            request = m_request;
+            hasRequest = true;
+            m_hasRequest = false;
+        }
+    }
+    if (hasRequest) StartRequest(request);
+
+    for (auto& stream : m_streams) Fill(*stream);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_streams.erase(std::remove_if(m_streams.begin(), m_streams.end(),
+                                   [](const std::unique_ptr<Stream>& s) { return s->finished; }),
+                    m_streams.end());
+}
+
+void BGMPlayer::StartRequest(const Request& request) {
+    const uint32_t sampleRate = m_mixer->GetSampleRate();
+    const float fadeFrames = request.fade * sampleRate;
+
+    // 開く・先読みはロックの外で（出力スレッドを待たせない）
+    std::unique_ptr<Stream> next;
+    if (!request.stop) {
+        auto decoder = m_opener(m_soundDir / request.track.file, sampleRate);
+        if (decoder && decoder->GetSampleRate() == sampleRate) {
+            next = std::make_unique<Stream>(RING_FRAMES);
+            next->decoder = std::move(decoder);
+            next->loopStart = request.track.loopStart;
+            next->loopEnd = request.track.loopEnd;
+            Fill(*next);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const bool crossfade = fadeFrames >= 1.0f;
+    for (auto& stream : m_streams) {
+        if (crossfade) {
+            stream->gainStep = -1.0f / fadeFrames;
+        } else {
+            stream->finished = true;
+        }
+    }
+    if (next) {
+        if (crossfade && !m_streams.empty()) {
+            next->gain = 0.0f;
+            next->gainStep = 1.0f / fadeFrames;
+        }
+        m_streams.push_back(std::move(next));
+    }
+}
+
+// リングバッファの空きをデコードで埋める。ループ終点（またはファイル終端）で頭出しする
+void BGMPlayer::Fill(Stream& stream) {
+    while (!stream.ended) {
+        size_t space = stream.ring.GetFree();
+        if (space == 0) break;
+
+        size_t want = std::min(space, DECODE_CHUNK);
+        if (stream.loopEnd > stream.loopStart) {
+            want = static_cast<size_t>(std::min<uint64_t>(want, stream.loopEnd - std::min(stream.position, stream.loopEnd)));
+        }
+        size_t got = want > 0 ? stream.decoder->Read(m_decodeBuffer.data(), want) : 0;
+        if (got == 0) {
+            // ループ区間が空（または頭出しできない）なら終わり
+            if (stream.position == stream.loopStart || !stream.decoder->Seek(stream.loopStart)) {
+                stream.ended = true;
+                break;
+            }
+            stream.position = stream.loopStart;
+            continue;
+        }
+        stream.ring.Write(m_decodeBuffer.data(), got);
+        stream.position += got;
+    }
+}
+
+void BGMPlayer::Mix(float* bus, size_t frames) {
+    const float volume = m_volume;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& stream : m_streams) {
+        if (stream->finished) continue;
+
+        size_t got = stream->ring.Read(m_mixBuffer.data(), frames);
+        if (got < frames) {
+            if (stream->ended) {
+                stream->finished = true;
+            } else {
+                m_underrunCount++;
+            }
+        }
+
+        const float* src = m_mixBuffer.data();
+        if (stream->gainStep == 0.0f) {
+            const float gain = stream->gain * volume;
+            for (size_t i = 0; i < got * 2; i++) bus[i] += src[i] * gain;
+            continue;
+        }
+        // フェード中は1フレームずつ音量を動かす
+        float gain = stream->gain;
+        for (size_t i = 0; i < got; i++) {
+            gain = std::clamp(gain + stream->gainStep, 0.0f, 1.0f);
+            bus[i * 2] += src[i * 2] * gain * volume;
+            bus[i * 2 + 1] += src[i * 2 + 1] * gain * volume;
+        }
+        stream->gain = gain;
+        if (gain <= 0.0f) {
+            stream->finished = true;
+        } else if (gain >= 1.0f) {
+            stream->gainStep = 0.0f;
+        }
+    }
+}
@@ -1,81 +1,114 @@
 ﻿#pragma once
 
-#include <windows.h>
-#include <mmsystem.h>
-#include <string>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "AssetManifest.h"
+#include "AudioMixer.h"
+#include "AudioRingBuffer.h"
+#include "StreamDecoder.h"
 
-#pragma comment(lib, "winmm.lib")
-
-class BGMPlayer {
+// BGMのストリーミング再生
+// ストリームスレッドがファイルを少しずつデコードしてリングバッファに溜め、ミキサーの出力スレッドが読む
+// 曲を開く・頭出しもストリームスレッドで行うので、切り替えでゲームスレッドは止まらない
+// ループ点で頭出しして途切れなく繰り返し、曲の切り替えはクロスフェード
+class BGMPlayer : public IAudioSource {
 public:
-    BGMPlayer() : m_initialized(false), m_isPlaying(false) {}
-    ~BGMPlayer() { Stop(); }
-
-    void Initialize() {
-        // Get executable path for sounds
-        wchar_t path[MAX_PATH];
-        GetModuleFileNameW(nullptr, path, MAX_PATH);
-        std::wstring exePath(path);
-        size_t lastSlash = exePath.find_last_of(L"\\/");
-        m_soundPath = exePath.substr(0, lastSlash) + L"\\..\\..\\assets\\sounds\\";
-        m_initialized = true;
-    }
-
-    void PlayStageBGM() {
-        PlayBGM(L"bgm_stage1_normal.mp3");
-    }
-
-    void PlayBossBGM() {
-        PlayBGM(L"bgm_stage1_boss.mp3");
-    }
-
-    void PlayTitleBGM() {
-        PlayBGM(L"bgm_op.mp3");
-    }
-
-    void PlayScoreBGM() {
-        PlayBGM(L"bgm_ed.mp3");
-    }
-
-    void Stop() {
-        if (m_isPlaying) {
-            mciSendStringW(L"stop bgm", nullptr, 0, nullptr);
-            mciSendStringW(L"close bgm", nullptr, 0, nullptr);
-            m_isPlaying = false;
-        }
-    }
-
-    void SetVolume(int volume) {
-        // Volume: 0-1000
-        m_volume = volume;  // 保存
-        wchar_t cmd[256];
-        swprintf_s(cmd, L"setaudio bgm volume to %d", volume);
-        mciSendStringW(cmd, nullptr, 0, nullptr);
-    }
+    using DecoderOpener = std::function<std::unique_ptr<IStreamDecoder>(const std::filesystem::path&, uint32_t sampleRate)>;
+
+    static constexpr size_t RING_FRAMES = 16384;       // 1曲あたりの先読み（44.1kHzで約0.37秒）
+    static constexpr size_t DECODE_CHUNK = 2048;       // 1回にデコードするフレーム数
+    static constexpr float DEFAULT_CROSSFADE = 1.0f;   // 秒
+
+    BGMPlayer();
+    ~BGMPlayer() override;
+
+    BGMPlayer(const BGMPlayer&) = delete;
+    BGMPlayer& operator=(const BGMPlayer&) = delete;
+
+    // threaded = false のときはスレッドを立てず、EndFrame でデコードする（テスト・WAV書き出し用）
+    bool Initialize(AudioMixer* mixer, const std::filesystem::path& soundDir, DecoderOpener opener,
+                    bool threaded = true);
+    void Shutdown();
+
+    void PlayStageBGM() { Play(AssetManifest::BGM_STAGE); }
+    void PlayBossBGM() { Play(AssetManifest::BGM_BOSS); }
+    void PlayTitleBGM() { Play(AssetManifest::BGM_TITLE); }
+    void PlayScoreBGM() { Play(AssetManifest::BGM_SCORE); }
+
+    // 曲を切り替える（鳴っている曲とは crossfade 秒かけて入れ替わる）
+    void Play(const AssetManifest::BGMTrack& track, float crossfade = DEFAULT_CROSSFADE);
+    // fadeOut 秒かけて止める（0 ですぐ止める）
+    void Stop(float fadeOut = 0.0f);
+
+    // Volume: 0-1000
+    void SetVolume(int volume) { m_volume = volume / 1000.0f; }
+
+    // スレッドを使わないときに1フレームに1回呼ぶ
+    void EndFrame();
+
+    // IAudioSource（ミキサーの出力スレッドから呼ばれる）
+    void Mix(float* bus, size_t frames) override;
+
+    // 統計
+    uint32_t GetUnderrunCount() const { return m_underrunCount; }  // デコードが間に合わず無音になった回数
+    size_t GetStreamCount() const;                                  // 鳴っている（フェード中を含む）曲の数
 
 private:
-    void PlayBGM(const std::wstring& filename) {
-        Stop();
-        
-        std::wstring fullPath = m_soundPath + filename;
-        
-        // Open the audio file
-        std::wstring openCmd = L"open \"" + fullPath + L"\" type mpegvideo alias bgm";
-        MCIERROR err = mciSendStringW(openCmd.c_str(), nullptr, 0, nullptr);
-        if (err != 0) return;
-        
-        // Set volume to saved value（保存した音量を適用）
-        wchar_t cmd[256];
-        swprintf_s(cmd, L"setaudio bgm volume to %d", m_volume);
-        mciSendStringW(cmd, nullptr, 0, nullptr);
-        
-        // Play with repeat
-        mciSendStringW(L"play bgm repeat", nullptr, 0, nullptr);
-        m_isPlaying = true;
-    }
-
-    bool m_initialized;
-    bool m_isPlaying;
-    std::wstring m_soundPath;
-    int m_volume = 500;  // デフォルト50%
+    struct Stream {
+        explicit Stream(size_t frames) : ring(frames) {}
+
+        // ストリームスレッドだけが触る
+        std::unique_ptr<IStreamDecoder> decoder;
+        uint64_t position = 0;  // デコード済みの位置（フレーム）
+        uint64_t loopStart = 0;
+        uint64_t loopEnd = 0;
+        std::atomic<bool> ended{ false };  // 終端まで読んだ（ループできない）
+
+        AudioRingBuffer ring;
+
+        // m_mutex で守る（フェードは出力スレッドが進める）
+        float gain = 1.0f;
+        float gainStep = 0.0f;  // 1フレームあたりの増減
+        bool finished = false;  // 鳴らし終わった（ストリームスレッドが捨てる）
+    };
+
+    struct Request {
+        bool stop = false;
+        AssetManifest::BGMTrack track = {};
+        float fade = 0.0f;
+    };
+
+    void Post(const Request& request);
+    void Pump();
+    void StartRequest(const Request& request);
+    void Fill(Stream& stream);
+    void ThreadMain();
+
+    AudioMixer* m_mixer;
+    std::filesystem::path m_soundDir;
+    DecoderOpener m_opener;
+
+    // ストリームの追加・削除はストリームスレッドだけが行い、m_mutex 中に出力スレッドが読む
+    std::vector<std::unique_ptr<Stream>> m_streams;
+    mutable std::mutex m_mutex;
+    std::vector<float> m_decodeBuffer;
+    std::vector<float> m_mixBuffer;
+
+    // ゲームスレッドからの要求（最新の1つだけ残す）
+    std::mutex m_requestMutex;
+    std::condition_variable m_wake;
+    Request m_request;
+    bool m_hasRequest;
+
+    std::thread m_thread;
+    std::atomic<bool> m_running;
+    std::atomic<float> m_volume;
+    std::atomic<uint32_t> m_underrunCount;
 };
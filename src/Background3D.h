@@ -1,36 +1,27 @@
 ﻿#pragma once
 
-#include <d3d11.h>
-#include <DirectXMath.h>
-#include <wrl/client.h>
 #include <vector>
+#include "Starfield.h"
 
-using Microsoft::WRL::ComPtr;
-using namespace DirectX;
-
-// Background star/particle
-struct BackgroundStar {
-    XMFLOAT3 position;
-    float speed;
-    float size;
-    XMFLOAT4 color;
-};
-
+// 背景の星空
+// 星の位置は時刻と星ごとの種だけで決まる（Starfield::Position）ので、Updateは時刻を進めるだけ
+// 描画はGPUで1回のインスタンス描画。使えないときだけCPUで1つずつ描く
 class Background3D {
 public:
     Background3D();
     ~Background3D();
 
-    void Initialize(int starCount = 200);
+    void Initialize(class Graphics* graphics, int starCount = 200);
     void Update(float deltaTime);
     void Render(class Graphics* graphics);
     void SetScreenSize(int width, int height);
 
+    const std::vector<StarInstance>& GetStars() const { return m_stars; }
+    float GetTime() const { return m_time; }
+
 private:
-    std::vector<BackgroundStar> m_stars;
+    std::vector<StarInstance> m_stars;
     float m_time;
-    float m_scrollSpeed;
-    int m_patternType;
     int m_screenWidth;
     int m_screenHeight;
 };
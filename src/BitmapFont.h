@@ -0,0 +1,115 @@
+﻿#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <DirectXMath.h>
+#include "AtlasPacker.h"
+
+// ラスタライズ済みの1文字（RGBA、白＋縁取り。色は描画時に頂点カラーで乗せる）
+struct GlyphImage {
+    wchar_t code;
+    std::vector<uint8_t> pixels;
+    int width;
+    int height;
+    float advance;   // 次の文字までの送り幅
+    float offsetX;   // 送り位置から画像左端までのずれ（縁取りの分だけ負）
+};
+
+struct FontGlyph {
+    DirectX::XMFLOAT4 uv;  // (u0, v0, u1, v1)
+    float width;
+    float height;
+    float advance;
+    float offsetX;
+    bool isLoaded;
+};
+
+// 文字画像を1枚のアトラスに詰めたビットマップフォント（ASCIIのみ）
+// 配置と文字送りだけを受け持ち、ラスタライズとテクスチャ化は GlyphAtlas が行う
+class BitmapFont {
+public:
+    static constexpr wchar_t FIRST_CODE = 32;
+    static constexpr wchar_t LAST_CODE = 126;
+    static constexpr int PADDING = 1;
+    static constexpr int MAX_ATLAS_SIZE = 1024;
+
+    BitmapFont() : m_lineHeight(0.0f), m_width(0), m_height(0) {
+        m_glyphs.assign(LAST_CODE - FIRST_CODE + 1, FontGlyph{ DirectX::XMFLOAT4(0, 0, 0, 0), 0, 0, 0, 0, false });
+    }
+
+    // 文字画像を詰めてアトラスのRGBAを作る（範囲外の文字は無視）
+    bool Build(const std::vector<GlyphImage>& images, float lineHeight, std::vector<uint8_t>* atlas) {
+        std::vector<const GlyphImage*> used;
+        std::vector<AtlasRect> sizes;
+        for (const GlyphImage& image : images) {
+            if (image.code < FIRST_CODE || image.code > LAST_CODE || image.width <= 0 || image.height <= 0) continue;
+            used.push_back(&image);
+            sizes.push_back({ 0, 0, image.width + PADDING * 2, image.height + PADDING * 2 });
+        }
+        if (used.empty()) return false;
+
+        AtlasLayout layout;
+        if (!PackAtlas(sizes, MAX_ATLAS_SIZE, &layout)) return false;
+
+        atlas->assign(static_cast<size_t>(layout.width) * layout.height * 4, 0);
+        for (FontGlyph& glyph : m_glyphs) glyph.isLoaded = false;
+        for (size_t n = 0; n < used.size(); n++) {
+            const GlyphImage& image = *used[n];
+            const AtlasRect& rect = layout.rects[n];
+            BlitWithExtrude(atlas->data(), layout.width, rect, image.pixels.data(), image.width, image.height, PADDING);
+
+            FontGlyph& glyph = m_glyphs[image.code - FIRST_CODE];
+            glyph.uv = DirectX::XMFLOAT4(
+                static_cast<float>(rect.x + PADDING) / layout.width,
+                static_cast<float>(rect.y + PADDING) / layout.height,
+                static_cast<float>(rect.x + PADDING + image.width) / layout.width,
+                static_cast<float>(rect.y + PADDING + image.height) / layout.height);
+            glyph.width = static_cast<float>(image.width);
+            glyph.height = static_cast<float>(image.height);
+            glyph.advance = image.advance;
+            glyph.offsetX = image.offsetX;
+            glyph.isLoaded = true;
+        }
+        m_lineHeight = lineHeight;
+        m_width = layout.width;
+        m_height = layout.height;
+        return true;
+    }
+
+    const FontGlyph* Find(wchar_t code) const {
+        if (code < FIRST_CODE || code > LAST_CODE) return nullptr;
+        const FontGlyph& glyph = m_glyphs[code - FIRST_CODE];
+        return glyph.isLoaded ? &glyph : nullptr;
+    }
+
+    // 文字列の幅（無い文字は飛ばす）
+    float Measure(const wchar_t* text, float scale) const {
+        float width = 0.0f;
+        for (const wchar_t* c = text; *c; c++) {
+            if (const FontGlyph* glyph = Find(*c)) width += glyph->advance;
+        }
+        return width * scale;
+    }
+
+    // 左上 (x, y) から並べた各文字の矩形を fn(x, y, width, height, uv) に渡す
+    template <typename Fn>
+    void Layout(const wchar_t* text, float x, float y, float scale, Fn&& fn) const {
+        float pen = x;
+        for (const wchar_t* c = text; *c; c++) {
+            const FontGlyph* glyph = Find(*c);
+            if (!glyph) continue;
+            fn(pen + glyph->offsetX * scale, y, glyph->width * scale, glyph->height * scale, glyph->uv);
+            pen += glyph->advance * scale;
+        }
+    }
+
+    float GetLineHeight() const { return m_lineHeight; }
+    int GetWidth() const { return m_width; }
+    int GetHeight() const { return m_height; }
+
+private:
+    std::vector<FontGlyph> m_glyphs;
+    float m_lineHeight;
+    int m_width;
+    int m_height;
+};
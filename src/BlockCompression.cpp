@@ -0,0 +1,641 @@
+﻿#include "BlockCompression.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace BlockCompression {
+
+using AssetPack::PixelFormat;
+
+namespace {
+
+constexpr int TEXELS = 16;
+
+// ---- 共通: 主成分軸に沿った端点の推定と最小二乗の再フィット ----
+
+// channels 次元（RGB=3, RGBA=4）の点群から端点を求める
+// inset は主軸上の幅に対して端を内側に寄せる割合（中間色の多いブロックほど寄せたほうが誤差が減る）
+void FindEndpoints(const float (*texels)[4], int channels, float inset, float* e0, float* e1) {
+    float mean[4] = {};
+    for (int i = 0; i < TEXELS; i++) {
+        for (int c = 0; c < channels; c++) mean[c] += texels[i][c];
+    }
+    for (int c = 0; c < channels; c++) mean[c] /= TEXELS;
+
+    float cov[4][4] = {};
+    for (int i = 0; i < TEXELS; i++) {
+        for (int a = 0; a < channels; a++) {
+            for (int b = 0; b < channels; b++) {
+                cov[a][b] += (texels[i][a] - mean[a]) * (texels[i][b] - mean[b]);
+            }
+        }
+    }
+
+    // べき乗法（初期値は値域の対角。分散最大のチャンネルと逆に動くチャンネルは向きを反転する。
+    // 反転しないと赤と青の市松のような逆相関のブロックで初期値が主軸と直交し、端点が平均に潰れる）
+    int dominant = 0;
+    for (int c = 1; c < channels; c++) {
+        if (cov[c][c] > cov[dominant][dominant]) dominant = c;
+    }
+    float axis[4] = {};
+    for (int c = 0; c < channels; c++) {
+        float lo = texels[0][c], hi = texels[0][c];
+        for (int i = 1; i < TEXELS; i++) {
+            lo = std::min(lo, texels[i][c]);
+            hi = std::max(hi, texels[i][c]);
+        }
+        axis[c] = cov[dominant][c] < 0.0f ? lo - hi : hi - lo;
+    }
+    for (int iter = 0; iter < 8; iter++) {
+        float next[4] = {};
+        float length = 0.0f;
+        for (int a = 0; a < channels; a++) {
+            for (int b = 0; b < channels; b++) next[a] += cov[a][b] * axis[b];
+            length = std::max(length, std::fabs(next[a]));
+        }
+        if (length < 1e-6f) break;
+        for (int c = 0; c < channels; c++) axis[c] = next[c] / length;
+    }
+    float norm = 0.0f;
+    for (int c = 0; c < channels; c++) norm += axis[c] * axis[c];
+    if (norm < 1e-12f) {
+        // 単色ブロック
+        for (int c = 0; c < channels; c++) e0[c] = e1[c] = mean[c];
+        return;
+    }
+    norm = 1.0f / std::sqrt(norm);
+    for (int c = 0; c < channels; c++) axis[c] *= norm;
+
+    float tMin = 0.0f, tMax = 0.0f;
+    for (int i = 0; i < TEXELS; i++) {
+        float t = 0.0f;
+        for (int c = 0; c < channels; c++) t += (texels[i][c] - mean[c]) * axis[c];
+        if (i == 0 || t < tMin) tMin = t;
+        if (i == 0 || t > tMax) tMax = t;
+    }
+    float shift = (tMax - tMin) * inset;
+    tMin += shift;
+    tMax -= shift;
+    for (int c = 0; c < channels; c++) {
+        e0[c] = std::clamp(mean[c] + axis[c] * tMax, 0.0f, 255.0f);
+        e1[c] = std::clamp(mean[c] + axis[c] * tMin, 0.0f, 255.0f);
+    }
+}
+
+// weights[i] は端点1の重み（0〜1）。x ≒ (1-w)e0 + w e1 を最小二乗で解く
+bool RefitEndpoints(const float (*texels)[4], int channels, const float* weights, float* e0, float* e1) {
+    float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+    float ax[4] = {}, bx[4] = {};
+    for (int i = 0; i < TEXELS; i++) {
+        float b = weights[i];
+        float a = 1.0f - b;
+        aa += a * a;
+        ab += a * b;
+        bb += b * b;
+        for (int c = 0; c < channels; c++) {
+            ax[c] += a * texels[i][c];
+            bx[c] += b * texels[i][c];
+        }
+    }
+    float det = aa * bb - ab * ab;
+    if (std::fabs(det) < 1e-6f) return false;
+    for (int c = 0; c < channels; c++) {
+        e0[c] = std::clamp((bb * ax[c] - ab * bx[c]) / det, 0.0f, 255.0f);
+        e1[c] = std::clamp((aa * bx[c] - ab * ax[c]) / det, 0.0f, 255.0f);
+    }
+    return true;
+}
+
+void ToFloat(const uint8_t* block, float (*texels)[4]) {
+    for (int i = 0; i < TEXELS; i++) {
+        for (int c = 0; c < 4; c++) texels[i][c] = block[i * 4 + c];
+    }
+}
+
+// ---- BC1（色ブロック、BC3と共通） ----
+
+uint16_t PackRGB565(const float* color) {
+    int r = static_cast<int>(color[0] * 31.0f / 255.0f + 0.5f);
+    int g = static_cast<int>(color[1] * 63.0f / 255.0f + 0.5f);
+    int b = static_cast<int>(color[2] * 31.0f / 255.0f + 0.5f);
+    return static_cast<uint16_t>((std::clamp(r, 0, 31) << 11) | (std::clamp(g, 0, 63) << 5) | std::clamp(b, 0, 31));
+}
+
+void UnpackRGB565(uint16_t c, int* rgb) {
+    int r = (c >> 11) & 31, g = (c >> 5) & 63, b = c & 31;
+    rgb[0] = (r << 3) | (r >> 2);
+    rgb[1] = (g << 2) | (g >> 4);
+    rgb[2] = (b << 3) | (b >> 2);
+}
+
+// 4色パレット（c0 > c1 のモード）
+void ColorPalette(uint16_t c0, uint16_t c1, int (*palette)[3]) {
+    UnpackRGB565(c0, palette[0]);
+    UnpackRGB565(c1, palette[1]);
+    for (int c = 0; c < 3; c++) {
+        palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+        palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+    }
+}
+
+// インデックスを選んで誤差を返す
+int SelectColorIndices(const float (*texels)[4], uint16_t c0, uint16_t c1, uint8_t* indices) {
+    int palette[4][3];
+    ColorPalette(c0, c1, palette);
+    int total = 0;
+    for (int i = 0; i < TEXELS; i++) {
+        int best = 0, bestError = 0;
+        for (int p = 0; p < 4; p++) {
+            int error = 0;
+            for (int c = 0; c < 3; c++) {
+                int d = static_cast<int>(texels[i][c]) - palette[p][c];
+                error += d * d;
+            }
+            if (p == 0 || error < bestError) {
+                best = p;
+                bestError = error;
+            }
+        }
+        indices[i] = static_cast<uint8_t>(best);
+        total += bestError;
+    }
+    return total;
+}
+
+void WriteColorBlock(uint16_t c0, uint16_t c1, const uint8_t* indices, uint8_t* out) {
+    // 4色モードにするため c0 > c1 に並べる（入れ替えたらインデックスも 0<->1, 2<->3）
+    bool swap = c0 < c1;
+    if (swap) std::swap(c0, c1);
+    uint32_t bits = 0;
+    for (int i = 0; i < TEXELS; i++) {
+        uint32_t index = indices[i];
+        if (c0 == c1) index = 0;  // 同色は3色モードになるので透明黒のインデックス3を使わない
+        else if (swap) index ^= 1;
+        bits |= index << (i * 2);
+    }
+    out[0] = static_cast<uint8_t>(c0);
+    out[1] = static_cast<uint8_t>(c0 >> 8);
+    out[2] = static_cast<uint8_t>(c1);
+    out[3] = static_cast<uint8_t>(c1 >> 8);
+    memcpy(out + 4, &bits, 4);
+}
+
+void EncodeColorBlock(const float (*texels)[4], uint8_t* out) {
+    static constexpr float WEIGHTS[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+
+    float e0[4], e1[4];
+    FindEndpoints(texels, 3, 1.0f / 16.0f, e0, e1);
+    uint16_t c0 = PackRGB565(e0), c1 = PackRGB565(e1);
+    uint8_t indices[TEXELS];
+    int error = SelectColorIndices(texels, c0, c1, indices);
+
+    // 選んだインデックスで端点を引き直し、良くなる間だけ繰り返す
+    for (int iter = 0; iter < 2 && error > 0; iter++) {
+        float weights[TEXELS];
+        for (int i = 0; i < TEXELS; i++) weights[i] = WEIGHTS[indices[i]];
+        if (!RefitEndpoints(texels, 3, weights, e0, e1)) break;
+
+        uint16_t r0 = PackRGB565(e0), r1 = PackRGB565(e1);
+        uint8_t refit[TEXELS];
+        int refitError = SelectColorIndices(texels, r0, r1, refit);
+        if (refitError >= error) break;
+        c0 = r0;
+        c1 = r1;
+        error = refitError;
+        memcpy(indices, refit, TEXELS);
+    }
+    WriteColorBlock(c0, c1, indices, out);
+}
+
+void DecodeColorBlock(const uint8_t* in, uint8_t* block, bool allowThreeColor) {
+    uint16_t c0 = static_cast<uint16_t>(in[0] | (in[1] << 8));
+    uint16_t c1 = static_cast<uint16_t>(in[2] | (in[3] << 8));
+    uint32_t bits;
+    memcpy(&bits, in + 4, 4);
+
+    int palette[4][4];
+    UnpackRGB565(c0, palette[0]);
+    UnpackRGB565(c1, palette[1]);
+    palette[0][3] = palette[1][3] = palette[2][3] = palette[3][3] = 255;
+    if (c0 > c1 || !allowThreeColor) {
+        for (int c = 0; c < 3; c++) {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+        }
+    } else {
+        for (int c = 0; c < 3; c++) {
+            palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+            palette[3][c] = 0;
+        }
+        palette[3][3] = 0;
+    }
+    for (int i = 0; i < TEXELS; i++) {
+        const int* color = palette[(bits >> (i * 2)) & 3];
+        for (int c = 0; c < 4; c++) block[i * 4 + c] = static_cast<uint8_t>(color[c]);
+    }
+}
+
+// ---- BC3 アルファブロック（8段階） ----
+
+void AlphaPalette(int a0, int a1, int* palette) {
+    palette[0] = a0;
+    palette[1] = a1;
+    if (a0 > a1) {
+        for (int k = 1; k <= 6; k++) palette[k + 1] = ((7 - k) * a0 + k * a1) / 7;
+    } else {
+        for (int k = 1; k <= 4; k++) palette[k + 1] = ((5 - k) * a0 + k * a1) / 5;
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+}
+
+void EncodeAlphaBlock(const uint8_t* block, uint8_t* out) {
+    int a0 = 0, a1 = 255;
+    for (int i = 0; i < TEXELS; i++) {
+        a0 = std::max(a0, static_cast<int>(block[i * 4 + 3]));
+        a1 = std::min(a1, static_cast<int>(block[i * 4 + 3]));
+    }
+    out[0] = static_cast<uint8_t>(a0);
+    out[1] = static_cast<uint8_t>(a1);
+
+    uint64_t bits = 0;
+    if (a0 > a1) {
+        int palette[8];
+        AlphaPalette(a0, a1, palette);
+        for (int i = 0; i < TEXELS; i++) {
+            int alpha = block[i * 4 + 3];
+            int best = 0;
+            for (int p = 1; p < 8; p++) {
+                if (std::abs(palette[p] - alpha) < std::abs(palette[best] - alpha)) best = p;
+            }
+            bits |= static_cast<uint64_t>(best) << (i * 3);
+        }
+    }
+    for (int b = 0; b < 6; b++) out[2 + b] = static_cast<uint8_t>(bits >> (b * 8));
+}
+
+void DecodeAlphaBlock(const uint8_t* in, uint8_t* block) {
+    int palette[8];
+    AlphaPalette(in[0], in[1], palette);
+    uint64_t bits = 0;
+    for (int b = 0; b < 6; b++) bits |= static_cast<uint64_t>(in[2 + b]) << (b * 8);
+    for (int i = 0; i < TEXELS; i++) {
+        block[i * 4 + 3] = static_cast<uint8_t>(palette[(bits >> (i * 3)) & 7]);
+    }
+}
+
+// ---- BC7 モード6 ----
+
+constexpr int BC7_WEIGHTS[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+int Bc7Interpolate(int e0, int e1, int weight) {
+    return ((64 - weight) * e0 + weight * e1 + 32) >> 6;
+}
+
+class BitWriter {
+public:
+    explicit BitWriter(uint8_t* out) : m_out(out), m_pos(0) { memset(out, 0, 16); }
+    void Write(uint32_t value, int count) {
+        for (int i = 0; i < count; i++, m_pos++) {
+            if (value & (1u << i)) m_out[m_pos >> 3] |= static_cast<uint8_t>(1u << (m_pos & 7));
+        }
+    }
+private:
+    uint8_t* m_out;
+    int m_pos;
+};
+
+class BitReader {
+public:
+    explicit BitReader(const uint8_t* in) : m_in(in), m_pos(0) {}
+    uint32_t Read(int count) {
+        uint32_t value = 0;
+        for (int i = 0; i < count; i++, m_pos++) {
+            value |= static_cast<uint32_t>((m_in[m_pos >> 3] >> (m_pos & 7)) & 1) << i;
+        }
+        return value;
+    }
+private:
+    const uint8_t* m_in;
+    int m_pos;
+};
+
+struct Bc7Mode6 {
+    int q[2][4];   // 7ビット端点
+    int p[2];      // Pビット
+    uint8_t indices[TEXELS];
+    int error;
+};
+
+// Pビットを決めたうえで端点を量子化し、インデックスを選ぶ
+void QuantizeBc7(const float (*texels)[4], const float* e0, const float* e1, int p0, int p1, Bc7Mode6* result) {
+    const float* e[2] = { e0, e1 };
+    int p[2] = { p0, p1 };
+    int endpoint[2][4];
+    for (int n = 0; n < 2; n++) {
+        for (int c = 0; c < 4; c++) {
+            int q = static_cast<int>((e[n][c] - p[n]) / 2.0f + 0.5f);
+            result->q[n][c] = std::clamp(q, 0, 127);
+            endpoint[n][c] = (result->q[n][c] << 1) | p[n];
+        }
+        result->p[n] = p[n];
+    }
+
+    int palette[16][4];
+    for (int k = 0; k < 16; k++) {
+        for (int c = 0; c < 4; c++) palette[k][c] = Bc7Interpolate(endpoint[0][c], endpoint[1][c], BC7_WEIGHTS[k]);
+    }
+    result->error = 0;
+    for (int i = 0; i < TEXELS; i++) {
+        int best = 0, bestError = 0;
+        for (int k = 0; k < 16; k++) {
+            int error = 0;
+            for (int c = 0; c < 4; c++) {
+                int d = static_cast<int>(texels[i][c]) - palette[k][c];
+                error += d * d;
+            }
+            if (k == 0 || error < bestError) {
+                best = k;
+                bestError = error;
+            }
+        }
+        result->indices[i] = static_cast<uint8_t>(best);
+        result->error += bestError;
+    }
+}
+
+void BestBc7(const float (*texels)[4], const float* e0, const float* e1, Bc7Mode6* best) {
+    for (int p0 = 0; p0 < 2; p0++) {
+        for (int p1 = 0; p1 < 2; p1++) {
+            Bc7Mode6 candidate;
+            QuantizeBc7(texels, e0, e1, p0, p1, &candidate);
+            if ((p0 == 0 && p1 == 0) || candidate.error < best->error) *best = candidate;
+        }
+    }
+}
+
+} // namespace
+
+// ---- サイズ計算 ----
+
+bool IsCompressed(PixelFormat format) {
+    return format == PixelFormat::BC1 || format == PixelFormat::BC3 || format == PixelFormat::BC7;
+}
+
+size_t GetBlockBytes(PixelFormat format) {
+    switch (format) {
+    case PixelFormat::BC1: return 8;
+    case PixelFormat::BC3:
+    case PixelFormat::BC7: return 16;
+    default: return 4;
+    }
+}
+
+size_t GetRowPitch(PixelFormat format, uint32_t width) {
+    if (!IsCompressed(format)) return static_cast<size_t>(width) * 4;
+    return static_cast<size_t>((width + BLOCK_DIM - 1) / BLOCK_DIM) * GetBlockBytes(format);
+}
+
+size_t GetLevelSize(PixelFormat format, uint32_t width, uint32_t height) {
+    size_t rows = IsCompressed(format) ? (height + BLOCK_DIM - 1) / BLOCK_DIM : height;
+    return GetRowPitch(format, width) * rows;
+}
+
+size_t GetChainSize(PixelFormat format, uint32_t width, uint32_t height, uint32_t mipLevels) {
+    size_t total = 0;
+    for (uint32_t level = 0; level < mipLevels; level++) {
+        total += GetLevelSize(format, MipDimension(width, level), MipDimension(height, level));
+    }
+    return total;
+}
+
+uint32_t CountMipLevels(uint32_t width, uint32_t height) {
+    uint32_t levels = 1;
+    while (width > 1 || height > 1) {
+        width = width > 1 ? width / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+        levels++;
+    }
+    return levels;
+}
+
+bool IsValidChain(PixelFormat format, uint32_t width, uint32_t height, uint32_t mipLevels, uint64_t dataSize) {
+    if (width == 0 || height == 0) return false;
+    if (mipLevels == 0 || mipLevels > CountMipLevels(width, height)) return false;
+    return dataSize == GetChainSize(format, width, height, mipLevels);
+}
+
+// ---- ブロック ----
+
+void EncodeBC1(const uint8_t* block, uint8_t* out) {
+    float texels[TEXELS][4];
+    ToFloat(block, texels);
+    EncodeColorBlock(texels, out);
+}
+
+void EncodeBC3(const uint8_t* block, uint8_t* out) {
+    EncodeAlphaBlock(block, out);
+    EncodeBC1(block, out + 8);
+}
+
+void EncodeBC7(const uint8_t* block, uint8_t* out) {
+    float texels[TEXELS][4];
+    ToFloat(block, texels);
+
+    // 端を寄せた端点と両端そのままの端点のうち良いほうから始める（一様なランプは寄せないほうが正確）
+    float e0[4], e1[4];
+    FindEndpoints(texels, 4, 1.0f / 16.0f, e0, e1);
+    Bc7Mode6 best;
+    BestBc7(texels, e0, e1, &best);
+    if (best.error > 0) {
+        float f0[4], f1[4];
+        FindEndpoints(texels, 4, 0.0f, f0, f1);
+        Bc7Mode6 full;
+        BestBc7(texels, f0, f1, &full);
+        if (full.error < best.error) {
+            best = full;
+            memcpy(e0, f0, sizeof(e0));
+            memcpy(e1, f1, sizeof(e1));
+        }
+    }
+
+    // 選んだインデックスで最小二乗に端点を引き直し、良くなる間だけ繰り返す
+    for (int iter = 0; iter < 4 && best.error > 0; iter++) {
+        float weights[TEXELS];
+        for (int i = 0; i < TEXELS; i++) weights[i] = BC7_WEIGHTS[best.indices[i]] / 64.0f;
+        if (!RefitEndpoints(texels, 4, weights, e0, e1)) break;
+        Bc7Mode6 refit;
+        BestBc7(texels, e0, e1, &refit);
+        if (refit.error >= best.error) break;
+        best = refit;
+    }
+
+    // 先頭テクセルのインデックスは最上位ビットが0（アンカー）。重みは対称なので端点を入れ替えて反転できる
+    if (best.indices[0] >= 8) {
+        for (int c = 0; c < 4; c++) std::swap(best.q[0][c], best.q[1][c]);
+        std::swap(best.p[0], best.p[1]);
+        for (int i = 0; i < TEXELS; i++) best.indices[i] = static_cast<uint8_t>(15 - best.indices[i]);
+    }
+
+    BitWriter writer(out);
+    writer.Write(1u << 6, 7);  // モード6
+    for (int c = 0; c < 4; c++) {
+        writer.Write(best.q[0][c], 7);
+        writer.Write(best.q[1][c], 7);
+    }
+    writer.Write(best.p[0], 1);
+    writer.Write(best.p[1], 1);
+    writer.Write(best.indices[0], 3);
+    for (int i = 1; i < TEXELS; i++) writer.Write(best.indices[i], 4);
+}
+
+void DecodeBC1(const uint8_t* in, uint8_t* block) {
+    DecodeColorBlock(in, block, true);
+}
+
+void DecodeBC3(const uint8_t* in, uint8_t* block) {
+    DecodeColorBlock(in + 8, block, false);
+    DecodeAlphaBlock(in, block);
+}
+
+bool DecodeBC7(const uint8_t* in, uint8_t* block) {
+    BitReader reader(in);
+    if (reader.Read(7) != (1u << 6)) return false;
+
+    int endpoint[2][4];
+    for (int c = 0; c < 4; c++) {
+        endpoint[0][c] = static_cast<int>(reader.Read(7)) << 1;
+        endpoint[1][c] = static_cast<int>(reader.Read(7)) << 1;
+    }
+    int p0 = static_cast<int>(reader.Read(1));
+    int p1 = static_cast<int>(reader.Read(1));
+    for (int c = 0; c < 4; c++) {
+        endpoint[0][c] |= p0;
+        endpoint[1][c] |= p1;
+    }
+    for (int i = 0; i < TEXELS; i++) {
+        int index = static_cast<int>(reader.Read(i == 0 ? 3 : 4));
+        for (int c = 0; c < 4; c++) {
+            block[i * 4 + c] = static_cast<uint8_t>(Bc7Interpolate(endpoint[0][c], endpoint[1][c], BC7_WEIGHTS[index]));
+        }
+    }
+    return true;
+}
+
+// ---- 画像 ----
+
+std::vector<uint8_t> CompressImage(PixelFormat format, const uint8_t* rgba, uint32_t width, uint32_t height) {
+    if (!IsCompressed(format)) {
+        return std::vector<uint8_t>(rgba, rgba + static_cast<size_t>(width) * height * 4);
+    }
+
+    std::vector<uint8_t> out(GetLevelSize(format, width, height));
+    size_t blockBytes = GetBlockBytes(format);
+    uint32_t blocksX = (width + BLOCK_DIM - 1) / BLOCK_DIM;
+    uint32_t blocksY = (height + BLOCK_DIM - 1) / BLOCK_DIM;
+    uint8_t block[TEXELS * 4];
+    for (uint32_t by = 0; by < blocksY; by++) {
+        for (uint32_t bx = 0; bx < blocksX; bx++) {
+            for (uint32_t ty = 0; ty < BLOCK_DIM; ty++) {
+                uint32_t y = std::min(by * BLOCK_DIM + ty, height - 1);
+                for (uint32_t tx = 0; tx < BLOCK_DIM; tx++) {
+                    uint32_t x = std::min(bx * BLOCK_DIM + tx, width - 1);
+                    memcpy(block + (ty * BLOCK_DIM + tx) * 4, rgba + (static_cast<size_t>(y) * width + x) * 4, 4);
+                }
+            }
+            uint8_t* dst = out.data() + (static_cast<size_t>(by) * blocksX + bx) * blockBytes;
+            switch (format) {
+            case PixelFormat::BC1: EncodeBC1(block, dst); break;
+            case PixelFormat::BC3: EncodeBC3(block, dst); break;
+            default: EncodeBC7(block, dst); break;
+            }
+        }
+    }
+    return out;
+}
+
+bool DecompressImage(PixelFormat format, const uint8_t* data, uint32_t width, uint32_t height,
+                     std::vector<uint8_t>* rgba) {
+    rgba->resize(static_cast<size_t>(width) * height * 4);
+    if (!IsCompressed(format)) {
+        memcpy(rgba->data(), data, rgba->size());
+        return true;
+    }
+
+    size_t blockBytes = GetBlockBytes(format);
+    uint32_t blocksX = (width + BLOCK_DIM - 1) / BLOCK_DIM;
+    uint32_t blocksY = (height + BLOCK_DIM - 1) / BLOCK_DIM;
+    uint8_t block[TEXELS * 4];
+    for (uint32_t by = 0; by < blocksY; by++) {
+        for (uint32_t bx = 0; bx < blocksX; bx++) {
+            const uint8_t* src = data + (static_cast<size_t>(by) * blocksX + bx) * blockBytes;
+            switch (format) {
+            case PixelFormat::BC1: DecodeBC1(src, block); break;
+            case PixelFormat::BC3: DecodeBC3(src, block); break;
+            default:
+                if (!DecodeBC7(src, block)) return false;
+                break;
+            }
+            for (uint32_t ty = 0; ty < BLOCK_DIM && by * BLOCK_DIM + ty < height; ty++) {
+                for (uint32_t tx = 0; tx < BLOCK_DIM && bx * BLOCK_DIM + tx < width; tx++) {
+                    size_t dst = (static_cast<size_t>(by * BLOCK_DIM + ty) * width + bx * BLOCK_DIM + tx) * 4;
+                    memcpy(rgba->data() + dst, block + (ty * BLOCK_DIM + tx) * 4, 4);
+                }
+            }
+        }
+    }
+    return true;
+}
+
+std::vector<uint8_t> Downsample(const uint8_t* rgba, uint32_t width, uint32_t height) {
+    uint32_t dstWidth = MipDimension(width, 1);
+    uint32_t dstHeight = MipDimension(height, 1);
+    std::vector<uint8_t> out(static_cast<size_t>(dstWidth) * dstHeight * 4);
+    for (uint32_t y = 0; y < dstHeight; y++) {
+        uint32_t y0 = std::min(y * 2, height - 1);
+        uint32_t y1 = std::min(y * 2 + 1, height - 1);
+        for (uint32_t x = 0; x < dstWidth; x++) {
+            uint32_t x0 = std::min(x * 2, width - 1);
+            uint32_t x1 = std::min(x * 2 + 1, width - 1);
+            const uint8_t* src[4] = {
+                rgba + (static_cast<size_t>(y0) * width + x0) * 4, rgba + (static_cast<size_t>(y0) * width + x1) * 4,
+                rgba + (static_cast<size_t>(y1) * width + x0) * 4, rgba + (static_cast<size_t>(y1) * width + x1) * 4,
+            };
+            uint8_t* dst = out.data() + (static_cast<size_t>(y) * dstWidth + x) * 4;
+
+            // 色はアルファで重み付けする（乗算済みで平均して戻すのと同じ）。
+            // 透明なテクセルの色（多くは黒）が縁に混ざって暗いフチになるのを防ぐ
+            int alphaSum = src[0][3] + src[1][3] + src[2][3] + src[3][3];
+            for (int c = 0; c < 3; c++) {
+                int sum = 0;
+                if (alphaSum > 0) {
+                    for (const uint8_t* p : src) sum += p[c] * p[3];
+                    dst[c] = static_cast<uint8_t>((sum + alphaSum / 2) / alphaSum);
+                } else {
+                    for (const uint8_t* p : src) sum += p[c];
+                    dst[c] = static_cast<uint8_t>((sum + 2) / 4);
+                }
+            }
+            dst[3] = static_cast<uint8_t>((alphaSum + 2) / 4);
+        }
+    }
+    return out;
+}
+
+std::vector<uint8_t> BuildMipChain(PixelFormat format, const uint8_t* rgba, uint32_t width, uint32_t height,
+                                   uint32_t mipLevels) {
+    std::vector<uint8_t> chain;
+    chain.reserve(GetChainSize(format, width, height, mipLevels));
+
+    std::vector<uint8_t> level(rgba, rgba + static_cast<size_t>(width) * height * 4);
+    for (uint32_t n = 0; n < mipLevels; n++) {
+        uint32_t w = MipDimension(width, n);
+        uint32_t h = MipDimension(height, n);
+        std::vector<uint8_t> encoded = CompressImage(format, level.data(), w, h);
+        chain.insert(chain.end(), encoded.begin(), encoded.end());
+        if (n + 1 < mipLevels) level = Downsample(level.data(), w, h);
+    }
+    return chain;
+}
+
+} // namespace BlockCompression
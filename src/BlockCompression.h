@@ -0,0 +1,50 @@
+﻿#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "AssetPack.h"
+
+// BC1/BC3/BC7 のブロック圧縮とミップ生成（CPUのみ、オフライン変換ツール用）
+// ブロックは4x4テクセルのRGBA8（64バイト、行優先）
+// ランタイムはサイズ計算だけを使い、圧縮済みデータをそのままGPUに渡す
+namespace BlockCompression {
+
+constexpr uint32_t BLOCK_DIM = 4;
+
+bool IsCompressed(AssetPack::PixelFormat format);
+size_t GetBlockBytes(AssetPack::PixelFormat format);  // RGBA8は1テクセル分（4）
+size_t GetRowPitch(AssetPack::PixelFormat format, uint32_t width);  // 圧縮形式はブロック1行分
+size_t GetLevelSize(AssetPack::PixelFormat format, uint32_t width, uint32_t height);
+size_t GetChainSize(AssetPack::PixelFormat format, uint32_t width, uint32_t height, uint32_t mipLevels);
+
+uint32_t CountMipLevels(uint32_t width, uint32_t height);  // 1x1まで
+// パックのテクスチャがそのまま転送できるか（ミップ数が1〜1x1までで、データサイズがちょうど合う）
+bool IsValidChain(AssetPack::PixelFormat format, uint32_t width, uint32_t height, uint32_t mipLevels,
+                  uint64_t dataSize);
+inline uint32_t MipDimension(uint32_t size, uint32_t level) {
+    uint32_t d = size >> level;
+    return d > 0 ? d : 1;
+}
+
+// ブロック単位
+void EncodeBC1(const uint8_t* block, uint8_t* out);  // 不透明として扱う（8バイト）
+void EncodeBC3(const uint8_t* block, uint8_t* out);  // 16バイト
+void EncodeBC7(const uint8_t* block, uint8_t* out);  // モード6（RGBA 1サブセット）、16バイト
+void DecodeBC1(const uint8_t* in, uint8_t* block);
+void DecodeBC3(const uint8_t* in, uint8_t* block);
+bool DecodeBC7(const uint8_t* in, uint8_t* block);   // モード6のみ（他のモードはfalse）
+
+// 画像単位（端のブロックは端のテクセルを繰り返して埋める）
+std::vector<uint8_t> CompressImage(AssetPack::PixelFormat format, const uint8_t* rgba, uint32_t width, uint32_t height);
+bool DecompressImage(AssetPack::PixelFormat format, const uint8_t* data, uint32_t width, uint32_t height,
+                     std::vector<uint8_t>* rgba);
+
+// 縦横半分に縮小（2x2の平均。色はアルファで重み付けし、透明なテクセルの色を混ぜない）
+std::vector<uint8_t> Downsample(const uint8_t* rgba, uint32_t width, uint32_t height);
+
+// ミップ0から順に連結したデータ
+std::vector<uint8_t> BuildMipChain(AssetPack::PixelFormat format, const uint8_t* rgba, uint32_t width, uint32_t height,
+                                   uint32_t mipLevels);
+
+} // namespace BlockCompression
@@ -1,8 +1,9 @@
 ﻿#pragma once
 
 #include <DirectXMath.h>
+#include <cstdint>
 
-enum class BulletType {
+enum class BulletType : uint8_t {
     PlayerShot,     // 自機弾
     EnemySmall,     // 小弾
     EnemyMedium,    // 中弾
@@ -10,28 +11,49 @@ enum class BulletType {
     EnemyLaser      // レーザー
 };
 
+// 描画用の弾スナップショット（Updateの最後に作り、Renderはこれだけを読む）
+struct BulletSprite {
+    DirectX::XMFLOAT2 position;
+    float radius;
+    uint8_t colorIndex;
+    uint8_t alpha;
+    bool isPlayerBullet;
+};
+
 struct Bullet {
     DirectX::XMFLOAT2 position;
     DirectX::XMFLOAT2 velocity;
-    DirectX::XMFLOAT4 color;
     float radius;
     float angle;
     float angularVelocity;
+    float lifetime;      // 残り寿命（秒）、0以下なら無期限（既定、SetBulletLifetimeで付ける）
     BulletType type;
+    uint8_t colorIndex;  // BulletPaletteのインデックス（色はGPU側で展開）
+    uint8_t alpha;       // 0〜255
     bool isActive;
     bool isPlayerBullet;
     bool isHoming;  // ホーミングミサイル
+    
+    // ホーミングのターゲットキャッシュ（数フレームごとに再探索）
+    uint8_t homingRetarget;   // 再探索までの残りフレーム（フラグ直後に置いて詰める）
+    int homingTarget;         // EnemyIndexのスロット（-1=未取得）
+    uint32_t homingTargetId;  // 敵の通し番号（入れ替わり検出用）
 
     Bullet()
         : position{ 0.0f, 0.0f }
         , velocity{ 0.0f, 0.0f }
-        , color{ 1.0f, 1.0f, 1.0f, 1.0f }
         , radius(4.0f)
         , angle(0.0f)
         , angularVelocity(0.0f)
+        , lifetime(0.0f)
         , type(BulletType::EnemySmall)
+        , colorIndex(0)
+        , alpha(255)
         , isActive(false)
         , isPlayerBullet(false)
         , isHoming(false)
+        , homingRetarget(0)
+        , homingTarget(-1)
+        , homingTargetId(0)
     {}
 };
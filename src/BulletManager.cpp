@@ -1,202 +1,230 @@
 ﻿#include "BulletManager.h"
 #include "Graphics.h"
-#include "TextureLoader.h"
+#include "EnemyIndex.h"
+#include "BulletMath.h"
+#include "JobSystem.h"
 #include <cmath>
 
 using namespace DirectX;
 
 constexpr float PI = 3.14159265358979f;
 
+// ホーミング旋回量（0.15ラジアン）のcos/sin
+constexpr float HOMING_TURN_COS = 0.98877108f;
+constexpr float HOMING_TURN_SIN = 0.14943813f;
+
+// ターゲット再探索の間隔（フレーム）
+constexpr uint8_t HOMING_RETARGET_FRAMES = 6;
+
+// 並列更新の1ジョブあたりの弾数
+constexpr uint32_t BULLET_JOB_CHUNK = 512;
+
+static_assert(BulletPalette::SIZE == Graphics::PALETTE_SIZE, "palette size mismatch");
+
 BulletManager::BulletManager() {
+    m_playerShotColor = m_palette.Intern(XMFLOAT4(0.8f, 1.0f, 1.0f, 1.0f));  // Cyan-white
+    m_homingColor = m_palette.Intern(XMFLOAT4(0.4f, 1.0f, 0.5f, 1.0f));      // 緑色のミサイル
 }
 
 BulletManager::~BulletManager() {
 }
 
 void BulletManager::Initialize(Graphics* graphics) {
-    m_bullets.reserve(MAX_BULLETS);
-    
-    // 樽テクスチャを読み込み
-    TextureLoader loader;
-    loader.Initialize(graphics->GetDevice());
-    
-    wchar_t exePath[MAX_PATH];
-    GetModuleFileNameW(nullptr, exePath, MAX_PATH);
-    std::wstring path(exePath);
-    size_t lastSlash = path.find_last_of(L"\\/");
-    std::wstring texturePath = path.substr(0, lastSlash) + L"\\..\\..\\assets\\textures\\barrel_bullet.png";
+    m_bullets.Reserve(BulletPool::DEFAULT_BUDGET);
+}
+
+void BulletManager::Update(float deltaTime, int screenWidth, int screenHeight, JobSystem* jobs) {
+    uint32_t count = static_cast<uint32_t>(m_bullets.size());
+    auto integrate = [&](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; i++) {
+            IntegrateBullet(m_bullets[i], deltaTime, screenWidth, screenHeight);
+        }
+    };
+    if (jobs) {
+        jobs->ParallelFor(count, BULLET_JOB_CHUNK, integrate);
+    } else {
+        integrate(0, count);
+    }
     
-    ID3D11ShaderResourceView* srv = nullptr;
-    if (loader.LoadTexture(texturePath, &srv)) {
-        m_barrelTexture.Attach(srv);
+    // 消えた弾を末尾と入れ替えて詰める（メインで先頭から順に行うのでスレッド数に依存しない）
+    for (uint32_t i = 0; i < m_bullets.size();) {
+        if (!m_bullets[i].isActive) {
+            m_bullets.RemoveAt(i);
+        } else {
+            i++;
+        }
     }
 }
 
-void BulletManager::Update(float deltaTime, int screenWidth, int screenHeight) {
-    for (auto& bullet : m_bullets) {
-        if (!bullet.isActive) continue;
+void BulletManager::IntegrateBullet(Bullet& bullet, float deltaTime, int screenWidth, int screenHeight) const {
+    const float margin = 50.0f;
+    
+    // 当たり判定などで消えた弾はそのまま（Updateの最後で詰める）
+    if (!bullet.isActive) return;
+    
+    // 寿命切れ（止まった弾や回り続ける弾がスロットを占有し続けないように）
+    if (bullet.lifetime > 0.0f) {
+        bullet.lifetime -= deltaTime;
+        if (bullet.lifetime <= 0.0f) {
+            bullet.isActive = false;
+            return;
+        }
+    }
 
-        // ホーミング処理（プレイヤー弾で敵を追尾）
-        if (bullet.isHoming && bullet.isPlayerBullet && !m_enemyPositions.empty()) {
-            // 最も近い敵を探す
-            float minDist = 999999.0f;
-            DirectX::XMFLOAT2 closestEnemy = { 0, 0 };
-            for (const auto& pos : m_enemyPositions) {
-                float dx = pos.x - bullet.position.x;
-                float dy = pos.y - bullet.position.y;
-                float dist = dx * dx + dy * dy;
-                if (dist < minDist) {
-                    minDist = dist;
-                    closestEnemy = pos;
-                }
-            }
-            
-            // 敵に向かって速度を調整（強めのホーミング）
-            float dx = closestEnemy.x - bullet.position.x;
-            float dy = closestEnemy.y - bullet.position.y;
+    // ホーミング処理（プレイヤー弾で敵を追尾）
+    if (bullet.isHoming && bullet.isPlayerBullet && m_enemyIndex && m_enemyIndex->GetActiveCount() > 0) {
+        // キャッシュしたターゲットを検証し、消えていたか期限切れなら再探索
+        const EnemyIndexEntry* target = m_enemyIndex->Resolve(bullet.homingTarget, bullet.homingTargetId);
+        if (!target || bullet.homingRetarget == 0) {
+            int slot = m_enemyIndex->FindNearest(bullet.position);
+            target = (slot >= 0) ? &m_enemyIndex->GetEntry(slot) : nullptr;
+            bullet.homingTarget = slot;
+            bullet.homingTargetId = target ? target->id : 0;
+            bullet.homingRetarget = HOMING_RETARGET_FRAMES;
+        } else {
+            bullet.homingRetarget--;
+        }
+        
+        // 敵に向かって速度を調整（強めのホーミング）
+        if (target) {
+            float dx = target->position.x - bullet.position.x;
+            float dy = target->position.y - bullet.position.y;
             float dist = sqrtf(dx * dx + dy * dy);
-            if (dist > 1.0f) {
-                float targetAngle = atan2f(dy, dx);
-                float currentAngle = atan2f(bullet.velocity.y, bullet.velocity.x);
-                float angleDiff = targetAngle - currentAngle;
-                
-                // 角度差を-PI〜PIに正規化
-                while (angleDiff > 3.14159f) angleDiff -= 6.28318f;
-                while (angleDiff < -3.14159f) angleDiff += 6.28318f;
-                
-                // 強めの旋回（毎フレーム最大0.15ラジアン）
-                float turnRate = 0.15f;
-                if (angleDiff > turnRate) angleDiff = turnRate;
-                if (angleDiff < -turnRate) angleDiff = -turnRate;
+            float speed = sqrtf(bullet.velocity.x * bullet.velocity.x + bullet.velocity.y * bullet.velocity.y);
+            if (dist > 1.0f && speed > 0.0f) {
+                // 進行方向と目標方向の内積・外積で角度差を判定（三角関数なし）
+                float vx = bullet.velocity.x;
+                float vy = bullet.velocity.y;
+                float dot = vx * dx + vy * dy;
+                float cross = vx * dy - vy * dx;
                 
-                float newAngle = currentAngle + angleDiff;
-                float speed = sqrtf(bullet.velocity.x * bullet.velocity.x + bullet.velocity.y * bullet.velocity.y);
-                bullet.velocity.x = cosf(newAngle) * speed;
-                bullet.velocity.y = sinf(newAngle) * speed;
+                if (dot >= HOMING_TURN_COS * speed * dist) {
+                    // 角度差が旋回上限以内なら目標方向へ向ける
+                    float scale = speed / dist;
+                    bullet.velocity.x = dx * scale;
+                    bullet.velocity.y = dy * scale;
+                } else {
+                    // 強めの旋回（毎フレーム最大0.15ラジアン）を回転行列で適用
+                    float s = (cross >= 0.0f) ? HOMING_TURN_SIN : -HOMING_TURN_SIN;
+                    bullet.velocity.x = vx * HOMING_TURN_COS - vy * s;
+                    bullet.velocity.y = vx * s + vy * HOMING_TURN_COS;
+                }
             }
         }
+    }
 
-        // Angular velocity
-        if (bullet.angularVelocity != 0.0f) {
-            bullet.angle += bullet.angularVelocity * deltaTime;
-            float speed = sqrtf(bullet.velocity.x * bullet.velocity.x + bullet.velocity.y * bullet.velocity.y);
-            bullet.velocity.x = cosf(bullet.angle) * speed;
-            bullet.velocity.y = sinf(bullet.angle) * speed;
-        }
+    // Angular velocity
+    if (bullet.angularVelocity != 0.0f) {
+        bullet.angle += bullet.angularVelocity * deltaTime;
+        float speed = sqrtf(bullet.velocity.x * bullet.velocity.x + bullet.velocity.y * bullet.velocity.y);
+        bullet.velocity.x = cosf(bullet.angle) * speed;
+        bullet.velocity.y = sinf(bullet.angle) * speed;
+    }
 
-        // Position update
-        bullet.position.x += bullet.velocity.x * deltaTime;
-        bullet.position.y += bullet.velocity.y * deltaTime;
+    // Position update
+    bullet.position.x += bullet.velocity.x * deltaTime;
+    bullet.position.y += bullet.velocity.y * deltaTime;
 
-        // Screen bounds check
-        float margin = 50.0f;
-        if (bullet.position.x < -margin || bullet.position.x > screenWidth + margin ||
-            bullet.position.y < -margin || bullet.position.y > screenHeight + margin) {
-            bullet.isActive = false;
-        }
+    // Screen bounds check
+    if (bullet.position.x < -margin || bullet.position.x > screenWidth + margin ||
+        bullet.position.y < -margin || bullet.position.y > screenHeight + margin) {
+        bullet.isActive = false;
     }
 }
 
+void BulletManager::PublishSnapshot() {
+    std::vector<BulletSprite>& sprites = m_snapshot.BeginWrite();
+    for (const auto& bullet : m_bullets) {
+        if (!bullet.isActive) continue;
+        sprites.push_back({ bullet.position, bullet.radius, bullet.colorIndex, bullet.alpha, bullet.isPlayerBullet });
+    }
+    m_snapshot.Publish();
+}
+
 void BulletManager::Render(Graphics* graphics) {
-    static float globalTime = 0.0f;
-    globalTime += 0.016f;  // 約60FPSで回転
+    // パレットに色が増えたフレームだけ転送（通常は起動直後の数フレームのみ）
+    if (m_palette.IsDirty()) {
+        graphics->UpdatePalette(m_palette.GetColors());
+        m_palette.ClearDirty();
+    }
     
-    for (size_t i = 0; i < m_bullets.size(); i++) {
-        const auto& bullet = m_bullets[i];
-        if (!bullet.isActive) continue;
+    const std::vector<BulletSprite>& sprites = m_snapshot.AcquireLatest();
+    
+    // プレイヤー弾：樽！（テクスチャは通常の頂点シェーダーで描く）
+    bool hasBarrel = graphics->HasSprite(SpriteId::BarrelBullet);
+    if (hasBarrel) {
+        for (const auto& sprite : sprites) {
+            if (!sprite.isPlayerBullet) continue;
+            float size = sprite.radius * 8.0f;  // 樽サイズ（倍増！）
+            graphics->DrawAtlasSprite(
+                sprite.position.x - size/2, sprite.position.y - size/2,
+                size, size, SpriteId::BarrelBullet);
+        }
+    }
+    
+    // 敵弾（とテクスチャが無いときの自機弾）はパレット経由でまとめて描く
+    graphics->SetPaletteMode(true);
+    for (const auto& sprite : sprites) {
+        float alpha = sprite.alpha / 255.0f;
 
-        if (bullet.isPlayerBullet) {
-            // プレイヤー弾：樽！
-            if (m_barrelTexture) {
-                float size = bullet.radius * 8.0f;  // 樽サイズ（倍増！）
-                graphics->DrawTexturedSprite(
-                    bullet.position.x - size/2, bullet.position.y - size/2,
-                    size, size,
-                    m_barrelTexture.Get(), XMFLOAT4(1, 1, 1, 1));
-            } else {
-                // フォールバック
-                graphics->DrawGlowCircle(
-                    bullet.position.x, bullet.position.y,
-                    bullet.radius, bullet.color, 2);
-            }
+        if (sprite.isPlayerBullet) {
+            if (hasBarrel) continue;
+            // フォールバック
+            graphics->DrawPaletteGlowCircle(
+                sprite.position.x, sprite.position.y,
+                sprite.radius, sprite.colorIndex, alpha, 2);
         } else {
             // Enemy bullets: beautiful glow effect
-            graphics->DrawGlowCircle(
-                bullet.position.x, bullet.position.y,
-                bullet.radius, bullet.color, 3);
+            graphics->DrawPaletteGlowCircle(
+                sprite.position.x, sprite.position.y,
+                sprite.radius, sprite.colorIndex, alpha, 3);
         }
     }
+    graphics->SetPaletteMode(false);
 }
 
 void BulletManager::Clear() {
-    for (auto& bullet : m_bullets) {
-        bullet.isActive = false;
-    }
+    m_bullets.ReleaseAll();
 }
 
-void BulletManager::SpawnPlayerBullet(float x, float y, float vx, float vy) {
-    for (auto& bullet : m_bullets) {
-        if (!bullet.isActive) {
-            bullet.position = { x, y };
-            bullet.velocity = { vx, vy };
-            bullet.color = { 0.8f, 1.0f, 1.0f, 1.0f }; // Cyan-white
-            bullet.radius = 5.0f;
-            bullet.angle = atan2f(vy, vx);
-            bullet.angularVelocity = 0.0f;
-            bullet.type = BulletType::PlayerShot;
-            bullet.isActive = true;
-            bullet.isPlayerBullet = true;
-            return;
-        }
-    }
+BulletHandle BulletManager::SpawnPlayerBullet(float x, float y, float vx, float vy) {
+    BulletHandle handle;
+    Bullet* bullet = m_bullets.Allocate(&handle);
+    if (!bullet) return handle;
 
-    if (m_bullets.size() < MAX_BULLETS) {
-        Bullet bullet;
-        bullet.position = { x, y };
-        bullet.velocity = { vx, vy };
-        bullet.color = { 0.8f, 1.0f, 1.0f, 1.0f };
-        bullet.radius = 5.0f;
-        bullet.angle = atan2f(vy, vx);
-        bullet.type = BulletType::PlayerShot;
-        bullet.isActive = true;
-        bullet.isPlayerBullet = true;
-        m_bullets.push_back(bullet);
-    }
+    bullet->position = { x, y };
+    bullet->velocity = { vx, vy };
+    bullet->colorIndex = m_playerShotColor;
+    bullet->radius = 5.0f;
+    bullet->angle = atan2f(vy, vx);
+    bullet->type = BulletType::PlayerShot;
+    bullet->isActive = true;
+    bullet->isPlayerBullet = true;
+    return handle;
 }
 
-void BulletManager::SpawnHomingMissile(float x, float y, float vx, float vy) {
-    for (auto& bullet : m_bullets) {
-        if (!bullet.isActive) {
-            bullet.position = { x, y };
-            bullet.velocity = { vx, vy };
-            bullet.color = { 0.4f, 1.0f, 0.5f, 1.0f }; // 緑色のミサイル
-            bullet.radius = 8.0f;  // 大きめ
-            bullet.angle = atan2f(vy, vx);
-            bullet.angularVelocity = 0.0f;
-            bullet.type = BulletType::PlayerShot;
-            bullet.isActive = true;
-            bullet.isPlayerBullet = true;
-            bullet.isHoming = true;  // ホーミングフラグ
-            return;
-        }
-    }
+BulletHandle BulletManager::SpawnHomingMissile(float x, float y, float vx, float vy) {
+    BulletHandle handle;
+    Bullet* bullet = m_bullets.Allocate(&handle);
+    if (!bullet) return handle;
 
-    if (m_bullets.size() < MAX_BULLETS) {
-        Bullet bullet;
-        bullet.position = { x, y };
-        bullet.velocity = { vx, vy };
-        bullet.color = { 0.4f, 1.0f, 0.5f, 1.0f };
-        bullet.radius = 8.0f;
-        bullet.angle = atan2f(vy, vx);
-        bullet.type = BulletType::PlayerShot;
-        bullet.isActive = true;
-        bullet.isPlayerBullet = true;
-        bullet.isHoming = true;
-        m_bullets.push_back(bullet);
-    }
+    bullet->position = { x, y };
+    bullet->velocity = { vx, vy };
+    bullet->colorIndex = m_homingColor;
+    bullet->radius = 8.0f;  // 大きめ
+    bullet->angle = atan2f(vy, vx);
+    bullet->type = BulletType::PlayerShot;
+    bullet->isActive = true;
+    bullet->isPlayerBullet = true;
+    bullet->isHoming = true;  // ホーミングフラグ
+    return handle;
+}
+
+BulletHandle BulletManager::SpawnEnemyBullet(float x, float y, float vx, float vy, BulletType type, XMFLOAT4 color) {
+    return SpawnEnemyBulletIndexed(x, y, vx, vy, type, m_palette.Intern(color), BulletPalette::ToAlpha(color.w));
 }
 
-void BulletManager::SpawnEnemyBullet(float x, float y, float vx, float vy, BulletType type, XMFLOAT4 color) {
+BulletHandle BulletManager::SpawnEnemyBulletIndexed(float x, float y, float vx, float vy, BulletType type, uint8_t colorIndex, uint8_t alpha) {
     float radius = 8.0f;  // 2倍に
     switch (type) {
         case BulletType::EnemySmall: radius = 8.0f; break;   // 4→8
@@ -205,51 +233,42 @@ void BulletManager::SpawnEnemyBullet(float x, float y, float vx, float vy, Bulle
         default: radius = 8.0f; break;
     }
 
-    for (auto& bullet : m_bullets) {
-        if (!bullet.isActive) {
-            bullet.position = { x, y };
-            bullet.velocity = { vx, vy };
-            bullet.color = color;
-            bullet.radius = radius;
-            bullet.angle = atan2f(vy, vx);
-            bullet.angularVelocity = 0.0f;
-            bullet.type = type;
-            bullet.isActive = true;
-            bullet.isPlayerBullet = false;
-            return;
-        }
-    }
+    BulletHandle handle;
+    Bullet* bullet = m_bullets.Allocate(&handle);
+    if (!bullet) return handle;
+
+    bullet->position = { x, y };
+    bullet->velocity = { vx, vy };
+    bullet->colorIndex = colorIndex;
+    bullet->alpha = alpha;
+    bullet->radius = radius;
+    bullet->angle = atan2f(vy, vx);
+    bullet->type = type;
+    bullet->isActive = true;
+    bullet->isPlayerBullet = false;
+    return handle;
+}
 
-    if (m_bullets.size() < MAX_BULLETS) {
-        Bullet bullet;
-        bullet.position = { x, y };
-        bullet.velocity = { vx, vy };
-        bullet.color = color;
-        bullet.radius = radius;
-        bullet.angle = atan2f(vy, vx);
-        bullet.type = type;
-        bullet.isActive = true;
-        bullet.isPlayerBullet = false;
-        m_bullets.push_back(bullet);
+void BulletManager::SetBulletLifetime(BulletHandle handle, float seconds) {
+    if (Bullet* bullet = m_bullets.Get(handle)) {
+        bullet->lifetime = seconds;
     }
 }
 
 void BulletManager::SpawnCircle(float x, float y, int count, float speed, BulletType type, XMFLOAT4 color) {
-    for (int i = 0; i < count; i++) {
-        float angle = (2.0f * PI * i) / count;
-        float vx = cosf(angle) * speed;
-        float vy = sinf(angle) * speed;
-        SpawnEnemyBullet(x, y, vx, vy, type, color);
-    }
+    uint8_t colorIndex = m_palette.Intern(color);
+    uint8_t alpha = BulletPalette::ToAlpha(color.w);
+    BulletMath::ForEachRingDirection(count, 0.0f, [&](int, BulletMath::UnitDir dir) {
+        SpawnEnemyBulletIndexed(x, y, dir.x * speed, dir.y * speed, type, colorIndex, alpha);
+    });
 }
 
 void BulletManager::SpawnSpiral(float x, float y, int count, float speed, float angleOffset, BulletType type, XMFLOAT4 color) {
-    for (int i = 0; i < count; i++) {
-        float angle = angleOffset + (2.0f * PI * i) / count;
-        float vx = cosf(angle) * speed;
-        float vy = sinf(angle) * speed;
-        SpawnEnemyBullet(x, y, vx, vy, type, color);
-    }
+    uint8_t colorIndex = m_palette.Intern(color);
+    uint8_t alpha = BulletPalette::ToAlpha(color.w);
+    BulletMath::ForEachRingDirection(count, angleOffset, [&](int, BulletMath::UnitDir dir) {
+        SpawnEnemyBulletIndexed(x, y, dir.x * speed, dir.y * speed, type, colorIndex, alpha);
+    });
 }
 
 void BulletManager::SpawnAimed(float x, float y, float targetX, float targetY, float speed, BulletType type, XMFLOAT4 color) {
@@ -265,79 +284,105 @@ void BulletManager::SpawnAimed(float x, float y, float targetX, float targetY, f
 
 // Touhou-style flower pattern
 void BulletManager::SpawnFlower(float x, float y, int petals, int bulletsPerPetal, float speed, float angleOffset, XMFLOAT4 color) {
-    for (int p = 0; p < petals; p++) {
-        float petalAngle = angleOffset + (2.0f * PI * p) / petals;
+    if (petals <= 0 || bulletsPerPetal <= 0) return;
+    uint8_t colorIndex = m_palette.Intern(color);
+    BulletMath::UnitDir base = BulletMath::FromAngle(angleOffset);
+    
+    // 花びら内の広がり角は全花びら共通なので4発分ずつまとめて計算
+    for (int b0 = 0; b0 < bulletsPerPetal; b0 += 4) {
+        int chunk = (bulletsPerPetal - b0 < 4) ? bulletsPerPetal - b0 : 4;
+        float spreadAngles[4];
+        BulletMath::UnitDir spreadDirs[4];
+        for (int j = 0; j < chunk; j++) {
+            // sin(b * PI / n) = 2n等分リングのy成分
+            spreadAngles[j] = (PI / 8.0f) * BulletMath::Direction(b0 + j, bulletsPerPetal * 2).y;
+        }
+        BulletMath::FromAngles(spreadAngles, spreadDirs, chunk);
         
-        for (int b = 0; b < bulletsPerPetal; b++) {
-            float spreadAngle = petalAngle + (PI / 8.0f) * sinf(b * PI / bulletsPerPetal);
-            float bulletSpeed = speed * (0.7f + 0.3f * (static_cast<float>(b) / bulletsPerPetal));
-            
-            float vx = cosf(spreadAngle) * bulletSpeed;
-            float vy = sinf(spreadAngle) * bulletSpeed;
-            
-            // Gradient color for each petal
-            XMFLOAT4 bulletColor = color;
-            bulletColor.w = 0.7f + 0.3f * (static_cast<float>(b) / bulletsPerPetal);
+        for (int p = 0; p < petals; p++) {
+            BulletMath::UnitDir petalDir = BulletMath::Rotate(BulletMath::Direction(p, petals), base);
             
-            SpawnEnemyBullet(x, y, vx, vy, BulletType::EnemySmall, bulletColor);
+            for (int j = 0; j < chunk; j++) {
+                int b = b0 + j;
+                float bulletSpeed = speed * (0.7f + 0.3f * (static_cast<float>(b) / bulletsPerPetal));
+                BulletMath::UnitDir dir = BulletMath::Rotate(petalDir, spreadDirs[j]);
+                
+                // Gradient alpha for each petal
+                uint8_t alpha = BulletPalette::ToAlpha(0.7f + 0.3f * (static_cast<float>(b) / bulletsPerPetal));
+                
+                SpawnEnemyBulletIndexed(x, y, dir.x * bulletSpeed, dir.y * bulletSpeed, BulletType::EnemySmall, colorIndex, alpha);
+            }
         }
     }
 }
 
 // Rose curve pattern (mathematical rose)
 void BulletManager::SpawnRose(float x, float y, int count, float speed, float time, XMFLOAT4 color) {
-    float k = 5.0f; // Rose petals
+    const int k = 5; // Rose petals
     
-    for (int i = 0; i < count; i++) {
-        float theta = time + (2.0f * PI * i) / count;
-        float r = cosf(k * theta);
-        
-        float angle = theta;
-        float vx = cosf(angle) * speed * (0.5f + 0.5f * fabsf(r));
-        float vy = sinf(angle) * speed * (0.5f + 0.5f * fabsf(r));
+    // cos(k * theta) は k*time だけ回したリング方向のx成分
+    BulletMath::UnitDir petalBase = BulletMath::FromAngle(k * time);
+    float hueBase = time / (2.0f * PI);
+    
+    BulletMath::ForEachRingDirection(count, time, [&](int i, BulletMath::UnitDir dir) {
+        float r = BulletMath::Rotate(BulletMath::Direction(k * i, count), petalBase).x;
+        float bulletSpeed = speed * (0.5f + 0.5f * fabsf(r));
         
-        // Rainbow color based on angle
-        float hue = fmodf(theta / (2.0f * PI), 1.0f);
-        XMFLOAT4 bulletColor = {
-            fabsf(sinf(hue * 2.0f * PI)),
-            fabsf(sinf(hue * 2.0f * PI + 2.0f * PI / 3.0f)),
-            fabsf(sinf(hue * 2.0f * PI + 4.0f * PI / 3.0f)),
-            1.0f
-        };
+        // Rainbow color based on angle（パレット先頭の虹色LUT）
+        float hue = hueBase + static_cast<float>(i) / count;
         
-        SpawnEnemyBullet(x, y, vx, vy, BulletType::EnemySmall, bulletColor);
-    }
+        SpawnEnemyBulletIndexed(x, y, dir.x * bulletSpeed, dir.y * bulletSpeed, BulletType::EnemySmall,
+            BulletPalette::RainbowIndex(hue), 255);
+    });
 }
 
 // Wave pattern
 void BulletManager::SpawnWave(float x, float y, int count, float speed, float amplitude, float frequency, float time, XMFLOAT4 color) {
-    for (int i = 0; i < count; i++) {
-        float baseAngle = time + (2.0f * PI * i) / count;
-        float waveOffset = amplitude * sinf(frequency * time + i * 0.5f);
-        float angle = baseAngle + waveOffset;
-        
-        float vx = cosf(angle) * speed;
-        float vy = sinf(angle) * speed;
-        
-        SpawnEnemyBullet(x, y, vx, vy, BulletType::EnemySmall, color);
-    }
+    // 波オフセット sin(frequency*time + i*0.5) は0.5ラジアンずつの回転で進める
+    BulletMath::UnitDir phase = BulletMath::FromAngle(frequency * time);
+    const BulletMath::UnitDir phaseStep = { 0.87758256f, 0.47942554f };  // cos/sin(0.5)
+    uint8_t colorIndex = m_palette.Intern(color);
+    uint8_t alpha = BulletPalette::ToAlpha(color.w);
+    
+    float waveAngles[4];
+    BulletMath::UnitDir waveDirs[4];
+    BulletMath::UnitDir ringDirs[4];
+    int pending = 0;
+    
+    auto flush = [&]() {
+        BulletMath::FromAngles(waveAngles, waveDirs, pending);
+        for (int j = 0; j < pending; j++) {
+            BulletMath::UnitDir dir = BulletMath::Rotate(ringDirs[j], waveDirs[j]);
+            SpawnEnemyBulletIndexed(x, y, dir.x * speed, dir.y * speed, BulletType::EnemySmall, colorIndex, alpha);
+        }
+        pending = 0;
+    };
+    
+    BulletMath::ForEachRingDirection(count, time, [&](int, BulletMath::UnitDir dir) {
+        waveAngles[pending] = amplitude * phase.y;
+        ringDirs[pending] = dir;
+        phase = BulletMath::Rotate(phase, phaseStep);
+        if (++pending == 4) flush();
+    });
+    if (pending > 0) flush();
 }
 
 // Double ring pattern with two colors
 void BulletManager::SpawnRing(float x, float y, int count, float speed, float delay, BulletType type, XMFLOAT4 color1, XMFLOAT4 color2) {
+    // 2色だけなので先にパレット番号を引いておく
+    uint8_t colorIndex1 = m_palette.Intern(color1);
+    uint8_t colorIndex2 = m_palette.Intern(color2);
+    uint8_t alpha1 = BulletPalette::ToAlpha(color1.w);
+    uint8_t alpha2 = BulletPalette::ToAlpha(color2.w);
+    
     // Outer ring
-    for (int i = 0; i < count; i++) {
-        float angle = (2.0f * PI * i) / count;
-        float vx = cosf(angle) * speed;
-        float vy = sinf(angle) * speed;
-        SpawnEnemyBullet(x, y, vx, vy, type, color1);
-    }
+    BulletMath::ForEachRingDirection(count, 0.0f, [&](int, BulletMath::UnitDir dir) {
+        SpawnEnemyBulletIndexed(x, y, dir.x * speed, dir.y * speed, type, colorIndex1, alpha1);
+    });
     
     // Inner ring (offset)
-    for (int i = 0; i < count; i++) {
-        float angle = (2.0f * PI * i) / count + PI / count;
-        float vx = cosf(angle) * speed * 0.7f;
-        float vy = sinf(angle) * speed * 0.7f;
-        SpawnEnemyBullet(x, y, vx, vy, type, color2);
-    }
+    if (count <= 0) return;
+    BulletMath::ForEachRingDirection(count, PI / count, [&](int, BulletMath::UnitDir dir) {
+        SpawnEnemyBulletIndexed(x, y, dir.x * speed * 0.7f, dir.y * speed * 0.7f, type, colorIndex2, alpha2);
+    });
 }
@@ -1,11 +1,13 @@
 ﻿#pragma once
 
-#include <vector>
-#include <d3d11.h>
-#include <wrl/client.h>
 #include "Bullet.h"
+#include "BulletPool.h"
+#include "BulletPalette.h"
+#include "RenderSnapshot.h"
 
 class Graphics;
+class EnemyIndex;
+class JobSystem;
 
 class BulletManager {
 public:
@@ -13,14 +15,22 @@ public:
     ~BulletManager();
 
     void Initialize(Graphics* graphics);
-    void Update(float deltaTime, int screenWidth, int screenHeight);
-    void Render(Graphics* graphics);
+    // jobs を渡すと弾の移動をチャンク単位で並列実行する（削除はその後メインで詰める）
+    void Update(float deltaTime, int screenWidth, int screenHeight, JobSystem* jobs = nullptr);
+    void Render(Graphics* graphics);  // 最後に公開されたスナップショットを描く
     void Clear();
+    
+    // 生きている弾を描画用スナップショットとして公開（1フレームの更新が終わったら呼ぶ）
+    void PublishSnapshot();
 
     // Bullet spawn
-    void SpawnPlayerBullet(float x, float y, float vx, float vy);
-    void SpawnHomingMissile(float x, float y, float vx, float vy);  // ホーミングミサイル
-    void SpawnEnemyBullet(float x, float y, float vx, float vy, BulletType type, DirectX::XMFLOAT4 color);
+    // 戻り値のハンドルはプール上限で捨てられたとき無効（IsValid() == false）
+    BulletHandle SpawnPlayerBullet(float x, float y, float vx, float vy);
+    BulletHandle SpawnHomingMissile(float x, float y, float vx, float vy);  // ホーミングミサイル
+    BulletHandle SpawnEnemyBullet(float x, float y, float vx, float vy, BulletType type, DirectX::XMFLOAT4 color);
+    // 弾の寿命を設定（秒、0以下で無期限）。既定は無期限で、止まる弾・回り続ける弾など
+    // 画面外に出ない弾を撃つパターンだけがここで寿命を付ける
+    void SetBulletLifetime(BulletHandle handle, float seconds);
     
     // Basic patterns
     void SpawnCircle(float x, float y, int count, float speed, BulletType type, DirectX::XMFLOAT4 color);
@@ -33,20 +43,35 @@ public:
     void SpawnWave(float x, float y, int count, float speed, float amplitude, float frequency, float time, DirectX::XMFLOAT4 color);
     void SpawnRing(float x, float y, int count, float speed, float delay, BulletType type, DirectX::XMFLOAT4 color1, DirectX::XMFLOAT4 color2);
 
-    // 当たり判定用
-    const std::vector<Bullet>& GetBullets() const { return m_bullets; }
-    std::vector<Bullet>& GetBullets() { return m_bullets; }
+    // 当たり判定用（生きている弾だけが詰めて並ぶ、位置はUpdateで入れ替わる）
+    const BulletPool& GetBullets() const { return m_bullets; }
+    BulletPool& GetBullets() { return m_bullets; }
+    Bullet* GetBullet(BulletHandle handle) { return m_bullets.Get(handle); }
+    const BulletPalette& GetPalette() const { return m_palette; }
 
 private:
-    std::vector<Bullet> m_bullets;
-    static const int MAX_BULLETS = 2000;
+    // 1発分の移動・寿命・画面外判定（他の弾に触れないので並列に呼べる）
+    void IntegrateBullet(Bullet& bullet, float deltaTime, int screenWidth, int screenHeight) const;
+    BulletHandle SpawnEnemyBulletIndexed(float x, float y, float vx, float vy, BulletType type, uint8_t colorIndex, uint8_t alpha);
+
+    // チャンク式プール（ソフト予算は既定2000発、超過・破棄はGetStatsで確認）
+    BulletPool m_bullets;
     
-    // 樽テクスチャ
-    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> m_barrelTexture;
+    // 描画用スナップショット（トリプルバッファ）
+    SnapshotBuffer<BulletSprite> m_snapshot;
     
-    // ホーミング用敵位置リスト
-    std::vector<DirectX::XMFLOAT2> m_enemyPositions;
+    // 弾の色はパレット番号で持つ（Renderで変更分だけGPUへ転送）
+    BulletPalette m_palette;
+    uint8_t m_playerShotColor;
+    uint8_t m_homingColor;
+    
+    // ホーミング用敵インデックス（EnemyManagerが所有、毎フレーム再構築）
+    const EnemyIndex* m_enemyIndex = nullptr;
     
 public:
-    void SetEnemyPositions(const std::vector<DirectX::XMFLOAT2>& positions) { m_enemyPositions = positions; }
+    void SetEnemyIndex(const EnemyIndex* index) { m_enemyIndex = index; }
+    
+    // 弾数の予算と統計（難易度ごとの想定弾数を超えたかの確認用）
+    void SetBulletBudget(size_t budget) { m_bullets.SetBudget(budget); }
+    const BulletPoolStats& GetStats() const { return m_bullets.GetStats(); }
 };
@@ -0,0 +1,153 @@
+﻿#pragma once
+
+#include <array>
+#include <cmath>
+#include <DirectXMath.h>
+
+// 弾幕パターン用の方向テーブル・カラーLUT
+// リング系パターンは sin/cos を呼ばずにテーブル参照＋積和で方向を求める
+namespace BulletMath {
+
+struct UnitDir {
+    float x;
+    float y;
+};
+
+constexpr double TWO_PI_D = 6.283185307179586;
+
+// コンパイル時テーブル生成用の sin/cos（テイラー展開、|x| <= π 前提）
+constexpr double ConstSin(double x) {
+    double term = x;
+    double sum = x;
+    for (int n = 1; n < 12; n++) {
+        term *= -x * x / ((2.0 * n) * (2.0 * n + 1.0));
+        sum += term;
+    }
+    return sum;
+}
+
+constexpr double ConstCos(double x) {
+    double term = 1.0;
+    double sum = 1.0;
+    for (int n = 1; n < 12; n++) {
+        term *= -x * x / ((2.0 * n - 1.0) * (2.0 * n));
+        sum += term;
+    }
+    return sum;
+}
+
+// [-π, π] に折り返す
+constexpr double WrapAngle(double a) {
+    while (a > TWO_PI_D / 2.0) a -= TWO_PI_D;
+    while (a < -TWO_PI_D / 2.0) a += TWO_PI_D;
+    return a;
+}
+
+// 単位方向テーブル（720分割: 4,6,8,12,16,20,24,30,36,40,...弾のリングを割り切れる）
+constexpr int DIR_TABLE_SIZE = 720;
+
+constexpr std::array<UnitDir, DIR_TABLE_SIZE> MakeDirTable() {
+    std::array<UnitDir, DIR_TABLE_SIZE> table{};
+    for (int i = 0; i < DIR_TABLE_SIZE; i++) {
+        double a = WrapAngle(TWO_PI_D * i / DIR_TABLE_SIZE);
+        table[i] = { static_cast<float>(ConstCos(a)), static_cast<float>(ConstSin(a)) };
+    }
+    return table;
+}
+
+inline constexpr std::array<UnitDir, DIR_TABLE_SIZE> DIR_TABLE = MakeDirTable();
+
+// 虹色LUT（hue 0〜1 を64段階、|sin(h*2π + k*2π/3)| の各チャンネル）
+constexpr int RAINBOW_LUT_SIZE = 64;
+
+constexpr std::array<DirectX::XMFLOAT4, RAINBOW_LUT_SIZE> MakeRainbowLut() {
+    std::array<DirectX::XMFLOAT4, RAINBOW_LUT_SIZE> lut{};
+    for (int i = 0; i < RAINBOW_LUT_SIZE; i++) {
+        double h = TWO_PI_D * i / RAINBOW_LUT_SIZE;
+        double r = ConstSin(WrapAngle(h));
+        double g = ConstSin(WrapAngle(h + TWO_PI_D / 3.0));
+        double b = ConstSin(WrapAngle(h + 2.0 * TWO_PI_D / 3.0));
+        lut[i] = DirectX::XMFLOAT4(
+            static_cast<float>(r < 0 ? -r : r),
+            static_cast<float>(g < 0 ? -g : g),
+            static_cast<float>(b < 0 ? -b : b),
+            1.0f);
+    }
+    return lut;
+}
+
+inline constexpr std::array<DirectX::XMFLOAT4, RAINBOW_LUT_SIZE> RAINBOW_LUT = MakeRainbowLut();
+
+// hue（0〜1、範囲外は折り返し）からLUTの段階番号を求める
+inline int RainbowIndex(float hue) {
+    float frac = hue - floorf(hue);
+    int index = static_cast<int>(frac * RAINBOW_LUT_SIZE + 0.5f);
+    return index % RAINBOW_LUT_SIZE;
+}
+
+inline const DirectX::XMFLOAT4& RainbowColor(float hue) {
+    return RAINBOW_LUT[RainbowIndex(hue)];
+}
+
+inline UnitDir FromAngle(float angle) {
+    UnitDir d;
+    DirectX::XMScalarSinCos(&d.y, &d.x, angle);
+    return d;
+}
+
+// 方向を回転（複素数の積）
+inline UnitDir Rotate(UnitDir d, UnitDir by) {
+    return { d.x * by.x - d.y * by.y, d.x * by.y + d.y * by.x };
+}
+
+// 2π * i / count の方向（割り切れればテーブル参照）
+inline UnitDir Direction(int i, int count) {
+    if (count > 0 && DIR_TABLE_SIZE % count == 0) {
+        int stride = DIR_TABLE_SIZE / count;
+        return DIR_TABLE[(i % count) * stride];
+    }
+    return FromAngle(static_cast<float>(TWO_PI_D) * i / count);
+}
+
+// 任意角の方向を4つずつまとめて計算（XMVectorSinCos）
+inline void FromAngles(const float* angles, UnitDir* out, int count) {
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        DirectX::XMVECTOR s, c;
+        DirectX::XMVectorSinCos(&s, &c,
+            DirectX::XMVectorSet(angles[i], angles[i + 1], angles[i + 2], angles[i + 3]));
+        DirectX::XMFLOAT4 sv, cv;
+        DirectX::XMStoreFloat4(&sv, s);
+        DirectX::XMStoreFloat4(&cv, c);
+        out[i] = { cv.x, sv.x };
+        out[i + 1] = { cv.y, sv.y };
+        out[i + 2] = { cv.z, sv.z };
+        out[i + 3] = { cv.w, sv.w };
+    }
+    for (; i < count; i++) {
+        out[i] = FromAngle(angles[i]);
+    }
+}
+
+// count等分リングの各方向を offset だけ回して列挙する
+// テーブルで割り切れない弾数は1ステップ分の回転を積み重ねる
+template <typename Fn>
+inline void ForEachRingDirection(int count, float offset, Fn&& fn) {
+    if (count <= 0) return;
+    UnitDir base = FromAngle(offset);
+    if (DIR_TABLE_SIZE % count == 0) {
+        int stride = DIR_TABLE_SIZE / count;
+        for (int i = 0; i < count; i++) {
+            fn(i, Rotate(DIR_TABLE[i * stride], base));
+        }
+    } else {
+        UnitDir step = FromAngle(static_cast<float>(TWO_PI_D) / count);
+        UnitDir dir = base;
+        for (int i = 0; i < count; i++) {
+            fn(i, dir);
+            dir = Rotate(dir, step);
+        }
+    }
+}
+
+} // namespace BulletMath
@@ -0,0 +1,117 @@
+﻿#pragma once
+
+#include <array>
+#include <cstdint>
+#include <DirectXMath.h>
+#include "BulletMath.h"
+
+// 弾の共有カラーパレット（256色）
+// 弾は1バイトのインデックスだけを持ち、色はGPU側（頂点シェーダー）で展開する
+// 先頭64色は虹色LUT固定、残りはパターンが使う色を登録順に積む
+class BulletPalette {
+public:
+    static constexpr int SIZE = 256;
+    static constexpr int RAINBOW_BASE = 0;
+
+    BulletPalette() { Reset(); }
+
+    void Reset() {
+        for (int i = 0; i < BulletMath::RAINBOW_LUT_SIZE; i++) {
+            m_colors[RAINBOW_BASE + i] = Quantize(BulletMath::RAINBOW_LUT[i], &m_keys[RAINBOW_BASE + i]);
+        }
+        for (int i = BulletMath::RAINBOW_LUT_SIZE; i < SIZE; i++) {
+            m_colors[i] = DirectX::XMFLOAT4(0.0f, 0.0f, 0.0f, 1.0f);
+            m_keys[i] = 0;
+        }
+        m_count = BulletMath::RAINBOW_LUT_SIZE;
+        m_lastKey = INVALID_KEY;
+        m_lastIndex = 0;
+        m_dirty = true;
+    }
+
+    // 色を登録してインデックスを返す（RGBを8bitに量子化、アルファは無視）
+    // 満杯なら最も近い既存色にまとめる
+    uint8_t Intern(const DirectX::XMFLOAT4& color) {
+        uint32_t key;
+        DirectX::XMFLOAT4 quantized = Quantize(color, &key);
+        // 同じ色の連続登録（リング弾など）はキャッシュで即答
+        if (key == m_lastKey) return m_lastIndex;
+
+        int found = -1;
+        for (int i = 0; i < m_count; i++) {
+            if (m_keys[i] == key) { found = i; break; }
+        }
+        if (found < 0) {
+            if (m_count < SIZE) {
+                found = m_count++;
+                m_colors[found] = quantized;
+                m_keys[found] = key;
+                m_dirty = true;
+            } else {
+                found = Nearest(key);
+            }
+        }
+        m_lastKey = key;
+        m_lastIndex = static_cast<uint8_t>(found);
+        return m_lastIndex;
+    }
+
+    // hue（0〜1）に対応する虹色のインデックス
+    static uint8_t RainbowIndex(float hue) {
+        return static_cast<uint8_t>(RAINBOW_BASE + BulletMath::RainbowIndex(hue));
+    }
+
+    static uint8_t ToAlpha(float alpha) {
+        if (alpha <= 0.0f) return 0;
+        if (alpha >= 1.0f) return 255;
+        return static_cast<uint8_t>(alpha * 255.0f + 0.5f);
+    }
+
+    const DirectX::XMFLOAT4& GetColor(uint8_t index) const { return m_colors[index]; }
+    const DirectX::XMFLOAT4* GetColors() const { return m_colors.data(); }
+    int GetCount() const { return m_count; }
+
+    // 色が追加されたフレームだけGPUへ再アップロードする
+    bool IsDirty() const { return m_dirty; }
+    void ClearDirty() { m_dirty = false; }
+
+private:
+    static constexpr uint32_t INVALID_KEY = 0xFFFFFFFFu;
+
+    static uint32_t ToByte(float v) {
+        if (v <= 0.0f) return 0;
+        if (v >= 1.0f) return 255;
+        return static_cast<uint32_t>(v * 255.0f + 0.5f);
+    }
+
+    static DirectX::XMFLOAT4 Quantize(const DirectX::XMFLOAT4& color, uint32_t* key) {
+        uint32_t r = ToByte(color.x);
+        uint32_t g = ToByte(color.y);
+        uint32_t b = ToByte(color.z);
+        *key = (r << 16) | (g << 8) | b;
+        return DirectX::XMFLOAT4(r / 255.0f, g / 255.0f, b / 255.0f, 1.0f);
+    }
+
+    int Nearest(uint32_t key) const {
+        int best = 0;
+        int bestDist = -1;
+        for (int i = 0; i < m_count; i++) {
+            int dr = static_cast<int>((m_keys[i] >> 16) & 0xFF) - static_cast<int>((key >> 16) & 0xFF);
+            int dg = static_cast<int>((m_keys[i] >> 8) & 0xFF) - static_cast<int>((key >> 8) & 0xFF);
+            int db = static_cast<int>(m_keys[i] & 0xFF) - static_cast<int>(key & 0xFF);
+            int dist = dr * dr + dg * dg + db * db;
+            if (bestDist < 0 || dist < bestDist) {
+                best = i;
+                bestDist = dist;
+            }
+        }
+        return best;
+    }
+
+    std::array<DirectX::XMFLOAT4, SIZE> m_colors;
+    std::array<uint32_t, SIZE> m_keys;
+    int m_count;
+    uint32_t m_lastKey;
+    uint8_t m_lastIndex;
+    bool m_dirty;
+};
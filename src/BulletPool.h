@@ -0,0 +1,179 @@
+﻿#pragma once
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+#include "Bullet.h"
+
+// 弾のハンドル（ハンドルID＋世代、削除済み・再利用済みを検出）
+struct BulletHandle {
+    uint32_t index = INVALID;
+    uint32_t generation = 0;
+
+    static constexpr uint32_t INVALID = 0xFFFFFFFFu;
+    bool IsValid() const { return index != INVALID; }
+};
+
+struct BulletPoolStats {
+    uint64_t spawned = 0;      // 確保できた弾の累計
+    uint64_t dropped = 0;      // ハード上限で捨てた弾の累計
+    uint64_t overBudget = 0;   // ソフト予算を超えて確保した弾の累計
+    size_t active = 0;
+    size_t peakActive = 0;
+    size_t capacity = 0;
+};
+
+// チャンク単位で伸びる弾プール
+// 1チャンク = CHUNK_SIZE 発、チャンク自体は再確保しないので伸びても既存の弾は動かない
+// 生きている弾は [0, size()) に詰めて並べる（削除は末尾との入れ替え）
+// 入れ替えで位置が変わるため、弾を持ち続けたいときはハンドルを使う
+// ソフト予算を超えても確保は続け（overBudgetを数える）、MAX_CHUNKS に達したら捨てる
+class BulletPool {
+public:
+    static constexpr uint32_t CHUNK_SIZE = 1024;
+    static constexpr uint32_t MAX_CHUNKS = 32;           // 32768発
+    static constexpr size_t DEFAULT_BUDGET = 2000;
+
+    BulletPool() : m_size(0), m_budget(DEFAULT_BUDGET) {
+        m_chunks.reserve(MAX_CHUNKS);
+    }
+
+    // count発分のチャンクを先に確保しておく
+    void Reserve(size_t count) {
+        while (Capacity() < count && m_chunks.size() < MAX_CHUNKS) {
+            AddChunk();
+        }
+    }
+
+    // 末尾に弾を追加（既定値で初期化済み）、上限到達時はnullptr
+    Bullet* Allocate(BulletHandle* handle = nullptr) {
+        if (m_size == Capacity()) {
+            if (m_chunks.size() >= MAX_CHUNKS) {
+                m_stats.dropped++;
+                return nullptr;
+            }
+            AddChunk();
+        }
+
+        uint32_t id;
+        if (!m_freeIds.empty()) {
+            id = m_freeIds.back();
+            m_freeIds.pop_back();
+        } else {
+            id = static_cast<uint32_t>(m_idToIndex.size());
+            m_idToIndex.push_back(0);
+            m_generations.push_back(0);
+        }
+
+        uint32_t index = m_size++;
+        m_idToIndex[id] = index;
+        m_indexToId[index] = id;
+
+        if (m_size > m_budget) m_stats.overBudget++;
+        m_stats.spawned++;
+        m_stats.active = m_size;
+        if (m_size > m_stats.peakActive) m_stats.peakActive = m_size;
+
+        Bullet* bullet = &(*this)[index];
+        *bullet = Bullet();
+        if (handle) {
+            handle->index = id;
+            handle->generation = m_generations[id];
+        }
+        return bullet;
+    }
+
+    // index の弾を削除し、末尾の弾をそこへ移す
+    // ループ中に呼んだら同じ index をもう一度処理すること
+    void RemoveAt(uint32_t index) {
+        if (index >= m_size) return;
+        uint32_t last = m_size - 1;
+        uint32_t id = m_indexToId[index];
+        if (index != last) {
+            (*this)[index] = (*this)[last];
+            uint32_t movedId = m_indexToId[last];
+            m_indexToId[index] = movedId;
+            m_idToIndex[movedId] = index;
+        }
+        m_generations[id]++;
+        m_freeIds.push_back(id);
+        m_size = last;
+        m_stats.active = m_size;
+    }
+
+    void Release(BulletHandle handle) {
+        if (IsValidHandle(handle)) RemoveAt(m_idToIndex[handle.index]);
+    }
+
+    void ReleaseAll() {
+        while (m_size > 0) RemoveAt(m_size - 1);
+    }
+
+    // ハンドルが指す弾（削除・再利用済みならnullptr）
+    Bullet* Get(BulletHandle handle) {
+        return IsValidHandle(handle) ? &(*this)[m_idToIndex[handle.index]] : nullptr;
+    }
+
+    Bullet& operator[](uint32_t index) { return m_chunks[index / CHUNK_SIZE][index % CHUNK_SIZE]; }
+    const Bullet& operator[](uint32_t index) const { return m_chunks[index / CHUNK_SIZE][index % CHUNK_SIZE]; }
+
+    // 生きている弾の数（当たり判定で消えてまだ詰めていない弾を含む）
+    size_t size() const { return m_size; }
+    size_t Capacity() const { return m_chunks.size() * CHUNK_SIZE; }
+
+    void SetBudget(size_t budget) { m_budget = budget; }
+    size_t GetBudget() const { return m_budget; }
+    bool IsOverBudget() const { return m_size > m_budget; }
+
+    const BulletPoolStats& GetStats() const { return m_stats; }
+    void ResetStats() {
+        m_stats.spawned = 0;
+        m_stats.dropped = 0;
+        m_stats.overBudget = 0;
+        m_stats.peakActive = m_stats.active;
+    }
+
+    // range-for 用（生きている弾だけを回る）
+    template <typename PoolT, typename BulletT>
+    class Iterator {
+    public:
+        Iterator(PoolT* pool, uint32_t index) : m_pool(pool), m_index(index) {}
+        BulletT& operator*() const { return (*m_pool)[m_index]; }
+        BulletT* operator->() const { return &(*m_pool)[m_index]; }
+        Iterator& operator++() { m_index++; return *this; }
+        bool operator!=(const Iterator& other) const { return m_index != other.m_index; }
+        uint32_t Index() const { return m_index; }
+    private:
+        PoolT* m_pool;
+        uint32_t m_index;
+    };
+    using iterator = Iterator<BulletPool, Bullet>;
+    using const_iterator = Iterator<const BulletPool, const Bullet>;
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, m_size); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, m_size); }
+
+private:
+    bool IsValidHandle(BulletHandle handle) const {
+        return handle.index < m_idToIndex.size() && m_generations[handle.index] == handle.generation
+            && m_idToIndex[handle.index] < m_size && m_indexToId[m_idToIndex[handle.index]] == handle.index;
+    }
+
+    void AddChunk() {
+        m_chunks.emplace_back(new Bullet[CHUNK_SIZE]);
+        m_indexToId.resize(Capacity(), 0);
+        m_stats.capacity = Capacity();
+    }
+
+    std::vector<std::unique_ptr<Bullet[]>> m_chunks;
+    std::vector<uint32_t> m_indexToId;     // 並び位置 → ハンドルID
+    std::vector<uint32_t> m_idToIndex;     // ハンドルID → 並び位置
+    std::vector<uint32_t> m_generations;   // ハンドルIDごとの世代
+    std::vector<uint32_t> m_freeIds;
+    uint32_t m_size;
+    size_t m_budget;
+    BulletPoolStats m_stats;
+};
@@ -1,6 +1,7 @@
 ﻿#include "Enemy.h"
 #include "Graphics.h"
 #include "BulletManager.h"
+#include "BulletMath.h"
 #include <cmath>
 
 using namespace DirectX;
@@ -49,10 +50,6 @@ void Enemy::Initialize(float x, float y, float health, EnemyType type) {
     }
 }
 
-void Enemy::SetTexture(ID3D11ShaderResourceView* texture) {
-    m_texture = texture;
-}
-
 void Enemy::Update(float deltaTime, int screenWidth, int screenHeight, BulletManager* bulletManager, XMFLOAT2 playerPos) {
     // 無敵時間のカウントダウン
     if (m_invincibleTimer > 0) {
@@ -274,11 +271,11 @@ void Enemy::Render(Graphics* graphics) {
         // 本体は徐々に小さく、透明に
         float scale = 1.0f - progress * 0.8f;
         float alpha = 1.0f - progress;
-        if (m_texture) {
+        if (graphics->HasSprite(m_sprite)) {
             float size = m_radius * 2.0f * scale;
-            graphics->DrawTexturedSprite(
+            graphics->DrawAtlasSprite(
                 m_position.x - m_radius * scale, m_position.y - m_radius * scale,
-                size, size, m_texture.Get(), XMFLOAT4(1, 1, 1, alpha));
+                size, size, m_sprite, XMFLOAT4(1, 1, 1, alpha));
         }
         return;  // Dying状態は通常描画をスキップ
     }
@@ -289,7 +286,7 @@ void Enemy::Render(Graphics* graphics) {
                              m_type == EnemyType::Boss ? 5 : 3);
 
     // Draw texture if available, otherwise fallback to shapes
-    if (m_texture) {
+    if (graphics->HasSprite(m_sprite)) {
         float size = m_radius * 2.0f;
         
         // ボスは浮遊アニメーション（上下に揺れる）
@@ -305,14 +302,14 @@ void Enemy::Render(Graphics* graphics) {
             : XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f);  // 通常
         
         // ボスはアニメーションフレームを使用
-        ID3D11ShaderResourceView* texToUse = m_texture.Get();
-        if (m_type == EnemyType::Boss && m_animFrames[m_currentFrame]) {
-            texToUse = m_animFrames[m_currentFrame].Get();
+        SpriteId spriteToUse = m_sprite;
+        if (m_type == EnemyType::Boss && graphics->HasSprite(m_animFrames[m_currentFrame])) {
+            spriteToUse = m_animFrames[m_currentFrame];
         }
         
-        graphics->DrawTexturedSprite(
+        graphics->DrawAtlasSprite(
             m_position.x - m_radius, drawY - m_radius,
-            size, size, texToUse, tintColor);
+            size, size, spriteToUse, tintColor);
         
         // 白フラッシュオーバーレイ（被弾時）
         if (m_flashTimer > 0.0f) {
@@ -441,12 +438,7 @@ void Enemy::ExecuteBulletPattern(BulletManager* bulletManager, XMFLOAT2 playerPo
         case 4: // Spiral with color gradient
             if (m_shootTimer >= 0.03f) {  // 3倍激しく
                 float hue = fmodf(m_patternTimer * 0.5f, 1.0f);
-                XMFLOAT4 color = {
-                    fabsf(sinf(hue * 2.0f * PI)),
-                    fabsf(sinf(hue * 2.0f * PI + 2.0f * PI / 3.0f)),
-                    fabsf(sinf(hue * 2.0f * PI + 4.0f * PI / 3.0f)),
-                    1.0f
-                };
+                XMFLOAT4 color = BulletMath::RainbowColor(hue);  // 虹色LUT
                 bulletManager->SpawnSpiral(
                     m_position.x, m_position.y,
                     4, 180.0f, m_patternTimer * 3.0f,
@@ -2,8 +2,10 @@
 
 #include <DirectXMath.h>
 #include <functional>
+#include <cstdint>
 #include <d3d11.h>
 #include <wrl/client.h>
+#include "TextureAtlas.h"
 
 using Microsoft::WRL::ComPtr;
 
@@ -32,7 +34,7 @@ public:
     ~Enemy();
 
     void Initialize(float x, float y, float health, EnemyType type = EnemyType::Barrel);
-    void SetTexture(ID3D11ShaderResourceView* texture);
+    void SetSprite(SpriteId sprite) { m_sprite = sprite; }
     void Update(float deltaTime, int screenWidth, int screenHeight, BulletManager* bulletManager, DirectX::XMFLOAT2 playerPos);
     void Render(Graphics* graphics);
 
@@ -48,6 +50,10 @@ public:
     float GetHealthPercent() const { return m_maxHealth > 0 ? m_health / m_maxHealth : 0; }
     float GetDisplayHealthPercent() const { return m_maxHealth > 0 ? m_displayHealth / m_maxHealth : 0; }
     bool IsBoss() const { return m_type == EnemyType::Boss; }
+    
+    // 通し番号（ホーミングのターゲットキャッシュ検証用）
+    void SetId(uint32_t id) { m_id = id; }
+    uint32_t GetId() const { return m_id; }
 
     // 弾幕パターンの設定
     void SetBulletPattern(int patternId) { m_patternId = patternId; }
@@ -60,27 +66,13 @@ public:
     bool IsInvincible() const { return m_invincibleTimer > 0; }
     bool IsShowingCutin() const { return m_showingCutin; }
     void ClearCutin() { m_showingCutin = false; }
-    
-    // スペルカード名（ウイスキーテーマ）
-    const wchar_t* GetSpellCardName() const {
-        static const wchar_t* names[] = {
-            L"シングル「オーダーズ・オン・ザ・ロック」",
-            L"ダブル「トワイライト・バレル」",
-            L"スリーショット「スモーキー・アイラ」",
-            L"フォーシーズン「シェリー・キャスク」",
-            L"禁断「マスターズ・リザーブ」"
-        };
-        if (m_currentSpell >= 0 && m_currentSpell < 5) {
-            return names[m_currentSpell];
-        }
-        return L"";
-    }
+    // スペルカード名は Game の SpellCardTable から GetCurrentSpell で引く
     
     // ボスアニメーションフレーム設定
-    void SetAnimFrames(ID3D11ShaderResourceView* frame1, ID3D11ShaderResourceView* frame2, ID3D11ShaderResourceView* frame3) {
-        if (frame1) m_animFrames[0] = frame1;
-        if (frame2) m_animFrames[1] = frame2;
-        if (frame3) m_animFrames[2] = frame3;
+    void SetAnimFrames(SpriteId frame1, SpriteId frame2, SpriteId frame3) {
+        m_animFrames[0] = frame1;
+        m_animFrames[1] = frame2;
+        m_animFrames[2] = frame3;
     }
 
 private:
@@ -98,7 +90,8 @@ private:
     int m_patternPhase;
     EnemyState m_state;
     EnemyType m_type;
-    ComPtr<ID3D11ShaderResourceView> m_texture;
+    uint32_t m_id = 0;
+    SpriteId m_sprite = SpriteId::None;  // アトラス上のスプライト
     
     // ボススペルカード
     int m_spellCards = 5;   // 復活回数（5つのスペル）
@@ -121,7 +114,7 @@ private:
     float m_deathDuration = 2.0f;     // 死亡アニメーション時間
     
     // ボスアニメーションフレーム
-    ComPtr<ID3D11ShaderResourceView> m_animFrames[3];
+    SpriteId m_animFrames[3] = { SpriteId::None, SpriteId::None, SpriteId::None };
     int m_currentFrame = 0;
     float m_frameTimer = 0.0f;
     float m_frameInterval = 0.2f;     // フレーム切り替え間隔（0.2秒）
@@ -0,0 +1,120 @@
+﻿#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <DirectXMath.h>
+
+// ホーミング用の敵エントリ（スロット番号 = EnemyManagerの並び順）
+struct EnemyIndexEntry {
+    DirectX::XMFLOAT2 position;
+    uint32_t id;        // 敵の通し番号（キャッシュ検証用）
+    bool isActive;
+};
+
+// 敵位置の空間インデックス（一様グリッド、毎フレーム再構築）
+// BulletManagerはコピーせずポインタ越しに読むだけ
+class EnemyIndex {
+public:
+    static constexpr float CELL_SIZE = 128.0f;
+
+    EnemyIndex() : m_cols(1), m_rows(1), m_activeCount(0) {}
+
+    // 再構築開始（バッファは使い回すので毎フレームの確保なし）
+    void Begin(int areaWidth, int areaHeight) {
+        m_cols = static_cast<int>(areaWidth / CELL_SIZE) + 1;
+        m_rows = static_cast<int>(areaHeight / CELL_SIZE) + 1;
+        m_entries.clear();
+        m_activeCount = 0;
+    }
+
+    void Add(uint32_t id, DirectX::XMFLOAT2 position, bool isActive) {
+        m_entries.push_back({ position, id, isActive });
+        if (isActive) m_activeCount++;
+    }
+
+    // アクティブな敵をセルごとに並べ替え（カウンティングソート）
+    void Build() {
+        m_cellStart.assign(static_cast<size_t>(m_cols * m_rows) + 1, 0);
+        for (const auto& entry : m_entries) {
+            if (entry.isActive) m_cellStart[CellOf(entry.position) + 1]++;
+        }
+        for (size_t i = 1; i < m_cellStart.size(); i++) {
+            m_cellStart[i] += m_cellStart[i - 1];
+        }
+        m_cellItems.resize(m_activeCount);
+        m_cursor.assign(m_cellStart.begin(), m_cellStart.end() - 1);
+        for (size_t slot = 0; slot < m_entries.size(); slot++) {
+            if (!m_entries[slot].isActive) continue;
+            m_cellItems[m_cursor[CellOf(m_entries[slot].position)]++] = static_cast<uint32_t>(slot);
+        }
+    }
+
+    // 最寄りの敵スロットを返す（見つからなければ-1）
+    int FindNearest(DirectX::XMFLOAT2 position) const {
+        if (m_activeCount == 0) return -1;
+
+        int cx = ClampCol(position.x);
+        int cy = ClampRow(position.y);
+        int maxRing = m_cols > m_rows ? m_cols : m_rows;
+
+        int best = -1;
+        float bestDist = 0.0f;
+        for (int ring = 0; ring <= maxRing; ring++) {
+            for (int y = cy - ring; y <= cy + ring; y++) {
+                if (y < 0 || y >= m_rows) continue;
+                bool edgeRow = (y == cy - ring || y == cy + ring);
+                int step = edgeRow ? 1 : ring * 2;
+                for (int x = cx - ring; x <= cx + ring; x += step) {
+                    if (x < 0 || x >= m_cols) continue;
+                    int cell = y * m_cols + x;
+                    for (uint32_t i = m_cellStart[cell]; i < m_cellStart[cell + 1]; i++) {
+                        const EnemyIndexEntry& entry = m_entries[m_cellItems[i]];
+                        float dx = entry.position.x - position.x;
+                        float dy = entry.position.y - position.y;
+                        float dist = dx * dx + dy * dy;
+                        if (best < 0 || dist < bestDist) {
+                            best = static_cast<int>(m_cellItems[i]);
+                            bestDist = dist;
+                        }
+                    }
+                }
+            }
+            // 次のリングはring*CELL_SIZEより遠いので打ち切れる
+            float ringDist = ring * CELL_SIZE;
+            if (best >= 0 && bestDist <= ringDist * ringDist) break;
+        }
+        return best;
+    }
+
+    // キャッシュしたスロットを検証して返す（消滅・入れ替わり済みならnullptr）
+    const EnemyIndexEntry* Resolve(int slot, uint32_t id) const {
+        if (slot < 0 || slot >= static_cast<int>(m_entries.size())) return nullptr;
+        const EnemyIndexEntry& entry = m_entries[slot];
+        if (entry.id != id || !entry.isActive) return nullptr;
+        return &entry;
+    }
+
+    const EnemyIndexEntry& GetEntry(int slot) const { return m_entries[slot]; }
+    size_t GetActiveCount() const { return m_activeCount; }
+
+private:
+    int ClampCol(float x) const {
+        int c = static_cast<int>(x / CELL_SIZE);
+        if (x < 0.0f || c < 0) return 0;
+        return c >= m_cols ? m_cols - 1 : c;
+    }
+    int ClampRow(float y) const {
+        int r = static_cast<int>(y / CELL_SIZE);
+        if (y < 0.0f || r < 0) return 0;
+        return r >= m_rows ? m_rows - 1 : r;
+    }
+    int CellOf(DirectX::XMFLOAT2 p) const { return ClampRow(p.y) * m_cols + ClampCol(p.x); }
+
+    std::vector<EnemyIndexEntry> m_entries;
+    std::vector<uint32_t> m_cellStart;   // セルごとの開始位置（CSR形式）
+    std::vector<uint32_t> m_cellItems;   // セル順に並んだスロット番号
+    std::vector<uint32_t> m_cursor;
+    int m_cols;
+    int m_rows;
+    size_t m_activeCount;
+};
@@ -1,7 +1,6 @@
 ﻿#include "EnemyManager.h"
 #include "Graphics.h"
 #include "BulletManager.h"
-#include "TextureLoader.h"
 
 using namespace DirectX;
 
@@ -20,46 +19,6 @@ EnemyManager::~EnemyManager() {
 void EnemyManager::Initialize(Graphics* graphics, BulletManager* bulletManager) {
     m_bulletManager = bulletManager;
     
-    // Load enemy textures
-    TextureLoader loader;
-    loader.Initialize(graphics->GetDevice());
-    
-    wchar_t exePath[MAX_PATH];
-    GetModuleFileNameW(nullptr, exePath, MAX_PATH);
-    std::wstring path(exePath);
-    size_t lastSlash = path.find_last_of(L"\\/");
-    std::wstring basePath = path.substr(0, lastSlash) + L"\\..\\..\\assets\\textures\\sprites\\";
-    
-    ID3D11ShaderResourceView* srv = nullptr;
-    if (loader.LoadTexture(basePath + L"enemy_barrel.png", &srv)) {
-        m_barrelTexture.Attach(srv);
-    }
-    srv = nullptr;
-    if (loader.LoadTexture(basePath + L"enemy_bottle.png", &srv)) {
-        m_bottleTexture.Attach(srv);
-    }
-    srv = nullptr;
-    if (loader.LoadTexture(basePath + L"boss_hinahina.png", &srv)) {
-        m_bossTexture.Attach(srv);
-    }
-    // ボスアニメーション用3フレーム読み込み
-    for (int i = 0; i < 3; i++) {
-        srv = nullptr;
-        wchar_t filename[64];
-        swprintf_s(filename, L"boss_frame_%d.png", i + 1);
-        if (loader.LoadTexture(basePath + filename, &srv)) {
-            m_bossFrames[i].Attach(srv);
-        }
-    }
-    srv = nullptr;
-    if (loader.LoadTexture(basePath + L"enemy_glass.png", &srv)) {
-        m_glassTexture.Attach(srv);
-    }
-    srv = nullptr;
-    if (loader.LoadTexture(basePath + L"enemy_glass2.png", &srv)) {
-        m_fairyTexture.Attach(srv);
-    }
-    
     // 初期ウェーブの生成
     SpawnWave(0);
 }
@@ -111,23 +70,24 @@ void EnemyManager::SpawnEnemy(float x, float y, float health, int patternId, Ene
     auto enemy = std::make_unique<Enemy>();
     enemy->Initialize(x, y, health, type);
     enemy->SetBulletPattern(patternId);
+    enemy->SetId(m_nextEnemyId++);
     
-    // Set texture based on type
+    // Set sprite based on type（アトラスに無ければ描画側で図形にフォールバック）
     switch (type) {
         case EnemyType::Barrel:
-            if (m_barrelTexture) enemy->SetTexture(m_barrelTexture.Get());
+            enemy->SetSprite(SpriteId::EnemyBarrel);
             break;
         case EnemyType::Bottle:
-            if (m_bottleTexture) enemy->SetTexture(m_bottleTexture.Get());
+            enemy->SetSprite(SpriteId::EnemyBottle);
             break;
         case EnemyType::Glass:
-            if (m_glassTexture) enemy->SetTexture(m_glassTexture.Get());
+            enemy->SetSprite(SpriteId::EnemyGlass);
             break;
         case EnemyType::Fairy:
-            if (m_fairyTexture) enemy->SetTexture(m_fairyTexture.Get());
+            enemy->SetSprite(SpriteId::EnemyFairy);
             break;
         case EnemyType::Boss:
-            if (m_bossTexture) enemy->SetTexture(m_bossTexture.Get());
+            enemy->SetSprite(SpriteId::Boss);
             // 1枚絵を使用（アニメーションなし）
             break;
         default:
@@ -218,6 +178,14 @@ void EnemyManager::ClearNonBossEnemies() {
     );
 }
 
+void EnemyManager::RebuildEnemyIndex(int areaWidth, int areaHeight) {
+    m_enemyIndex.Begin(areaWidth, areaHeight);
+    for (const auto& enemy : m_enemies) {
+        m_enemyIndex.Add(enemy->GetId(), enemy->GetPosition(), enemy->IsActive());
+    }
+    m_enemyIndex.Build();
+}
+
 void EnemyManager::DamageBoss(float damage) {
     for (auto& enemy : m_enemies) {
         if (enemy->IsActive() && enemy->GetType() == EnemyType::Boss) {
@@ -5,6 +5,7 @@
 #include <d3d11.h>
 #include <wrl/client.h>
 #include "Enemy.h"
+#include "EnemyIndex.h"
 
 using Microsoft::WRL::ComPtr;
 
@@ -35,6 +36,10 @@ public:
     void ClearBossWaveStartFlag() { m_bossWaveJustStarted = false; }
     void ClearNonBossEnemies();  // 雑魚敵を全滅させる
     void DamageBoss(float damage);  // デバッグ用ボスダメージ
+    
+    // ホーミング用空間インデックス（毎フレーム再構築、BulletManagerが参照で読む）
+    void RebuildEnemyIndex(int areaWidth, int areaHeight);
+    const EnemyIndex& GetEnemyIndex() const { return m_enemyIndex; }
 
 private:
     std::vector<std::unique_ptr<Enemy>> m_enemies;
@@ -43,12 +48,6 @@ private:
     float m_waveTimer;
     int m_currentWave;
     bool m_bossWaveJustStarted;  // ボスウェーブ開始フラグ
-    
-    // Enemy textures
-    ComPtr<ID3D11ShaderResourceView> m_barrelTexture;
-    ComPtr<ID3D11ShaderResourceView> m_bottleTexture;
-    ComPtr<ID3D11ShaderResourceView> m_glassTexture;
-    ComPtr<ID3D11ShaderResourceView> m_fairyTexture;
-    ComPtr<ID3D11ShaderResourceView> m_bossTexture;
-    ComPtr<ID3D11ShaderResourceView> m_bossFrames[3];  // ボスアニメーション用3フレーム
+    uint32_t m_nextEnemyId = 1;  // 敵の通し番号
+    EnemyIndex m_enemyIndex;
 };
@@ -0,0 +1,225 @@
+﻿#include "FileWatcher.h"
+#include <algorithm>
+#include <system_error>
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__linux__)
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace {
+
+#if defined(_WIN32)
+
+// ReadDirectoryChangesW を重複I/Oで投げておき、Poll のたびに完了だけ確かめる
+class Win32Backend : public FileWatcher::Backend {
+public:
+    ~Win32Backend() override {
+        if (m_directory != INVALID_HANDLE_VALUE) {
+            CancelIoEx(m_directory, &m_overlapped);
+            DWORD bytes = 0;
+            GetOverlappedResult(m_directory, &m_overlapped, &bytes, TRUE);
+            CloseHandle(m_directory);
+        }
+        if (m_overlapped.hEvent) CloseHandle(m_overlapped.hEvent);
+    }
+
+    bool Start(const fs::path& root) override {
+        m_directory = CreateFileW(root.c_str(), FILE_LIST_DIRECTORY,
+                                  FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+                                  FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+        if (m_directory == INVALID_HANDLE_VALUE) return false;
+        m_overlapped.hEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+        return m_overlapped.hEvent && Issue();
+    }
+
+    void Read(std::vector<fs::path>* changed) override {
+        DWORD bytes = 0;
+        if (!GetOverlappedResult(m_directory, &m_overlapped, &bytes, FALSE)) {
+            if (GetLastError() == ERROR_IO_INCOMPLETE) return;
+        }
+        // bytes == 0 はバッファ溢れ（取りこぼした分は次の保存で拾う）
+        const BYTE* cursor = reinterpret_cast<const BYTE*>(m_buffer);
+        while (bytes > 0) {
+            const auto* info = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(cursor);
+            if (info->Action == FILE_ACTION_ADDED || info->Action == FILE_ACTION_MODIFIED ||
+                info->Action == FILE_ACTION_RENAMED_NEW_NAME) {
+                changed->emplace_back(std::wstring(info->FileName, info->FileNameLength / sizeof(WCHAR)));
+            }
+            if (info->NextEntryOffset == 0) break;
+            cursor += info->NextEntryOffset;
+        }
+        Issue();
+    }
+
+private:
+    bool Issue() {
+        ResetEvent(m_overlapped.hEvent);
+        return ReadDirectoryChangesW(m_directory, m_buffer, sizeof(m_buffer), TRUE,
+                                     FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME,
+                                     nullptr, &m_overlapped, nullptr) != FALSE;
+    }
+
+    HANDLE m_directory = INVALID_HANDLE_VALUE;
+    OVERLAPPED m_overlapped = {};
+    DWORD m_buffer[16 * 1024];  // DWORD境界が必要
+};
+
+#elif defined(__linux__)
+
+// inotify はフォルダ単位なので、サブフォルダごとに監視を張る（後から作られたフォルダも追加）
+class InotifyBackend : public FileWatcher::Backend {
+public:
+    ~InotifyBackend() override {
+        if (m_fd >= 0) close(m_fd);
+    }
+
+    bool Start(const fs::path& root) override {
+        m_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (m_fd < 0) return false;
+        m_root = root;
+        if (!AddWatch(fs::path())) return false;
+
+        std::error_code ec;
+        for (fs::recursive_directory_iterator it(root, ec), end; !ec && it != end; it.increment(ec)) {
+            if (it->is_directory(ec)) AddWatch(fs::relative(it->path(), root, ec));
+        }
+        return true;
+    }
+
+    void Read(std::vector<fs::path>* changed) override {
+        alignas(inotify_event) char buffer[16 * 1024];
+        for (;;) {
+            ssize_t length = read(m_fd, buffer, sizeof(buffer));
+            if (length <= 0) break;  // EAGAIN: 未読なし
+
+            for (ssize_t offset = 0; offset < length;) {
+                const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+                offset += sizeof(inotify_event) + event->len;
+
+                auto dir = m_directories.find(event->wd);
+                if (dir == m_directories.end() || event->len == 0) continue;
+                fs::path path = dir->second / event->name;
+                if (event->mask & IN_ISDIR) {
+                    if (event->mask & (IN_CREATE | IN_MOVED_TO)) AddWatch(path);
+                } else if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) {
+                    changed->push_back(path);
+                }
+            }
+        }
+    }
+
+private:
+    bool AddWatch(const fs::path& relative) {
+        int wd = inotify_add_watch(m_fd, (m_root / relative).c_str(),
+                                   IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_ONLYDIR);
+        if (wd < 0) return false;
+        m_directories[wd] = relative;
+        return true;
+    }
+
+    int m_fd = -1;
+    fs::path m_root;
+    std::unordered_map<int, fs::path> m_directories;  // 監視ID → root からの相対パス
+};
+
+#endif
+
+// 通知APIの無い環境向け: Poll のたびに更新日時を比べる（内容が変わっても更新日時が同じなら拾えない）
+class PollingBackend : public FileWatcher::Backend {
+public:
+    bool Start(const fs::path& root) override {
+        m_root = root;
+        std::vector<fs::path> ignored;
+        Scan(&ignored);
+        return fs::is_directory(root);
+    }
+
+    void Read(std::vector<fs::path>* changed) override { Scan(changed); }
+
+private:
+    void Scan(std::vector<fs::path>* changed) {
+        std::error_code ec;
+        for (fs::recursive_directory_iterator it(m_root, ec), end; !ec && it != end; it.increment(ec)) {
+            if (!it->is_regular_file(ec)) continue;
+            fs::file_time_type time = it->last_write_time(ec);
+            std::string key = it->path().generic_string();
+            auto found = m_times.find(key);
+            if (found == m_times.end() || found->second != time) {
+                if (found != m_times.end() || m_scanned) changed->push_back(fs::relative(it->path(), m_root, ec));
+                m_times[key] = time;
+            }
+        }
+        m_scanned = true;
+    }
+
+    fs::path m_root;
+    std::unordered_map<std::string, fs::file_time_type> m_times;
+    bool m_scanned = false;
+};
+
+std::unique_ptr<FileWatcher::Backend> CreateBackend() {
+#if defined(_WIN32)
+    return std::make_unique<Win32Backend>();
+#elif defined(__linux__)
+    return std::make_unique<InotifyBackend>();
+#else
+    return std::make_unique<PollingBackend>();
+#endif
+}
+
+} // namespace
+
+FileWatcher::FileWatcher(std::chrono::milliseconds settleTime, ClockFn clock)
+    : m_settleTime(settleTime)
+    , m_clock(clock ? std::move(clock) : ClockFn(&Clock::now))
+{
+}
+
+FileWatcher::~FileWatcher() = default;
+
+std::unique_ptr<FileWatcher::Backend> FileWatcher::CreatePollingBackend() {
+    return std::make_unique<PollingBackend>();
+}
+
+bool FileWatcher::Watch(const fs::path& root) {
+    return Watch(root, CreateBackend());
+}
+
+bool FileWatcher::Watch(const fs::path& root, std::unique_ptr<Backend> backend) {
+    m_backend.reset();
+    m_pending.clear();
+
+    if (!backend || !backend->Start(root)) return false;
+    m_backend = std::move(backend);
+    m_root = root;
+    return true;
+}
+
+std::vector<fs::path> FileWatcher::Poll() {
+    std::vector<fs::path> settled;
+    if (!m_backend) return settled;
+
+    m_changed.clear();
+    m_backend->Read(&m_changed);
+    Clock::time_point now = m_clock();
+    for (const auto& path : m_changed) {
+        m_pending[path.lexically_normal().native()] = now;
+    }
+
+    for (auto it = m_pending.begin(); it != m_pending.end();) {
+        if (now - it->second >= m_settleTime) {
+            settled.emplace_back(it->first);
+            it = m_pending.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    std::sort(settled.begin(), settled.end());
+    return settled;
+}
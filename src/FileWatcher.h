@@ -0,0 +1,52 @@
+﻿#pragma once
+
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// フォルダ以下の変更監視（アセットのホットリロード用）
+// 実装はOSごと: Windows は ReadDirectoryChangesW、Linux は inotify、それ以外は更新日時の走査
+// Poll は待たずに返る。保存直後は書き込みが続くことがあるので、settleTime 静かになってから報告する
+class FileWatcher {
+public:
+    // OSごとの監視処理
+    class Backend {
+    public:
+        virtual ~Backend() = default;
+        virtual bool Start(const std::filesystem::path& root) = 0;
+        // 前回から変更・作成・リネームされたファイル（root からの相対パス、重複あり）
+        virtual void Read(std::vector<std::filesystem::path>* changed) = 0;
+    };
+
+    using Clock = std::chrono::steady_clock;
+    using ClockFn = std::function<Clock::time_point()>;
+
+    // clock は settleTime を測る時計（テストで差し替える、省略時は steady_clock）
+    explicit FileWatcher(std::chrono::milliseconds settleTime = std::chrono::milliseconds(100), ClockFn clock = nullptr);
+    ~FileWatcher();
+
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    bool Watch(const std::filesystem::path& root);  // サブフォルダも含む
+    bool Watch(const std::filesystem::path& root, std::unique_ptr<Backend> backend);  // 監視処理を指定する
+    // 更新日時の走査（どのOSでも使える）
+    static std::unique_ptr<Backend> CreatePollingBackend();
+    bool IsWatching() const { return m_backend != nullptr; }
+    const std::filesystem::path& GetRoot() const { return m_root; }
+
+    // 書き込みが落ち着いたファイルを root からの相対パスで返す（名前順、1回につき1度だけ）
+    std::vector<std::filesystem::path> Poll();
+
+private:
+    std::unique_ptr<Backend> m_backend;
+    std::filesystem::path m_root;
+    std::chrono::milliseconds m_settleTime;
+    ClockFn m_clock;
+    std::unordered_map<std::filesystem::path::string_type, Clock::time_point> m_pending;  // 正規化したパス → 最後の変更時刻
+    std::vector<std::filesystem::path> m_changed;                  // Read の受け取り用（使い回し）
+};
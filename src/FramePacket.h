@@ -0,0 +1,54 @@
+﻿#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "RenderQueue.h"
+#include "TextQueue.h"
+
+// パスの描画先
+enum class PassTarget : uint8_t {
+    BackBuffer,
+    SidebarLayer  // 合成済みサイドバーのオフスクリーンレイヤー（clip の範囲だけ描き直す）
+};
+
+struct PassClip {
+    int left, top, right, bottom;  // 画面座標
+};
+
+// 1パス = D3Dの描画コマンド → その上に文字
+struct RenderPass {
+    PassTarget target = PassTarget::BackBuffer;
+    PassClip clip = {};
+    RenderQueue queue;
+    TextQueue text;
+};
+
+// メインスレッドが記録し、描画スレッドが提出する1フレーム分（パスは記録順に描く）
+// パスは作り直さずに使い回す（アドレスも変わらないので記録中のキューを指したまま次のパスを足せる）
+class FramePacket {
+public:
+    FramePacket() : m_passCount(0) {}
+
+    void Reset() { m_passCount = 0; }
+
+    RenderPass& AddPass(PassTarget target = PassTarget::BackBuffer, PassClip clip = {}) {
+        if (m_passCount == m_passes.size()) {
+            m_passes.push_back(std::make_unique<RenderPass>());
+        }
+        RenderPass& pass = *m_passes[m_passCount++];
+        pass.target = target;
+        pass.clip = clip;
+        pass.queue.Reset();
+        pass.text.Reset();
+        return pass;
+    }
+
+    size_t GetPassCount() const { return m_passCount; }
+    RenderPass& GetPass(size_t i) { return *m_passes[i]; }
+    const RenderPass& GetPass(size_t i) const { return *m_passes[i]; }
+
+private:
+    std::vector<std::unique_ptr<RenderPass>> m_passes;
+    size_t m_passCount;
+};
@@ -1,4 +1,5 @@
 ﻿#include "Game.h"
+#include "AssetManifest.h"
 #include <cmath>
 #include <fstream>
 
@@ -8,12 +9,30 @@ constexpr int PLAY_AREA_WIDTH = 1200;   // 横幅倍増！
 constexpr int PLAY_AREA_HEIGHT = 1080;
 constexpr int SIDEBAR_WIDTH = 720;      // 残りをUI用に
 
+static std::wstring GetExeDir() {
+    wchar_t exePath[MAX_PATH];
+    GetModuleFileNameW(nullptr, exePath, MAX_PATH);
+    std::wstring path(exePath);
+    return path.substr(0, path.find_last_of(L"\\/"));
+}
+
+// AssetPacker がビルドディレクトリに書き出すパック（実行ファイルの1つ上）
+static std::wstring GetAssetPackPath() {
+    return GetExeDir() + L"\\..\\assets.pak";
+}
+
+// 元のアセット（末尾に区切りあり）
+static std::wstring GetAssetDir() {
+    return GetExeDir() + L"\\..\\..\\assets\\";
+}
+
 Game::Game()
     : m_hWnd(nullptr)
     , m_width(0)
     , m_height(0)
     , m_isRunning(false)
     , m_deltaTime(0.0f)
+    , m_frameCost(0.0f)
     , m_frameCount(0)
     , m_fpsTimer(0.0f)
     , m_currentFPS(0.0f)
@@ -55,6 +74,19 @@ bool Game::Initialize(HWND hWnd, int width, int height) {
     QueryPerformanceFrequency(&m_frequency);
     QueryPerformanceCounter(&m_lastTime);
 
+    m_jobs = std::make_unique<JobSystem>();
+    m_renderThread = std::make_unique<RenderThread<FramePacket>>([this](FramePacket& frame) { SubmitFrame(frame); });
+    // 画像・音声のデコードはワーカーで（WIC/Media FoundationのためにCOMを初期化しておく）
+    m_assets = std::make_unique<AssetLoader>(m_jobs.get(), []() {
+        CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+    });
+
+    // ビルド時に作ったパックがあればデコードせずに使う（無ければ各画像・音声ファイルから読む）
+    m_assetPack = std::make_unique<AssetPack::Reader>();
+    if (!m_assetPack->Open(GetAssetPackPath())) {
+        m_assetPack.reset();
+    }
+
     m_graphics = std::make_unique<Graphics>();
     if (!m_graphics->Initialize(hWnd, width, height)) {
         return false;
@@ -66,7 +98,7 @@ bool Game::Initialize(HWND hWnd, int width, int height) {
     }
 
     m_background = std::make_unique<Background3D>();
-    m_background->Initialize(300);
+    m_background->Initialize(m_graphics.get(), 300);
 
     m_bulletManager = std::make_unique<BulletManager>();
     m_bulletManager->Initialize(m_graphics.get());
@@ -77,6 +109,7 @@ bool Game::Initialize(HWND hWnd, int width, int height) {
 
     m_enemyManager = std::make_unique<EnemyManager>();
     m_enemyManager->Initialize(m_graphics.get(), m_bulletManager.get());
+    m_bulletManager->SetEnemyIndex(&m_enemyManager->GetEnemyIndex());
 
     m_particles = std::make_unique<ParticleSystem>();
     m_particles->Initialize(500);
@@ -85,10 +118,12 @@ bool Game::Initialize(HWND hWnd, int width, int height) {
     m_items->Initialize(m_graphics.get());
 
     m_sound = std::make_unique<AudioManager>();
-    m_sound->Initialize();
+    m_sound->Initialize(m_assets.get(), m_assetPack.get(), m_audioCapturePath);
 
+    // BGMはストリームスレッドでデコードしてミキサーに流す（WAV書き出し中はフレームに合わせて同じスレッドで）
     m_bgm = std::make_unique<BGMPlayer>();
-    m_bgm->Initialize();
+    m_bgm->Initialize(m_sound->GetMixer(), GetAssetDir() + L"sounds\\", AudioManager::OpenStreamDecoder,
+                      !m_sound->IsCapturing());
     m_bgm->SetVolume(m_bgmVolume * 10);  // 50%で初期化
     m_bgm->PlayTitleBGM();  // タイトル画面BGM
 
@@ -96,30 +131,69 @@ bool Game::Initialize(HWND hWnd, int width, int height) {
     m_text = std::make_unique<TextRenderer>();
     m_text->Initialize(m_graphics->GetSwapChain());
 
-    // Initialize texture loader and load title screen
-    m_textureLoader = std::make_unique<TextureLoader>();
-    m_textureLoader->Initialize(m_graphics->GetDevice());
-    
-    // Get executable path for textures
-    wchar_t exePath[MAX_PATH];
-    GetModuleFileNameW(nullptr, exePath, MAX_PATH);
-    std::wstring path(exePath);
-    size_t lastSlash = path.find_last_of(L"\\/");
-    std::wstring texturePath = path.substr(0, lastSlash) + L"\\..\\..\\assets\\textures\\title_screen.jpg";
-    
-    ID3D11ShaderResourceView* titleSRV = nullptr;
-    if (m_textureLoader->LoadTexture(texturePath, &titleSRV)) {
-        m_titleTexture.Attach(titleSRV);
+    // サイドバーはオフスクリーンに合成しておき、表示値が変わったときだけ描き直す
+    // （作れなければ従来どおり毎フレームその場で描く）
+    if (m_graphics->CreateOffscreenLayer(PLAY_AREA_WIDTH, 0, SIDEBAR_WIDTH, PLAY_AREA_HEIGHT, &m_sidebarLayer)) {
+        ComPtr<IDXGISurface> surface;
+        m_sidebarText = std::make_unique<TextRenderer>();
+        if (SUCCEEDED(m_sidebarLayer.texture->QueryInterface(IID_PPV_ARGS(&surface))) &&
+            m_sidebarText->Initialize(surface.Get())) {
+            m_sidebarText->SetOrigin(static_cast<float>(PLAY_AREA_WIDTH), 0.0f);
+            // 各項目の縦範囲（文字と図形、残機・ボムは光彩の外周まで）
+            m_sidebarCache.Reset(PLAY_AREA_HEIGHT);
+            m_sidebarCache.SetBand(SidebarWidget::HiScore, 50, 80);
+            m_sidebarCache.SetBand(SidebarWidget::Score, 90, 120);
+            m_sidebarCache.SetBand(SidebarWidget::Player, 130, 160);
+            m_sidebarCache.SetBand(SidebarWidget::Lives, 129, 211);
+            m_sidebarCache.SetBand(SidebarWidget::Bombs, 176, 244);
+            m_sidebarCache.SetBand(SidebarWidget::Power, 250, 310);
+            m_sidebarCache.SetBand(SidebarWidget::Special, 330, 355);
+            m_sidebarCache.SetBand(SidebarWidget::Graze, 290, 390);
+            m_sidebarCache.SetBand(SidebarWidget::Fps, 410, 505);
+        } else {
+            m_sidebarText.reset();
+            m_sidebarLayer = OffscreenLayer();
+        }
+    }
+
+    // Initialize texture registry and load title screen
+    // タイトル画像だけはすぐ表示したいので同期で読み、残りは裏で読む
+    m_textures = std::make_unique<TextureRegistry>();
+    m_textures->Initialize(m_graphics->GetDevice());
+    m_textures->SetPack(m_assetPack.get());
+    m_titleTexture = m_textures->Acquire(AssetManifest::TITLE_TEXTURE);
+
+    // ゲーム中のスプライトは1枚のアトラスにまとめる
+    m_spriteAtlas = std::make_unique<TextureAtlas>();
+    m_spriteAtlas->BuildAsync(m_textures->GetLoader(), m_textures->GetTextureDir(), *m_assets, m_assetPack.get());
+    m_graphics->SetSpriteAtlas(m_spriteAtlas.get());
+
+    // 得点の数字は起動時にラスタライズしたグリフで描く（失敗したら数字なし）
+    m_glyphAtlas = std::make_unique<GlyphAtlas>();
+    m_glyphAtlas->Build(m_textures->GetLoader(), L"Meiryo UI", 18.0f);
+    m_graphics->SetGlyphAtlas(m_glyphAtlas.get());
+
+    m_spellCardNames.Load(GetAssetDir() + L"text\\spellcards_jp.txt");
+
+    // 保存されたアセットだけをその場で読み直す（フォルダが無ければ何もしない）
+    m_assetWatcher = std::make_unique<FileWatcher>();
+    if (!m_assetWatcher->Watch(GetAssetDir())) {
+        m_assetWatcher.reset();
     }
 
     m_isRunning = true;
     LoadHiScore();
-    LoadCutinTextures();  // カットインテクスチャ読み込み
-    LoadPortraits();      // ポートレートテクスチャ読み込み
+    LoadCutinTextures();  // カットインテクスチャ読み込み（非同期）
+    LoadPortraits();      // ポートレートテクスチャ読み込み（非同期）
     return true;
 }
 
 void Game::Shutdown() {
+    // 提出中のフレームを待ってからデバイスを片付ける
+    if (m_renderThread) m_renderThread.reset();
+    if (m_assetWatcher) m_assetWatcher.reset();
+    // 読み込み中のデコードを待つ（書き込み先のテクスチャ置き場・音声より先に止める）
+    if (m_assets) m_assets.reset();
     SaveHiScore();
     if (m_items) m_items.reset();
     if (m_particles) m_particles.reset();
@@ -128,14 +202,42 @@ void Game::Shutdown() {
     if (m_player) m_player.reset();
     if (m_bulletManager) m_bulletManager.reset();
     if (m_input) m_input.reset();
+    if (m_graphics) m_graphics->SetSpriteAtlas(nullptr);
+    if (m_spriteAtlas) m_spriteAtlas.reset();
+    if (m_graphics) m_graphics->SetGlyphAtlas(nullptr);
+    if (m_glyphAtlas) m_glyphAtlas.reset();
+    if (m_textures) m_textures.reset();
     if (m_graphics) {
         m_graphics->Shutdown();
         m_graphics.reset();
     }
+    if (m_jobs) m_jobs.reset();
     m_isRunning = false;
 }
 
 void Game::Update() {
+    // 前フレームの処理時間でパーティクルの発生量を調整
+    m_particles->SetFrameCost(m_frameCost);
+    QueryPerformanceCounter(&m_workStart);
+
+    // 裏で読み終わったアセットを登録（GPU転送はメインスレッドで）
+    // 差し替えで古いテクスチャが解放されるので、提出中のフレームが使い終わるのを待ってから
+    if (!m_assets->IsIdle()) m_renderThread->WaitIdle();
+    m_assets->Pump();
+    UpdateHotReload();
+
+    UpdateFrame();
+    // 効果音は同じフレームの同じ音を1回にまとめて鳴らす
+    if (m_bgm) m_bgm->EndFrame();
+    if (m_sound) m_sound->EndFrame();
+    
+    // このフレームの結果を描画用に公開（Renderは生の弾・パーティクルを読まない）
+    m_bulletManager->PublishSnapshot();
+    m_particles->PublishSnapshot();
+    m_frameCost = GetElapsedSeconds(m_workStart);
+}
+
+void Game::UpdateFrame() {
     UpdateDeltaTime();
     UpdateFade();  // フェード処理
     m_input->Update();
@@ -213,7 +315,6 @@ void Game::Update() {
         if (m_bossSpawnDelay >= 2.0f) {  // 2秒後にボス登場
             m_waitingForBoss = false;
             m_bossMode = true;
-            m_bgm->Stop();
             m_bgm->PlayBossBGM();
             
             // ボスをスポーン！
@@ -232,18 +333,17 @@ void Game::Update() {
         m_bossMode = false;  // ボスモード終了
     }
     
-    // ホーミング用に敵の位置をBulletManagerに渡す
-    std::vector<DirectX::XMFLOAT2> enemyPositions;
-    for (const auto& enemy : m_enemyManager->GetEnemies()) {
-        if (enemy->IsActive()) {
-            enemyPositions.push_back(enemy->GetPosition());
-        }
-    }
-    m_bulletManager->SetEnemyPositions(enemyPositions);
+    // ホーミング用の敵インデックスを更新（BulletManagerは参照で読む）
+    m_enemyManager->RebuildEnemyIndex(PLAY_AREA_WIDTH, PLAY_AREA_HEIGHT);
     
-    m_bulletManager->Update(m_deltaTime, PLAY_AREA_WIDTH, PLAY_AREA_HEIGHT);
-    m_particles->Update(m_deltaTime);
-    m_items->Update(m_deltaTime, m_player->GetPosition(), PLAY_AREA_WIDTH, PLAY_AREA_HEIGHT);
+    // 弾・パーティクル・アイテムは互いに触れないので並行に更新
+    // （弾とパーティクルは中でさらにチャンク分割、背景と敵はrand()の順序を保つためメインで実行済み）
+    DirectX::XMFLOAT2 playerPos = m_player->GetPosition();
+    m_jobs->Run({
+        [&]() { m_bulletManager->Update(m_deltaTime, PLAY_AREA_WIDTH, PLAY_AREA_HEIGHT, m_jobs.get()); },
+        [&]() { m_particles->Update(m_deltaTime, m_jobs.get()); },
+        [&]() { m_items->Update(m_deltaTime, playerPos, PLAY_AREA_WIDTH, PLAY_AREA_HEIGHT); },
+    });
     
     // ボス周りの禍々しいパーティクル（人魂風）
     if (m_bossMode) {
@@ -263,7 +363,7 @@ void Game::Update() {
                     float r = 0.6f + static_cast<float>(rand()) / RAND_MAX * 0.4f;
                     float g = 0.0f + static_cast<float>(rand()) / RAND_MAX * 0.2f;
                     float b = 0.4f + static_cast<float>(rand()) / RAND_MAX * 0.4f;
-                    m_particles->SpawnTrail(px, py, DirectX::XMFLOAT4(r, g, b, 0.8f));
+                    m_particles->Emit(ParticleEmitters::TRAIL, px, py, DirectX::XMFLOAT4(r, g, b, 0.8f));
                 }
             }
         }
@@ -327,7 +427,7 @@ void Game::Update() {
             }
             
             // Spawn explosion particles
-            m_particles->SpawnExplosion(m_player->GetPosition().x, m_player->GetPosition().y, 
+            m_particles->Emit(ParticleEmitters::EXPLOSION, m_player->GetPosition().x, m_player->GetPosition().y, 
                 DirectX::XMFLOAT4(1.0f, 0.8f, 0.3f, 1.0f));
         }
         bombPressed = true;
@@ -384,7 +484,7 @@ void Game::CheckCollisions() {
                 bullet.isActive = false;
                 
                 // Hit effect and sound
-                m_particles->SpawnHitEffect(bullet.position.x, bullet.position.y,
+                m_particles->Emit(ParticleEmitters::HIT, bullet.position.x, bullet.position.y,
                     DirectX::XMFLOAT4(1.0f, 0.9f, 0.5f, 1.0f));
                 m_sound->PlayEnemyHit();
                 
@@ -399,7 +499,7 @@ void Game::CheckCollisions() {
                 
                 // If enemy died, spawn explosion and items
                 if (!enemy->IsActive()) {
-                    m_particles->SpawnExplosion(
+                    m_particles->Emit(ParticleEmitters::EXPLOSION,
                         enemy->GetPosition().x, 
                         enemy->GetPosition().y,
                         DirectX::XMFLOAT4(1.0f, 0.5f, 0.3f, 1.0f),
@@ -418,124 +518,164 @@ void Game::CheckCollisions() {
 
 void Game::Render() {
     if (!m_graphics) return;
-
-    m_graphics->BeginFrame();
-
-    // Render title screen
-    if (m_gameState == GameState::Title) {
-        RenderTitle();
-        m_graphics->EndFrame();
-        return;
-    }
-    
-    // Render game over screen
-    if (m_gameState == GameState::GameOver) {
-        RenderGameOver();
-        m_graphics->EndFrame();
-        return;
-    }
-    
-    // Render stage clear screen
-    if (m_gameState == GameState::StageClear) {
-        RenderStageClear();
+    QueryPerformanceCounter(&m_workStart);
+
+    // メニュー画面はメインスレッドで直接描く（提出中のフレームが終わってからコンテキストに触る）
+    if (m_gameState == GameState::Title || m_gameState == GameState::GameOver ||
+        m_gameState == GameState::StageClear || m_gameState == GameState::Paused) {
+        m_renderThread->WaitIdle();
+        m_graphics->BeginFrame();
+        if (m_gameState == GameState::Title) {
+            RenderTitle();
+        } else if (m_gameState == GameState::GameOver) {
+            RenderGameOver();
+        } else if (m_gameState == GameState::StageClear) {
+            RenderStageClear();
+        } else {
+            RenderSettingsMenu();
+        }
+        if (m_text) m_text->EndFrame();
         m_graphics->EndFrame();
+        m_frameCost += GetElapsedSeconds(m_workStart);
         return;
     }
-    
+
     // VictoryDialogueはゲーム画面上にオーバーレイ（後で描画）
-    
-    // Render paused/settings menu
-    if (m_gameState == GameState::Paused) {
-        RenderSettingsMenu();
-        m_graphics->EndFrame();
-        return;
-    }
+
+    // ゲーム画面はパスごとに描画コマンドと文字を記録するだけ（公開済みのスナップショットから）
+    // 並べ替え・提出・Present は描画スレッドで、その間にメインは次のフレームの Update へ進む
+    FramePacket& frame = m_renderThread->BeginFrame();
+    frame.Reset();
+
+    // サイドバーは値が変わったフレームだけレイヤーに描き直す
+    ComposeSidebar(frame);
+
+    RenderPass& scene = frame.AddPass();
+    m_graphics->BeginQueue(&scene.queue);
 
     // Play area background
+    m_graphics->SetRenderLayer(RenderLayer::Backdrop);
     m_graphics->DrawSprite(0, 0, PLAY_AREA_WIDTH, PLAY_AREA_HEIGHT,
         DirectX::XMFLOAT4(0.02f, 0.01f, 0.05f, 1.0f));
 
-    m_background->Render(m_graphics.get());
-
     // Border
     m_graphics->DrawSprite(PLAY_AREA_WIDTH - 2, 0, 4, PLAY_AREA_HEIGHT,
         DirectX::XMFLOAT4(0.5f, 0.3f, 0.6f, 1.0f));
 
+    m_graphics->SetRenderLayer(RenderLayer::Background);
+    m_background->Render(m_graphics.get());
+
     // Game objects
+    m_graphics->SetRenderLayer(RenderLayer::Enemies);
     m_enemyManager->Render(m_graphics.get());
+    m_graphics->SetRenderLayer(RenderLayer::Bullets);
     m_bulletManager->Render(m_graphics.get());
+    m_graphics->SetRenderLayer(RenderLayer::Items);
     m_items->Render(m_graphics.get());
+    m_graphics->SetRenderLayer(RenderLayer::Player);
     m_player->Render(m_graphics.get());
+    m_graphics->SetRenderLayer(RenderLayer::Particles);
     m_particles->Render(m_graphics.get());
+    m_graphics->SetRenderLayer(RenderLayer::Popups);
+    m_particles->RenderScoreText(m_graphics.get());
 
+    m_graphics->SetRenderLayer(RenderLayer::UI);
     RenderUI();
 
-    // Render settings menu if paused
-    if (m_isPaused) {
-        RenderSettingsMenu();
+    m_graphics->EndQueue();
+
+    // D2Dの文字（ゲーム画面のD3Dの後に描く）
+    // サイドバーの文字（レイヤーに合成済みなら描かない）
+    float textX = static_cast<float>(PLAY_AREA_WIDTH + 20);
+    if (!m_sidebarLayer.IsReady()) {
+        RenderSidebarText(scene.text);
     }
 
-    // Flush D3D before D2D text rendering
-    m_graphics->GetContext()->Flush();
+    // 弾数（毎フレーム変わるのでレイヤーに入れず直接描く）（予算超過でゴールド、上限で捨てた弾があれば併記）
+    const BulletPoolStats& bulletStats = m_bulletManager->GetStats();
+    wchar_t bulletBuffer[64];
+    if (bulletStats.dropped > 0) {
+        swprintf_s(bulletBuffer, L"弾: %zu 破棄: %llu", bulletStats.active,
+            static_cast<unsigned long long>(bulletStats.dropped));
+    } else {
+        swprintf_s(bulletBuffer, L"弾: %zu", bulletStats.active);
+    }
+    bool overBudget = m_bulletManager->GetBullets().IsOverBudget();
+    scene.text.DrawText(bulletBuffer, textX, 440, 200, 30, 1, overBudget ? 1 : 0);
 
-    // D2D text rendering (after D3D, before EndFrame)
-    if (m_text) {
-        m_text->BeginDraw();
-        
-        // UI Text labels (日本語化)
-        float textX = static_cast<float>(PLAY_AREA_WIDTH + 20);
-        m_text->DrawTextWithValue(L"ハイスコア", m_hiScore, textX, 50);
-        m_text->DrawTextWithValue(L"スコア", m_score, textX, 90);
-        
-        // プレイヤー名表示
-        const wchar_t* playerName = (m_playerCharacter == 0) ? L"★ ひなひな" : L"★ かい";
-        m_text->DrawText(playerName, textX, 130, 200, 30, 1, 1);  // ゴールド
-        
-        m_text->DrawTextWithValue(L"残機", m_lives, textX, 170);
-        m_text->DrawTextWithValue(L"ボム", m_bombs, textX, 210);
-        m_text->DrawTextWithValue(L"パワー", m_power, textX, 250);
-        m_text->DrawTextWithValue(L"バレル", m_graze, textX, 290);
-        
-        // FPS display
-        wchar_t fpsBuffer[32];
-        swprintf_s(fpsBuffer, L"FPS: %.1f", m_currentFPS);
-        m_text->DrawText(fpsBuffer, textX, 410, 200, 30, 1, m_currentFPS >= 60 ? 0 : 1);
-        
-        // ボススペルカード名（プレイエリア上部に表示）
-        if (!m_currentBossSpellName.empty()) {
-            m_text->DrawText(m_currentBossSpellName.c_str(), 20.0f, 18.0f, 
-                static_cast<float>(PLAY_AREA_WIDTH - 100), 30, 1, 1);  // ゴールド文字
-        }
-        
-        // Build info
-        m_text->DrawText(L"LoC: 4231", textX, static_cast<float>(PLAY_AREA_HEIGHT - 60), 200, 20, 0, 2);
-        m_text->DrawText(L"ひなた vs ひなひな", textX, static_cast<float>(PLAY_AREA_HEIGHT - 35), 200, 20, 0, 1);
-        
-        m_text->EndDraw();
+    // ボススペルカード名（プレイエリア上部に表示）
+    if (!m_currentBossSpellName.empty()) {
+        scene.text.DrawText(m_currentBossSpellName, 20.0f, 18.0f,
+            static_cast<float>(PLAY_AREA_WIDTH - 100), 30, 1, 1);  // ゴールド文字
     }
-    
-    // カットイン描画（UIの上に表示）
+
+    // カットイン・ボス会話（UIと文字の上に表示）
+    RenderPass& overlay = frame.AddPass();
+    m_graphics->BeginQueue(&overlay.queue);
     RenderCutin();
-    
-    // ボス会話描画
-    RenderBossDialogue();
-    
+    RenderBossDialogue(overlay.text);
+    m_graphics->EndQueue();
+
     // 勝利セリフオーバーレイ（ゲーム画面の上に表示）
     if (m_gameState == GameState::VictoryDialogue) {
-        RenderVictoryDialogue();
+        RenderPass& victory = frame.AddPass();
+        m_graphics->BeginQueue(&victory.queue);
+        RenderVictoryDialogue(victory.text);
+        m_graphics->EndQueue();
     }
 
     // フェード効果を最後に描画
+    RenderPass& fade = frame.AddPass();
+    m_graphics->BeginQueue(&fade.queue);
     RenderFade();
+    m_graphics->EndQueue();
+
+    PresentFrame();
+}
 
+void Game::PresentFrame() {
+    // 前に渡したフレームが受け取られるまでは待つ（描画スレッドが遅れても溜め込まない）
+    m_renderThread->Publish();
+    m_frameCost += GetElapsedSeconds(m_workStart);
+}
+
+// 記録済みのフレームをパスの順に提出する（描画スレッド）
+void Game::SubmitFrame(FramePacket& frame) {
+    m_graphics->BeginFrame();
+    for (size_t i = 0; i < frame.GetPassCount(); i++) {
+        RenderPass& pass = frame.GetPass(i);
+        if (pass.target == PassTarget::SidebarLayer) {
+            D3D11_RECT clip = { pass.clip.left, pass.clip.top, pass.clip.right, pass.clip.bottom };
+            m_graphics->BeginOffscreen(m_sidebarLayer, clip);
+            m_graphics->Submit(pass.queue);
+            m_graphics->EndOffscreen();
+            if (!pass.text.empty()) {
+                m_graphics->GetContext()->Flush();
+                m_sidebarText->BeginDraw();
+                m_sidebarText->PushClip(static_cast<float>(clip.left), static_cast<float>(clip.top),
+                                        static_cast<float>(clip.right), static_cast<float>(clip.bottom));
+                m_sidebarText->Draw(pass.text);
+                m_sidebarText->PopClip();
+                m_sidebarText->EndDraw();
+            }
+            continue;
+        }
+
+        m_graphics->Submit(pass.queue);
+        if (!pass.text.empty() && m_text) {
+            // Flush D3D before D2D text rendering
+            m_graphics->GetContext()->Flush();
+            m_text->BeginDraw();
+            m_text->Draw(pass.text);
+            m_text->EndDraw();
+        }
+    }
+    if (m_text) m_text->EndFrame();
+    if (m_sidebarText) m_sidebarText->EndFrame();
     m_graphics->EndFrame();
 }
 
 void Game::RenderUI() {
-    int uiX = PLAY_AREA_WIDTH + 20;
-    int uiY = 50;
-    int lineHeight = 40;
-    
     // ボス体力バー（プレイエリア上部に表示）
     for (const auto& enemy : m_enemyManager->GetEnemies()) {
         if (enemy->IsBoss() && enemy->IsActive()) {
@@ -555,7 +695,7 @@ void Game::RenderUI() {
             
             // スペルカード名を保存（ボス名 + スペルカード名）
             std::wstring spellName = L"ひなひな ▸ ";
-            spellName += enemy->GetSpellCardName();
+            spellName += m_spellCardNames.Get(enemy->GetCurrentSpell());
             m_currentBossSpellName = spellName;
             m_bossRemainingSpells = remaining;
             
@@ -584,6 +724,75 @@ void Game::RenderUI() {
         }
     }
 
+    // サイドバーは合成済みのレイヤーを1枚貼るだけ
+    if (m_sidebarLayer.IsReady()) {
+        m_graphics->DrawLayer(m_sidebarLayer);
+    } else {
+        RenderSidebar();
+    }
+}
+
+void Game::ComposeSidebar(FramePacket& frame) {
+    if (!m_sidebarLayer.IsReady()) return;
+
+    // 表示に使う値で比べる（FPSは表示桁、ゲージは描く幅）
+    int specialWidth = static_cast<int>(200 * (m_specialGauge / m_maxSpecialGauge));
+    m_sidebarCache.Set(SidebarWidget::HiScore, m_hiScore);
+    m_sidebarCache.Set(SidebarWidget::Score, m_score);
+    m_sidebarCache.Set(SidebarWidget::Player, m_playerCharacter);
+    m_sidebarCache.Set(SidebarWidget::Lives, m_lives);
+    m_sidebarCache.Set(SidebarWidget::Bombs, m_bombs);
+    m_sidebarCache.Set(SidebarWidget::Power, m_power);
+    m_sidebarCache.Set(SidebarWidget::Special, specialWidth * 2 + (m_specialReady ? 1 : 0));
+    m_sidebarCache.Set(SidebarWidget::Graze, m_graze);
+    m_sidebarCache.Set(SidebarWidget::Fps, static_cast<int64_t>(m_currentFPS * 10.0f));
+
+    int top = 0;
+    int bottom = 0;
+    if (!m_sidebarCache.GetDirtyBand(&top, &bottom)) return;
+
+    // 変わった項目の帯だけ下地から描き直す（それ以外の行はレイヤーに残っている）
+    // （フレームは捨てられないので、記録した時点で合成済みとしてよい）
+    PassClip clip = { PLAY_AREA_WIDTH, top, PLAY_AREA_WIDTH + SIDEBAR_WIDTH, bottom };
+    RenderPass& pass = frame.AddPass(PassTarget::SidebarLayer, clip);
+    m_graphics->BeginQueue(&pass.queue);
+    RenderSidebar();
+    m_graphics->EndQueue();
+    RenderSidebarText(pass.text);
+
+    m_sidebarCache.MarkComposed();
+}
+
+void Game::RenderSidebarText(TextQueue& text) {
+    // UI Text labels (日本語化)
+    float textX = static_cast<float>(PLAY_AREA_WIDTH + 20);
+    text.DrawTextWithValue(L"ハイスコア", m_hiScore, textX, 50);
+    text.DrawTextWithValue(L"スコア", m_score, textX, 90);
+    
+    // プレイヤー名表示
+    const wchar_t* playerName = (m_playerCharacter == 0) ? L"★ ひなひな" : L"★ かい";
+    text.DrawText(playerName, textX, 130, 200, 30, 1, 1);  // ゴールド
+    
+    text.DrawTextWithValue(L"残機", m_lives, textX, 170);
+    text.DrawTextWithValue(L"ボム", m_bombs, textX, 210);
+    text.DrawTextWithValue(L"パワー", m_power, textX, 250);
+    text.DrawTextWithValue(L"バレル", m_graze, textX, 290);
+    
+    // FPS display
+    wchar_t fpsBuffer[32];
+    swprintf_s(fpsBuffer, L"FPS: %.1f", m_currentFPS);
+    text.DrawText(fpsBuffer, textX, 410, 200, 30, 1, m_currentFPS >= 60 ? 0 : 1);
+    
+    // Build info
+    text.DrawText(L"LoC: 4231", textX, static_cast<float>(PLAY_AREA_HEIGHT - 60), 200, 20, 0, 2);
+    text.DrawText(L"ひなた vs ひなひな", textX, static_cast<float>(PLAY_AREA_HEIGHT - 35), 200, 20, 0, 1);
+}
+
+void Game::RenderSidebar() {
+    int uiX = PLAY_AREA_WIDTH + 20;
+    int uiY = 50;
+    int lineHeight = 40;
+
     // Sidebar background
     m_graphics->DrawSprite(PLAY_AREA_WIDTH, 0, SIDEBAR_WIDTH, PLAY_AREA_HEIGHT,
         DirectX::XMFLOAT4(0.1f, 0.05f, 0.15f, 1.0f));
@@ -687,6 +896,12 @@ void Game::UpdateDeltaTime() {
     }
 }
 
+float Game::GetElapsedSeconds(const LARGE_INTEGER& since) const {
+    LARGE_INTEGER now;
+    QueryPerformanceCounter(&now);
+    return static_cast<float>(now.QuadPart - since.QuadPart) / static_cast<float>(m_frequency.QuadPart);
+}
+
 void Game::HandleDebugInput() {
     // デバッグキー削除済み（リリース版）
 }
@@ -699,7 +914,6 @@ void Game::SpawnBoss() {
     m_enemyManager->ResetWaves();  // ウェーブをリセット
     
     // ボスBGMに切り替え
-    m_bgm->Stop();
     m_bgm->PlayBossBGM();
     
     // 最終ボス「ひなひな」を生成（体力800、4スペルカード完備）
@@ -893,13 +1107,18 @@ void Game::RenderFade() {
 }
 
 void Game::ResetGame() {
+    // ゲーム開始前に残りのアセットを読み終えておく（ステージの効果音のデコードもここで）
+    if (m_sound) m_sound->PrefetchAll();
+    m_assets->Flush();
+
     // プレイヤー初期化
     m_player->SetPosition(static_cast<float>(PLAY_AREA_WIDTH / 2), static_cast<float>(PLAY_AREA_HEIGHT - 100));
     m_player->SetPower(0);
     m_player->SetEvolutionLevel(0);
     
-    // 弾クリア
+    // 弾クリア（弾数予算は難易度の弾量に合わせる）
     m_bulletManager->Clear();
+    m_bulletManager->SetBulletBudget(GetBulletBudget());
     
     // 敵クリアとウェーブリセット
     m_enemyManager->Clear();
@@ -970,9 +1189,9 @@ void Game::UpdateTitle() {
 
 void Game::RenderTitle() {
     // Draw title screen background (full screen)
-    if (m_titleTexture) {
+    if (ID3D11ShaderResourceView* titleTexture = m_textures->Get(m_titleTexture)) {
         m_graphics->DrawTexturedSprite(0, 0, static_cast<float>(m_width), static_cast<float>(m_height),
-            m_titleTexture.Get(), DirectX::XMFLOAT4(1, 1, 1, 1));
+            titleTexture, DirectX::XMFLOAT4(1, 1, 1, 1));
     } else {
         // Fallback: gradient background
         m_graphics->DrawSprite(0, 0, static_cast<float>(m_width), static_cast<float>(m_height),
@@ -1046,6 +1265,11 @@ float Game::GetEnemyBulletCountMultiplier() const {
     }
 }
 
+size_t Game::GetBulletBudget() const {
+    // 超えても弾は出る（ソフト予算）、超過はサイドバーと統計で分かる
+    return static_cast<size_t>(BulletPool::DEFAULT_BUDGET * GetEnemyBulletCountMultiplier());
+}
+
 void Game::UpdateGameOver() {
     static bool upPressed = false, downPressed = false, zPressed = false;
     static float gameOverTimer = 0.0f;
@@ -1148,9 +1372,9 @@ void Game::UpdateStageClear() {
 
 void Game::RenderStageClear() {
     // ステージクリアイラストを背景として表示（フルスクリーン）
-    if (m_stageClearTexture) {
+    if (ID3D11ShaderResourceView* stageClearTexture = m_textures->Get(m_stageClearTexture)) {
         m_graphics->DrawTexturedSprite(0, 0, static_cast<float>(m_width), static_cast<float>(m_height),
-            m_stageClearTexture.Get(), DirectX::XMFLOAT4(1, 1, 1, 1));
+            stageClearTexture, DirectX::XMFLOAT4(1, 1, 1, 1));
     } else {
         // フォールバック：ゴールドのオーバーレイ
         m_graphics->DrawSprite(0, 0, static_cast<float>(m_width), static_cast<float>(m_height),
@@ -1198,7 +1422,6 @@ void Game::UpdateVictoryDialogue() {
     if (m_victoryDialogueTimer > 5.0f) {
         m_gameState = GameState::StageClear;
         if (m_bgm) {
-            m_bgm->Stop();
             m_bgm->PlayScoreBGM();  // スコア画面BGM
         }
         return;
@@ -1212,14 +1435,13 @@ void Game::UpdateVictoryDialogue() {
         if (zPressed || enterPressed) {
             m_gameState = GameState::StageClear;
             if (m_bgm) {
-                m_bgm->Stop();
                 m_bgm->PlayScoreBGM();  // スコア画面BGM
             }
         }
     }
 }
 
-void Game::RenderVictoryDialogue() {
+void Game::RenderVictoryDialogue(TextQueue& text) {
     // 背景を少し暗く
     m_graphics->DrawSprite(0, 0, static_cast<float>(PLAY_AREA_WIDTH), static_cast<float>(PLAY_AREA_HEIGHT),
         DirectX::XMFLOAT4(0.0f, 0.0f, 0.0f, 0.4f));
@@ -1232,21 +1454,18 @@ void Game::RenderVictoryDialogue() {
         DirectX::XMFLOAT4(0.1f, 0.1f, 0.4f, 0.9f));
     
     // かいポートレート
-    if (m_portraitKai) {
-        m_graphics->DrawTexturedSprite(40, windowY + 20, 140, 140, m_portraitKai.Get());
+    if (ID3D11ShaderResourceView* portraitKai = m_textures->Get(m_portraitKai)) {
+        m_graphics->DrawTexturedSprite(40, windowY + 20, 140, 140, portraitKai);
     }
     
     // 勝利セリフ - かい画像とかいのセリフ
-    m_text->BeginDraw();
     const wchar_t* victoryLine = L"かい「ほいじゃ、また見てね」";
     
-    m_text->DrawText(victoryLine, 200, windowY + 50, 400, 120, 3, 0);  // サイズ3で大きく
+    text.DrawText(victoryLine, 200, windowY + 50, 400, 120, 3, 0);  // サイズ3で大きく
     
     // スキップヒント
     float alpha = (sinf(m_victoryDialogueTimer * 4.0f) + 1.0f) * 0.5f;
-    m_text->DrawTextWithAlpha(L"Zキーでスキップ", PLAY_AREA_WIDTH - 200, windowY + 150, 160, 30, 1, 0, alpha);
-    
-    m_text->EndDraw();
+    text.DrawTextWithAlpha(L"Zキーでスキップ", PLAY_AREA_WIDTH - 200, windowY + 150, 160, 30, 1, 0, alpha);
 }
 
 
@@ -1266,54 +1485,43 @@ void Game::LoadHiScore() {
     }
 }
 
+// 変更されたアセットを読み直す（デコードはワーカー、差し替えは次回以降の Pump）
+void Game::UpdateHotReload() {
+    if (!m_assetWatcher) return;
+
+    for (const auto& changed : m_assetWatcher->Poll()) {
+        std::wstring path = changed.wstring();
+        for (auto& c : path) {
+            if (c == L'/') c = L'\\';
+        }
+
+        const std::wstring textureDir = L"textures\\";
+        if (path.compare(0, textureDir.size(), textureDir) == 0) {
+            std::wstring relativePath = path.substr(textureDir.size());
+            if (!m_spriteAtlas->ReloadAsync(relativePath, m_textures->GetLoader(), m_textures->GetTextureDir(),
+                                            *m_assets, m_assetPack.get())) {
+                m_textures->ReloadAsync(relativePath, *m_assets);
+            }
+        } else if (_wcsicmp(path.c_str(), L"text\\spellcards_jp.txt") == 0) {
+            m_spellCardNames.Load(m_assetWatcher->GetRoot() / changed);
+        }
+    }
+}
+
 // カットインテクスチャ読み込み
 void Game::LoadCutinTextures() {
-    wchar_t exePath[MAX_PATH];
-    GetModuleFileNameW(nullptr, exePath, MAX_PATH);
-    std::wstring path(exePath);
-    size_t lastSlash = path.find_last_of(L"\\/");
-    std::wstring basePath = path.substr(0, lastSlash) + L"\\..\\..\\assets\\textures\\";
-    
-    const wchar_t* cutinFiles[] = {
-        L"cutin_spell1.png",
-        L"cutin_spell2.png",
-        L"cutin_spell3.png",
-        L"cutin_spell4.png",
-        L"cutin_spell5.png"
-    };
-    
     for (int i = 0; i < 5; i++) {
-        std::wstring texturePath = basePath + cutinFiles[i];
-        ID3D11ShaderResourceView* srv = nullptr;
-        if (m_textureLoader->LoadTexture(texturePath, &srv)) {
-            m_cutinTextures[i].Attach(srv);
-        }
+        m_cutinTextures[i] = m_textures->AcquireAsync(AssetManifest::CUTIN_TEXTURES[i], *m_assets);
     }
 }
 
 // ポートレートテクスチャ読み込み
 void Game::LoadPortraits() {
-    wchar_t exePath[MAX_PATH];
-    GetModuleFileNameW(nullptr, exePath, MAX_PATH);
-    std::wstring path(exePath);
-    size_t lastSlash = path.find_last_of(L"\\/");
-    std::wstring basePath = path.substr(0, lastSlash) + L"\\..\\..\\assets\\textures\\portraits\\";
-    
-    ID3D11ShaderResourceView* srv = nullptr;
-    if (m_textureLoader->LoadTexture(basePath + L"hinata.png", &srv)) {
-        m_portraitHinata.Attach(srv);
-    }
-    srv = nullptr;
-    if (m_textureLoader->LoadTexture(basePath + L"kai.png", &srv)) {
-        m_portraitKai.Attach(srv);
-    }
+    m_portraitHinata = m_textures->AcquireAsync(AssetManifest::PORTRAIT_HINATA, *m_assets);
+    m_portraitKai = m_textures->AcquireAsync(AssetManifest::PORTRAIT_KAI, *m_assets);
     
     // ステージクリアイラスト読み込み
-    std::wstring uiPath = path.substr(0, lastSlash) + L"\\..\\..\\assets\\textures\\ui\\";
-    srv = nullptr;
-    if (m_textureLoader->LoadTexture(uiPath + L"stage_clear.png", &srv)) {
-        m_stageClearTexture.Attach(srv);
-    }
+    m_stageClearTexture = m_textures->AcquireAsync(AssetManifest::STAGE_CLEAR_TEXTURE, *m_assets);
 }
 
 // カットイン更新（毎フレーム呼び出し）
@@ -1350,7 +1558,8 @@ void Game::UpdateCutin() {
 // カットイン描画
 void Game::RenderCutin() {
     if (m_currentCutinIndex < 0 || m_currentCutinIndex >= 5) return;
-    if (!m_cutinTextures[m_currentCutinIndex]) return;
+    ID3D11ShaderResourceView* cutinTexture = m_textures->Get(m_cutinTextures[m_currentCutinIndex]);
+    if (!cutinTexture) return;
     
     // タイマー進行（0→1.5秒）
     float t = 1.5f - m_cutinTimer;  // 0→1.5に変換
@@ -1388,7 +1597,7 @@ void Game::RenderCutin() {
     
     // カットイン画像描画
     m_graphics->DrawTexturedSprite(x, y, cutinWidth, cutinHeight,
-        m_cutinTextures[m_currentCutinIndex].Get(),
+        cutinTexture,
         DirectX::XMFLOAT4(1.0f, 1.0f, 1.0f, alpha));
     
     // キラキラ効果（1.5秒版）
@@ -1472,7 +1681,7 @@ void Game::UpdateBossDialogue() {
 }
 
 // ボス会話描画
-void Game::RenderBossDialogue() {
+void Game::RenderBossDialogue(TextQueue& text) {
     if (!m_bossDialogueActive) return;
     
     // 会話ウィンドウ（画面下部）- 大きく
@@ -1496,28 +1705,28 @@ void Game::RenderBossDialogue() {
     bool isKaiSpeaking = (m_dialogueLine < g_numDialogues) && 
         (wcsstr(g_bossDialogues[m_dialogueLine], L"【かい】") != nullptr);
     
-    if (isKaiSpeaking && m_portraitKai) {
+    ID3D11ShaderResourceView* portraitKai = m_textures->Get(m_portraitKai);
+    ID3D11ShaderResourceView* portraitHinata = m_textures->Get(m_portraitHinata);
+    if (isKaiSpeaking && portraitKai) {
         m_graphics->DrawTexturedSprite(boxX + 20.0f, boxY + 25.0f, portraitSize, portraitSize,
-            m_portraitKai.Get(), DirectX::XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f));
-    } else if (m_portraitHinata) {
+            portraitKai, DirectX::XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f));
+    } else if (portraitHinata) {
         m_graphics->DrawTexturedSprite(boxX + 20.0f, boxY + 25.0f, portraitSize, portraitSize,
-            m_portraitHinata.Get(), DirectX::XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f));
+            portraitHinata, DirectX::XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f));
     }
     
     // テキスト開始位置を左寄せに
     float textStartX = boxX + portraitSize + 30.0f;
     
     // セリフテキスト - 80%サイズ、左寄せ
-    if (m_text && m_dialogueLine < g_numDialogues) {
+    if (m_dialogueLine < g_numDialogues) {
         std::wstring displayText(g_bossDialogues[m_dialogueLine], m_dialogueCharIndex);
-        m_text->BeginDraw();
-        m_text->DrawText(displayText.c_str(), textStartX, boxY + 25.0f, boxW - portraitSize - 60.0f, 180.0f, 3, 0);  // サイズ3
+        text.DrawText(displayText, textStartX, boxY + 25.0f, boxW - portraitSize - 60.0f, 180.0f, 3, 0);  // サイズ3
         
         // 次へ進むヒント
         int len = static_cast<int>(wcslen(g_bossDialogues[m_dialogueLine]));
         if (m_dialogueCharIndex >= len) {
-            m_text->DrawText(L"Z or Click >>", boxX + boxW - 180.0f, boxY + boxH - 35.0f, 160.0f, 25.0f, 0, 2);
+            text.DrawText(L"Z or Click >>", boxX + boxW - 180.0f, boxY + boxH - 35.0f, 160.0f, 25.0f, 0, 2);
         }
-        m_text->EndDraw();
     }
 }
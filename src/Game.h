@@ -13,8 +13,18 @@
 #include "AudioManager.h"
 #include "BGMPlayer.h"
 #include "TextRenderer.h"
-#include "TextureLoader.h"
+#include "TextureRegistry.h"
+#include "TextureAtlas.h"
+#include "GlyphAtlas.h"
 #include "ReplaySystem.h"
+#include "JobSystem.h"
+#include "AssetLoader.h"
+#include "AssetPack.h"
+#include "FileWatcher.h"
+#include "SpellCardTable.h"
+#include "RenderThread.h"
+#include "FramePacket.h"
+#include "SidebarCache.h"
 
 enum class GameState {
     Title,
@@ -39,11 +49,23 @@ public:
     ~Game();
 
     bool Initialize(HWND hWnd, int width, int height);
+    // 効果音をデバイスに出さずWAVに書き出す（Initialize の前に呼ぶ、フレーム単位で同期）
+    void SetAudioCapturePath(const std::wstring& path) { m_audioCapturePath = path; }
     void Shutdown();
     void Update();
     void Render();
 
 private:
+    void UpdateFrame();
+    void PresentFrame();                     // 記録したフレームを描画スレッドへ渡す
+    void SubmitFrame(FramePacket& frame);    // 描画スレッド: ソート・Draw・文字・Present
+
+    std::unique_ptr<JobSystem> m_jobs;  // シミュレーション更新用ワーカー
+    std::unique_ptr<RenderThread<FramePacket>> m_renderThread;  // 提出専用（次フレームのUpdate・記録と重ねる）
+    std::unique_ptr<AssetLoader> m_assets;         // 起動時の非同期読み込み
+    std::unique_ptr<AssetPack::Reader> m_assetPack;  // 変換済みアセット（効果音が直接指すので m_sound より後に破棄）
+    std::unique_ptr<FileWatcher> m_assetWatcher;     // assets\ の変更を拾って読み直す（ホットリロード）
+    void UpdateHotReload();
     std::unique_ptr<Graphics> m_graphics;
     std::unique_ptr<Input> m_input;
     std::unique_ptr<Player> m_player;
@@ -54,7 +76,11 @@ private:
     std::unique_ptr<ItemManager> m_items;
     std::unique_ptr<AudioManager> m_sound;
     std::unique_ptr<BGMPlayer> m_bgm;
+    std::wstring m_audioCapturePath;
     std::unique_ptr<TextRenderer> m_text;
+    OffscreenLayer m_sidebarLayer;                 // 合成済みのサイドバー（毎フレーム1枚貼るだけ）
+    std::unique_ptr<TextRenderer> m_sidebarText;   // サイドバーの文字をレイヤーに描く
+    SidebarCache m_sidebarCache;                   // 表示値が変わった項目の検出
 
     HWND m_hWnd;
     int m_width;
@@ -64,6 +90,9 @@ private:
     LARGE_INTEGER m_frequency;
     LARGE_INTEGER m_lastTime;
     float m_deltaTime;
+    LARGE_INTEGER m_workStart;   // 更新・描画の計測開始（待ちは含めない）
+    float m_frameCost;           // 前フレームの更新＋描画の処理時間（秒）
+    float GetElapsedSeconds(const LARGE_INTEGER& since) const;
     
     // FPS counter
     int m_frameCount;
@@ -80,6 +109,9 @@ private:
 
     void UpdateDeltaTime();
     void RenderUI();
+    void ComposeSidebar(FramePacket& frame);  // 表示値が変わっていればレイヤーの該当帯を描き直すパスを足す
+    void RenderSidebar();
+    void RenderSidebarText(TextQueue& text);
     void CheckCollisions();
     void UpdateGraze();
 
@@ -120,8 +152,10 @@ private:
 
     // Game state and title screen
     GameState m_gameState;
-    std::unique_ptr<TextureLoader> m_textureLoader;
-    ComPtr<ID3D11ShaderResourceView> m_titleTexture;
+    std::unique_ptr<TextureRegistry> m_textures;   // タイトル・カットイン・ポートレート等（パスで共有）
+    std::unique_ptr<TextureAtlas> m_spriteAtlas;  // 敵・アイテム・自機・自機弾のスプライト
+    std::unique_ptr<GlyphAtlas> m_glyphAtlas;     // 得点の数字
+    TextureHandle m_titleTexture;
     void UpdateTitle();
     void RenderTitle();
     void ResetGame();  // ゲーム状態の初期化
@@ -131,6 +165,7 @@ private:
     int m_titleSelection;  // 0=Easy, 1=Normal, 2=Hard
     float GetBulletSpeedMultiplier() const;
     float GetEnemyBulletCountMultiplier() const;
+    size_t GetBulletBudget() const;
     
     // Game Over / Stage Clear screens
     int m_gameOverSelection;  // 0=Continue, 1=Title
@@ -140,7 +175,7 @@ private:
     void UpdateStageClear();
     void RenderStageClear();
     void UpdateVictoryDialogue();
-    void RenderVictoryDialogue();
+    void RenderVictoryDialogue(TextQueue& text);
     
     // ハイスコア保存
     void SaveHiScore();
@@ -150,11 +185,12 @@ private:
     std::unique_ptr<ReplaySystem> m_replay;
     
     // ボススペルカード表示用
+    SpellCardTable m_spellCardNames;  // assets\text\spellcards_jp.txt
     std::wstring m_currentBossSpellName;
     int m_bossRemainingSpells = 0;
     
     // カットインシステム
-    ComPtr<ID3D11ShaderResourceView> m_cutinTextures[5];  // 5枚のカットイン
+    TextureHandle m_cutinTextures[5];  // 5枚のカットイン
     float m_cutinTimer = 0.0f;
     int m_currentCutinIndex = -1;  // -1 = 非表示
     void LoadCutinTextures();
@@ -172,14 +208,14 @@ private:
     bool m_waitingForBoss = false;     // ボス登場待機中
     float m_victoryDialogueTimer = 0.0f;  // 勝利セリフタイマー
     int m_victoryDialogueLine = 0;        // 勝利セリフ行
-    ComPtr<ID3D11ShaderResourceView> m_portraitHinata;  // ひなひな顔イラスト
-    ComPtr<ID3D11ShaderResourceView> m_portraitKai;     // かい顔イラスト
+    TextureHandle m_portraitHinata;  // ひなひな顔イラスト
+    TextureHandle m_portraitKai;     // かい顔イラスト
     int m_playerCharacter = 0;  // 0=ひなひな, 1=かい
     void StartBossDialogue();
     void UpdateBossDialogue();
-    void RenderBossDialogue();
+    void RenderBossDialogue(TextQueue& text);
     void LoadPortraits();
     
     // ステージクリアイラスト
-    ComPtr<ID3D11ShaderResourceView> m_stageClearTexture;
+    TextureHandle m_stageClearTexture;
 };
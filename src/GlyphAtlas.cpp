@@ -0,0 +1,131 @@
+﻿#include "GlyphAtlas.h"
+#include "TextureLoader.h"
+#include <d2d1.h>
+#include <dwrite.h>
+#include <cmath>
+
+#pragma comment(lib, "d2d1.lib")
+#pragma comment(lib, "dwrite.lib")
+
+bool GlyphAtlas::Build(TextureLoader& loader, const wchar_t* fontName, float fontSize, const wchar_t* charset) {
+    IWICImagingFactory* wicFactory = loader.GetWicFactory();
+    if (!wicFactory) return false;
+
+    ComPtr<ID2D1Factory> d2dFactory;
+    HRESULT hr = D2D1CreateFactory(D2D1_FACTORY_TYPE_SINGLE_THREADED, d2dFactory.GetAddressOf());
+    if (FAILED(hr)) return false;
+
+    ComPtr<IDWriteFactory> dwriteFactory;
+    hr = DWriteCreateFactory(DWRITE_FACTORY_TYPE_SHARED, __uuidof(IDWriteFactory),
+                             reinterpret_cast<IUnknown**>(dwriteFactory.GetAddressOf()));
+    if (FAILED(hr)) return false;
+
+    ComPtr<IDWriteTextFormat> format;
+    hr = dwriteFactory->CreateTextFormat(fontName, nullptr, DWRITE_FONT_WEIGHT_BOLD, DWRITE_FONT_STYLE_NORMAL,
+                                         DWRITE_FONT_STRETCH_NORMAL, fontSize, L"ja-JP", &format);
+    if (FAILED(hr)) return false;
+
+    // 文字ごとの送り幅を測り、縁取り分の余白を足したセルを横一列に並べる
+    struct Cell {
+        wchar_t code;
+        int x;
+        int width;
+        float advance;
+    };
+    std::vector<Cell> cells;
+    int stripWidth = 0;
+    float lineHeight = 0.0f;
+    for (const wchar_t* c = charset; *c; c++) {
+        ComPtr<IDWriteTextLayout> layout;
+        hr = dwriteFactory->CreateTextLayout(c, 1, format.Get(), 1000.0f, 1000.0f, &layout);
+        if (FAILED(hr)) continue;
+        DWRITE_TEXT_METRICS metrics;
+        if (FAILED(layout->GetMetrics(&metrics))) continue;
+
+        int width = static_cast<int>(ceilf(metrics.widthIncludingTrailingWhitespace)) + OUTLINE * 2;
+        cells.push_back({ *c, stripWidth, width, metrics.widthIncludingTrailingWhitespace });
+        stripWidth += width;
+        if (metrics.height > lineHeight) lineHeight = metrics.height;
+    }
+    if (cells.empty()) return false;
+    int stripHeight = static_cast<int>(ceilf(lineHeight)) + OUTLINE * 2;
+
+    ComPtr<IWICBitmap> bitmap;
+    hr = wicFactory->CreateBitmap(static_cast<UINT>(stripWidth), static_cast<UINT>(stripHeight),
+                                  GUID_WICPixelFormat32bppPBGRA, WICBitmapCacheOnLoad, &bitmap);
+    if (FAILED(hr)) return false;
+
+    ComPtr<ID2D1RenderTarget> target;
+    D2D1_RENDER_TARGET_PROPERTIES props = D2D1::RenderTargetProperties(
+        D2D1_RENDER_TARGET_TYPE_SOFTWARE,
+        D2D1::PixelFormat(DXGI_FORMAT_B8G8R8A8_UNORM, D2D1_ALPHA_MODE_PREMULTIPLIED));
+    hr = d2dFactory->CreateWicBitmapRenderTarget(bitmap.Get(), props, &target);
+    if (FAILED(hr)) return false;
+
+    ComPtr<ID2D1SolidColorBrush> fillBrush;
+    ComPtr<ID2D1SolidColorBrush> outlineBrush;
+    target->CreateSolidColorBrush(D2D1::ColorF(D2D1::ColorF::White), &fillBrush);
+    target->CreateSolidColorBrush(D2D1::ColorF(0.0f, 0.0f, 0.0f, 0.85f), &outlineBrush);
+    if (!fillBrush || !outlineBrush) return false;
+
+    // 縁取りは黒を8方向にずらして重ね、最後に白を置く
+    target->BeginDraw();
+    target->Clear(D2D1::ColorF(0, 0, 0, 0));
+    for (const Cell& cell : cells) {
+        float left = static_cast<float>(cell.x + OUTLINE);
+        float top = static_cast<float>(OUTLINE);
+        for (int dy = -OUTLINE; dy <= OUTLINE; dy += OUTLINE) {
+            for (int dx = -OUTLINE; dx <= OUTLINE; dx += OUTLINE) {
+                if (dx == 0 && dy == 0) continue;
+                D2D1_RECT_F rect = D2D1::RectF(left + dx, top + dy, left + dx + cell.advance, top + dy + lineHeight);
+                target->DrawText(&cell.code, 1, format.Get(), rect, outlineBrush.Get());
+            }
+        }
+        D2D1_RECT_F rect = D2D1::RectF(left, top, left + cell.advance, top + lineHeight);
+        target->DrawText(&cell.code, 1, format.Get(), rect, fillBrush.Get());
+    }
+    hr = target->EndDraw();
+    if (FAILED(hr)) return false;
+
+    UINT stride = static_cast<UINT>(stripWidth) * 4;
+    std::vector<BYTE> strip(static_cast<size_t>(stride) * stripHeight);
+    hr = bitmap->CopyPixels(nullptr, stride, static_cast<UINT>(strip.size()), strip.data());
+    if (FAILED(hr)) return false;
+
+    // 乗算済みBGRAをストレートなRGBAに戻してセルごとに切り出す
+    std::vector<GlyphImage> images;
+    images.reserve(cells.size());
+    for (const Cell& cell : cells) {
+        GlyphImage image;
+        image.code = cell.code;
+        image.width = cell.width;
+        image.height = stripHeight;
+        image.advance = cell.advance;
+        image.offsetX = -static_cast<float>(OUTLINE);
+        image.pixels.resize(static_cast<size_t>(cell.width) * stripHeight * 4);
+        for (int y = 0; y < stripHeight; y++) {
+            const BYTE* src = strip.data() + static_cast<size_t>(y) * stride + static_cast<size_t>(cell.x) * 4;
+            uint8_t* dst = image.pixels.data() + static_cast<size_t>(y) * cell.width * 4;
+            for (int x = 0; x < cell.width; x++, src += 4, dst += 4) {
+                uint8_t a = src[3];
+                if (a == 0) {
+                    dst[0] = dst[1] = dst[2] = dst[3] = 0;
+                    continue;
+                }
+                dst[0] = static_cast<uint8_t>((src[2] * 255 + a / 2) / a);
+                dst[1] = static_cast<uint8_t>((src[1] * 255 + a / 2) / a);
+                dst[2] = static_cast<uint8_t>((src[0] * 255 + a / 2) / a);
+                dst[3] = a;
+            }
+        }
+        images.push_back(std::move(image));
+    }
+
+    std::vector<uint8_t> atlas;
+    if (!m_font.Build(images, static_cast<float>(stripHeight), &atlas)) return false;
+
+    ID3D11ShaderResourceView* srv = nullptr;
+    if (!loader.CreateTexture(atlas.data(), m_font.GetWidth(), m_font.GetHeight(), &srv)) return false;
+    m_texture.Attach(srv);
+    return true;
+}
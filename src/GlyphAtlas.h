@@ -0,0 +1,28 @@
+﻿#pragma once
+
+#include <d3d11.h>
+#include <wrl/client.h>
+#include "BitmapFont.h"
+
+class TextureLoader;
+
+// 得点などの数字用のグリフアトラス
+// 起動時に DirectWrite で各文字を白＋黒縁でラスタライズし、1枚のテクスチャにする
+// 毎フレームの DirectWrite を通さず、スプライトと同じ経路の四角形でまとめて描ける
+class GlyphAtlas {
+public:
+    static constexpr const wchar_t* SCORE_CHARSET = L"0123456789+-x.,";
+    static constexpr int OUTLINE = 2;  // 縁取りの太さ（px）
+
+    GlyphAtlas() {}
+
+    bool Build(TextureLoader& loader, const wchar_t* fontName, float fontSize, const wchar_t* charset = SCORE_CHARSET);
+
+    bool IsReady() const { return m_texture.Get() != nullptr; }
+    const BitmapFont& GetFont() const { return m_font; }
+    ID3D11ShaderResourceView* GetTexture() const { return m_texture.Get(); }
+
+private:
+    BitmapFont m_font;
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> m_texture;
+};
@@ -1,9 +1,74 @@
 ﻿#include "Graphics.h"
 #include <vector>
 
+namespace {
+
+const int CIRCLE_SEGMENTS = 24;
+
+// 円周の単位ベクトル（CIRCLE_SEGMENTS + 1点、最後は先頭と同じ角度）
+struct CircleTable {
+    float cosTable[CIRCLE_SEGMENTS + 1];
+    float sinTable[CIRCLE_SEGMENTS + 1];
+    CircleTable() {
+        for (int i = 0; i <= CIRCLE_SEGMENTS; i++) {
+            float angle = (2.0f * 3.14159f * i) / CIRCLE_SEGMENTS;
+            cosTable[i] = cosf(angle);
+            sinTable[i] = sinf(angle);
+        }
+    }
+};
+
+const CircleTable& GetCircleTable() {
+    static const CircleTable table;
+    return table;
+}
+
+// uv = (u0, v0, u1, v1)
+void AppendQuad(std::vector<Vertex>& out, float x, float y, float width, float height, XMFLOAT4 color,
+                XMFLOAT4 uv = XMFLOAT4(0.0f, 0.0f, 1.0f, 1.0f)) {
+    out.push_back({ XMFLOAT3(x, y, 0.0f), color, XMFLOAT2(uv.x, uv.y) });
+    out.push_back({ XMFLOAT3(x + width, y, 0.0f), color, XMFLOAT2(uv.z, uv.y) });
+    out.push_back({ XMFLOAT3(x, y + height, 0.0f), color, XMFLOAT2(uv.x, uv.w) });
+    out.push_back({ XMFLOAT3(x + width, y, 0.0f), color, XMFLOAT2(uv.z, uv.y) });
+    out.push_back({ XMFLOAT3(x + width, y + height, 0.0f), color, XMFLOAT2(uv.z, uv.w) });
+    out.push_back({ XMFLOAT3(x, y + height, 0.0f), color, XMFLOAT2(uv.x, uv.w) });
+}
+
+// 中心 innerColor → 外周 outerColor の扇（三角形リスト）
+void AppendFan(std::vector<Vertex>& out, float x, float y, float radius, XMFLOAT4 innerColor, XMFLOAT4 outerColor) {
+    const CircleTable& t = GetCircleTable();
+    for (int i = 0; i < CIRCLE_SEGMENTS; i++) {
+        // Center with inner color
+        out.push_back({ XMFLOAT3(x, y, 0.0f), innerColor, XMFLOAT2(0.5f, 0.5f) });
+        // Edge with outer color
+        out.push_back({ XMFLOAT3(x + radius * t.cosTable[i], y + radius * t.sinTable[i], 0.0f), outerColor,
+                        XMFLOAT2(0.5f + 0.5f * t.cosTable[i], 0.5f + 0.5f * t.sinTable[i]) });
+        out.push_back({ XMFLOAT3(x + radius * t.cosTable[i + 1], y + radius * t.sinTable[i + 1], 0.0f), outerColor,
+                        XMFLOAT2(0.5f + 0.5f * t.cosTable[i + 1], 0.5f + 0.5f * t.sinTable[i + 1]) });
+    }
+}
+
+size_t VertexCountOf(const RenderCommand& command) {
+    switch (command.primitive) {
+        case RenderPrimitive::Quad: return 6;
+        case RenderPrimitive::Fan: return CIRCLE_SEGMENTS * 3;
+        default: return 0;  // インスタンス描画は頂点をためない
+    }
+}
+
+} // namespace
+
 Graphics::Graphics()
     : m_width(0)
     , m_height(0)
+    , m_queue(nullptr)
+    , m_queueAdditive(false)
+    , m_queuePalette(false)
+    , m_submitting(nullptr)
+    , m_lastDrawCalls(0)
+    , m_spriteAtlas(nullptr)
+    , m_glyphAtlas(nullptr)
+    , m_starfieldCount(0)
 {
 }
 
@@ -79,14 +144,7 @@ bool Graphics::CreateDevice(HWND hWnd, int width, int height) {
     }
 
     // Viewport
-    D3D11_VIEWPORT viewport = {};
-    viewport.TopLeftX = 0;
-    viewport.TopLeftY = 0;
-    viewport.Width = static_cast<float>(width);
-    viewport.Height = static_cast<float>(height);
-    viewport.MinDepth = 0.0f;
-    viewport.MaxDepth = 1.0f;
-    m_context->RSSetViewports(1, &viewport);
+    SetViewport(static_cast<float>(width), static_cast<float>(height));
 
     // Alpha blend state
     D3D11_BLEND_DESC blendDesc = {};
@@ -120,6 +178,18 @@ bool Graphics::CreateDevice(HWND hWnd, int width, int height) {
         return false;
     }
 
+    // オフスクリーン合成用（既定のラスタライザー状態＋シザー）
+    D3D11_RASTERIZER_DESC rasterizerDesc = {};
+    rasterizerDesc.FillMode = D3D11_FILL_SOLID;
+    rasterizerDesc.CullMode = D3D11_CULL_BACK;
+    rasterizerDesc.DepthClipEnable = TRUE;
+    rasterizerDesc.ScissorEnable = TRUE;
+
+    hr = m_device->CreateRasterizerState(&rasterizerDesc, &m_scissorState);
+    if (FAILED(hr)) {
+        return false;
+    }
+
     return true;
 }
 
@@ -162,6 +232,47 @@ bool Graphics::CreateShaders() {
         return false;
     }
 
+    // Palette vertex shader（COLOR = パレット番号, 乗算, 加算, アルファ）
+    const char* vsPaletteSource = R"(
+        cbuffer ConstantBuffer : register(b0) {
+            matrix projection;
+        };
+        cbuffer PaletteBuffer : register(b1) {
+            float4 palette[256];
+        };
+        struct VS_INPUT {
+            float3 pos : POSITION;
+            float4 color : COLOR;
+            float2 tex : TEXCOORD;
+        };
+        struct VS_OUTPUT {
+            float4 pos : SV_POSITION;
+            float4 color : COLOR;
+            float2 tex : TEXCOORD;
+        };
+        VS_OUTPUT main(VS_INPUT input) {
+            VS_OUTPUT output;
+            output.pos = mul(float4(input.pos, 1.0f), projection);
+            float3 rgb = palette[(uint)input.color.x].rgb;
+            output.color = float4(saturate(rgb * input.color.y + input.color.z), input.color.w);
+            output.tex = input.tex;
+            return output;
+        }
+    )";
+
+    ComPtr<ID3DBlob> vsPaletteBlob;
+    hr = D3DCompile(vsPaletteSource, strlen(vsPaletteSource), "VS_Palette", nullptr, nullptr,
+        "main", "vs_5_0", 0, 0, &vsPaletteBlob, &errorBlob);
+    if (FAILED(hr)) {
+        return false;
+    }
+
+    hr = m_device->CreateVertexShader(vsPaletteBlob->GetBufferPointer(), vsPaletteBlob->GetBufferSize(),
+        nullptr, &m_paletteVertexShader);
+    if (FAILED(hr)) {
+        return false;
+    }
+
     // Pixel shader
     const char* psSource = R"(
         struct PS_INPUT {
@@ -233,7 +344,7 @@ bool Graphics::CreateBuffers() {
     // Dynamic vertex buffer
     D3D11_BUFFER_DESC vbDesc = {};
     vbDesc.Usage = D3D11_USAGE_DYNAMIC;
-    vbDesc.ByteWidth = sizeof(Vertex) * 4096; // Increased for glow effects
+    vbDesc.ByteWidth = sizeof(Vertex) * MAX_BATCH_VERTICES; // バッチ提出用
     vbDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
     vbDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
 
@@ -241,6 +352,7 @@ bool Graphics::CreateBuffers() {
     if (FAILED(hr)) {
         return false;
     }
+    m_batch.reserve(MAX_BATCH_VERTICES);
 
     // Constant buffer
     D3D11_BUFFER_DESC cbDesc = {};
@@ -254,11 +366,18 @@ bool Graphics::CreateBuffers() {
     }
 
     // Orthographic projection
-    ConstantBuffer cb;
-    cb.projection = XMMatrixOrthographicOffCenterLH(0.0f, static_cast<float>(m_width),
-        static_cast<float>(m_height), 0.0f, 0.0f, 1.0f);
-    cb.projection = XMMatrixTranspose(cb.projection);
-    m_context->UpdateSubresource(m_constantBuffer.Get(), 0, nullptr, &cb, 0, 0);
+    SetProjection(0.0f, 0.0f, static_cast<float>(m_width), static_cast<float>(m_height));
+
+    // Palette constant buffer（弾の色、変更があったフレームだけ更新）
+    D3D11_BUFFER_DESC paletteDesc = {};
+    paletteDesc.Usage = D3D11_USAGE_DEFAULT;
+    paletteDesc.ByteWidth = sizeof(XMFLOAT4) * PALETTE_SIZE;
+    paletteDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+
+    hr = m_device->CreateBuffer(&paletteDesc, nullptr, &m_paletteBuffer);
+    if (FAILED(hr)) {
+        return false;
+    }
 
     return true;
 }
@@ -272,6 +391,7 @@ void Graphics::BeginFrame() {
     m_context->PSSetShader(m_pixelShader.Get(), nullptr, 0);
     m_context->IASetInputLayout(m_inputLayout.Get());
     m_context->VSSetConstantBuffers(0, 1, m_constantBuffer.GetAddressOf());
+    m_context->VSSetConstantBuffers(1, 1, m_paletteBuffer.GetAddressOf());
     
     float blendFactor[] = { 1.0f, 1.0f, 1.0f, 1.0f };
     m_context->OMSetBlendState(m_blendState.Get(), blendFactor, 0xffffffff);
@@ -281,7 +401,119 @@ void Graphics::EndFrame() {
     m_swapChain->Present(1, 0);
 }
 
+void Graphics::SetViewport(float width, float height) {
+    D3D11_VIEWPORT viewport = {};
+    viewport.TopLeftX = 0;
+    viewport.TopLeftY = 0;
+    viewport.Width = width;
+    viewport.Height = height;
+    viewport.MinDepth = 0.0f;
+    viewport.MaxDepth = 1.0f;
+    m_context->RSSetViewports(1, &viewport);
+}
+
+// 画面座標 (left, top)〜(left + width, top + height) を描画先全体に写す
+void Graphics::SetProjection(float left, float top, float width, float height) {
+    ConstantBuffer cb;
+    cb.projection = XMMatrixOrthographicOffCenterLH(left, left + width, top + height, top, 0.0f, 1.0f);
+    cb.projection = XMMatrixTranspose(cb.projection);
+    m_context->UpdateSubresource(m_constantBuffer.Get(), 0, nullptr, &cb, 0, 0);
+}
+
+bool Graphics::CreateOffscreenLayer(int x, int y, int width, int height, OffscreenLayer* layer) {
+    D3D11_TEXTURE2D_DESC desc = {};
+    desc.Width = static_cast<UINT>(width);
+    desc.Height = static_cast<UINT>(height);
+    desc.MipLevels = 1;
+    desc.ArraySize = 1;
+    desc.Format = DXGI_FORMAT_B8G8R8A8_UNORM;
+    desc.SampleDesc.Count = 1;
+    desc.Usage = D3D11_USAGE_DEFAULT;
+    desc.BindFlags = D3D11_BIND_RENDER_TARGET | D3D11_BIND_SHADER_RESOURCE;
+
+    OffscreenLayer created;
+    HRESULT hr = m_device->CreateTexture2D(&desc, nullptr, &created.texture);
+    if (FAILED(hr)) {
+        return false;
+    }
+    hr = m_device->CreateRenderTargetView(created.texture.Get(), nullptr, &created.renderTarget);
+    if (FAILED(hr)) {
+        return false;
+    }
+    hr = m_device->CreateShaderResourceView(created.texture.Get(), nullptr, &created.shaderResource);
+    if (FAILED(hr)) {
+        return false;
+    }
+
+    float clearColor[] = { 0.0f, 0.0f, 0.0f, 1.0f };
+    m_context->ClearRenderTargetView(created.renderTarget.Get(), clearColor);
+
+    created.x = x;
+    created.y = y;
+    created.width = width;
+    created.height = height;
+    *layer = created;
+    return true;
+}
+
+void Graphics::BeginOffscreen(const OffscreenLayer& layer, const D3D11_RECT& clip) {
+    // 前フレームで貼ったときのSRVが残っていると描画先にできない
+    ID3D11ShaderResourceView* nullSRV = nullptr;
+    m_context->PSSetShaderResources(0, 1, &nullSRV);
+    m_context->OMSetRenderTargets(1, layer.renderTarget.GetAddressOf(), nullptr);
+    SetViewport(static_cast<float>(layer.width), static_cast<float>(layer.height));
+    SetProjection(static_cast<float>(layer.x), static_cast<float>(layer.y),
+                  static_cast<float>(layer.width), static_cast<float>(layer.height));
+
+    D3D11_RECT local = { clip.left - layer.x, clip.top - layer.y, clip.right - layer.x, clip.bottom - layer.y };
+    m_context->RSSetState(m_scissorState.Get());
+    m_context->RSSetScissorRects(1, &local);
+}
+
+void Graphics::EndOffscreen() {
+    m_context->RSSetState(nullptr);
+    m_context->OMSetRenderTargets(1, m_renderTargetView.GetAddressOf(), nullptr);
+    SetViewport(static_cast<float>(m_width), static_cast<float>(m_height));
+    SetProjection(0.0f, 0.0f, static_cast<float>(m_width), static_cast<float>(m_height));
+}
+
+void Graphics::DrawLayer(const OffscreenLayer& layer) {
+    if (!layer.IsReady()) return;
+    ID3D11ShaderResourceView* texture = layer.shaderResource.Get();
+    float x = static_cast<float>(layer.x);
+    float y = static_cast<float>(layer.y);
+    float width = static_cast<float>(layer.width);
+    float height = static_cast<float>(layer.height);
+    XMFLOAT4 white(1.0f, 1.0f, 1.0f, 1.0f);
+
+    if (m_queue) {
+        m_queueAdditive = false;
+        m_queue->PushQuad(RenderPipeline::Textured, BlendMode::Opaque, m_queue->TextureId(texture),
+                          x, y, width, height, white);
+        return;
+    }
+
+    float blendFactor[] = { 1.0f, 1.0f, 1.0f, 1.0f };
+    m_context->OMSetBlendState(nullptr, blendFactor, 0xffffffff);
+    m_context->PSSetShader(m_texturedPixelShader.Get(), nullptr, 0);
+    m_context->PSSetShaderResources(0, 1, &texture);
+    m_context->PSSetSamplers(0, 1, m_samplerState.GetAddressOf());
+
+    m_batch.clear();
+    AppendQuad(m_batch, x, y, width, height, white);
+    DrawVertices(m_batch.data(), m_batch.size());
+
+    m_context->PSSetShader(m_pixelShader.Get(), nullptr, 0);
+    ID3D11ShaderResourceView* nullSRV = nullptr;
+    m_context->PSSetShaderResources(0, 1, &nullSRV);
+    m_context->OMSetBlendState(m_blendState.Get(), blendFactor, 0xffffffff);
+}
+
 void Graphics::SetAdditiveBlend(bool additive) {
+    if (m_queue) {
+        m_queueAdditive = additive;
+        return;
+    }
     float blendFactor[] = { 1.0f, 1.0f, 1.0f, 1.0f };
     if (additive) {
         m_context->OMSetBlendState(m_additiveBlendState.Get(), blendFactor, 0xffffffff);
@@ -291,51 +523,32 @@ void Graphics::SetAdditiveBlend(bool additive) {
 }
 
 void Graphics::DrawSprite(float x, float y, float width, float height, XMFLOAT4 color) {
-    Vertex vertices[] = {
-        { XMFLOAT3(x, y, 0.0f), color, XMFLOAT2(0.0f, 0.0f) },
-        { XMFLOAT3(x + width, y, 0.0f), color, XMFLOAT2(1.0f, 0.0f) },
-        { XMFLOAT3(x, y + height, 0.0f), color, XMFLOAT2(0.0f, 1.0f) },
-        { XMFLOAT3(x + width, y, 0.0f), color, XMFLOAT2(1.0f, 0.0f) },
-        { XMFLOAT3(x + width, y + height, 0.0f), color, XMFLOAT2(1.0f, 1.0f) },
-        { XMFLOAT3(x, y + height, 0.0f), color, XMFLOAT2(0.0f, 1.0f) },
-    };
+    if (m_queue) {
+        m_queue->PushQuad(m_queuePalette ? RenderPipeline::Palette : RenderPipeline::Color,
+                          m_queueAdditive ? BlendMode::Additive : BlendMode::Alpha,
+                          RenderQueue::NO_TEXTURE, x, y, width, height, color);
+        return;
+    }
+    m_batch.clear();
+    AppendQuad(m_batch, x, y, width, height, color);
+    DrawVertices(m_batch.data(), m_batch.size());
+}
 
+void Graphics::DrawVertices(const Vertex* vertices, size_t count) {
     D3D11_MAPPED_SUBRESOURCE mapped;
     m_context->Map(m_vertexBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped);
-    memcpy(mapped.pData, vertices, sizeof(vertices));
+    memcpy(mapped.pData, vertices, count * sizeof(Vertex));
     m_context->Unmap(m_vertexBuffer.Get(), 0);
 
     UINT stride = sizeof(Vertex);
     UINT offset = 0;
     m_context->IASetVertexBuffers(0, 1, m_vertexBuffer.GetAddressOf(), &stride, &offset);
     m_context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-    m_context->Draw(6, 0);
+    m_context->Draw(static_cast<UINT>(count), 0);
 }
 
 void Graphics::DrawCircle(float x, float y, float radius, XMFLOAT4 color) {
-    const int segments = 24;
-    std::vector<Vertex> vertices;
-    vertices.reserve(segments * 3);
-
-    for (int i = 0; i < segments; i++) {
-        float angle1 = (2.0f * 3.14159f * i) / segments;
-        float angle2 = (2.0f * 3.14159f * (i + 1)) / segments;
-
-        vertices.push_back({ XMFLOAT3(x, y, 0.0f), color, XMFLOAT2(0.5f, 0.5f) });
-        vertices.push_back({ XMFLOAT3(x + radius * cosf(angle1), y + radius * sinf(angle1), 0.0f), color, XMFLOAT2(0.5f + 0.5f * cosf(angle1), 0.5f + 0.5f * sinf(angle1)) });
-        vertices.push_back({ XMFLOAT3(x + radius * cosf(angle2), y + radius * sinf(angle2), 0.0f), color, XMFLOAT2(0.5f + 0.5f * cosf(angle2), 0.5f + 0.5f * sinf(angle2)) });
-    }
-
-    D3D11_MAPPED_SUBRESOURCE mapped;
-    m_context->Map(m_vertexBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped);
-    memcpy(mapped.pData, vertices.data(), vertices.size() * sizeof(Vertex));
-    m_context->Unmap(m_vertexBuffer.Get(), 0);
-
-    UINT stride = sizeof(Vertex);
-    UINT offset = 0;
-    m_context->IASetVertexBuffers(0, 1, m_vertexBuffer.GetAddressOf(), &stride, &offset);
-    m_context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-    m_context->Draw(static_cast<UINT>(vertices.size()), 0);
+    DrawGradientCircle(x, y, radius, color, color);
 }
 
 void Graphics::DrawGlowCircle(float x, float y, float radius, XMFLOAT4 color, int layers) {
@@ -368,32 +581,62 @@ void Graphics::DrawGlowCircle(float x, float y, float radius, XMFLOAT4 color, in
         XMFLOAT4(color.x * 0.6f, color.y * 0.6f, color.z * 0.6f, color.w));
 }
 
-void Graphics::DrawGradientCircle(float x, float y, float radius, XMFLOAT4 innerColor, XMFLOAT4 outerColor) {
-    const int segments = 24;
-    std::vector<Vertex> vertices;
-    vertices.reserve(segments * 3);
-
-    for (int i = 0; i < segments; i++) {
-        float angle1 = (2.0f * 3.14159f * i) / segments;
-        float angle2 = (2.0f * 3.14159f * (i + 1)) / segments;
+void Graphics::UpdatePalette(const XMFLOAT4* colors) {
+    if (m_queue) {
+        m_queue->SetPalette(colors, PALETTE_SIZE);
+        return;
+    }
+    m_context->UpdateSubresource(m_paletteBuffer.Get(), 0, nullptr, colors, 0, 0);
+}
 
-        // Center with inner color
-        vertices.push_back({ XMFLOAT3(x, y, 0.0f), innerColor, XMFLOAT2(0.5f, 0.5f) });
-        // Edge with outer color
-        vertices.push_back({ XMFLOAT3(x + radius * cosf(angle1), y + radius * sinf(angle1), 0.0f), outerColor, XMFLOAT2(0.5f + 0.5f * cosf(angle1), 0.5f + 0.5f * sinf(angle1)) });
-        vertices.push_back({ XMFLOAT3(x + radius * cosf(angle2), y + radius * sinf(angle2), 0.0f), outerColor, XMFLOAT2(0.5f + 0.5f * cosf(angle2), 0.5f + 0.5f * sinf(angle2)) });
+void Graphics::SetPaletteMode(bool usePalette) {
+    if (m_queue) {
+        m_queuePalette = usePalette;
+        return;
+    }
+    if (usePalette) {
+        m_context->VSSetShader(m_paletteVertexShader.Get(), nullptr, 0);
+    } else {
+        m_context->VSSetShader(m_vertexShader.Get(), nullptr, 0);
     }
+}
 
-    D3D11_MAPPED_SUBRESOURCE mapped;
-    m_context->Map(m_vertexBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped);
-    memcpy(mapped.pData, vertices.data(), vertices.size() * sizeof(Vertex));
-    m_context->Unmap(m_vertexBuffer.Get(), 0);
+// DrawGlowCircleのパレット版（SetPaletteMode(true)中に呼ぶ）
+// 頂点カラーに (番号, 乗算, 加算, アルファ) を詰め、実際の色はシェーダーで求める
+void Graphics::DrawPaletteGlowCircle(float x, float y, float radius, uint8_t colorIndex, float alpha, int layers) {
+    float index = static_cast<float>(colorIndex);
+    XMFLOAT4 clear = { 0.0f, 0.0f, 0.0f, 0.0f };
+    
+    SetAdditiveBlend(true);
+    
+    // Outer glow layers
+    for (int i = layers + 2; i >= 1; i--) {
+        float layerRadius = radius * (1.0f + i * 0.6f);
+        float layerAlpha = alpha * 0.15f / (i * 0.8f);
+        DrawGradientCircle(x, y, layerRadius, XMFLOAT4(index, 0.7f, 0.0f, layerAlpha), clear);
+    }
+    
+    // Inner bright glow
+    DrawGradientCircle(x, y, radius * 1.3f, XMFLOAT4(index, 0.9f, 0.0f, alpha * 0.4f), clear);
+    
+    SetAdditiveBlend(false);
+    
+    // Bright solid core（saturateで fminf(c + 0.3, 1) と同じ）
+    DrawGradientCircle(x, y, radius,
+        XMFLOAT4(index, 1.0f, 0.3f, alpha),
+        XMFLOAT4(index, 0.6f, 0.0f, alpha));
+}
 
-    UINT stride = sizeof(Vertex);
-    UINT offset = 0;
-    m_context->IASetVertexBuffers(0, 1, m_vertexBuffer.GetAddressOf(), &stride, &offset);
-    m_context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-    m_context->Draw(static_cast<UINT>(vertices.size()), 0);
+void Graphics::DrawGradientCircle(float x, float y, float radius, XMFLOAT4 innerColor, XMFLOAT4 outerColor) {
+    if (m_queue) {
+        m_queue->PushFan(m_queuePalette ? RenderPipeline::Palette : RenderPipeline::Color,
+                         m_queueAdditive ? BlendMode::Additive : BlendMode::Alpha,
+                         x, y, radius, innerColor, outerColor);
+        return;
+    }
+    m_batch.clear();
+    AppendFan(m_batch, x, y, radius, innerColor, outerColor);
+    DrawVertices(m_batch.data(), m_batch.size());
 }
 
 void Graphics::DrawTexturedSprite(float x, float y, float width, float height,
@@ -402,6 +645,57 @@ void Graphics::DrawTexturedSprite(float x, float y, float width, float height,
         DrawSprite(x, y, width, height, tint);
         return;
     }
+    DrawTexturedQuad(x, y, width, height, texture, tint, XMFLOAT4(0.0f, 0.0f, 1.0f, 1.0f));
+}
+
+void Graphics::DrawAtlasSprite(float x, float y, float width, float height, SpriteId id, XMFLOAT4 tint) {
+    if (!HasSprite(id)) return;
+    DrawTexturedQuad(x, y, width, height, m_spriteAtlas->GetTexture(), tint, m_spriteAtlas->Get(id).uv);
+}
+
+void Graphics::DrawGlyphText(const wchar_t* text, float x, float y, float scale, XMFLOAT4 color) {
+    if (!HasGlyphs()) return;
+    const BitmapFont& font = m_glyphAtlas->GetFont();
+    ID3D11ShaderResourceView* texture = m_glyphAtlas->GetTexture();
+    float left = x - font.Measure(text, scale) * 0.5f;
+    float top = y - font.GetLineHeight() * scale * 0.5f;
+
+    if (m_queue) {
+        m_queueAdditive = false;
+        uint16_t textureId = m_queue->TextureId(texture);
+        font.Layout(text, left, top, scale, [&](float qx, float qy, float qw, float qh, const XMFLOAT4& uv) {
+            m_queue->PushQuad(RenderPipeline::Textured, BlendMode::Alpha, textureId, qx, qy, qw, qh, color, uv);
+        });
+        return;
+    }
+
+    // 即時描画でも1文字列を1回のDrawで
+    float blendFactor[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    m_context->OMSetBlendState(m_blendState.Get(), blendFactor, 0xFFFFFFFF);
+    m_context->PSSetShader(m_texturedPixelShader.Get(), nullptr, 0);
+    m_context->PSSetShaderResources(0, 1, &texture);
+    m_context->PSSetSamplers(0, 1, m_samplerState.GetAddressOf());
+
+    m_batch.clear();
+    font.Layout(text, left, top, scale, [this, color](float qx, float qy, float qw, float qh, const XMFLOAT4& uv) {
+        AppendQuad(m_batch, qx, qy, qw, qh, color, uv);
+    });
+    DrawVertices(m_batch.data(), m_batch.size());
+
+    m_context->PSSetShader(m_pixelShader.Get(), nullptr, 0);
+    ID3D11ShaderResourceView* nullSRV = nullptr;
+    m_context->PSSetShaderResources(0, 1, &nullSRV);
+}
+
+void Graphics::DrawTexturedQuad(float x, float y, float width, float height,
+                                ID3D11ShaderResourceView* texture, XMFLOAT4 tint, XMFLOAT4 uv) {
+    if (m_queue) {
+        // 即時描画と同じくアルファ合成に戻す
+        m_queueAdditive = false;
+        m_queue->PushQuad(RenderPipeline::Textured, BlendMode::Alpha, m_queue->TextureId(texture),
+                          x, y, width, height, tint, uv);
+        return;
+    }
 
     // Enable alpha blending
     float blendFactor[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
@@ -412,26 +706,9 @@ void Graphics::DrawTexturedSprite(float x, float y, float width, float height,
     m_context->PSSetShaderResources(0, 1, &texture);
     m_context->PSSetSamplers(0, 1, m_samplerState.GetAddressOf());
 
-    // Draw quad with texture coordinates
-    Vertex vertices[] = {
-        { XMFLOAT3(x, y, 0.0f), tint, XMFLOAT2(0.0f, 0.0f) },
-        { XMFLOAT3(x + width, y, 0.0f), tint, XMFLOAT2(1.0f, 0.0f) },
-        { XMFLOAT3(x, y + height, 0.0f), tint, XMFLOAT2(0.0f, 1.0f) },
-        { XMFLOAT3(x + width, y, 0.0f), tint, XMFLOAT2(1.0f, 0.0f) },
-        { XMFLOAT3(x + width, y + height, 0.0f), tint, XMFLOAT2(1.0f, 1.0f) },
-        { XMFLOAT3(x, y + height, 0.0f), tint, XMFLOAT2(0.0f, 1.0f) },
-    };
-
-    D3D11_MAPPED_SUBRESOURCE mapped;
-    m_context->Map(m_vertexBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped);
-    memcpy(mapped.pData, vertices, sizeof(vertices));
-    m_context->Unmap(m_vertexBuffer.Get(), 0);
-
-    UINT stride = sizeof(Vertex);
-    UINT offset = 0;
-    m_context->IASetVertexBuffers(0, 1, m_vertexBuffer.GetAddressOf(), &stride, &offset);
-    m_context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-    m_context->Draw(6, 0);
+    m_batch.clear();
+    AppendQuad(m_batch, x, y, width, height, tint, uv);
+    DrawVertices(m_batch.data(), m_batch.size());
 
     // Switch back to non-textured shader
     m_context->PSSetShader(m_pixelShader.Get(), nullptr, 0);
@@ -447,6 +724,272 @@ void Graphics::SetTextureMode(bool useTexture) {
     }
 }
 
+void Graphics::BeginQueue(RenderQueue* queue) {
+    queue->Reset();
+    m_queue = queue;
+    m_queueAdditive = false;
+    m_queuePalette = false;
+}
+
+void Graphics::SetRenderLayer(RenderLayer layer) {
+    if (m_queue) {
+        m_queue->SetLayer(layer);
+    }
+}
+
+void Graphics::EndQueue() {
+    m_queue = nullptr;
+    m_queueAdditive = false;
+    m_queuePalette = false;
+}
+
+// ソート済みコマンドを状態の変わり目（またはバッファ満杯）ごとに1回のDrawで提出
+void Graphics::Submit(RenderQueue& queue) {
+    if (queue.HasPalette()) {
+        m_context->UpdateSubresource(m_paletteBuffer.Get(), 0, nullptr, queue.GetPalette(), 0, 0);
+    }
+    queue.Sort();
+    m_submitting = &queue;
+    int drawCalls = 0;
+    m_batch.clear();
+
+    size_t count = queue.size();
+    for (size_t i = 0; i < count; i++) {
+        const RenderCommand& command = queue.GetSorted(i);
+        if (i > 0) {
+            const RenderCommand& previous = queue.GetSorted(i - 1);
+            if (!RenderQueue::SameState(previous, command) ||
+                m_batch.size() + VertexCountOf(command) > static_cast<size_t>(MAX_BATCH_VERTICES)) {
+                drawCalls += FlushBatch(previous);
+            }
+        }
+        if (command.primitive == RenderPrimitive::Instances) {
+            // 直前までのバッチは状態の変わり目で提出済み
+            DrawStarfieldInstances(command.x, command.w, command.h);
+            drawCalls++;
+        } else if (command.primitive == RenderPrimitive::Quad) {
+            AppendQuad(m_batch, command.x, command.y, command.w, command.h, command.color0, command.uv);
+        } else {
+            AppendFan(m_batch, command.x, command.y, command.w, command.color0, command.color1);
+        }
+    }
+    if (count > 0) {
+        drawCalls += FlushBatch(queue.GetSorted(count - 1));
+    }
+    m_submitting = nullptr;
+    m_lastDrawCalls.store(drawCalls, std::memory_order_relaxed);
+
+    // 即時描画の既定状態に戻す
+    m_context->VSSetShader(m_vertexShader.Get(), nullptr, 0);
+    m_context->PSSetShader(m_pixelShader.Get(), nullptr, 0);
+    ID3D11ShaderResourceView* nullSRV = nullptr;
+    m_context->PSSetShaderResources(0, 1, &nullSRV);
+    float blendFactor[] = { 1.0f, 1.0f, 1.0f, 1.0f };
+    m_context->OMSetBlendState(m_blendState.Get(), blendFactor, 0xffffffff);
+}
+
+int Graphics::FlushBatch(const RenderCommand& state) {
+    if (m_batch.empty()) return 0;
+
+    float blendFactor[] = { 1.0f, 1.0f, 1.0f, 1.0f };
+    ID3D11BlendState* blendState = m_blendState.Get();
+    if (state.blend == BlendMode::Additive) {
+        blendState = m_additiveBlendState.Get();
+    } else if (state.blend == BlendMode::Opaque) {
+        blendState = nullptr;  // 既定状態 = 合成なし
+    }
+    m_context->OMSetBlendState(blendState, blendFactor, 0xffffffff);
+    m_context->VSSetShader(state.pipeline == RenderPipeline::Palette ? m_paletteVertexShader.Get() : m_vertexShader.Get(),
+                           nullptr, 0);
+    if (state.pipeline == RenderPipeline::Textured) {
+        ID3D11ShaderResourceView* texture =
+            static_cast<ID3D11ShaderResourceView*>(const_cast<void*>(m_submitting->GetTexture(state.texture)));
+        m_context->PSSetShader(m_texturedPixelShader.Get(), nullptr, 0);
+        m_context->PSSetShaderResources(0, 1, &texture);
+        m_context->PSSetSamplers(0, 1, m_samplerState.GetAddressOf());
+    } else {
+        m_context->PSSetShader(m_pixelShader.Get(), nullptr, 0);
+    }
+
+    DrawVertices(m_batch.data(), m_batch.size());
+    m_batch.clear();
+    return 1;
+}
+
+bool Graphics::CreateStarfield(const StarInstance* stars, int count) {
+    m_starfieldCount = 0;
+    if (count <= 0) return false;
+
+    // 位置の式は Starfield::Position と同じ（1頂点 = 星の四隅のどれか、SV_VertexIDで決める）
+    const char* vsSource = R"(
+        cbuffer ConstantBuffer : register(b0) {
+            matrix projection;
+        };
+        cbuffer StarfieldBuffer : register(b2) {
+            float4 params;  // 時刻, 幅, 高さ
+        };
+        struct VS_INPUT {
+            float3 star : POSITION;  // x, y, depth
+            uint seed : SEED;
+            float4 color : COLOR;
+            uint vertexId : SV_VertexID;
+        };
+        struct VS_OUTPUT {
+            float4 pos : SV_POSITION;
+            float4 color : COLOR;
+            float2 local : TEXCOORD0;  // 星の半径を1とした座標
+            float glow : TEXCOORD1;
+        };
+        static const float WRAP_MARGIN = 20.0f;
+        static const float2 corners[6] = {
+            float2(-1, -1), float2(1, -1), float2(-1, 1),
+            float2(1, -1), float2(1, 1), float2(-1, 1)
+        };
+        uint Hash(uint v) {
+            uint h = v * 747796405u + 2891336453u;
+            h = ((h >> ((h >> 28) + 4u)) ^ h) * 277803737u;
+            return (h >> 22) ^ h;
+        }
+        VS_OUTPUT main(VS_INPUT input) {
+            float time = params.x;
+            float width = params.y;
+            float height = params.z;
+            float depth = input.star.z;
+
+            float span = height + WRAP_MARGIN * 2.0f;
+            float travel = input.star.y + WRAP_MARGIN + (50.0f + depth * 150.0f) * time;
+            float lap = floor(travel / span);
+            float y = travel - lap * span - WRAP_MARGIN;
+            float x = lap > 0.0f ? (Hash(input.seed + (uint)lap) & 0xFFFF) / 65536.0f * width : input.star.x;
+            x += sin(time * 2.0f + (input.seed & 0xFF) * 0.0245f) * 1.5f;
+
+            float perspective = 0.3f + depth * 0.7f;
+            x = width * 0.5f + (x - width * 0.5f) * perspective;
+            y = height * 0.5f + (y - height * 0.5f) * perspective;
+
+            float size = 1.0f + depth * 3.0f;
+            float extent = size > 2.0f ? 3.4f : 1.0f;
+            float2 corner = corners[input.vertexId];
+
+            VS_OUTPUT output;
+            output.pos = mul(float4(x + corner.x * size * extent, y + corner.y * size * extent, 0.0f, 1.0f), projection);
+            output.color = input.color;
+            output.local = corner * extent;
+            output.glow = extent > 1.0f ? 1.0f : 0.0f;
+            return output;
+        }
+    )";
+
+    // 中心ほど明るい円＋大きい星は外側に薄い光彩（加算）
+    const char* psSource = R"(
+        struct PS_INPUT {
+            float4 pos : SV_POSITION;
+            float4 color : COLOR;
+            float2 local : TEXCOORD0;
+            float glow : TEXCOORD1;
+        };
+        float4 main(PS_INPUT input) : SV_TARGET {
+            float r = length(input.local);
+            float core = saturate(1.0f - r * 0.5f) * step(r, 1.0f);
+            float halo = input.glow * 0.3f * saturate(1.0f - r / 3.4f);
+            return float4(input.color.rgb, saturate(core + halo) * input.color.a);
+        }
+    )";
+
+    ComPtr<ID3DBlob> vsBlob;
+    ComPtr<ID3DBlob> psBlob;
+    ComPtr<ID3DBlob> errorBlob;
+    HRESULT hr = D3DCompile(vsSource, strlen(vsSource), "VS_Starfield", nullptr, nullptr,
+        "main", "vs_5_0", 0, 0, &vsBlob, &errorBlob);
+    if (FAILED(hr)) {
+        return false;
+    }
+    hr = D3DCompile(psSource, strlen(psSource), "PS_Starfield", nullptr, nullptr,
+        "main", "ps_5_0", 0, 0, &psBlob, &errorBlob);
+    if (FAILED(hr)) {
+        return false;
+    }
+
+    hr = m_device->CreateVertexShader(vsBlob->GetBufferPointer(), vsBlob->GetBufferSize(),
+        nullptr, &m_starfieldVertexShader);
+    if (FAILED(hr)) {
+        return false;
+    }
+    hr = m_device->CreatePixelShader(psBlob->GetBufferPointer(), psBlob->GetBufferSize(),
+        nullptr, &m_starfieldPixelShader);
+    if (FAILED(hr)) {
+        return false;
+    }
+
+    // 1インスタンス = StarInstance 1つ
+    D3D11_INPUT_ELEMENT_DESC layout[] = {
+        { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+        { "SEED", 0, DXGI_FORMAT_R32_UINT, 0, 12, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+        { "COLOR", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 16, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+    };
+    hr = m_device->CreateInputLayout(layout, 3, vsBlob->GetBufferPointer(),
+        vsBlob->GetBufferSize(), &m_starfieldLayout);
+    if (FAILED(hr)) {
+        return false;
+    }
+
+    D3D11_BUFFER_DESC instanceDesc = {};
+    instanceDesc.Usage = D3D11_USAGE_IMMUTABLE;
+    instanceDesc.ByteWidth = static_cast<UINT>(sizeof(StarInstance) * count);
+    instanceDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+    D3D11_SUBRESOURCE_DATA instanceData = {};
+    instanceData.pSysMem = stars;
+    hr = m_device->CreateBuffer(&instanceDesc, &instanceData, &m_starfieldInstances);
+    if (FAILED(hr)) {
+        return false;
+    }
+
+    D3D11_BUFFER_DESC constantDesc = {};
+    constantDesc.Usage = D3D11_USAGE_DEFAULT;
+    constantDesc.ByteWidth = sizeof(XMFLOAT4);
+    constantDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+    hr = m_device->CreateBuffer(&constantDesc, nullptr, &m_starfieldConstants);
+    if (FAILED(hr)) {
+        return false;
+    }
+
+    m_starfieldCount = count;
+    return true;
+}
+
+void Graphics::DrawStarfield(float time, float width, float height) {
+    if (!HasStarfield()) return;
+    if (m_queue) {
+        m_queue->PushStarfield(time, width, height);
+        return;
+    }
+    DrawStarfieldInstances(time, width, height);
+}
+
+void Graphics::DrawStarfieldInstances(float time, float width, float height) {
+    XMFLOAT4 params(time, width, height, 0.0f);
+    m_context->UpdateSubresource(m_starfieldConstants.Get(), 0, nullptr, &params, 0, 0);
+
+    UINT stride = sizeof(StarInstance);
+    UINT offset = 0;
+    m_context->IASetInputLayout(m_starfieldLayout.Get());
+    m_context->IASetVertexBuffers(0, 1, m_starfieldInstances.GetAddressOf(), &stride, &offset);
+    m_context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+    m_context->VSSetShader(m_starfieldVertexShader.Get(), nullptr, 0);
+    m_context->VSSetConstantBuffers(2, 1, m_starfieldConstants.GetAddressOf());
+    m_context->PSSetShader(m_starfieldPixelShader.Get(), nullptr, 0);
+    float blendFactor[] = { 1.0f, 1.0f, 1.0f, 1.0f };
+    m_context->OMSetBlendState(m_additiveBlendState.Get(), blendFactor, 0xffffffff);
+
+    m_context->DrawInstanced(6, static_cast<UINT>(m_starfieldCount), 0, 0);
+
+    // 通常の描画状態に戻す（頂点バッファは DrawVertices が毎回設定する）
+    m_context->IASetInputLayout(m_inputLayout.Get());
+    m_context->VSSetShader(m_vertexShader.Get(), nullptr, 0);
+    m_context->PSSetShader(m_pixelShader.Get(), nullptr, 0);
+    m_context->OMSetBlendState(m_blendState.Get(), blendFactor, 0xffffffff);
+}
+
 bool Graphics::CreateSamplerState() {
     D3D11_SAMPLER_DESC samplerDesc = {};
     samplerDesc.Filter = D3D11_FILTER_MIN_MAG_MIP_LINEAR;
@@ -5,7 +5,14 @@
 #include <d3dcompiler.h>
 #include <DirectXMath.h>
 #include <wrl/client.h>
+#include <atomic>
 #include <string>
+#include <cstdint>
+#include <vector>
+#include "RenderQueue.h"
+#include "TextureAtlas.h"
+#include "GlyphAtlas.h"
+#include "Starfield.h"
 
 using Microsoft::WRL::ComPtr;
 using namespace DirectX;
@@ -16,6 +23,20 @@ struct Vertex {
     XMFLOAT2 texCoord;
 };
 
+// オフスクリーンの描画先（一度合成した絵を毎フレーム1枚の矩形として貼る）
+// 画面上の (x, y) から width × height の範囲をそのまま受け持つ
+struct OffscreenLayer {
+    ComPtr<ID3D11Texture2D> texture;
+    ComPtr<ID3D11RenderTargetView> renderTarget;
+    ComPtr<ID3D11ShaderResourceView> shaderResource;
+    int x = 0;
+    int y = 0;
+    int width = 0;
+    int height = 0;
+
+    bool IsReady() const { return shaderResource.Get() != nullptr; }
+};
+
 class Graphics {
 public:
     Graphics();
@@ -34,11 +55,52 @@ public:
     void DrawGlowCircle(float x, float y, float radius, XMFLOAT4 color, int layers = 3);
     void DrawGradientCircle(float x, float y, float radius, XMFLOAT4 innerColor, XMFLOAT4 outerColor);
     void DrawCircleArc(float x, float y, float radius, float thickness, float startAngle, float endAngle, XMFLOAT4 color);
+
+    // スプライトアトラス（所有はGame、全スプライトが同じテクスチャなので1回のDrawにまとまる）
+    void SetSpriteAtlas(const TextureAtlas* atlas) { m_spriteAtlas = atlas; }
+    bool HasSprite(SpriteId id) const { return m_spriteAtlas && m_spriteAtlas->Has(id); }
+    void DrawAtlasSprite(float x, float y, float width, float height, SpriteId id, XMFLOAT4 tint = XMFLOAT4(1,1,1,1));
+
+    // ビットマップフォント（所有はGame、全文字が同じテクスチャなので記録中は文字列をまたいで1回のDrawにまとまる）
+    void SetGlyphAtlas(const GlyphAtlas* glyphs) { m_glyphAtlas = glyphs; }
+    bool HasGlyphs() const { return m_glyphAtlas && m_glyphAtlas->IsReady(); }
+    // (x, y) を中心に text を描く（scale はアトラス作成時の文字サイズに対する倍率）
+    void DrawGlyphText(const wchar_t* text, float x, float y, float scale, XMFLOAT4 color);
+
+    // 背景の星（位置は時刻と星ごとの種から頂点シェーダーで出す、全部で1回のインスタンス描画）
+    // 作った後はCPU側で星を動かさない。作れなければ false（呼び出し側で1つずつ描く）
+    bool CreateStarfield(const StarInstance* stars, int count);
+    bool HasStarfield() const { return m_starfieldCount > 0; }
+    void DrawStarfield(float time, float width, float height);
+
+    // 弾パレット（色は頂点シェーダーでパレットから展開）
+    static const int PALETTE_SIZE = 256;
+    void UpdatePalette(const XMFLOAT4* colors);  // PALETTE_SIZE色をまとめて転送（記録中はキューに持たせる）
+    void SetPaletteMode(bool usePalette);
+    void DrawPaletteGlowCircle(float x, float y, float radius, uint8_t colorIndex, float alpha, int layers = 3);
     
     // Blend mode
     void SetAdditiveBlend(bool additive);
     void SetTextureMode(bool useTexture);
 
+    // 描画コマンドの記録（BeginQueue〜EndQueueの間のDraw系は即時描画せずキューに積む）
+    // 記録はコンテキストに触れないので、描画スレッドが前のフレームを提出している間に進められる
+    void BeginQueue(RenderQueue* queue);
+    void SetRenderLayer(RenderLayer layer);
+    void EndQueue();
+    bool IsRecording() const { return m_queue != nullptr; }
+    // 記録済みのキューをキー順に並べ替え、同じ状態の連続区間を1回のDrawにまとめて提出する（描画スレッド）
+    void Submit(RenderQueue& queue);
+    int GetLastDrawCalls() const { return m_lastDrawCalls.load(std::memory_order_relaxed); }
+
+    // オフスクリーンレイヤー（BGRAなのでD2Dの文字も同じテクスチャに描ける）
+    bool CreateOffscreenLayer(int x, int y, int width, int height, OffscreenLayer* layer);
+    // 以降の描画を layer に向ける（座標は画面のまま、clip の外は書き換えない）
+    void BeginOffscreen(const OffscreenLayer& layer, const D3D11_RECT& clip);
+    void EndOffscreen();
+    // 合成済みのレイヤーを元の位置に合成なしで貼る
+    void DrawLayer(const OffscreenLayer& layer);
+
     // Device access
     ID3D11Device* GetDevice() const { return m_device.Get(); }
     ID3D11DeviceContext* GetContext() const { return m_context.Get(); }
@@ -49,24 +111,54 @@ private:
     bool CreateShaders();
     bool CreateBuffers();
     bool CreateSamplerState();
+    void DrawVertices(const Vertex* vertices, size_t count);
+    void DrawTexturedQuad(float x, float y, float width, float height,
+                          ID3D11ShaderResourceView* texture, XMFLOAT4 tint, XMFLOAT4 uv);
+    int FlushBatch(const RenderCommand& state);  // 出したDrawの数
+    void SetProjection(float left, float top, float width, float height);
+    void DrawStarfieldInstances(float time, float width, float height);
+    void SetViewport(float width, float height);
 
     ComPtr<ID3D11Device> m_device;
     ComPtr<ID3D11DeviceContext> m_context;
     ComPtr<IDXGISwapChain> m_swapChain;
     ComPtr<ID3D11RenderTargetView> m_renderTargetView;
     ComPtr<ID3D11VertexShader> m_vertexShader;
+    ComPtr<ID3D11VertexShader> m_paletteVertexShader;
     ComPtr<ID3D11PixelShader> m_pixelShader;
     ComPtr<ID3D11PixelShader> m_texturedPixelShader;
     ComPtr<ID3D11InputLayout> m_inputLayout;
     ComPtr<ID3D11Buffer> m_vertexBuffer;
     ComPtr<ID3D11Buffer> m_constantBuffer;
+    ComPtr<ID3D11Buffer> m_paletteBuffer;
     ComPtr<ID3D11BlendState> m_blendState;
     ComPtr<ID3D11BlendState> m_additiveBlendState;
+    ComPtr<ID3D11RasterizerState> m_scissorState;
+
+    // 背景の星
+    ComPtr<ID3D11VertexShader> m_starfieldVertexShader;
+    ComPtr<ID3D11PixelShader> m_starfieldPixelShader;
+    ComPtr<ID3D11InputLayout> m_starfieldLayout;
+    ComPtr<ID3D11Buffer> m_starfieldInstances;
+    ComPtr<ID3D11Buffer> m_starfieldConstants;  // (時刻, 幅, 高さ, 未使用)
+    int m_starfieldCount;
     ComPtr<ID3D11SamplerState> m_samplerState;
 
     int m_width;
     int m_height;
 
+    // コマンド記録中の状態（メインスレッド）
+    static const int MAX_BATCH_VERTICES = 16384;
+    RenderQueue* m_queue;
+    bool m_queueAdditive;
+    bool m_queuePalette;
+    // 提出中の状態（描画スレッド）
+    const RenderQueue* m_submitting;
+    std::vector<Vertex> m_batch;
+    std::atomic<int> m_lastDrawCalls;
+    const TextureAtlas* m_spriteAtlas;
+    const GlyphAtlas* m_glyphAtlas;
+
     struct ConstantBuffer {
         XMMATRIX projection;
     };
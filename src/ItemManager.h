@@ -62,15 +62,6 @@ private:
     std::vector<Item> m_items;
     static const int MAX_ITEMS = 200;
     
-    // テクスチャ（全アイテムタイプ）
-    ComPtr<ID3D11ShaderResourceView> m_whiskyTexture;    // ウイスキーショット
-    ComPtr<ID3D11ShaderResourceView> m_maltTexture;      // モルト粒
-    ComPtr<ID3D11ShaderResourceView> m_barrelTexture;    // 樽のしずく
-    ComPtr<ID3D11ShaderResourceView> m_labelTexture;     // ラベルスター
-    ComPtr<ID3D11ShaderResourceView> m_iceCubeTexture;   // 氷
-    ComPtr<ID3D11ShaderResourceView> m_bottleTexture;    // 金のボトル
-    ComPtr<ID3D11ShaderResourceView> m_caskTexture;      // フルカスク
-    
     XMFLOAT4 GetItemColor(ItemType type);
     float GetItemRadius(ItemType type);
 };
@@ -0,0 +1,156 @@
+﻿#include "JobSystem.h"
+
+namespace {
+    // 実行中スレッドのキュー番号（-1 = ワーカー以外）と、そのキューを持つインスタンス
+    // 別の JobSystem のワーカーから呼ばれたら番号は使わず、外部用のキューに積む
+    thread_local int t_workerIndex = -1;
+    thread_local const JobSystem* t_owner = nullptr;
+}
+
+JobSystem::JobSystem(unsigned workerCount)
+    : m_queued(0)
+    , m_quit(false)
+{
+    for (unsigned i = 0; i < workerCount + 1; i++) {
+        m_queues.push_back(std::make_unique<WorkQueue>());
+    }
+    m_threads.reserve(workerCount);
+    for (unsigned i = 0; i < workerCount; i++) {
+        m_threads.emplace_back(&JobSystem::WorkerMain, this, i);
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_quit = true;
+    }
+    m_wake.notify_all();
+    for (auto& thread : m_threads) {
+        thread.join();
+    }
+}
+
+void JobSystem::Run(std::initializer_list<Task> tasks) {
+    if (tasks.size() == 0) return;
+    if (m_threads.empty()) {
+        for (const auto& task : tasks) task();
+        return;
+    }
+
+    std::atomic<uint32_t> pending(static_cast<uint32_t>(tasks.size()));
+    for (const auto& task : tasks) {
+        Push(task, &pending);
+    }
+    Wait(pending);
+}
+
+unsigned JobSystem::CurrentQueue() const {
+    return t_owner == this ? static_cast<unsigned>(t_workerIndex)
+                           : static_cast<unsigned>(m_queues.size() - 1);
+}
+
+void JobSystem::Push(Task task, std::atomic<uint32_t>* pending) {
+    WorkQueue& queue = *m_queues[CurrentQueue()];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back({ std::move(task), pending });
+    }
+    m_queued.fetch_add(1, std::memory_order_release);
+    {
+        // 寝ようとしているワーカーとの行き違いを防ぐ
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+    }
+    m_wake.notify_all();
+}
+
+void JobSystem::Dispatch(Task task, std::atomic<uint32_t>& pending) {
+    pending.fetch_add(1, std::memory_order_acq_rel);
+    if (m_threads.empty()) {
+        task();
+        pending.fetch_sub(1, std::memory_order_acq_rel);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_background.mutex);
+        m_background.jobs.push_back({ std::move(task), &pending });
+    }
+    m_queued.fetch_add(1, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+    }
+    m_wake.notify_one();
+}
+
+void JobSystem::WaitForBackground(std::atomic<uint32_t>& pending) {
+    while (pending.load(std::memory_order_acquire) > 0) {
+        if (!TryRunOne(true)) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+bool JobSystem::TryRunOne(bool allowBackground) {
+    unsigned self = CurrentQueue();
+    unsigned queueCount = static_cast<unsigned>(m_queues.size());
+    Job job;
+    bool found = false;
+
+    // 自分のキューは末尾から（直前に積んだジョブほどキャッシュに残っている）
+    {
+        WorkQueue& own = *m_queues[self];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.jobs.empty()) {
+            job = std::move(own.jobs.back());
+            own.jobs.pop_back();
+            found = true;
+        }
+    }
+    // 他のキューからは先頭を盗む
+    for (unsigned i = 1; !found && i < queueCount; i++) {
+        WorkQueue& victim = *m_queues[(self + i) % queueCount];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.jobs.empty()) {
+            job = std::move(victim.jobs.front());
+            victim.jobs.pop_front();
+            found = true;
+        }
+    }
+    // バックグラウンドはフレームのジョブが無いときだけ
+    if (!found && allowBackground) {
+        std::lock_guard<std::mutex> lock(m_background.mutex);
+        if (!m_background.jobs.empty()) {
+            job = std::move(m_background.jobs.front());
+            m_background.jobs.pop_front();
+            found = true;
+        }
+    }
+    if (!found) return false;
+
+    m_queued.fetch_sub(1, std::memory_order_relaxed);
+    job.task();
+    job.pending->fetch_sub(1, std::memory_order_acq_rel);
+    return true;
+}
+
+void JobSystem::Wait(std::atomic<uint32_t>& pending) {
+    while (pending.load(std::memory_order_acquire) > 0) {
+        if (!TryRunOne(false)) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::WorkerMain(unsigned index) {
+    t_workerIndex = static_cast<int>(index);
+    t_owner = this;
+    while (!m_quit.load(std::memory_order_acquire)) {
+        if (TryRunOne(true)) continue;
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_wake.wait(lock, [this]() {
+            return m_quit.load(std::memory_order_acquire) || m_queued.load(std::memory_order_acquire) > 0;
+        });
+    }
+}
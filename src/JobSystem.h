@@ -0,0 +1,103 @@
+﻿#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// 固定スレッドプールのワークスティーリング型ジョブシステム
+// 各ワーカーは自分のキューの末尾から取り、空なら他のキューの先頭から盗む
+// 待っているスレッドもジョブを手伝うので、ジョブの中から ParallelFor を呼んでもよい
+class JobSystem {
+public:
+    using Task = std::function<void()>;
+
+    // workerCount = 0 ならワーカーを作らず、全ジョブを呼び出し側で実行する
+    explicit JobSystem(unsigned workerCount = DefaultWorkerCount());
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // 独立したタスクを並行実行し、全部終わるまで待つ
+    void Run(std::initializer_list<Task> tasks);
+
+    // [0, count) を chunkSize ごとに分けて fn(begin, end) を並列実行する
+    // チャンクの境界は count と chunkSize だけで決まる（スレッド数に依存しない）ので、
+    // チャンクごとの結果を添字順に合成すれば毎回同じ結果になる
+    template <typename Fn>
+    void ParallelFor(uint32_t count, uint32_t chunkSize, Fn&& fn) {
+        if (count == 0) return;
+        if (chunkSize == 0) chunkSize = 1;
+        uint32_t chunks = (count + chunkSize - 1) / chunkSize;
+        if (chunks == 1 || m_threads.empty()) {
+            for (uint32_t begin = 0; begin < count; begin += chunkSize) {
+                uint32_t end = (count - begin < chunkSize) ? count : begin + chunkSize;
+                fn(begin, end);
+            }
+            return;
+        }
+
+        std::atomic<uint32_t> pending(chunks);
+        for (uint32_t c = 0; c < chunks; c++) {
+            uint32_t begin = c * chunkSize;
+            uint32_t end = (count - begin < chunkSize) ? count : begin + chunkSize;
+            Push([&fn, begin, end]() { fn(begin, end); }, &pending);
+        }
+        Wait(pending);
+    }
+
+    // 完了を待たずにバックグラウンドで実行する（読み込み等の長いタスク用）
+    // pending は投げるときに増え、終わると減る。フレーム中の Run/ParallelFor の待ちでは拾わないので、
+    // 長いタスクがフレームを止めることはない（ワーカーが空いたときに実行される）
+    void Dispatch(Task task, std::atomic<uint32_t>& pending);
+
+    // pending が0になるまで待つ（バックグラウンドタスクも手伝う）
+    void WaitForBackground(std::atomic<uint32_t>& pending);
+
+    // チャンク数（ParallelForで結果をチャンク別に持つときの配列サイズ）
+    static uint32_t ChunkCount(uint32_t count, uint32_t chunkSize) {
+        return chunkSize == 0 ? count : (count + chunkSize - 1) / chunkSize;
+    }
+
+    unsigned GetWorkerCount() const { return static_cast<unsigned>(m_threads.size()); }
+
+    // 論理コア数 - 1（メインスレッドの分を引く）
+    static unsigned DefaultWorkerCount() {
+        unsigned cores = std::thread::hardware_concurrency();
+        return cores > 1 ? cores - 1 : 0;
+    }
+
+private:
+    struct Job {
+        Task task;
+        std::atomic<uint32_t>* pending;
+    };
+
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    void Push(Task task, std::atomic<uint32_t>* pending);
+    bool TryRunOne(bool allowBackground);
+    void Wait(std::atomic<uint32_t>& pending);
+    void WorkerMain(unsigned index);
+    unsigned CurrentQueue() const;
+
+    // ワーカーごとのキュー＋外部スレッド用キュー（末尾）
+    std::vector<std::unique_ptr<WorkQueue>> m_queues;
+    WorkQueue m_background;
+    std::vector<std::thread> m_threads;
+
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wake;
+    std::atomic<uint32_t> m_queued;
+    std::atomic<bool> m_quit;
+};
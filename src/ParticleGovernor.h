@@ -0,0 +1,59 @@
+﻿#pragma once
+
+#include <cstddef>
+
+// パーティクルの発生量を負荷に合わせて絞る
+// フレームの処理時間（待ちを除く）が予算を超えたら発生数とグロー段数を下げ、収まればゆっくり戻す
+// プールが半分を超えて埋まってきたら、処理時間によらず埋まり具合に応じて絞る
+class ParticleGovernor {
+public:
+    static constexpr float TARGET_FRAME_COST = 0.75f / 60.0f;  // 60fpsの75%
+    static constexpr float MIN_SCALE = 0.25f;
+    static constexpr float PRESSURE_START = 0.5f;   // ここまでの埋まり具合なら絞らない
+    static constexpr float SMOOTHING = 0.2f;        // 処理時間の指数移動平均
+    static constexpr float DECREASE_STEP = 0.05f;   // 1フレームで絞る量
+    static constexpr float RECOVER_STEP = 0.01f;    // 1フレームで戻す量
+
+    ParticleGovernor() : m_smoothedCost(0.0f), m_costScale(1.0f), m_carry(0.0f) {}
+
+    // 毎フレーム1回、前フレームの処理時間（秒）を渡す
+    void SetFrameCost(float frameCost) {
+        m_smoothedCost += (frameCost - m_smoothedCost) * SMOOTHING;
+        if (m_smoothedCost > TARGET_FRAME_COST) {
+            m_costScale -= DECREASE_STEP;
+            if (m_costScale < MIN_SCALE) m_costScale = MIN_SCALE;
+        } else if (m_smoothedCost < TARGET_FRAME_COST * 0.8f) {
+            m_costScale += RECOVER_STEP;
+            if (m_costScale > 1.0f) m_costScale = 1.0f;
+        }
+    }
+
+    // 発生数にかける倍率（処理時間とプールの埋まり具合の厳しい方）
+    float GetScale(size_t active, size_t capacity) const {
+        float fill = capacity > 0 ? static_cast<float>(active) / capacity : 1.0f;
+        float pressure = 1.0f;
+        if (fill > PRESSURE_START) {
+            pressure = 1.0f - (fill - PRESSURE_START) / (1.0f - PRESSURE_START) * (1.0f - MIN_SCALE);
+        }
+        return pressure < m_costScale ? pressure : m_costScale;
+    }
+
+    // count 個の要求を絞った数（端数は次の要求へ持ち越すので1個ずつの発生も間引かれる）
+    int ScaleCount(int count, size_t active, size_t capacity) {
+        m_carry += count * GetScale(active, capacity);
+        int scaled = static_cast<int>(m_carry);
+        m_carry -= scaled;
+        return scaled;
+    }
+
+    // グローの重ね数（処理時間で絞っているときは1段）
+    int GetGlowLayers() const { return m_costScale >= 0.75f ? 2 : 1; }
+
+    float GetCostScale() const { return m_costScale; }
+    float GetSmoothedCost() const { return m_smoothedCost; }
+
+private:
+    float m_smoothedCost;
+    float m_costScale;
+    float m_carry;
+};
@@ -1,12 +1,109 @@
 ﻿#include "ParticleSystem.h"
 #include "Graphics.h"
+#include "JobSystem.h"
+#include <algorithm>
 #include <cmath>
 #include <cstdlib>
 
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define PARTICLE_SSE2 1
+#endif
+
 constexpr float PI = 3.14159265358979f;
 
+// 並列更新の1ジョブあたりのパーティクル数（4の倍数）
+constexpr uint32_t PARTICLE_JOB_CHUNK = 256;
+
+namespace {
+
+// 0〜range の乱数
+float RandRange(float range) {
+    return range * static_cast<float>(rand() % 1000) / 1000.0f;
+}
+
+// exp(x)（x ≤ 0 の小さい値用）: x/8 の4次までのテイラー展開を3回2乗する
+// |x| ≤ 1 で相対誤差 1e-5 未満。SIMD版と同じ式なので端数の扱いで結果が変わらない
+inline float ExpSmall(float x) {
+    float y = x * 0.125f;
+    float p = 1.0f + y * (1.0f + y * (0.5f + y * (1.0f / 6.0f + y * (1.0f / 24.0f))));
+    p *= p;
+    p *= p;
+    return p * p;
+}
+
+#ifdef PARTICLE_SSE2
+inline __m128 ExpSmall(__m128 x) {
+    __m128 y = _mm_mul_ps(x, _mm_set1_ps(0.125f));
+    __m128 p = _mm_add_ps(_mm_set1_ps(1.0f / 6.0f), _mm_mul_ps(y, _mm_set1_ps(1.0f / 24.0f)));
+    p = _mm_add_ps(_mm_set1_ps(0.5f), _mm_mul_ps(y, p));
+    p = _mm_add_ps(_mm_set1_ps(1.0f), _mm_mul_ps(y, p));
+    p = _mm_add_ps(_mm_set1_ps(1.0f), _mm_mul_ps(y, p));
+    p = _mm_mul_ps(p, p);
+    p = _mm_mul_ps(p, p);
+    return _mm_mul_ps(p, p);
+}
+#endif
+
+// 位置・重力・寿命・アルファ・大きさを [begin, end) について進める
+// 大きさは ds/dt = -SHRINK_RATE × (1 - 寿命比) × s を厳密に解く（寿命比は1ステップ内で直線なので中点で積分）
+struct ParticleKernel {
+    float* posX;
+    float* posY;
+    float* velX;
+    float* velY;
+    float* life;
+    const float* invMaxLife;
+    float* size;
+    float* alpha;
+
+    void Run(uint32_t begin, uint32_t end, float dt) const {
+        uint32_t i = begin;
+#ifdef PARTICLE_SSE2
+        const __m128 vdt = _mm_set1_ps(dt);
+        const __m128 gravity = _mm_set1_ps(ParticleSystem::GRAVITY * dt);
+        const __m128 shrink = _mm_set1_ps(ParticleSystem::SHRINK_RATE * dt);
+        const __m128 halfDt = _mm_set1_ps(0.5f * dt);
+        const __m128 one = _mm_set1_ps(1.0f);
+        for (; i + 4 <= end; i += 4) {
+            __m128 vx = _mm_loadu_ps(velX + i);
+            __m128 vy = _mm_loadu_ps(velY + i);
+            _mm_storeu_ps(posX + i, _mm_add_ps(_mm_loadu_ps(posX + i), _mm_mul_ps(vx, vdt)));
+            _mm_storeu_ps(posY + i, _mm_add_ps(_mm_loadu_ps(posY + i), _mm_mul_ps(vy, vdt)));
+            _mm_storeu_ps(velY + i, _mm_add_ps(vy, gravity));
+
+            __m128 l = _mm_sub_ps(_mm_loadu_ps(life + i), vdt);
+            __m128 inv = _mm_loadu_ps(invMaxLife + i);
+            __m128 ratio = _mm_mul_ps(l, inv);
+            _mm_storeu_ps(life + i, l);
+            _mm_storeu_ps(alpha + i, ratio);
+
+            __m128 midRatio = _mm_add_ps(ratio, _mm_mul_ps(halfDt, inv));
+            __m128 scale = ExpSmall(_mm_mul_ps(shrink, _mm_sub_ps(midRatio, one)));
+            _mm_storeu_ps(size + i, _mm_mul_ps(_mm_loadu_ps(size + i), scale));
+        }
+#endif
+        for (; i < end; i++) {
+            posX[i] += velX[i] * dt;
+            posY[i] += velY[i] * dt;
+            velY[i] += ParticleSystem::GRAVITY * dt;
+
+            life[i] -= dt;
+            float ratio = life[i] * invMaxLife[i];
+            alpha[i] = ratio;
+
+            float midRatio = ratio + 0.5f * dt * invMaxLife[i];
+            size[i] *= ExpSmall(ParticleSystem::SHRINK_RATE * dt * (midRatio - 1.0f));
+        }
+    }
+};
+
+} // namespace
+
 ParticleSystem::ParticleSystem()
     : m_maxParticles(500)
+    , m_activeCount(0)
+    , m_evicted(0)
 {
 }
 
@@ -15,209 +112,213 @@ ParticleSystem::~ParticleSystem() {
 
 void ParticleSystem::Initialize(int maxParticles) {
     m_maxParticles = maxParticles;
-    m_particles.reserve(maxParticles);
+    size_t count = static_cast<size_t>(maxParticles);
+    for (auto* component : { &m_posX, &m_posY, &m_velX, &m_velY, &m_life, &m_invMaxLife, &m_size, &m_alpha }) {
+        component->assign(count, 0.0f);
+    }
+    m_color.assign(count, XMFLOAT3(0, 0, 0));
+    m_evictOrder.reserve(count);
+    m_scoreTexts.reserve(MAX_SCORE_TEXTS);
+    m_activeCount = 0;
+}
+
+// 生きている列の末尾を1つ使う（空きは常に [m_activeCount, max) なので探さない）
+int ParticleSystem::Allocate() {
+    if (m_activeCount >= static_cast<size_t>(m_maxParticles)) return -1;
+    return static_cast<int>(m_activeCount++);
+}
+
+void ParticleSystem::Move(size_t to, size_t from) {
+    m_posX[to] = m_posX[from];
+    m_posY[to] = m_posY[from];
+    m_velX[to] = m_velX[from];
+    m_velY[to] = m_velY[from];
+    m_life[to] = m_life[from];
+    m_invMaxLife[to] = m_invMaxLife[from];
+    m_size[to] = m_size[from];
+    m_alpha[to] = m_alpha[from];
+    m_color[to] = m_color[from];
 }
 
-void ParticleSystem::Update(float deltaTime) {
-    for (auto& p : m_particles) {
-        if (!p.isActive) continue;
+void ParticleSystem::Update(float deltaTime, JobSystem* jobs) {
+    // 各パーティクルは独立なのでチャンクごとに並列に動かせる
+    ParticleKernel kernel = {
+        m_posX.data(), m_posY.data(), m_velX.data(), m_velY.data(),
+        m_life.data(), m_invMaxLife.data(), m_size.data(), m_alpha.data(),
+    };
+    auto integrate = [&kernel, deltaTime](uint32_t begin, uint32_t end) {
+        kernel.Run(begin, end, deltaTime);
+    };
+
+    uint32_t count = static_cast<uint32_t>(m_activeCount);
+    if (jobs) {
+        jobs->ParallelFor(count, PARTICLE_JOB_CHUNK, integrate);
+    } else {
+        integrate(0, count);
+    }
 
-        // Update position
-        p.position.x += p.velocity.x * deltaTime;
-        p.position.y += p.velocity.y * deltaTime;
+    // 並列更新が終わってから1スレッドで詰める
+    Compact();
 
-        // Apply gravity (slight downward pull)
-        p.velocity.y += 50.0f * deltaTime;
+    for (size_t i = 0; i < m_scoreTexts.size(); ) {
+        ScoreText& text = m_scoreTexts[i];
+        text.position.y -= SCORE_TEXT_RISE * deltaTime;
+        text.life -= deltaTime;
+        if (text.life > 0.0f) {
+            i++;
+        } else {
+            text = m_scoreTexts.back();
+            m_scoreTexts.pop_back();
+        }
+    }
+}
 
-        // Fade out and shrink
-        p.life -= deltaTime;
-        if (p.life <= 0) {
-            p.isActive = false;
+// 寿命が尽きたものは末尾と入れ替えて詰める
+void ParticleSystem::Compact() {
+    for (size_t i = 0; i < m_activeCount; ) {
+        if (m_life[i] > 0.0f) {
+            i++;
+        } else {
+            Move(i, --m_activeCount);
         }
+    }
+}
 
-        // Update color alpha based on life
-        float lifeRatio = p.life / p.maxLife;
-        p.color.w = lifeRatio;
-        p.size = p.size * (0.95f + 0.05f * lifeRatio);
+// 見た目の大きさ×濃さが小さいものから count 個消す
+void ParticleSystem::EvictLeastVisible(size_t count) {
+    if (count == 0 || m_activeCount == 0) return;
+    if (count > m_activeCount) count = m_activeCount;
+
+    auto visibility = [this](uint32_t i) { return m_size[i] * m_alpha[i]; };
+    m_evictOrder.resize(m_activeCount);
+    for (uint32_t i = 0; i < m_activeCount; i++) m_evictOrder[i] = i;
+    std::nth_element(m_evictOrder.begin(), m_evictOrder.begin() + (count - 1), m_evictOrder.end(),
+        [&visibility](uint32_t a, uint32_t b) { return visibility(a) < visibility(b); });
+    for (size_t i = 0; i < count; i++) {
+        m_life[m_evictOrder[i]] = 0.0f;
     }
+    Compact();
+    m_evicted += count;
 }
 
-void ParticleSystem::Render(Graphics* graphics) {
-    for (const auto& p : m_particles) {
-        if (!p.isActive) continue;
+void ParticleSystem::PublishSnapshot() {
+    std::vector<ParticleSprite>& sprites = m_snapshot.BeginWrite();
+    int glowLayers = m_governor.GetGlowLayers();
+    for (size_t i = 0; i < m_activeCount; i++) {
+        float lifeRatio = m_life[i] * m_invMaxLife[i];
+        const XMFLOAT3& c = m_color[i];
+        sprites.push_back({
+            XMFLOAT2(m_posX[i], m_posY[i]),
+            m_size[i] * (1.0f + (1.0f - lifeRatio) * 0.5f),
+            XMFLOAT4(c.x, c.y, c.z, m_alpha[i]),
+            glowLayers,
+        });
+    }
+    m_snapshot.Publish();
 
-        float lifeRatio = p.life / p.maxLife;
-        
+    std::vector<ScoreTextSprite>& texts = m_scoreSnapshot.BeginWrite();
+    for (const ScoreText& text : m_scoreTexts) {
+        float alpha = text.life / SCORE_TEXT_LIFE;
+        texts.push_back({ text.position, alpha < 1.0f ? alpha : 1.0f, text.score });
+    }
+    m_scoreSnapshot.Publish();
+}
+
+void ParticleSystem::Render(Graphics* graphics) {
+    for (const auto& sprite : m_snapshot.AcquireLatest()) {
         // Draw glow effect
         graphics->DrawGlowCircle(
-            p.position.x,
-            p.position.y,
-            p.size * (1.0f + (1.0f - lifeRatio) * 0.5f),
-            p.color,
-            2
+            sprite.position.x,
+            sprite.position.y,
+            sprite.radius,
+            sprite.color,
+            sprite.glowLayers
         );
     }
 }
 
-void ParticleSystem::SpawnExplosion(float x, float y, XMFLOAT4 color, int count) {
-    for (int i = 0; i < count; i++) {
-        // Find inactive particle
-        Particle* particle = nullptr;
-        for (auto& p : m_particles) {
-            if (!p.isActive) {
-                particle = &p;
-                break;
-            }
-        }
-        
-        if (!particle && m_particles.size() < static_cast<size_t>(m_maxParticles)) {
-            m_particles.push_back(Particle());
-            particle = &m_particles.back();
-        }
-        
-        if (!particle) continue;
-
-        // Random angle and speed
-        float angle = (2.0f * PI * i) / count + (rand() % 100) / 100.0f * 0.5f;
-        float speed = 100.0f + (rand() % 200);
-
-        particle->position = { x, y };
-        particle->velocity = { cosf(angle) * speed, sinf(angle) * speed - 100.0f };
-        
-        // Color variation
-        float hueShift = (rand() % 100) / 100.0f * 0.3f;
-        particle->color = {
-            fminf(1.0f, color.x + hueShift),
-            fminf(1.0f, color.y + hueShift * 0.5f),
-            fminf(1.0f, color.z + (1.0f - hueShift)),
-            1.0f
-        };
-        
-        particle->size = 4.0f + (rand() % 8);
-        particle->life = 0.5f + (rand() % 100) / 100.0f * 0.5f;
-        particle->maxLife = particle->life;
-        particle->isActive = true;
+void ParticleSystem::RenderScoreText(Graphics* graphics) {
+    if (!graphics->HasGlyphs()) return;
+    for (const auto& text : m_scoreSnapshot.AcquireLatest()) {
+        // 桁を後ろから詰める（書式化なしで整数だけ）
+        wchar_t buffer[16];
+        wchar_t* p = buffer + 15;
+        *p = L'\0';
+        int value = text.score > 0 ? text.score : 0;
+        do {
+            *--p = static_cast<wchar_t>(L'0' + value % 10);
+            value /= 10;
+        } while (value > 0 && p > buffer);
+        graphics->DrawGlyphText(p, text.position.x, text.position.y, 1.0f,
+                                XMFLOAT4(1.0f, 0.9f, 0.3f, text.alpha));
     }
 }
 
-void ParticleSystem::SpawnStarBurst(float x, float y, XMFLOAT4 color, int count) {
+void ParticleSystem::Emit(const ParticleEmitter& emitter, float x, float y, XMFLOAT4 color, int count) {
+    if (count <= 0) count = emitter.count;
+    size_t capacity = static_cast<size_t>(m_maxParticles);
+    count = m_governor.ScaleCount(count, m_activeCount, capacity);
+    if (count <= 0) return;
+
+    // 入りきらない分は古い・薄い・小さいものを消して空ける（新しい方が目立つ）
+    if (static_cast<size_t>(count) > capacity) count = static_cast<int>(capacity);
+    size_t room = capacity - m_activeCount;
+    if (static_cast<size_t>(count) > room) EvictLeastVisible(count - room);
+
     for (int i = 0; i < count; i++) {
-        Particle* particle = nullptr;
-        for (auto& p : m_particles) {
-            if (!p.isActive) {
-                particle = &p;
-                break;
-            }
+        int index = Allocate();
+        if (index < 0) return;
+
+        float offsetX = RandRange(emitter.positionJitter.x * 2.0f) - emitter.positionJitter.x;
+        float offsetY = RandRange(emitter.positionJitter.y * 2.0f) - emitter.positionJitter.y;
+        m_posX[index] = x + offsetX;
+        m_posY[index] = y + offsetY;
+
+        // リング状に等分した向き＋速度の乱数
+        float vx = emitter.velocityBias.x + offsetX * emitter.offsetToVelocity.x;
+        float vy = emitter.velocityBias.y + offsetY * emitter.offsetToVelocity.y;
+        vx += RandRange(emitter.velocityJitter.x * 2.0f) - emitter.velocityJitter.x;
+        vy += RandRange(emitter.velocityJitter.y * 2.0f) - emitter.velocityJitter.y;
+        if (emitter.speedMin > 0.0f || emitter.speedRange > 0.0f) {
+            float angle = (2.0f * PI * i) / count + RandRange(emitter.angleJitter);
+            float speed = emitter.speedMin + RandRange(emitter.speedRange);
+            vx += cosf(angle) * speed;
+            vy += sinf(angle) * speed;
         }
-        
-        if (!particle && m_particles.size() < static_cast<size_t>(m_maxParticles)) {
-            m_particles.push_back(Particle());
-            particle = &m_particles.back();
+        m_velX[index] = vx;
+        m_velY[index] = vy;
+
+        // Color variation
+        if (emitter.hueShift > 0.0f) {
+            float hueShift = RandRange(emitter.hueShift);
+            m_color[index] = {
+                fminf(1.0f, color.x + hueShift),
+                fminf(1.0f, color.y + hueShift * 0.5f),
+                fminf(1.0f, color.z + (1.0f - hueShift)),
+            };
+            m_alpha[index] = 1.0f;
+        } else {
+            m_color[index] = { color.x, color.y, color.z };
+            m_alpha[index] = color.w;
         }
-        
-        if (!particle) continue;
-
-        float angle = (2.0f * PI * i) / count;
-        float speed = 150.0f + (rand() % 100);
-
-        particle->position = { x, y };
-        particle->velocity = { cosf(angle) * speed, sinf(angle) * speed };
-        particle->color = color;
-        particle->size = 6.0f;
-        particle->life = 0.8f;
-        particle->maxLife = particle->life;
-        particle->isActive = true;
+
+        float life = emitter.lifeMin + RandRange(emitter.lifeRange);
+        m_life[index] = life;
+        m_invMaxLife[index] = 1.0f / life;
+        m_size[index] = emitter.sizeMin + RandRange(emitter.sizeRange);
     }
 }
 
 void ParticleSystem::SpawnScorePopup(float x, float y, int score) {
     // Spawn golden particles for score
     XMFLOAT4 goldColor = { 1.0f, 0.9f, 0.3f, 1.0f };
-    
-    int count = 5 + score / 100;
-    if (count > 20) count = 20;
-    
-    for (int i = 0; i < count; i++) {
-        Particle* particle = nullptr;
-        for (auto& p : m_particles) {
-            if (!p.isActive) {
-                particle = &p;
-                break;
-            }
-        }
-        
-        if (!particle && m_particles.size() < static_cast<size_t>(m_maxParticles)) {
-            m_particles.push_back(Particle());
-            particle = &m_particles.back();
-        }
-        
-        if (!particle) continue;
-
-        float offsetX = (rand() % 40) - 20.0f;
-        float offsetY = (rand() % 20) - 10.0f;
-
-        particle->position = { x + offsetX, y + offsetY };
-        particle->velocity = { offsetX * 2.0f, -100.0f - (rand() % 50) };
-        particle->color = goldColor;
-        particle->size = 3.0f + (rand() % 4);
-        particle->life = 0.6f;
-        particle->maxLife = particle->life;
-        particle->isActive = true;
-    }
-}
-
-void ParticleSystem::SpawnTrail(float x, float y, XMFLOAT4 color) {
-    Particle* particle = nullptr;
-    for (auto& p : m_particles) {
-        if (!p.isActive) {
-            particle = &p;
-            break;
-        }
-    }
-    
-    if (!particle && m_particles.size() < static_cast<size_t>(m_maxParticles)) {
-        m_particles.push_back(Particle());
-        particle = &m_particles.back();
-    }
-    
-    if (!particle) return;
 
-    particle->position = { x + (rand() % 10) - 5.0f, y };
-    particle->velocity = { 0, 30.0f };
-    particle->color = color;
-    particle->size = 3.0f;
-    particle->life = 0.3f;
-    particle->maxLife = particle->life;
-    particle->isActive = true;
-}
+    int count = ParticleEmitters::SCORE_POPUP.count + score / 100;
+    if (count > 20) count = 20;
+    Emit(ParticleEmitters::SCORE_POPUP, x, y, goldColor, count);
 
-void ParticleSystem::SpawnHitEffect(float x, float y, XMFLOAT4 color) {
-    int count = 8;
-    for (int i = 0; i < count; i++) {
-        Particle* particle = nullptr;
-        for (auto& p : m_particles) {
-            if (!p.isActive) {
-                particle = &p;
-                break;
-            }
-        }
-        
-        if (!particle && m_particles.size() < static_cast<size_t>(m_maxParticles)) {
-            m_particles.push_back(Particle());
-            particle = &m_particles.back();
-        }
-        
-        if (!particle) continue;
-
-        float angle = (2.0f * PI * i) / count;
-        float speed = 80.0f + (rand() % 60);
-
-        particle->position = { x, y };
-        particle->velocity = { cosf(angle) * speed, sinf(angle) * speed };
-        particle->color = color;
-        particle->size = 3.0f + (rand() % 3);
-        particle->life = 0.25f;
-        particle->maxLife = particle->life;
-        particle->isActive = true;
+    // 数字はパーティクルと違い1枚のアトラスで1回のDrawなので間引かない（あふれた分だけ捨てる）
+    if (m_scoreTexts.size() < MAX_SCORE_TEXTS) {
+        m_scoreTexts.push_back({ XMFLOAT2(x, y - 20.0f), SCORE_TEXT_LIFE, score });
     }
 }
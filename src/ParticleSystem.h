@@ -2,47 +2,143 @@
 
 #include <vector>
 #include <DirectXMath.h>
+#include "ParticleGovernor.h"
+#include "RenderSnapshot.h"
 
 using namespace DirectX;
 
-struct Particle {
+// パーティクルの出し方（乱数幅はすべて0〜range、Jitter は ±range）
+struct ParticleEmitter {
+    int count = 1;                          // 1回に出す数（リング状に等分）
+    float angleJitter = 0.0f;               // リング角に足す乱数幅（ラジアン）
+    float speedMin = 0.0f;
+    float speedRange = 0.0f;
+    XMFLOAT2 positionJitter = { 0, 0 };
+    XMFLOAT2 velocityBias = { 0, 0 };       // 速度に足す一定値
+    XMFLOAT2 velocityJitter = { 0, 0 };
+    XMFLOAT2 offsetToVelocity = { 0, 0 };   // 発生位置のずれ×係数を速度に足す
+    float sizeMin = 3.0f;
+    float sizeRange = 0.0f;
+    float lifeMin = 0.5f;
+    float lifeRange = 0.0f;
+    float hueShift = 0.0f;                  // 0より大きければ色をランダムにずらす
+};
+
+namespace ParticleEmitters {
+
+// 敵の撃破・ボム
+inline constexpr ParticleEmitter EXPLOSION = {
+    .count = 30, .angleJitter = 0.5f, .speedMin = 100.0f, .speedRange = 200.0f,
+    .velocityBias = { 0.0f, -100.0f },
+    .sizeMin = 4.0f, .sizeRange = 8.0f, .lifeMin = 0.5f, .lifeRange = 0.5f, .hueShift = 0.3f,
+};
+
+// パワーアップ
+inline constexpr ParticleEmitter STAR_BURST = {
+    .count = 15, .speedMin = 150.0f, .speedRange = 100.0f, .sizeMin = 6.0f, .lifeMin = 0.8f,
+};
+
+// 得点（数は SpawnScorePopup が得点から決める）
+inline constexpr ParticleEmitter SCORE_POPUP = {
+    .count = 5, .positionJitter = { 20.0f, 10.0f },
+    .velocityBias = { 0.0f, -125.0f }, .velocityJitter = { 0.0f, 25.0f }, .offsetToVelocity = { 2.0f, 0.0f },
+    .sizeMin = 3.0f, .sizeRange = 4.0f, .lifeMin = 0.6f,
+};
+
+// ボス周りの人魂など
+inline constexpr ParticleEmitter TRAIL = {
+    .count = 1, .positionJitter = { 5.0f, 0.0f }, .velocityBias = { 0.0f, 30.0f },
+    .sizeMin = 3.0f, .lifeMin = 0.3f,
+};
+
+// 被弾
+inline constexpr ParticleEmitter HIT = {
+    .count = 8, .speedMin = 80.0f, .speedRange = 60.0f, .sizeMin = 3.0f, .sizeRange = 3.0f, .lifeMin = 0.25f,
+};
+
+} // namespace ParticleEmitters
+
+// 描画用スナップショット（半径は寿命による膨らみ込み）
+struct ParticleSprite {
     XMFLOAT2 position;
-    XMFLOAT2 velocity;
+    float radius;
     XMFLOAT4 color;
-    float size;
-    float life;
-    float maxLife;
-    bool isActive;
+    int glowLayers;
+};
+
+// 浮かび上がる得点の数字（描画はグリフアトラスで）
+struct ScoreTextSprite {
+    XMFLOAT2 position;
+    float alpha;
+    int score;
 };
 
 class Graphics;
+class JobSystem;
 
 class ParticleSystem {
 public:
+    static constexpr float GRAVITY = 50.0f;
+    static constexpr float SHRINK_RATE = 3.0f;  // 寿命の尽き具合×この割合で指数的に縮む（毎秒、フレームレートによらない）
+    static constexpr size_t MAX_SCORE_TEXTS = 512;
+    static constexpr float SCORE_TEXT_LIFE = 0.8f;
+    static constexpr float SCORE_TEXT_RISE = 60.0f;  // 上昇速度（px/秒）
+
     ParticleSystem();
     ~ParticleSystem();
 
     void Initialize(int maxParticles = 500);
-    void Update(float deltaTime);
-    void Render(Graphics* graphics);
-    void Clear() { for (auto& p : m_particles) p.isActive = false; }
-
-    // Explosion effect when enemy dies
-    void SpawnExplosion(float x, float y, XMFLOAT4 color, int count = 30);
-    
-    // Star burst for power-up
-    void SpawnStarBurst(float x, float y, XMFLOAT4 color, int count = 15);
-    
-    // Score pop-up effect
+    void Update(float deltaTime, JobSystem* jobs = nullptr);  // jobsがあればチャンク並列
+    void Render(Graphics* graphics);  // 最後に公開されたスナップショットを描く
+    void RenderScoreText(Graphics* graphics);  // 得点の数字（Popupsレイヤーで呼ぶ）
+    void Clear() { m_activeCount = 0; m_scoreTexts.clear(); }
+    void PublishSnapshot();
+
+    // emitter の設定で (x, y) に出す（count が0なら emitter.count 個）
+    // 数は負荷に応じて絞り、それでも入りきらなければ目立たないものから消して空ける
+    void Emit(const ParticleEmitter& emitter, float x, float y, XMFLOAT4 color, int count = 0);
+
+    // 得点が大きいほど多く出す（数字も浮かべる）
     void SpawnScorePopup(float x, float y, int score);
+    size_t GetScoreTextCount() const { return m_scoreTexts.size(); }
+
+    // 前フレームの処理時間（秒）を渡して発生量を調整する
+    void SetFrameCost(float frameCost) { m_governor.SetFrameCost(frameCost); }
+    const ParticleGovernor& GetGovernor() const { return m_governor; }
 
-    // Sparkle trail
-    void SpawnTrail(float x, float y, XMFLOAT4 color);
-    
-    // Hit effect
-    void SpawnHitEffect(float x, float y, XMFLOAT4 color);
+    size_t GetActiveCount() const { return m_activeCount; }
+    uint64_t GetEvictedCount() const { return m_evicted; }
+    float GetSize(size_t index) const { return m_size[index]; }
+    float GetLife(size_t index) const { return m_life[index]; }
 
 private:
-    std::vector<Particle> m_particles;
+    int Allocate();  // 空きがなければ-1
+    void Move(size_t to, size_t from);
+    void Compact();                 // 寿命の尽きたものを詰める
+    void EvictLeastVisible(size_t count);
+
+    // 成分ごとの配列（SoA）。生きているパーティクルは [0, m_activeCount) に詰めて並べる
+    std::vector<float> m_posX;
+    std::vector<float> m_posY;
+    std::vector<float> m_velX;
+    std::vector<float> m_velY;
+    std::vector<float> m_life;
+    std::vector<float> m_invMaxLife;
+    std::vector<float> m_size;
+    std::vector<float> m_alpha;
+    std::vector<XMFLOAT3> m_color;
+    std::vector<uint32_t> m_evictOrder;
+
+    struct ScoreText {
+        XMFLOAT2 position;
+        float life;
+        int score;
+    };
+    std::vector<ScoreText> m_scoreTexts;
     int m_maxParticles;
+    size_t m_activeCount;
+    uint64_t m_evicted;
+    ParticleGovernor m_governor;
+    SnapshotBuffer<ParticleSprite> m_snapshot;
+    SnapshotBuffer<ScoreTextSprite> m_scoreSnapshot;
 };
@@ -3,7 +3,6 @@
 #include "Input.h"
 #include "BulletManager.h"
 #include "AudioManager.h"
-#include "TextureLoader.h"
 #include <windows.h>
 
 using namespace DirectX;
@@ -28,21 +27,6 @@ Player::~Player() {
 void Player::Initialize(Graphics* graphics, BulletManager* bulletManager, AudioManager* sound) {
     m_bulletManager = bulletManager;
     m_sound = sound;
-    
-    // Load player texture
-    TextureLoader loader;
-    loader.Initialize(graphics->GetDevice());
-    
-    wchar_t exePath[MAX_PATH];
-    GetModuleFileNameW(nullptr, exePath, MAX_PATH);
-    std::wstring path(exePath);
-    size_t lastSlash = path.find_last_of(L"\\/");
-    std::wstring texturePath = path.substr(0, lastSlash) + L"\\..\\..\\assets\\textures\\sprites\\player.png";
-    
-    ID3D11ShaderResourceView* srv = nullptr;
-    if (loader.LoadTexture(texturePath, &srv)) {
-        m_texture.Attach(srv);
-    }
 }
 
 void Player::Update(Input* input, float deltaTime, int screenWidth, int screenHeight) {
@@ -165,11 +149,11 @@ void Player::Render(Graphics* graphics) {
         XMFLOAT4(1.0f, 0.6f, 0.7f, 0.3f), 3);
     
     // Draw player texture if available
-    if (m_texture) {
-        graphics->DrawTexturedSprite(
+    if (graphics->HasSprite(SpriteId::Player)) {
+        graphics->DrawAtlasSprite(
             m_position.x - halfSize, m_position.y - halfSize,
             m_size, m_size,
-            m_texture.Get(), XMFLOAT4(1, 1, 1, 1));
+            SpriteId::Player, XMFLOAT4(1, 1, 1, 1));
     } else {
         // Fallback: simple shape
         graphics->DrawCircle(m_position.x, m_position.y, halfSize * 0.8f,
@@ -43,5 +43,4 @@ private:
 
     BulletManager* m_bulletManager;
     AudioManager* m_sound;
-    ComPtr<ID3D11ShaderResourceView> m_texture;
 };
@@ -0,0 +1,223 @@
+﻿#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <vector>
+#include <DirectXMath.h>
+
+// 描画レイヤー（小さい順に描く）
+enum class RenderLayer : uint8_t {
+    Backdrop,    // プレイエリアの下地・枠
+    Background,  // 星空
+    Enemies,
+    Bullets,
+    Items,
+    Player,
+    Particles,
+    Popups,      // 得点の数字（グリフアトラス1枚なのでまとめて1回のDraw）
+    UI
+};
+
+enum class BlendMode : uint8_t {
+    Alpha,
+    Additive,
+    Opaque     // 合成なしで上書き（合成済みレイヤーの貼り付け用、順序はアルファと同じく記録順）
+};
+
+// 使うシェーダーの組み合わせ
+enum class RenderPipeline : uint8_t {
+    Color,     // 頂点カラーそのまま
+    Palette,   // 頂点カラー = (パレット番号, 乗算, 加算, アルファ)
+    Textured,  // テクスチャ × 頂点カラー
+    Starfield  // 背景の星（インスタンスバッファの種と時刻から頂点シェーダーで配置）
+};
+
+enum class RenderPrimitive : uint8_t {
+    Quad,  // x, y, w, h の矩形（color0、テクスチャ座標 uv）
+    Fan,       // 中心 x, y・半径 w のグラデーション円（中心 color0 → 外周 color1）
+    Instances  // 頂点を持たないインスタンス描画（x = 時刻、w, h = 画面の大きさ）
+};
+
+struct RenderCommand {
+    uint64_t key;
+    RenderPrimitive primitive;
+    RenderPipeline pipeline;
+    BlendMode blend;
+    RenderLayer layer;
+    uint16_t texture;
+    float x, y, w, h;
+    DirectX::XMFLOAT4 color0;
+    DirectX::XMFLOAT4 color1;
+    DirectX::XMFLOAT4 uv;  // (u0, v0, u1, v1)
+};
+
+// 1フレーム分の描画コマンド列
+// 各サブシステムはレイヤーを指定して記録だけ行い、最後に64bitキーで基数ソートしてから
+// まとめて提出する。GPUが無くても件数やバッチ数を数えたり中身を書き出したりできる
+//
+// キー: [63:56] レイヤー  [55] 0=アルファ / 1=加算  [47:32] 加算のみ描画状態  [31:0] 記録順
+// アルファ合成は順序で結果が変わるので記録順のまま、加算は順序に依らないので状態ごとにまとめる
+class RenderQueue {
+public:
+    static constexpr uint16_t NO_TEXTURE = 0xFFFF;
+
+    RenderQueue() : m_layer(RenderLayer::Backdrop), m_sequence(0), m_sorted(false) {}
+
+    // フレーム開始（確保済みの領域はそのまま使い回す）
+    void Reset() {
+        m_commands.clear();
+        m_textures.clear();
+        m_order.clear();
+        m_palette.clear();
+        m_layer = RenderLayer::Backdrop;
+        m_sequence = 0;
+        m_sorted = false;
+    }
+
+    void SetLayer(RenderLayer layer) { m_layer = layer; }
+    RenderLayer GetLayer() const { return m_layer; }
+
+    // テクスチャをフレーム内の番号に変換（同じものは同じ番号）
+    uint16_t TextureId(const void* texture) {
+        if (!texture) return NO_TEXTURE;
+        for (size_t i = 0; i < m_textures.size(); i++) {
+            if (m_textures[i] == texture) return static_cast<uint16_t>(i);
+        }
+        m_textures.push_back(texture);
+        return static_cast<uint16_t>(m_textures.size() - 1);
+    }
+    const void* GetTexture(uint16_t id) const { return id == NO_TEXTURE ? nullptr : m_textures[id]; }
+
+    void PushQuad(RenderPipeline pipeline, BlendMode blend, uint16_t texture,
+                  float x, float y, float width, float height, DirectX::XMFLOAT4 color,
+                  DirectX::XMFLOAT4 uv = DirectX::XMFLOAT4(0.0f, 0.0f, 1.0f, 1.0f)) {
+        Push(RenderPrimitive::Quad, pipeline, blend, texture, x, y, width, height, color, color, uv);
+    }
+
+    void PushFan(RenderPipeline pipeline, BlendMode blend,
+                 float x, float y, float radius, DirectX::XMFLOAT4 inner, DirectX::XMFLOAT4 outer) {
+        Push(RenderPrimitive::Fan, pipeline, blend, NO_TEXTURE, x, y, radius, 0.0f, inner, outer,
+             DirectX::XMFLOAT4(0.0f, 0.0f, 1.0f, 1.0f));
+    }
+
+    // 背景の星をまとめて1コマンド（星の数に関わらず1回のDraw）
+    void PushStarfield(float time, float width, float height) {
+        DirectX::XMFLOAT4 white(1.0f, 1.0f, 1.0f, 1.0f);
+        Push(RenderPrimitive::Instances, RenderPipeline::Starfield, BlendMode::Additive, NO_TEXTURE,
+             time, 0.0f, width, height, white, white, DirectX::XMFLOAT4(0.0f, 0.0f, 1.0f, 1.0f));
+    }
+
+    // 記録中に更新された弾パレット（提出の前にまとめて転送する、更新が無ければ空）
+    void SetPalette(const DirectX::XMFLOAT4* colors, size_t count) { m_palette.assign(colors, colors + count); }
+    bool HasPalette() const { return !m_palette.empty(); }
+    const DirectX::XMFLOAT4* GetPalette() const { return m_palette.data(); }
+
+    // キーで並べ替え（LSD基数ソート、全件同じ桁は飛ばす）
+    void Sort() {
+        uint32_t count = static_cast<uint32_t>(m_commands.size());
+        m_order.resize(count);
+        m_scratch.resize(count);
+        for (uint32_t i = 0; i < count; i++) m_order[i] = i;
+
+        for (int shift = 0; shift < 64 && count > 0; shift += 8) {
+            uint32_t histogram[256] = {};
+            for (uint32_t i = 0; i < count; i++) {
+                histogram[(m_commands[m_order[i]].key >> shift) & 0xFF]++;
+            }
+            if (histogram[(m_commands[m_order[0]].key >> shift) & 0xFF] == count) continue;
+
+            uint32_t offset = 0;
+            for (uint32_t& bucket : histogram) {
+                uint32_t n = bucket;
+                bucket = offset;
+                offset += n;
+            }
+            for (uint32_t i = 0; i < count; i++) {
+                uint32_t index = m_order[i];
+                m_scratch[histogram[(m_commands[index].key >> shift) & 0xFF]++] = index;
+            }
+            m_order.swap(m_scratch);
+        }
+        m_sorted = true;
+    }
+
+    size_t size() const { return m_commands.size(); }
+    bool IsSorted() const { return m_sorted; }
+
+    // ソート後 i 番目のコマンド（Sort前は記録順）
+    const RenderCommand& GetSorted(size_t i) const {
+        return m_sorted ? m_commands[m_order[i]] : m_commands[i];
+    }
+
+    // 描画状態（パイプライン・ブレンド・テクスチャ）が同じ連続区間の数 = 提出時のバッチ数
+    size_t CountBatches() const {
+        size_t batches = 0;
+        for (size_t i = 0; i < m_commands.size(); i++) {
+            if (i == 0 || !SameState(GetSorted(i - 1), GetSorted(i))) batches++;
+        }
+        return batches;
+    }
+
+    static bool SameState(const RenderCommand& a, const RenderCommand& b) {
+        return a.pipeline == b.pipeline && a.blend == b.blend && a.texture == b.texture;
+    }
+
+    // デバッグ用の書き出し（1行1コマンド、提出順）
+    void Dump(std::ostream& out) const {
+        static const char* layerNames[] = { "Backdrop", "Background", "Enemies", "Bullets",
+                                            "Items", "Player", "Particles", "Popups", "UI" };
+        static const char* blendNames[] = { "alpha", "add", "opaque" };
+        static const char* pipelineNames[] = { "Color", "Palette", "Textured", "Starfield" };
+        static const char* primitiveNames[] = { "quad", "fan", "instances" };
+        out << "RenderQueue: " << m_commands.size() << " commands, " << CountBatches() << " batches\n";
+        for (size_t i = 0; i < m_commands.size(); i++) {
+            const RenderCommand& c = GetSorted(i);
+            out << i << ' ' << layerNames[static_cast<int>(c.layer)]
+                << ' ' << blendNames[static_cast<int>(c.blend)] << ' '
+                << pipelineNames[static_cast<int>(c.pipeline)]
+                << ' ' << primitiveNames[static_cast<int>(c.primitive)] << ' ';
+            if (c.texture != NO_TEXTURE) out << "tex" << c.texture << ' ';
+            out << c.x << ',' << c.y << ' ' << c.w << ',' << c.h << '\n';
+        }
+    }
+
+private:
+    void Push(RenderPrimitive primitive, RenderPipeline pipeline, BlendMode blend, uint16_t texture,
+              float x, float y, float w, float h, DirectX::XMFLOAT4 color0, DirectX::XMFLOAT4 color1,
+              DirectX::XMFLOAT4 uv) {
+        RenderCommand command;
+        command.key = MakeKey(m_layer, blend, pipeline, texture, m_sequence++);
+        command.primitive = primitive;
+        command.pipeline = pipeline;
+        command.blend = blend;
+        command.layer = m_layer;
+        command.texture = texture;
+        command.x = x;
+        command.y = y;
+        command.w = w;
+        command.h = h;
+        command.color0 = color0;
+        command.color1 = color1;
+        command.uv = uv;
+        m_commands.push_back(command);
+        m_sorted = false;
+    }
+
+    static uint64_t MakeKey(RenderLayer layer, BlendMode blend, RenderPipeline pipeline, uint16_t texture, uint32_t sequence) {
+        uint64_t key = static_cast<uint64_t>(layer) << 56;
+        if (blend == BlendMode::Additive) {
+            uint64_t state = (static_cast<uint64_t>(pipeline) << 14) | (texture & 0x3FFF);
+            key |= (1ull << 55) | (state << 32);
+        }
+        return key | sequence;
+    }
+
+    std::vector<RenderCommand> m_commands;   // フレーム単位のアリーナ（clearしても容量は残る）
+    std::vector<const void*> m_textures;
+    std::vector<uint32_t> m_order;
+    std::vector<uint32_t> m_scratch;
+    std::vector<DirectX::XMFLOAT4> m_palette;
+    RenderLayer m_layer;
+    uint32_t m_sequence;
+    bool m_sorted;
+};
@@ -0,0 +1,66 @@
+﻿#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+// スレッド間の受け渡し用トリプルバッファ
+// 書き手は BeginWrite で得たバッファに書いて Publish、読み手は AcquireLatest で
+// 最新の公開済みバッファを取る。書き手と読み手が同じバッファに触れることはない
+// バッファは作り直さずに使い回す（中身の片付けは書き手が行う）
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() : m_writeIndex(0), m_readIndex(1), m_middle(2), m_published(0) {}
+
+    // 書き込み用バッファ（前に書いた内容が残っている）
+    T& BeginWrite() { return m_buffers[m_writeIndex]; }
+
+    // 書き終えたバッファを公開し、前回の公開分（未読なら捨てる）を次の書き込み先にする
+    void Publish() {
+        uint8_t previous = m_middle.exchange(static_cast<uint8_t>(m_writeIndex | FRESH_BIT), std::memory_order_acq_rel);
+        m_writeIndex = previous & INDEX_MASK;
+        m_published.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // 新しい公開分があれば受け取る（なければ前回と同じ内容）
+    T& AcquireLatest() {
+        if (m_middle.load(std::memory_order_acquire) & FRESH_BIT) {
+            uint8_t previous = m_middle.exchange(m_readIndex, std::memory_order_acq_rel);
+            m_readIndex = previous & INDEX_MASK;
+        }
+        return m_buffers[m_readIndex];
+    }
+
+    uint64_t GetPublishedCount() const { return m_published.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr uint8_t INDEX_MASK = 0x3;
+    static constexpr uint8_t FRESH_BIT = 0x4;
+
+    std::array<T, 3> m_buffers;
+    uint8_t m_writeIndex;            // 書き手専用
+    uint8_t m_readIndex;             // 読み手専用
+    std::atomic<uint8_t> m_middle;   // 受け渡し中のバッファ番号＋未読フラグ
+    std::atomic<uint64_t> m_published;
+};
+
+// シミュレーション→描画の受け渡し用（Update が書き、Render が読む）
+template <typename T>
+class SnapshotBuffer {
+public:
+    // 書き込み用バッファ（中身は空、確保済み容量は使い回す）
+    std::vector<T>& BeginWrite() {
+        std::vector<T>& buffer = m_buffers.BeginWrite();
+        buffer.clear();
+        return buffer;
+    }
+
+    void Publish() { m_buffers.Publish(); }
+    const std::vector<T>& AcquireLatest() { return m_buffers.AcquireLatest(); }
+    uint64_t GetPublishedCount() const { return m_buffers.GetPublishedCount(); }
+
+private:
+    TripleBuffer<std::vector<T>> m_buffers;
+};
@@ -0,0 +1,93 @@
+﻿#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include "RenderSnapshot.h"
+
+// 描画スレッド
+// メインスレッドが記録したフレーム（Frame）をトリプルバッファで受け取り、提出（ソート・Draw・Present）を受け持つ
+// メインは BeginFrame で書き込み先を取って記録し、Publish で渡す。その間こちらは前のフレームを提出する
+// 渡したフレームがまだ受け取られていなければ Publish で待つ（フレームを捨てないので差分の描画も欠けない）
+// D3D11 のコンテキストに触るのは提出中のこのスレッドだけ。メインで直接描くときは先に WaitIdle すること
+template <typename Frame>
+class RenderThread {
+public:
+    using SubmitFunc = std::function<void(Frame&)>;
+
+    explicit RenderThread(SubmitFunc submit)
+        : m_submit(std::move(submit)), m_published(0), m_acquired(0), m_submitted(0), m_quit(false) {
+        m_thread = std::thread(&RenderThread::ThreadMain, this);
+    }
+
+    // 渡し済みのフレームは提出し終えてから止める
+    ~RenderThread() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_quit = true;
+        }
+        m_wake.notify_all();
+        m_thread.join();
+    }
+
+    RenderThread(const RenderThread&) = delete;
+    RenderThread& operator=(const RenderThread&) = delete;
+
+    // 記録先のフレーム（メインスレッド専用、前に書いた内容が残っているので使う側で片付ける）
+    Frame& BeginFrame() { return m_frames.BeginWrite(); }
+
+    // 記録し終えたフレームを渡す（前に渡したフレームが受け取られるまで待つ）
+    void Publish() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_taken.wait(lock, [this]() { return m_acquired == m_published; });
+        m_frames.Publish();
+        m_published++;
+        lock.unlock();
+        m_wake.notify_all();
+    }
+
+    // 渡したフレームを全部提出し終えるまで待つ
+    void WaitIdle() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_idle.wait(lock, [this]() { return m_submitted == m_published; });
+    }
+
+    uint64_t GetSubmittedCount() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_submitted;
+    }
+
+private:
+    void ThreadMain() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true) {
+            m_wake.wait(lock, [this]() { return m_quit || m_acquired < m_published; });
+            if (m_acquired < m_published) {
+                Frame& frame = m_frames.AcquireLatest();
+                m_acquired++;
+                lock.unlock();
+                m_taken.notify_all();
+                m_submit(frame);
+                lock.lock();
+                m_submitted++;
+                m_idle.notify_all();
+            } else if (m_quit) {
+                return;
+            }
+        }
+    }
+
+    TripleBuffer<Frame> m_frames;
+    SubmitFunc m_submit;
+    std::thread m_thread;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wake;    // 新しいフレームが渡された
+    std::condition_variable m_taken;   // 渡したフレームが受け取られた
+    std::condition_variable m_idle;    // 提出し終えた
+    uint64_t m_published;
+    uint64_t m_acquired;
+    uint64_t m_submitted;
+    bool m_quit;
+};
@@ -0,0 +1,102 @@
+﻿#pragma once
+
+#include <cstdint>
+
+// サイドバーの表示項目
+enum class SidebarWidget : uint8_t {
+    HiScore,
+    Score,
+    Player,
+    Lives,
+    Bombs,
+    Power,
+    Special,
+    Graze,
+    Fps,
+    Count
+};
+
+// サイドバーを合成済みレイヤーとして使い回すための変更検出
+// 毎フレーム各項目の表示値を Set し、どれかが変わったフレームだけ描き直す
+// 描き直すのは変わった項目の縦範囲をまとめた帯だけ（それ以外はレイヤーに残っている絵を使う）
+class SidebarCache {
+public:
+    static constexpr int WIDGET_COUNT = static_cast<int>(SidebarWidget::Count);
+
+    SidebarCache() : m_dirtyMask(0), m_fullRedraw(true), m_height(0), m_composeCount(0) {
+        for (int i = 0; i < WIDGET_COUNT; i++) {
+            m_values[i] = 0;
+            m_top[i] = 0;
+            m_bottom[i] = 0;
+        }
+    }
+
+    // レイヤーの高さ（作り直したときも呼ぶ、次の合成は全体）
+    void Reset(int height) {
+        m_height = height;
+        Invalidate();
+    }
+
+    // 項目が占める縦範囲（文字・光彩を含む、上端〜下端）
+    void SetBand(SidebarWidget widget, int top, int bottom) {
+        m_top[Index(widget)] = top;
+        m_bottom[Index(widget)] = bottom;
+    }
+
+    // 表示値を渡す（前回と違えば描き直し対象）
+    void Set(SidebarWidget widget, int64_t value) {
+        int i = Index(widget);
+        if (m_values[i] != value) {
+            m_values[i] = value;
+            m_dirtyMask |= 1u << i;
+        }
+    }
+
+    bool IsDirty() const { return m_fullRedraw || m_dirtyMask != 0; }
+    bool IsDirty(SidebarWidget widget) const { return m_fullRedraw || (m_dirtyMask & (1u << Index(widget))) != 0; }
+    uint32_t GetDirtyMask() const { return m_dirtyMask; }
+
+    // 描き直す縦範囲（変わった項目の帯の和、全体描き直しならレイヤー全体）
+    bool GetDirtyBand(int* top, int* bottom) const {
+        if (m_fullRedraw) {
+            *top = 0;
+            *bottom = m_height;
+            return true;
+        }
+        if (m_dirtyMask == 0) return false;
+        bool found = false;
+        for (int i = 0; i < WIDGET_COUNT; i++) {
+            if ((m_dirtyMask & (1u << i)) == 0) continue;
+            if (!found || m_top[i] < *top) *top = m_top[i];
+            if (!found || m_bottom[i] > *bottom) *bottom = m_bottom[i];
+            found = true;
+        }
+        if (*top < 0) *top = 0;
+        if (*bottom > m_height) *bottom = m_height;
+        return *top < *bottom;
+    }
+
+    // 合成し終えたら呼ぶ
+    void MarkComposed() {
+        m_dirtyMask = 0;
+        m_fullRedraw = false;
+        m_composeCount++;
+    }
+
+    // 次の合成でレイヤー全体を描き直す
+    void Invalidate() { m_fullRedraw = true; }
+
+    // これまでに合成した回数（毎フレームではなく値が変わったときだけ増える）
+    uint64_t GetComposeCount() const { return m_composeCount; }
+
+private:
+    static int Index(SidebarWidget widget) { return static_cast<int>(widget); }
+
+    int64_t m_values[WIDGET_COUNT];
+    int m_top[WIDGET_COUNT];
+    int m_bottom[WIDGET_COUNT];
+    uint32_t m_dirtyMask;
+    bool m_fullRedraw;
+    int m_height;
+    uint64_t m_composeCount;
+};
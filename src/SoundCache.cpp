@@ -0,0 +1,110 @@
+﻿#include "SoundCache.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "AssetLoader.h"
+#include "AudioMixer.h"
+
+SoundCache::SoundCache(AssetLoader* loader)
+    : m_loader(loader)
+    , m_cursor(nullptr)
+    , m_remaining(0)
+    , m_arenaUsed(0)
+{
+}
+
+SoundCache::~SoundCache() = default;
+
+int SoundCache::Add(DecodeFn decode) {
+    m_sounds.push_back({ State::Unloaded, std::move(decode), nullptr, 0 });
+    return static_cast<int>(m_sounds.size()) - 1;
+}
+
+int SoundCache::AddMapped(const AudioFormat& format, const uint8_t* data, size_t size) {
+    if (format == SFX_FORMAT) {
+        m_sounds.push_back({ State::Ready, nullptr, data, size });
+        return static_cast<int>(m_sounds.size()) - 1;
+    }
+    // 形式が違えば変換が要るので、ほかの音と同じく初めて使うときにワーカーで
+    return Add([format, data, size](std::vector<uint8_t>* pcm, AudioFormat* out) {
+        pcm->assign(data, data + size);
+        *out = format;
+        return true;
+    });
+}
+
+void SoundCache::Request(int sound) {
+    if (sound < 0 || sound >= static_cast<int>(m_sounds.size())) return;
+    if (m_sounds[sound].state != State::Unloaded) return;
+    m_sounds[sound].state = State::Decoding;
+
+    // デコードと形式の変換はワーカー、アリーナへの格納は呼び出し側のスレッド
+    auto pcm = std::make_shared<std::vector<uint8_t>>();
+    auto decoded = std::make_shared<bool>(false);
+    auto decode = [pcm, decoded, fn = m_sounds[sound].decode]() {
+        std::vector<uint8_t> raw;
+        AudioFormat format;
+        *decoded = fn(&raw, &format) && Normalize(format, raw.data(), raw.size(), pcm.get()) && !pcm->empty();
+    };
+    auto finish = [this, sound, pcm, decoded]() {
+        if (!*decoded) {
+            m_sounds[sound].state = State::Failed;
+            return;
+        }
+        Store(sound, *pcm);
+        if (m_onReady) m_onReady(sound);
+    };
+
+    if (m_loader) {
+        m_loader->Enqueue(decode, finish);
+    } else {
+        decode();
+        finish();
+    }
+}
+
+void SoundCache::Store(int sound, const std::vector<uint8_t>& pcm) {
+    uint8_t* data = Allocate(pcm.size());
+    memcpy(data, pcm.data(), pcm.size());
+    Sound& entry = m_sounds[sound];
+    entry.data = data;
+    entry.size = pcm.size();
+    entry.state = State::Ready;
+    entry.decode = nullptr;
+}
+
+// ブロックの先頭から詰めていく（ブロックより大きい音は専用のブロック）
+uint8_t* SoundCache::Allocate(size_t size) {
+    size_t aligned = (size + 15) & ~static_cast<size_t>(15);
+    m_arenaUsed += aligned;
+    if (aligned > ARENA_BLOCK_SIZE) {
+        m_blocks.push_back(std::make_unique<uint8_t[]>(aligned));
+        return m_blocks.back().get();
+    }
+    if (aligned > m_remaining) {
+        m_blocks.push_back(std::make_unique<uint8_t[]>(ARENA_BLOCK_SIZE));
+        m_cursor = m_blocks.back().get();
+        m_remaining = ARENA_BLOCK_SIZE;
+    }
+    uint8_t* result = m_cursor;
+    m_cursor += aligned;
+    m_remaining -= aligned;
+    return result;
+}
+
+bool SoundCache::Normalize(const AudioFormat& format, const uint8_t* data, size_t size, std::vector<uint8_t>* out) {
+    if (format == SFX_FORMAT) {
+        out->assign(data, data + size);
+        return true;
+    }
+
+    std::vector<float> samples;
+    if (!AudioMixer::Convert(format, data, size, SFX_FORMAT.sampleRate, &samples)) return false;
+    out->resize(samples.size() * sizeof(int16_t));
+    for (size_t i = 0; i < samples.size(); i++) {
+        float v = std::clamp(samples[i], -1.0f, 1.0f) * 32767.0f;
+        int16_t s = static_cast<int16_t>(std::lround(v));
+        memcpy(out->data() + i * sizeof(int16_t), &s, sizeof(s));
+    }
+    return true;
+}
@@ -0,0 +1,77 @@
+﻿#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "AudioBackend.h"
+
+class AssetLoader;
+
+// 効果音のPCMキャッシュ
+// 全部 SFX_FORMAT にそろえるので、ボイスは1つの形式のプールだけで足りる
+// PCM は大きめのブロック（アリーナ）に詰めて持ち、音ごとに確保・解放しない
+// 登録時にはデコードせず、初めて使うとき（Request）にワーカーでデコードする
+class SoundCache {
+public:
+    static constexpr AudioFormat SFX_FORMAT = { 1, 2, 44100, 16 };  // 16bit ステレオ 44.1kHz
+    static constexpr size_t ARENA_BLOCK_SIZE = 1 << 20;
+    static constexpr int INVALID_SOUND = -1;
+
+    enum class State { Unloaded, Decoding, Ready, Failed };
+
+    // 元の形式の PCM を返すデコード関数（ワーカースレッドで呼ばれる）
+    using DecodeFn = std::function<bool(std::vector<uint8_t>* pcm, AudioFormat* format)>;
+    // Request でデコードが済んだ音（Request を呼んだスレッド、または loader.Pump() を呼んだスレッドで呼ばれる）
+    using ReadyFn = std::function<void(int sound)>;
+
+    // loader が無ければ Request のその場でデコードする
+    explicit SoundCache(AssetLoader* loader = nullptr);
+    ~SoundCache();
+
+    SoundCache(const SoundCache&) = delete;
+    SoundCache& operator=(const SoundCache&) = delete;
+
+    void SetReadyCallback(ReadyFn onReady) { m_onReady = std::move(onReady); }
+
+    int Add(DecodeFn decode);
+    // 読み込み済みの PCM（パックなど）。SFX_FORMAT ならコピーせずにそのまま指し、すぐ Ready になる
+    // （data は SoundCache より長く保持する）
+    int AddMapped(const AudioFormat& format, const uint8_t* data, size_t size);
+
+    // 未デコードならデコードを始める（済んでいれば何もしない）
+    void Request(int sound);
+
+    State GetState(int sound) const { return m_sounds[sound].state; }
+    const uint8_t* GetData(int sound) const { return m_sounds[sound].data; }
+    size_t GetSize(int sound) const { return m_sounds[sound].size; }
+    size_t GetCount() const { return m_sounds.size(); }
+
+    // アリーナの使用量（ブロック数・使っているバイト数）
+    size_t GetArenaBlockCount() const { return m_blocks.size(); }
+    size_t GetArenaUsed() const { return m_arenaUsed; }
+
+    // PCM を SFX_FORMAT に変換する（AssetPacker でも使う）
+    static bool Normalize(const AudioFormat& format, const uint8_t* data, size_t size, std::vector<uint8_t>* out);
+
+private:
+    struct Sound {
+        State state;
+        DecodeFn decode;
+        const uint8_t* data;
+        size_t size;
+    };
+
+    void Store(int sound, const std::vector<uint8_t>& pcm);
+    uint8_t* Allocate(size_t size);
+
+    AssetLoader* m_loader;
+    ReadyFn m_onReady;
+    std::vector<Sound> m_sounds;
+
+    std::vector<std::unique_ptr<uint8_t[]>> m_blocks;
+    uint8_t* m_cursor;      // 今のブロックの空き先頭
+    size_t m_remaining;     // 今のブロックの残り
+    size_t m_arenaUsed;
+};
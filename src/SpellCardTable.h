@@ -0,0 +1,97 @@
+﻿#pragma once
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// ボスのスペルカード名（assets\text\spellcards_jp.txt、UTF-8で1行1枚）
+// ファイルが無い・読めないときは組み込みの名前を使う。ホットリロードで読み直してよい
+class SpellCardTable {
+public:
+    SpellCardTable()
+        : m_names({
+            L"シングル「オーダーズ・オン・ザ・ロック」",
+            L"ダブル「トワイライト・バレル」",
+            L"スリーショット「スモーキー・アイラ」",
+            L"フォーシーズン「シェリー・キャスク」",
+            L"禁断「マスターズ・リザーブ」",
+        })
+    {
+    }
+
+    // 読めなければ今の名前を残して false
+    bool Load(const std::filesystem::path& path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) return false;
+        std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        return Parse(text);
+    }
+
+    // 空行は飛ばす。1枚も無ければ今の名前を残して false
+    bool Parse(std::string_view text) {
+        if (text.substr(0, 3) == "\xEF\xBB\xBF") text.remove_prefix(3);
+
+        std::vector<std::wstring> names;
+        while (!text.empty()) {
+            size_t end = text.find('\n');
+            std::string_view line = text.substr(0, end);
+            text = end == std::string_view::npos ? std::string_view() : text.substr(end + 1);
+            if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+            if (!line.empty()) names.push_back(DecodeUtf8(line));
+        }
+        if (names.empty()) return false;
+        m_names = std::move(names);
+        return true;
+    }
+
+    const wchar_t* Get(int index) const {
+        if (index < 0 || index >= static_cast<int>(m_names.size())) return L"";
+        return m_names[index].c_str();
+    }
+    size_t GetCount() const { return m_names.size(); }
+
+private:
+    // wchar_t が16ビットの環境（Windows）ではサロゲートペアにする
+    static std::wstring DecodeUtf8(std::string_view text) {
+        std::wstring out;
+        out.reserve(text.size());
+        for (size_t i = 0; i < text.size();) {
+            unsigned char lead = static_cast<unsigned char>(text[i]);
+            int extra = lead < 0x80 ? 0 : (lead >> 5) == 0x6 ? 1 : (lead >> 4) == 0xE ? 2 : (lead >> 3) == 0x1E ? 3 : -1;
+            if (extra < 0 || i + extra >= text.size()) {
+                out.push_back(L'\xFFFD');
+                i++;
+                continue;
+            }
+            char32_t code = extra == 0 ? lead : lead & (0x3F >> extra);
+            bool valid = true;
+            for (int k = 1; k <= extra; k++) {
+                unsigned char next = static_cast<unsigned char>(text[i + k]);
+                if ((next & 0xC0) != 0x80) {
+                    valid = false;
+                    break;
+                }
+                code = (code << 6) | (next & 0x3F);
+            }
+            if (!valid) {
+                out.push_back(L'\xFFFD');
+                i++;
+                continue;
+            }
+            i += extra + 1;
+            if (sizeof(wchar_t) == 2 && code >= 0x10000) {
+                code -= 0x10000;
+                out.push_back(static_cast<wchar_t>(0xD800 + (code >> 10)));
+                out.push_back(static_cast<wchar_t>(0xDC00 + (code & 0x3FF)));
+            } else {
+                out.push_back(static_cast<wchar_t>(code));
+            }
+        }
+        return out;
+    }
+
+    std::vector<std::wstring> m_names;
+};
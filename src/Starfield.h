@@ -0,0 +1,85 @@
+﻿#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include <DirectXMath.h>
+
+// 背景の星1つ分（インスタンスバッファにそのまま置く、作った後は書き換えない）
+struct StarInstance {
+    float x;        // 最初の周回のx（画面座標）
+    float y;        // 時刻0のy
+    float depth;    // 0=遠い 〜 1=近い（速さ・大きさ・遠近の寄せ方）
+    uint32_t seed;  // 周回ごとのxの振り直しと揺れの位相
+    DirectX::XMFLOAT4 color;
+};
+
+// 星の動き（時刻と星ごとの種だけで決まるので毎フレームの状態を持たない）
+// Graphics.cpp の星用頂点シェーダーと同じ式。GPUで描けないときとテストはこちらを使う
+namespace Starfield {
+
+constexpr float WRAP_MARGIN = 20.0f;   // 画面の上下にはみ出してから折り返す
+constexpr float GLOW_SIZE = 2.0f;      // これより大きい星は光彩付き
+constexpr float GLOW_EXTENT = 3.4f;    // 光彩の外周（星の半径に対する倍率）
+
+inline float Speed(float depth) { return 50.0f + depth * 150.0f; }
+inline float Size(float depth) { return 1.0f + depth * 3.0f; }
+
+inline uint32_t Hash(uint32_t v) {
+    uint32_t h = v * 747796405u + 2891336453u;
+    h = ((h >> ((h >> 28) + 4u)) ^ h) * 277803737u;
+    return (h >> 22) ^ h;
+}
+
+// 0〜1（下位16bit）
+inline float HashUnit(uint32_t v) {
+    return static_cast<float>(Hash(v) & 0xFFFF) / 65536.0f;
+}
+
+// 時刻 time での画面上の中心位置
+inline DirectX::XMFLOAT2 Position(const StarInstance& star, float time, float width, float height) {
+    float span = height + WRAP_MARGIN * 2.0f;
+    float travel = star.y + WRAP_MARGIN + Speed(star.depth) * time;
+    float lap = floorf(travel / span);
+    float y = travel - lap * span - WRAP_MARGIN;
+
+    // 下に抜けるたびに別のxから出直す
+    float x = lap > 0.0f ? HashUnit(star.seed + static_cast<uint32_t>(lap)) * width : star.x;
+    x += sinf(time * 2.0f + static_cast<float>(star.seed & 0xFF) * 0.0245f) * 1.5f;
+
+    // 遠い星ほど画面中央に寄せる
+    float perspective = 0.3f + star.depth * 0.7f;
+    float centerX = width * 0.5f;
+    float centerY = height * 0.5f;
+    return DirectX::XMFLOAT2(centerX + (x - centerX) * perspective, centerY + (y - centerY) * perspective);
+}
+
+// ウイスキー色（琥珀・金・青白）の星を count 個並べる（同じ seed なら同じ並び）
+inline std::vector<StarInstance> Generate(int count, float width, float height, uint32_t seed) {
+    std::vector<StarInstance> stars(static_cast<size_t>(count));
+    for (int i = 0; i < count; i++) {
+        uint32_t base = Hash(seed + static_cast<uint32_t>(i));
+        StarInstance& star = stars[i];
+        star.x = HashUnit(base) * width;
+        star.y = HashUnit(base + 1) * height;
+        star.depth = static_cast<float>(Hash(base + 2) % 100) / 100.0f;
+        star.seed = Hash(base + 3);
+
+        float z = star.depth;
+        float brightness = 0.3f + z * 0.7f;
+        switch (Hash(base + 4) % 3) {
+            case 0:  // Amber
+                star.color = DirectX::XMFLOAT4(brightness, brightness * 0.6f, brightness * 0.2f, 0.6f + z * 0.4f);
+                break;
+            case 1:  // Gold
+                star.color = DirectX::XMFLOAT4(brightness, brightness * 0.8f, brightness * 0.3f, 0.5f + z * 0.5f);
+                break;
+            default:  // Blue-white (classic star)
+                star.color = DirectX::XMFLOAT4(brightness * 0.8f, brightness * 0.9f, brightness, 0.4f + z * 0.6f);
+                break;
+        }
+    }
+    return stars;
+}
+
+} // namespace Starfield
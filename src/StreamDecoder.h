@@ -0,0 +1,120 @@
+﻿#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+// 音声ファイルを少しずつPCMにする（BGMのストリーミング用）
+// 出力はステレオ float（LRLR...）。モノラルは左右に同じ値を入れる
+class IStreamDecoder {
+public:
+    virtual ~IStreamDecoder() = default;
+
+    virtual uint32_t GetSampleRate() const = 0;
+    // 最大 frames 分をデコードして書いたフレーム数を返す（0 = 終端）
+    virtual size_t Read(float* out, size_t frames) = 0;
+    // フレーム位置へ移動する（ループ用）
+    virtual bool Seek(uint64_t frame) = 0;
+};
+
+// WAV（PCM 16bit・float32、1〜2ch）をファイルから読むデコーダー（OS非依存）
+class WavStreamDecoder : public IStreamDecoder {
+public:
+    WavStreamDecoder() : m_channels(0), m_bitsPerSample(0), m_isFloat(false), m_sampleRate(0),
+                         m_dataOffset(0), m_frameCount(0), m_position(0) {}
+
+    bool Open(const std::filesystem::path& path) {
+        m_file.open(path, std::ios::binary);
+        if (!m_file.is_open()) return false;
+
+        char riff[12];
+        if (!m_file.read(riff, sizeof(riff)) || memcmp(riff, "RIFF", 4) != 0 || memcmp(riff + 8, "WAVE", 4) != 0) {
+            return false;
+        }
+
+        bool hasFormat = false;
+        char chunk[8];
+        while (m_file.read(chunk, sizeof(chunk))) {
+            uint32_t size;
+            memcpy(&size, chunk + 4, sizeof(size));
+            std::streamoff next = static_cast<std::streamoff>(m_file.tellg()) + size + (size & 1);
+            if (memcmp(chunk, "fmt ", 4) == 0 && size >= 16) {
+                uint8_t fmt[16];
+                m_file.read(reinterpret_cast<char*>(fmt), sizeof(fmt));
+                uint16_t tag;
+                memcpy(&tag, fmt, 2);
+                memcpy(&m_channels, fmt + 2, 2);
+                memcpy(&m_sampleRate, fmt + 4, 4);
+                memcpy(&m_bitsPerSample, fmt + 14, 2);
+                m_isFloat = (tag == 3);
+                bool supported = (tag == 1 && m_bitsPerSample == 16) || (m_isFloat && m_bitsPerSample == 32);
+                if (!supported || m_channels < 1 || m_channels > 2) return false;
+                hasFormat = true;
+            } else if (memcmp(chunk, "data", 4) == 0 && hasFormat) {
+                m_dataOffset = m_file.tellg();
+                m_frameCount = size / GetFrameBytes();
+                return true;
+            }
+            m_file.seekg(next);
+        }
+        return false;
+    }
+
+    uint32_t GetSampleRate() const override { return m_sampleRate; }
+    uint64_t GetFrameCount() const { return m_frameCount; }
+
+    size_t Read(float* out, size_t frames) override {
+        uint64_t remaining = m_frameCount - m_position;
+        if (frames > remaining) frames = static_cast<size_t>(remaining);
+        if (frames == 0) return 0;
+
+        m_raw.resize(frames * GetFrameBytes());
+        if (!m_file.read(reinterpret_cast<char*>(m_raw.data()), m_raw.size())) return 0;
+        const uint8_t* p = m_raw.data();
+        const size_t bytesPerSample = m_bitsPerSample / 8;
+        for (size_t i = 0; i < frames; i++) {
+            float left = Load(p);
+            float right = m_channels > 1 ? Load(p + bytesPerSample) : left;
+            out[i * 2] = left;
+            out[i * 2 + 1] = right;
+            p += GetFrameBytes();
+        }
+        m_position += frames;
+        return frames;
+    }
+
+    bool Seek(uint64_t frame) override {
+        if (frame > m_frameCount) return false;
+        m_file.clear();
+        m_file.seekg(m_dataOffset + static_cast<std::streamoff>(frame * GetFrameBytes()));
+        m_position = frame;
+        return static_cast<bool>(m_file);
+    }
+
+private:
+    size_t GetFrameBytes() const { return static_cast<size_t>(m_channels) * (m_bitsPerSample / 8); }
+
+    float Load(const uint8_t* p) const {
+        if (m_isFloat) {
+            float v;
+            memcpy(&v, p, sizeof(v));
+            return v;
+        }
+        int16_t v;
+        memcpy(&v, p, sizeof(v));
+        return v * (1.0f / 32768.0f);
+    }
+
+    std::ifstream m_file;
+    std::vector<uint8_t> m_raw;
+    uint16_t m_channels;
+    uint16_t m_bitsPerSample;
+    bool m_isFloat;
+    uint32_t m_sampleRate;
+    std::streamoff m_dataOffset;
+    uint64_t m_frameCount;
+    uint64_t m_position;
+};
@@ -0,0 +1,92 @@
+﻿#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <cwchar>
+#include <string>
+#include <unordered_map>
+
+// 文字列のレイアウト結果のキャッシュ（文字列・書式・枠の大きさが同じなら作り直さない）
+// 描画位置はキーに含めないので、動く文字でも中身が同じなら使い回せる
+// MAX_IDLE_FRAMES フレーム使われなかったものは EndFrame で捨てる（変わった数値の古い文字列など）
+template <typename T>
+class TextLayoutCache {
+public:
+    static constexpr uint32_t MAX_IDLE_FRAMES = 60;
+
+    TextLayoutCache() : m_frame(0), m_created(0) {}
+
+    // 見つからなければ create() の戻り値を登録して返す（失敗して空の値でもそのまま返す）
+    template <typename CreateFn>
+    const T& Get(const wchar_t* text, uint32_t format, float width, float height, CreateFn&& create) {
+        size_t length = wcslen(text);
+        uint64_t hash = Hash(text, length, format, width, height);
+        Entry& entry = m_entries[hash];
+        if (entry.lastUsed == 0 || !Matches(entry, text, length, format, width, height)) {
+            // 新規、またはハッシュの衝突（まれなので上書きする）
+            entry.text.assign(text, length);
+            entry.format = format;
+            entry.width = width;
+            entry.height = height;
+            entry.value = create();
+            m_created++;
+        }
+        entry.lastUsed = m_frame + 1;
+        return entry.value;
+    }
+
+    // フレームの終わりに呼ぶ
+    void EndFrame() {
+        m_frame++;
+        for (auto it = m_entries.begin(); it != m_entries.end(); ) {
+            if (m_frame - (it->second.lastUsed - 1) > MAX_IDLE_FRAMES) {
+                it = m_entries.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    void Clear() { m_entries.clear(); }
+    size_t size() const { return m_entries.size(); }
+    uint64_t GetCreatedCount() const { return m_created; }
+
+private:
+    struct Entry {
+        std::wstring text;
+        uint32_t format = 0;
+        float width = 0.0f;
+        float height = 0.0f;
+        T value{};
+        uint64_t lastUsed = 0;  // 最後に使ったフレーム+1（0は未使用）
+    };
+
+    static bool Matches(const Entry& entry, const wchar_t* text, size_t length, uint32_t format,
+                        float width, float height) {
+        return entry.format == format && entry.width == width && entry.height == height &&
+               entry.text.size() == length && wmemcmp(entry.text.data(), text, length) == 0;
+    }
+
+    // FNV-1a
+    static uint64_t Hash(const wchar_t* text, size_t length, uint32_t format, float width, float height) {
+        uint64_t hash = 14695981039346656037ull;
+        auto mix = [&hash](uint32_t value) {
+            for (int i = 0; i < 4; i++) {
+                hash ^= (value >> (i * 8)) & 0xFF;
+                hash *= 1099511628211ull;
+            }
+        };
+        for (size_t i = 0; i < length; i++) mix(static_cast<uint32_t>(text[i]));
+        uint32_t bits;
+        mix(format);
+        memcpy(&bits, &width, sizeof(bits));
+        mix(bits);
+        memcpy(&bits, &height, sizeof(bits));
+        mix(bits);
+        return hash;
+    }
+
+    std::unordered_map<uint64_t, Entry> m_entries;
+    uint64_t m_frame;
+    uint64_t m_created;
+};
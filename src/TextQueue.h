@@ -0,0 +1,67 @@
+﻿#pragma once
+
+#include <cstdint>
+#include <cwchar>
+#include <string>
+#include <vector>
+
+// D2D の文字描画の記録（TextRenderer と同じ引数で積み、描画スレッドで TextRenderer::Draw がまとめて描く）
+// 文字列は1本のバッファに詰める（clearしても容量は残るので毎フレーム確保しない）
+struct TextCommand {
+    uint32_t offset;  // 文字バッファ上の位置（終端の0を含めて詰めてある）
+    uint32_t length;
+    float x, y, width, height;
+    int fontSize;
+    int colorType;
+    float alpha;      // 1 なら色ごとの固定ブラシ、それ未満は透過ブラシ
+};
+
+class TextQueue {
+public:
+    void Reset() {
+        m_commands.clear();
+        m_chars.clear();
+    }
+
+    void DrawText(const std::wstring& text, float x, float y, float width, float height,
+                  int fontSize = 1, int colorType = 0) {
+        Push(text.c_str(), text.length(), x, y, width, height, fontSize, colorType, 1.0f);
+    }
+
+    void DrawTextWithValue(const std::wstring& label, int value, float x, float y) {
+        wchar_t buffer[64];
+        swprintf(buffer, 64, L"%ls: %d", label.c_str(), value);
+        Push(buffer, wcslen(buffer), x, y, 300, 30, 1, 0, 1.0f);
+    }
+
+    void DrawTextWithAlpha(const std::wstring& text, float x, float y, float width, float height,
+                           int fontSize = 1, int colorType = 0, float alpha = 1.0f) {
+        Push(text.c_str(), text.length(), x, y, width, height, fontSize, colorType, alpha < 1.0f ? alpha : 1.0f);
+    }
+
+    size_t size() const { return m_commands.size(); }
+    bool empty() const { return m_commands.empty(); }
+    const TextCommand& operator[](size_t i) const { return m_commands[i]; }
+    const wchar_t* GetText(const TextCommand& command) const { return m_chars.data() + command.offset; }
+
+private:
+    void Push(const wchar_t* text, size_t length, float x, float y, float width, float height,
+              int fontSize, int colorType, float alpha) {
+        TextCommand command;
+        command.offset = static_cast<uint32_t>(m_chars.size());
+        command.length = static_cast<uint32_t>(length);
+        command.x = x;
+        command.y = y;
+        command.width = width;
+        command.height = height;
+        command.fontSize = fontSize;
+        command.colorType = colorType;
+        command.alpha = alpha;
+        m_chars.insert(m_chars.end(), text, text + length);
+        m_chars.push_back(L'\0');
+        m_commands.push_back(command);
+    }
+
+    std::vector<TextCommand> m_commands;
+    std::vector<wchar_t> m_chars;
+};
@@ -5,6 +5,8 @@
 #include <d3d11.h>
 #include <wrl/client.h>
 #include <string>
+#include "TextLayoutCache.h"
+#include "TextQueue.h"
 
 #pragma comment(lib, "d2d1.lib")
 #pragma comment(lib, "dwrite.lib")
@@ -13,10 +15,19 @@ using Microsoft::WRL::ComPtr;
 
 class TextRenderer {
 public:
-    TextRenderer() : m_initialized(false) {}
+    TextRenderer() : m_initialized(false), m_originX(0.0f), m_originY(0.0f) {}
     ~TextRenderer() { Shutdown(); }
 
     bool Initialize(IDXGISwapChain* swapChain) {
+        // Get DXGI surface from swap chain
+        ComPtr<IDXGISurface> dxgiSurface;
+        HRESULT hr = swapChain->GetBuffer(0, IID_PPV_ARGS(&dxgiSurface));
+        if (FAILED(hr)) return false;
+        return Initialize(dxgiSurface.Get());
+    }
+
+    // テクスチャ（オフスクリーンレイヤー）に描く場合はそのサーフェスを渡す
+    bool Initialize(IDXGISurface* dxgiSurface) {
         // Create D2D factory
         HRESULT hr = D2D1CreateFactory(D2D1_FACTORY_TYPE_SINGLE_THREADED, m_d2dFactory.GetAddressOf());
         if (FAILED(hr)) return false;
@@ -29,18 +40,13 @@ public:
         );
         if (FAILED(hr)) return false;
 
-        // Get DXGI surface from swap chain
-        ComPtr<IDXGISurface> dxgiSurface;
-        hr = swapChain->GetBuffer(0, IID_PPV_ARGS(&dxgiSurface));
-        if (FAILED(hr)) return false;
-
         // Create D2D render target
         D2D1_RENDER_TARGET_PROPERTIES props = D2D1::RenderTargetProperties(
             D2D1_RENDER_TARGET_TYPE_DEFAULT,
             D2D1::PixelFormat(DXGI_FORMAT_UNKNOWN, D2D1_ALPHA_MODE_PREMULTIPLIED)
         );
 
-        hr = m_d2dFactory->CreateDxgiSurfaceRenderTarget(dxgiSurface.Get(), &props, &m_renderTarget);
+        hr = m_d2dFactory->CreateDxgiSurfaceRenderTarget(dxgiSurface, &props, &m_renderTarget);
         if (FAILED(hr)) return false;
 
         // Create text formats (日本語対応フォント)
@@ -53,12 +59,15 @@ public:
         m_renderTarget->CreateSolidColorBrush(D2D1::ColorF(D2D1::ColorF::White), &m_whiteBrush);
         m_renderTarget->CreateSolidColorBrush(D2D1::ColorF(0.9f, 0.8f, 0.3f), &m_goldBrush);
         m_renderTarget->CreateSolidColorBrush(D2D1::ColorF(0.5f, 0.8f, 1.0f), &m_blueBrush);
+        m_renderTarget->CreateSolidColorBrush(D2D1::ColorF(D2D1::ColorF::White), &m_alphaBrush);
 
         m_initialized = true;
         return true;
     }
 
     void Shutdown() {
+        m_layouts.Clear();
+        m_alphaBrush.Reset();
         m_whiteBrush.Reset();
         m_goldBrush.Reset();
         m_blueBrush.Reset();
@@ -72,9 +81,29 @@ public:
         m_initialized = false;
     }
 
+    // 描画先の左上が画面上のどこにあたるか（オフスクリーンでも画面座標のまま描ける）
+    void SetOrigin(float x, float y) {
+        m_originX = x;
+        m_originY = y;
+    }
+
     void BeginDraw() {
         if (m_renderTarget) {
             m_renderTarget->BeginDraw();
+            m_renderTarget->SetTransform(D2D1::Matrix3x2F::Translation(-m_originX, -m_originY));
+        }
+    }
+
+    // 画面座標の矩形の外には描かない（PushClip〜PopClipの間）
+    void PushClip(float left, float top, float right, float bottom) {
+        if (m_renderTarget) {
+            m_renderTarget->PushAxisAlignedClip(D2D1::RectF(left, top, right, bottom), D2D1_ANTIALIAS_MODE_ALIASED);
+        }
+    }
+
+    void PopClip() {
+        if (m_renderTarget) {
+            m_renderTarget->PopAxisAlignedClip();
         }
     }
 
@@ -84,30 +113,16 @@ public:
         }
     }
 
+    // フレームの終わりに1回だけ呼ぶ（BeginDraw〜EndDrawはパスごとに何度もあるので、そこでは進めない）
+    void EndFrame() {
+        m_layouts.EndFrame();
+    }
+
     void DrawText(const std::wstring& text, float x, float y, float width, float height, 
                   int fontSize = 1, int colorType = 0) {
         if (!m_renderTarget) return;
-
-        IDWriteTextFormat* font = nullptr;
-        switch (fontSize) {
-            case 0: font = m_smallFont.Get(); break;
-            case 1: font = m_normalFont.Get(); break;
-            case 2: font = m_largeFont.Get(); break;
-            case 3: font = m_titleFont.Get(); break;
-            default: font = m_normalFont.Get(); break;
-        }
-
-        ID2D1SolidColorBrush* brush = nullptr;
-        switch (colorType) {
-            case 0: brush = m_whiteBrush.Get(); break;
-            case 1: brush = m_goldBrush.Get(); break;
-            case 2: brush = m_blueBrush.Get(); break;
-            default: brush = m_whiteBrush.Get(); break;
-        }
-
-        D2D1_RECT_F rect = D2D1::RectF(x, y, x + width, y + height);
-        m_renderTarget->DrawText(text.c_str(), static_cast<UINT32>(text.length()),
-                                  font, rect, brush);
+        ID2D1SolidColorBrush* brush = GetBrush(colorType);
+        DrawCachedLayout(text.c_str(), static_cast<UINT32>(text.length()), x, y, width, height, fontSize, brush);
     }
 
     void DrawTextWithValue(const std::wstring& label, int value, float x, float y) {
@@ -118,18 +133,35 @@ public:
 
     void DrawTextWithAlpha(const std::wstring& text, float x, float y, float width, float height,
                            int fontSize = 1, int colorType = 0, float alpha = 1.0f) {
-        if (!m_renderTarget) return;
+        DrawAlphaLayout(text.c_str(), static_cast<UINT32>(text.length()), x, y, width, height, fontSize, colorType, alpha);
+    }
 
-        IDWriteTextFormat* font = nullptr;
-        switch (fontSize) {
-            case 0: font = m_smallFont.Get(); break;
-            case 1: font = m_normalFont.Get(); break;
-            case 2: font = m_largeFont.Get(); break;
-            case 3: font = m_titleFont.Get(); break;
-            default: font = m_normalFont.Get(); break;
+    // 記録済みの文字をまとめて描く（BeginDraw〜EndDrawの間、描画スレッドで呼ぶ）
+    void Draw(const TextQueue& queue) {
+        if (!m_renderTarget) return;
+        for (size_t i = 0; i < queue.size(); i++) {
+            const TextCommand& command = queue[i];
+            const wchar_t* text = queue.GetText(command);
+            if (command.alpha < 1.0f) {
+                DrawAlphaLayout(text, command.length, command.x, command.y, command.width, command.height,
+                                command.fontSize, command.colorType, command.alpha);
+            } else {
+                DrawCachedLayout(text, command.length, command.x, command.y, command.width, command.height,
+                                 command.fontSize, GetBrush(command.colorType));
+            }
         }
+    }
+
+    // 今のキャッシュ件数と、これまでにレイアウトを作った回数（デバッグ表示用）
+    size_t GetCachedLayoutCount() const { return m_layouts.size(); }
+    uint64_t GetLayoutBuildCount() const { return m_layouts.GetCreatedCount(); }
+
+private:
+    void DrawAlphaLayout(const wchar_t* text, UINT32 length, float x, float y, float width, float height,
+                         int fontSize, int colorType, float alpha) {
+        if (!m_renderTarget || !m_alphaBrush) return;
 
-        // Create brush with alpha
+        // 同じブラシの色を差し替えて使う（毎回作らない）
         D2D1_COLOR_F color;
         switch (colorType) {
             case 0: color = D2D1::ColorF(1.0f, 1.0f, 1.0f, alpha); break;
@@ -138,15 +170,45 @@ public:
             default: color = D2D1::ColorF(1.0f, 1.0f, 1.0f, alpha); break;
         }
 
-        ComPtr<ID2D1SolidColorBrush> alphaBrush;
-        m_renderTarget->CreateSolidColorBrush(color, &alphaBrush);
+        m_alphaBrush->SetColor(color);
+        DrawCachedLayout(text, length, x, y, width, height, fontSize, m_alphaBrush.Get());
+    }
 
-        D2D1_RECT_F rect = D2D1::RectF(x, y, x + width, y + height);
-        m_renderTarget->DrawText(text.c_str(), static_cast<UINT32>(text.length()),
-                                  font, rect, alphaBrush.Get());
+    ID2D1SolidColorBrush* GetBrush(int colorType) const {
+        switch (colorType) {
+            case 0: return m_whiteBrush.Get();
+            case 1: return m_goldBrush.Get();
+            case 2: return m_blueBrush.Get();
+            default: return m_whiteBrush.Get();
+        }
+    }
+
+    IDWriteTextFormat* GetFont(int fontSize) const {
+        switch (fontSize) {
+            case 0: return m_smallFont.Get();
+            case 1: return m_normalFont.Get();
+            case 2: return m_largeFont.Get();
+            case 3: return m_titleFont.Get();
+            default: return m_normalFont.Get();
+        }
+    }
+
+    // 文字列・フォント・枠が前のフレームと同じならレイアウトを作り直さずに描く
+    void DrawCachedLayout(const wchar_t* text, UINT32 length, float x, float y, float width, float height,
+                          int fontSize, ID2D1Brush* brush) {
+        IDWriteTextFormat* font = GetFont(fontSize);
+        if (!font || !brush) return;
+        uint32_t format = fontSize >= 0 && fontSize <= 3 ? static_cast<uint32_t>(fontSize) : 1u;
+        const ComPtr<IDWriteTextLayout>& layout = m_layouts.Get(text, format, width, height, [&]() {
+            ComPtr<IDWriteTextLayout> created;
+            m_dwriteFactory->CreateTextLayout(text, length,
+                                              font, width, height, &created);
+            return created;
+        });
+        if (!layout) return;
+        m_renderTarget->DrawTextLayout(D2D1::Point2F(x, y), layout.Get(), brush);
     }
 
-private:
     bool CreateTextFormat(const wchar_t* fontName, float size, IDWriteTextFormat** format) {
         HRESULT hr = m_dwriteFactory->CreateTextFormat(
             fontName, nullptr,
@@ -163,6 +225,8 @@ private:
     }
 
     bool m_initialized;
+    float m_originX;
+    float m_originY;
     ComPtr<ID2D1Factory> m_d2dFactory;
     ComPtr<IDWriteFactory> m_dwriteFactory;
     ComPtr<ID2D1RenderTarget> m_renderTarget;
@@ -175,4 +239,7 @@ private:
     ComPtr<ID2D1SolidColorBrush> m_whiteBrush;
     ComPtr<ID2D1SolidColorBrush> m_goldBrush;
     ComPtr<ID2D1SolidColorBrush> m_blueBrush;
+    ComPtr<ID2D1SolidColorBrush> m_alphaBrush;
+
+    TextLayoutCache<ComPtr<IDWriteTextLayout>> m_layouts;
 };
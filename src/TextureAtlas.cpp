@@ -0,0 +1,152 @@
+﻿#include "TextureAtlas.h"
+#include "TextureLoader.h"
+#include "AtlasPacker.h"
+#include "AssetLoader.h"
+#include "AssetManifest.h"
+#include <memory>
+
+namespace {
+
+const wchar_t* SPRITE_PATHS[] = {
+    L"barrel_bullet.png",            // BarrelBullet
+    L"sprites\\enemy_barrel.png",    // EnemyBarrel
+    L"sprites\\enemy_bottle.png",    // EnemyBottle
+    L"sprites\\enemy_glass.png",     // EnemyGlass
+    L"sprites\\enemy_glass2.png",    // EnemyFairy
+    L"sprites\\boss_hinahina.png",   // Boss
+    L"items\\whisky_shot.png",       // ItemWhisky
+    L"items\\malt_grain.png",        // ItemMalt
+    L"barrel_item.png",              // ItemBarrel
+    L"items\\label_star.png",        // ItemLabel
+    L"items\\ice_cube.png",          // ItemIce
+    L"items\\golden_bottle.png",     // ItemBottle
+    L"items\\full_cask.png",         // ItemCask
+    L"sprites\\player.png",          // Player
+};
+
+static_assert(sizeof(SPRITE_PATHS) / sizeof(SPRITE_PATHS[0]) == static_cast<size_t>(SpriteId::Count),
+              "SPRITE_PATHS must list every SpriteId");
+
+} // namespace
+
+TextureAtlas::TextureAtlas()
+    : m_sprites(static_cast<size_t>(SpriteId::Count), AtlasSprite{ DirectX::XMFLOAT4(0, 0, 0, 0), 0, 0, false })
+    , m_edited(static_cast<size_t>(SpriteId::Count), false)
+    , m_width(0)
+    , m_height(0)
+{
+}
+
+const wchar_t* TextureAtlas::GetSpritePath(SpriteId id) {
+    return SPRITE_PATHS[static_cast<size_t>(id)];
+}
+
+bool TextureAtlas::Has(SpriteId id) const {
+    return id < SpriteId::Count && m_sprites[static_cast<size_t>(id)].isLoaded && m_texture;
+}
+
+void TextureAtlas::DecodeSprite(TextureLoader& loader, const std::wstring& textureDir, const AssetPack::Reader* pack,
+                                SpriteId id, DecodedSprite* out) {
+    const wchar_t* path = SPRITE_PATHS[static_cast<size_t>(id)];
+
+    // パックの縮小済みピクセルはコピーせずにアトラスへ直接転写する
+    if (pack) {
+        const AssetPack::PackEntry* entry = pack->Find(AssetManifest::SpriteName(path));
+        if (entry && entry->type == AssetPack::AssetType::Texture && entry->format == AssetPack::PixelFormat::RGBA8 &&
+            entry->width <= MAX_SPRITE_SIZE && entry->height <= MAX_SPRITE_SIZE &&
+            entry->dataSize == static_cast<uint64_t>(entry->width) * entry->height * 4) {
+            out->source = pack->GetData(*entry);
+            out->width = static_cast<int>(entry->width);
+            out->height = static_cast<int>(entry->height);
+            out->isValid = true;
+            return;
+        }
+    }
+
+    out->isValid = loader.LoadPixels(textureDir + path, MAX_SPRITE_SIZE, &out->pixels, &out->width, &out->height);
+    out->source = out->pixels.data();
+}
+
+bool TextureAtlas::Build(TextureLoader& loader, const std::wstring& textureDir, const AssetPack::Reader* pack) {
+    std::vector<DecodedSprite> images(static_cast<size_t>(SpriteId::Count));
+    for (size_t i = 0; i < images.size(); i++) {
+        DecodeSprite(loader, textureDir, m_edited[i] ? nullptr : pack, static_cast<SpriteId>(i), &images[i]);
+    }
+    return Upload(loader, images);
+}
+
+void TextureAtlas::BuildAsync(TextureLoader& loader, const std::wstring& textureDir, AssetLoader& assets,
+                              const AssetPack::Reader* pack) {
+    auto images = std::make_shared<std::vector<DecodedSprite>>(static_cast<size_t>(SpriteId::Count));
+    size_t count = images->size();
+    for (size_t i = 0; i < count; i++) {
+        DecodedSprite* image = &(*images)[i];
+        const AssetPack::Reader* spritePack = m_edited[i] ? nullptr : pack;
+        auto decode = [&loader, textureDir, spritePack, image, i]() {
+            DecodeSprite(loader, textureDir, spritePack, static_cast<SpriteId>(i), image);
+        };
+        // finish は登録順なので、最後の1つの finish の時点で全スプライトが揃っている
+        if (i + 1 < count) {
+            assets.Enqueue(decode, [images]() {});
+        } else {
+            assets.Enqueue(decode, [this, &loader, images]() { Upload(loader, *images); });
+        }
+    }
+}
+
+bool TextureAtlas::ReloadAsync(const std::wstring& relativePath, TextureLoader& loader, const std::wstring& textureDir,
+                               AssetLoader& assets, const AssetPack::Reader* pack) {
+    std::string name = AssetPack::MakeName(relativePath);
+    for (size_t i = 0; i < m_edited.size(); i++) {
+        if (AssetPack::MakeName(SPRITE_PATHS[i]) != name) continue;
+        m_edited[i] = true;
+        // 他のスプライトはパックから指すだけなので、組み直しても数ミリ秒で終わる
+        BuildAsync(loader, textureDir, assets, pack);
+        return true;
+    }
+    return false;
+}
+
+// 読めた画像だけを詰める（読めなかったスプライトは各所の図形描画にフォールバック）
+bool TextureAtlas::Upload(TextureLoader& loader, const std::vector<DecodedSprite>& images) {
+    std::vector<size_t> loaded;
+    std::vector<AtlasRect> sizes;
+    for (size_t i = 0; i < images.size(); i++) {
+        if (!images[i].isValid) continue;
+        loaded.push_back(i);
+        sizes.push_back({ 0, 0, images[i].width + PADDING * 2, images[i].height + PADDING * 2 });
+    }
+    if (loaded.empty()) return false;
+
+    AtlasLayout layout;
+    if (!PackAtlas(sizes, MAX_ATLAS_SIZE, &layout)) return false;
+
+    // 組み直しのときは転送に成功するまで今のアトラスを使い続ける
+    std::vector<AtlasSprite> sprites(m_sprites.size(), AtlasSprite{ DirectX::XMFLOAT4(0, 0, 0, 0), 0, 0, false });
+    std::vector<BYTE> atlas(static_cast<size_t>(layout.width) * layout.height * 4, 0);
+    for (size_t n = 0; n < loaded.size(); n++) {
+        const DecodedSprite& image = images[loaded[n]];
+        const AtlasRect& rect = layout.rects[n];
+        BlitWithExtrude(atlas.data(), layout.width, rect, image.source, image.width, image.height, PADDING);
+
+        AtlasSprite& sprite = sprites[loaded[n]];
+        sprite.uv = DirectX::XMFLOAT4(
+            static_cast<float>(rect.x + PADDING) / layout.width,
+            static_cast<float>(rect.y + PADDING) / layout.height,
+            static_cast<float>(rect.x + PADDING + image.width) / layout.width,
+            static_cast<float>(rect.y + PADDING + image.height) / layout.height);
+        sprite.width = image.width;
+        sprite.height = image.height;
+        sprite.isLoaded = true;
+    }
+
+    ID3D11ShaderResourceView* srv = nullptr;
+    if (!loader.CreateTexture(atlas.data(), layout.width, layout.height, &srv)) {
+        return false;
+    }
+    m_texture.Attach(srv);
+    m_sprites = std::move(sprites);
+    m_width = layout.width;
+    m_height = layout.height;
+    return true;
+}
@@ -0,0 +1,88 @@
+﻿#pragma once
+
+#include <d3d11.h>
+#include <wrl/client.h>
+#include <DirectXMath.h>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+class TextureLoader;
+class AssetLoader;
+namespace AssetPack { class Reader; }
+
+// アトラスに詰めるゲーム中のスプライト
+enum class SpriteId : uint16_t {
+    BarrelBullet,
+    EnemyBarrel,
+    EnemyBottle,
+    EnemyGlass,
+    EnemyFairy,
+    Boss,
+    ItemWhisky,
+    ItemMalt,
+    ItemBarrel,
+    ItemLabel,
+    ItemIce,
+    ItemBottle,
+    ItemCask,
+    Player,
+    Count,
+    None = 0xFFFF
+};
+
+struct AtlasSprite {
+    DirectX::XMFLOAT4 uv;  // (u0, v0, u1, v1)
+    int width;
+    int height;
+    bool isLoaded;
+};
+
+// スプライト画像を1枚のテクスチャに詰めたもの
+// 読み込み時に縮小してMaxRectsで配置し、UV表をSpriteIdで引く
+class TextureAtlas {
+public:
+    static constexpr int MAX_SPRITE_SIZE = 256;  // 画面上は最大でも100px程度
+    static constexpr int PADDING = 2;
+    static constexpr int MAX_ATLAS_SIZE = 4096;
+
+    TextureAtlas();
+
+    // textureDir は assets\textures\ （末尾に区切りあり）
+    // pack に縮小済みのスプライトがあればそれを使い、無いものだけ画像からデコードする
+    bool Build(TextureLoader& loader, const std::wstring& textureDir, const AssetPack::Reader* pack = nullptr);
+    // スプライトごとのデコードをワーカーに投げ、全部揃った Pump で配置・転送する
+    void BuildAsync(TextureLoader& loader, const std::wstring& textureDir, AssetLoader& assets,
+                    const AssetPack::Reader* pack = nullptr);
+    // 元画像が編集されたスプライトをファイルから読み直してアトラスを組み直す（ホットリロード用）
+    // 以降そのスプライトはパックを使わない。アトラスのスプライトでなければ false
+    bool ReloadAsync(const std::wstring& relativePath, TextureLoader& loader, const std::wstring& textureDir,
+                     AssetLoader& assets, const AssetPack::Reader* pack);
+
+    bool Has(SpriteId id) const;
+    const AtlasSprite& Get(SpriteId id) const { return m_sprites[static_cast<size_t>(id)]; }
+    ID3D11ShaderResourceView* GetTexture() const { return m_texture.Get(); }
+    int GetWidth() const { return m_width; }
+    int GetHeight() const { return m_height; }
+
+    static const wchar_t* GetSpritePath(SpriteId id);  // textureDirからの相対パス
+
+private:
+    struct DecodedSprite {
+        std::vector<BYTE> pixels;
+        const BYTE* source = nullptr;  // pixels またはパックのマップ
+        int width = 0;
+        int height = 0;
+        bool isValid = false;
+    };
+
+    static void DecodeSprite(TextureLoader& loader, const std::wstring& textureDir, const AssetPack::Reader* pack,
+                             SpriteId id, DecodedSprite* out);
+    bool Upload(TextureLoader& loader, const std::vector<DecodedSprite>& images);
+
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> m_texture;
+    std::vector<AtlasSprite> m_sprites;
+    std::vector<bool> m_edited;  // パックより新しい元画像があるスプライト
+    int m_width;
+    int m_height;
+};
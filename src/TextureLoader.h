@@ -4,6 +4,7 @@
 #include <wrl/client.h>
 #include <wincodec.h>
 #include <string>
+#include <vector>
 
 #pragma comment(lib, "windowscodecs.lib")
 
@@ -14,8 +15,10 @@ public:
     TextureLoader() : m_device(nullptr) {}
     ~TextureLoader() {}
 
+    // WICファクトリはここで1回だけ作る（以降は読み取りのみなのでワーカーから並行にデコードしてよい）
     void Initialize(ID3D11Device* device) {
         m_device = device;
+        GetFactory();
     }
 
     // Load texture from file using WIC
@@ -24,19 +27,24 @@ public:
                      int* width = nullptr, int* height = nullptr) {
         if (!m_device) return false;
 
-        // Create WIC factory
-        ComPtr<IWICImagingFactory> wicFactory;
-        HRESULT hr = CoCreateInstance(
-            CLSID_WICImagingFactory,
-            nullptr,
-            CLSCTX_INPROC_SERVER,
-            IID_PPV_ARGS(&wicFactory)
-        );
-        if (FAILED(hr)) return false;
+        std::vector<BYTE> pixels;
+        int texWidth = 0, texHeight = 0;
+        if (!LoadPixels(filename, 0, &pixels, &texWidth, &texHeight)) return false;
+
+        if (width) *width = texWidth;
+        if (height) *height = texHeight;
+        return CreateTexture(pixels.data(), texWidth, texHeight, textureView);
+    }
+
+    // 画像をRGBAで読み込む（maxSize > 0 なら長辺がmaxSize以下になるよう縮小）
+    bool LoadPixels(const std::wstring& filename, int maxSize,
+                    std::vector<BYTE>* pixels, int* width, int* height) {
+        IWICImagingFactory* wicFactory = GetFactory();
+        if (!wicFactory) return false;
 
         // Create decoder
         ComPtr<IWICBitmapDecoder> decoder;
-        hr = wicFactory->CreateDecoderFromFilename(
+        HRESULT hr = wicFactory->CreateDecoderFromFilename(
             filename.c_str(),
             nullptr,
             GENERIC_READ,
@@ -55,9 +63,6 @@ public:
         hr = frame->GetSize(&texWidth, &texHeight);
         if (FAILED(hr)) return false;
 
-        if (width) *width = static_cast<int>(texWidth);
-        if (height) *height = static_cast<int>(texHeight);
-
         // Convert to RGBA
         ComPtr<IWICFormatConverter> converter;
         hr = wicFactory->CreateFormatConverter(&converter);
@@ -73,42 +78,92 @@ public:
         );
         if (FAILED(hr)) return false;
 
+        IWICBitmapSource* source = converter.Get();
+        ComPtr<IWICBitmapScaler> scaler;
+        UINT longSide = texWidth > texHeight ? texWidth : texHeight;
+        if (maxSize > 0 && longSide > static_cast<UINT>(maxSize)) {
+            UINT scaledWidth = texWidth * maxSize / longSide;
+            UINT scaledHeight = texHeight * maxSize / longSide;
+            if (scaledWidth == 0) scaledWidth = 1;
+            if (scaledHeight == 0) scaledHeight = 1;
+
+            hr = wicFactory->CreateBitmapScaler(&scaler);
+            if (FAILED(hr)) return false;
+            hr = scaler->Initialize(converter.Get(), scaledWidth, scaledHeight, WICBitmapInterpolationModeFant);
+            if (FAILED(hr)) return false;
+            source = scaler.Get();
+            texWidth = scaledWidth;
+            texHeight = scaledHeight;
+        }
+
         // Copy pixels
         UINT stride = texWidth * 4;
         UINT bufferSize = stride * texHeight;
-        std::vector<BYTE> pixels(bufferSize);
-        hr = converter->CopyPixels(nullptr, stride, bufferSize, pixels.data());
+        pixels->resize(bufferSize);
+        hr = source->CopyPixels(nullptr, stride, bufferSize, pixels->data());
         if (FAILED(hr)) return false;
 
-        // Create texture
+        *width = static_cast<int>(texWidth);
+        *height = static_cast<int>(texHeight);
+        return true;
+    }
+
+    // RGBAピクセルからテクスチャを作る
+    bool CreateTexture(const BYTE* pixels, int width, int height, ID3D11ShaderResourceView** textureView) {
+        D3D11_SUBRESOURCE_DATA initData = {};
+        initData.pSysMem = pixels;
+        initData.SysMemPitch = static_cast<UINT>(width) * 4;
+        return CreateTexture(DXGI_FORMAT_R8G8B8A8_UNORM, width, height, &initData, 1, textureView);
+    }
+
+    // 変換済みデータ（BC圧縮・ミップ付き）からテクスチャを作る
+    // levels はミップごとの先頭と行ピッチ（BCはブロック1行分）。非対応の形式なら失敗する
+    bool CreateTexture(DXGI_FORMAT format, int width, int height,
+                       const D3D11_SUBRESOURCE_DATA* levels, UINT mipLevels,
+                       ID3D11ShaderResourceView** textureView) {
+        if (!m_device) return false;
+
         D3D11_TEXTURE2D_DESC texDesc = {};
-        texDesc.Width = texWidth;
-        texDesc.Height = texHeight;
-        texDesc.MipLevels = 1;
+        texDesc.Width = static_cast<UINT>(width);
+        texDesc.Height = static_cast<UINT>(height);
+        texDesc.MipLevels = mipLevels;
         texDesc.ArraySize = 1;
-        texDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+        texDesc.Format = format;
         texDesc.SampleDesc.Count = 1;
-        texDesc.Usage = D3D11_USAGE_DEFAULT;
+        texDesc.Usage = D3D11_USAGE_IMMUTABLE;
         texDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
 
-        D3D11_SUBRESOURCE_DATA initData = {};
-        initData.pSysMem = pixels.data();
-        initData.SysMemPitch = stride;
-
         ComPtr<ID3D11Texture2D> texture;
-        hr = m_device->CreateTexture2D(&texDesc, &initData, &texture);
+        HRESULT hr = m_device->CreateTexture2D(&texDesc, levels, &texture);
         if (FAILED(hr)) return false;
 
         // Create shader resource view
         D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
         srvDesc.Format = texDesc.Format;
         srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
-        srvDesc.Texture2D.MipLevels = 1;
+        srvDesc.Texture2D.MipLevels = mipLevels;
 
         hr = m_device->CreateShaderResourceView(texture.Get(), &srvDesc, textureView);
         return SUCCEEDED(hr);
     }
 
+    // フォントのラスタライズなどでWICビットマップを作るとき用
+    IWICImagingFactory* GetWicFactory() { return GetFactory(); }
+
 private:
+    IWICImagingFactory* GetFactory() {
+        if (!m_wicFactory) {
+            HRESULT hr = CoCreateInstance(
+                CLSID_WICImagingFactory,
+                nullptr,
+                CLSCTX_INPROC_SERVER,
+                IID_PPV_ARGS(&m_wicFactory)
+            );
+            if (FAILED(hr)) return nullptr;
+        }
+        return m_wicFactory.Get();
+    }
+
     ID3D11Device* m_device;
+    ComPtr<IWICImagingFactory> m_wicFactory;
 };
@@ -0,0 +1,157 @@
+﻿#include "TextureRegistry.h"
+#include "AssetLoader.h"
+#include "AssetManifest.h"
+#include "BlockCompression.h"
+#include <windows.h>
+#include <memory>
+
+TextureRegistry::TextureRegistry()
+    : m_pack(nullptr)
+    , m_decodeCount(0)
+    , m_cacheHitCount(0)
+    , m_packedCount(0)
+{
+}
+
+void TextureRegistry::Initialize(ID3D11Device* device) {
+    m_loader.Initialize(device);
+
+    wchar_t exePath[MAX_PATH];
+    GetModuleFileNameW(nullptr, exePath, MAX_PATH);
+    std::wstring path(exePath);
+    size_t lastSlash = path.find_last_of(L"\\/");
+    m_textureDir = path.substr(0, lastSlash) + L"\\..\\..\\assets\\textures\\";
+}
+
+TextureHandle TextureRegistry::Acquire(const std::wstring& relativePath) {
+    std::wstring key = TextureSlots<TexturePtr>::NormalizeKey(relativePath);
+    TextureHandle cached = FindCached(key);
+    if (cached.IsValid()) return cached;
+
+    ID3D11ShaderResourceView* srv = nullptr;
+    if (CreateFromPack(relativePath, &srv)) {
+        m_packedCount++;
+    } else if (m_loader.LoadTexture(m_textureDir + relativePath, &srv)) {
+        m_decodeCount++;
+    } else {
+        return {};
+    }
+
+    TextureHandle handle = m_slots.Allocate(key);
+    m_slots.Resolve(handle)->Attach(srv);
+    return handle;
+}
+
+bool TextureRegistry::ReloadAsync(const std::wstring& relativePath, AssetLoader& loader) {
+    TextureHandle handle = m_slots.Find(TextureSlots<TexturePtr>::NormalizeKey(relativePath));
+    if (!handle.IsValid()) return false;
+
+    // パックは古いので必ず元ファイルから読む。読めなければ（保存途中など）今のテクスチャを残す
+    EnqueueDecode(m_textureDir + relativePath, handle, loader);
+    return true;
+}
+
+TextureHandle TextureRegistry::AcquireAsync(const std::wstring& relativePath, AssetLoader& loader) {
+    std::wstring key = TextureSlots<TexturePtr>::NormalizeKey(relativePath);
+    TextureHandle cached = FindCached(key);
+    if (cached.IsValid()) return cached;
+
+    // パックにあればデコード不要なので、ワーカーを通さずその場で転送する
+    ID3D11ShaderResourceView* packed = nullptr;
+    if (CreateFromPack(relativePath, &packed)) {
+        m_packedCount++;
+        TextureHandle handle = m_slots.Allocate(key);
+        m_slots.Resolve(handle)->Attach(packed);
+        return handle;
+    }
+
+    TextureHandle handle = m_slots.Allocate(key);
+    EnqueueDecode(m_textureDir + relativePath, handle, loader);
+    return handle;
+}
+
+void TextureRegistry::EnqueueDecode(const std::wstring& path, TextureHandle handle, AssetLoader& loader) {
+    struct DecodedImage {
+        std::vector<BYTE> pixels;
+        int width = 0;
+        int height = 0;
+        bool isValid = false;
+    };
+    auto image = std::make_shared<DecodedImage>();
+
+    loader.Enqueue(
+        [this, image, path]() {
+            image->isValid = m_loader.LoadPixels(path, 0, &image->pixels, &image->width, &image->height);
+        },
+        [this, image, handle]() {
+            // 読み込み中に解放されていたら捨てる
+            TexturePtr* texture = m_slots.Resolve(handle);
+            if (!texture || !image->isValid) return;
+
+            ID3D11ShaderResourceView* srv = nullptr;
+            if (m_loader.CreateTexture(image->pixels.data(), image->width, image->height, &srv)) {
+                texture->Attach(srv);
+                m_decodeCount++;
+            }
+        });
+}
+
+namespace {
+
+DXGI_FORMAT ToDxgiFormat(AssetPack::PixelFormat format) {
+    switch (format) {
+    case AssetPack::PixelFormat::RGBA8: return DXGI_FORMAT_R8G8B8A8_UNORM;
+    case AssetPack::PixelFormat::BC1: return DXGI_FORMAT_BC1_UNORM;
+    case AssetPack::PixelFormat::BC3: return DXGI_FORMAT_BC3_UNORM;
+    case AssetPack::PixelFormat::BC7: return DXGI_FORMAT_BC7_UNORM;
+    }
+    return DXGI_FORMAT_UNKNOWN;
+}
+
+} // namespace
+
+// BC圧縮・ミップ付きのデータもミップごとにマップ上の位置を指すだけで転送する
+// （BC7非対応のGPUなどで作れなければ false を返し、呼び出し側が画像ファイルから読む）
+bool TextureRegistry::CreateFromPack(const std::wstring& relativePath, ID3D11ShaderResourceView** textureView) {
+    if (!m_pack) return false;
+    const AssetPack::PackEntry* entry = m_pack->Find(AssetManifest::TextureName(relativePath));
+    if (!entry || entry->type != AssetPack::AssetType::Texture) return false;
+
+    DXGI_FORMAT format = ToDxgiFormat(entry->format);
+    uint32_t mipLevels = entry->mipLevels;
+    if (format == DXGI_FORMAT_UNKNOWN || mipLevels > D3D11_REQ_MIP_LEVELS) return false;
+    if (!BlockCompression::IsValidChain(entry->format, entry->width, entry->height, mipLevels, entry->dataSize)) {
+        return false;
+    }
+
+    D3D11_SUBRESOURCE_DATA levels[D3D11_REQ_MIP_LEVELS] = {};
+    const BYTE* data = m_pack->GetData(*entry);
+    for (uint32_t level = 0; level < mipLevels; level++) {
+        uint32_t width = BlockCompression::MipDimension(entry->width, level);
+        uint32_t height = BlockCompression::MipDimension(entry->height, level);
+        levels[level].pSysMem = data;
+        levels[level].SysMemPitch = static_cast<UINT>(BlockCompression::GetRowPitch(entry->format, width));
+        data += BlockCompression::GetLevelSize(entry->format, width, height);
+    }
+    return m_loader.CreateTexture(format, static_cast<int>(entry->width), static_cast<int>(entry->height),
+                                  levels, mipLevels, textureView);
+}
+
+TextureHandle TextureRegistry::FindCached(const std::wstring& key) {
+    TextureHandle handle = m_slots.Acquire(key);
+    if (handle.IsValid()) m_cacheHitCount++;
+    return handle;
+}
+
+void TextureRegistry::AddRef(TextureHandle handle) {
+    m_slots.AddRef(handle);
+}
+
+void TextureRegistry::Release(TextureHandle handle) {
+    m_slots.Release(handle);
+}
+
+ID3D11ShaderResourceView* TextureRegistry::Get(TextureHandle handle) const {
+    const TexturePtr* texture = m_slots.Resolve(handle);
+    return texture ? texture->Get() : nullptr;
+}
@@ -0,0 +1,59 @@
+﻿#pragma once
+
+#include <d3d11.h>
+#include <wrl/client.h>
+#include <string>
+#include <cstdint>
+#include "TextureLoader.h"
+#include "TextureSlots.h"
+
+class AssetLoader;
+namespace AssetPack { class Reader; }
+
+// プロセス全体で共有するテクスチャ置き場
+// パス（assets\textures\ からの相対）をキーに1回だけデコードし、参照カウントで寿命を管理する
+// WICファクトリと実行ファイルのパスも1回だけ用意する
+// パックがあれば変換済みのピクセルをマップから直接転送し、無い画像だけWICでデコードする
+class TextureRegistry {
+public:
+    TextureRegistry();
+
+    void Initialize(ID3D11Device* device);
+    void SetPack(const AssetPack::Reader* pack) { m_pack = pack; }  // 寿命は呼び出し側が持つ
+    const AssetPack::Reader* GetPack() const { return m_pack; }
+
+    // 読み込み済みなら参照を増やすだけ（失敗時は無効ハンドル）
+    TextureHandle Acquire(const std::wstring& relativePath);
+    // デコードはワーカーで行い、テクスチャは AssetLoader::Pump で作る（それまで Get は nullptr）
+    TextureHandle AcquireAsync(const std::wstring& relativePath, AssetLoader& loader);
+    // 読み込み済みの画像を元ファイルから読み直し、同じハンドルのままテクスチャを差し替える
+    // （ホットリロード用。デコードはワーカー、差し替えは Pump。登録されていないパスなら false）
+    bool ReloadAsync(const std::wstring& relativePath, AssetLoader& loader);
+    void AddRef(TextureHandle handle);
+    void Release(TextureHandle handle);  // 参照が0になったらテクスチャを解放
+
+    ID3D11ShaderResourceView* Get(TextureHandle handle) const;
+
+    const std::wstring& GetTextureDir() const { return m_textureDir; }  // 末尾に区切りあり
+    TextureLoader& GetLoader() { return m_loader; }                      // アトラス等のデコード用
+
+    // 起動時のデコード回数・キャッシュヒット数・パックからの転送数（重複読み込みの確認用）
+    uint32_t GetDecodeCount() const { return m_decodeCount; }
+    uint32_t GetCacheHitCount() const { return m_cacheHitCount; }
+    uint32_t GetPackedCount() const { return m_packedCount; }
+
+private:
+    using TexturePtr = Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>;
+
+    TextureHandle FindCached(const std::wstring& key);
+    void EnqueueDecode(const std::wstring& path, TextureHandle handle, AssetLoader& loader);
+    bool CreateFromPack(const std::wstring& relativePath, ID3D11ShaderResourceView** textureView);
+
+    TextureLoader m_loader;
+    const AssetPack::Reader* m_pack;
+    std::wstring m_textureDir;
+    TextureSlots<TexturePtr> m_slots;
+    uint32_t m_decodeCount;
+    uint32_t m_cacheHitCount;
+    uint32_t m_packedCount;
+};
@@ -0,0 +1,120 @@
+﻿#pragma once
+
+#include <cstdint>
+#include <cwctype>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// 登録済みテクスチャへの参照（スロット番号＋世代）
+struct TextureHandle {
+    static constexpr uint32_t INVALID = 0xFFFFFFFF;
+
+    uint32_t index = INVALID;
+    uint32_t generation = 0;
+
+    bool IsValid() const { return index != INVALID; }
+};
+
+// TextureRegistry のスロット管理（パス → スロット、参照カウント、世代）
+// 中身（T）はレジストリ側が持つテクスチャ。解放したスロットは世代を進めて再利用し、古いハンドルは引けなくなる
+template<typename T>
+class TextureSlots {
+public:
+    // 区切り文字と大文字小文字の違いで別物扱いしない
+    static std::wstring NormalizeKey(const std::wstring& relativePath) {
+        std::wstring key = relativePath;
+        for (auto& c : key) {
+            if (c == L'/') c = L'\\';
+            else c = static_cast<wchar_t>(towlower(c));
+        }
+        return key;
+    }
+
+    // 登録済みなら参照を増やして返す（無ければ無効ハンドル）
+    TextureHandle Acquire(const std::wstring& key) {
+        TextureHandle handle = Find(key);
+        if (handle.IsValid()) m_slots[handle.index].refCount++;
+        return handle;
+    }
+
+    // 参照を増やさずに引く
+    TextureHandle Find(const std::wstring& key) const {
+        auto it = m_lookup.find(key);
+        if (it == m_lookup.end()) return {};
+        return { it->second, m_slots[it->second].generation };
+    }
+
+    // 参照1で登録する
+    TextureHandle Allocate(const std::wstring& key) {
+        uint32_t index;
+        if (!m_freeSlots.empty()) {
+            index = m_freeSlots.back();
+            m_freeSlots.pop_back();
+        } else {
+            index = static_cast<uint32_t>(m_slots.size());
+            m_slots.emplace_back();
+        }
+
+        Slot& slot = m_slots[index];
+        slot.key = key;
+        slot.refCount = 1;
+        m_lookup[key] = index;
+        return { index, slot.generation };
+    }
+
+    void AddRef(TextureHandle handle) {
+        if (Slot* slot = ResolveSlot(handle)) {
+            slot->refCount++;
+        }
+    }
+
+    // 参照が0になったら中身を捨ててスロットを空ける（空けたら true）
+    bool Release(TextureHandle handle) {
+        Slot* slot = ResolveSlot(handle);
+        if (!slot || --slot->refCount > 0) return false;
+
+        m_lookup.erase(slot->key);
+        slot->key.clear();
+        slot->value = T{};
+        slot->generation++;  // 古いハンドルを無効化
+        m_freeSlots.push_back(handle.index);
+        return true;
+    }
+
+    // 解放済み・再利用済みのスロットを指すハンドルは nullptr
+    T* Resolve(TextureHandle handle) {
+        Slot* slot = ResolveSlot(handle);
+        return slot ? std::addressof(slot->value) : nullptr;  // ComPtr の operator& は中身を解放するので使わない
+    }
+    const T* Resolve(TextureHandle handle) const {
+        return const_cast<TextureSlots*>(this)->Resolve(handle);
+    }
+
+    uint32_t GetRefCount(TextureHandle handle) const {
+        const Slot* slot = const_cast<TextureSlots*>(this)->ResolveSlot(handle);
+        return slot ? slot->refCount : 0;
+    }
+    size_t GetSlotCount() const { return m_slots.size(); }
+    size_t GetLiveCount() const { return m_lookup.size(); }
+
+private:
+    struct Slot {
+        std::wstring key;
+        T value{};
+        uint32_t refCount = 0;
+        uint32_t generation = 0;
+    };
+
+    Slot* ResolveSlot(TextureHandle handle) {
+        if (handle.index >= m_slots.size()) return nullptr;
+        Slot& slot = m_slots[handle.index];
+        if (slot.generation != handle.generation || slot.refCount == 0) return nullptr;
+        return &slot;
+    }
+
+    std::vector<Slot> m_slots;
+    std::vector<uint32_t> m_freeSlots;
+    std::unordered_map<std::wstring, uint32_t> m_lookup;
+};
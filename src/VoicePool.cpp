@@ -0,0 +1,118 @@
+﻿#include "VoicePool.h"
+#include <algorithm>
+
+VoicePool::VoicePool(IAudioBackend* backend, size_t voicesPerFormat)
+    : m_backend(backend)
+    , m_voicesPerFormat(voicesPerFormat)
+    , m_sequence(0)
+    , m_startedCount(0)
+    , m_coalescedCount(0)
+    , m_stolenCount(0)
+    , m_droppedCount(0)
+{
+}
+
+VoicePool::~VoicePool() {
+    for (auto& pool : m_pools) {
+        for (auto& voice : pool.voices) {
+            m_backend->Stop(voice.handle);
+            m_backend->DestroyVoice(voice.handle);
+        }
+    }
+}
+
+int VoicePool::RegisterSound(const AudioFormat& format, const uint8_t* data, size_t size, int priority) {
+    size_t pool = FindOrCreatePool(format);
+    if (m_pools[pool].voices.empty()) return INVALID_SOUND;
+
+    m_sounds.push_back({ pool, data, size, priority, -1 });
+    return static_cast<int>(m_sounds.size()) - 1;
+}
+
+size_t VoicePool::FindOrCreatePool(const AudioFormat& format) {
+    for (size_t i = 0; i < m_pools.size(); i++) {
+        if (m_pools[i].format == format) return i;
+    }
+
+    Pool pool;
+    pool.format = format;
+    for (size_t i = 0; i < m_voicesPerFormat; i++) {
+        int handle = m_backend->CreateVoice(format);
+        if (handle == IAudioBackend::INVALID_VOICE) break;
+        pool.voices.push_back({ handle, INVALID_SOUND, 0, 0 });
+    }
+    m_pools.push_back(std::move(pool));
+    return m_pools.size() - 1;
+}
+
+void VoicePool::Play(int sound, float volume, float pan) {
+    if (sound < 0 || sound >= static_cast<int>(m_sounds.size())) return;
+
+    Sound& entry = m_sounds[sound];
+    if (entry.pendingIndex >= 0) {
+        Request& request = m_pending[entry.pendingIndex];
+        if (volume > request.volume) {
+            request.volume = volume;
+            request.pan = pan;
+        }
+        m_coalescedCount++;
+        return;
+    }
+    entry.pendingIndex = static_cast<int>(m_pending.size());
+    m_pending.push_back({ sound, volume, pan });
+}
+
+void VoicePool::EndFrame() {
+    if (m_pending.empty()) return;
+
+    // 優先度の高い要求から取る（同じ優先度は要求順）
+    std::stable_sort(m_pending.begin(), m_pending.end(), [this](const Request& a, const Request& b) {
+        return m_sounds[a.sound].priority > m_sounds[b.sound].priority;
+    });
+
+    for (const Request& request : m_pending) {
+        Sound& sound = m_sounds[request.sound];
+        sound.pendingIndex = -1;
+
+        Voice* voice = AcquireVoice(m_pools[sound.pool], sound.priority);
+        if (!voice) {
+            m_droppedCount++;
+            continue;
+        }
+        m_backend->Start(voice->handle, sound.data, sound.size, request.volume, request.pan);
+        voice->sound = request.sound;
+        voice->priority = sound.priority;
+        voice->startedAt = ++m_sequence;
+        m_startedCount++;
+    }
+    m_pending.clear();
+}
+
+// 空きボイス、なければ優先度が低い（同じなら古い）鳴っているボイス
+VoicePool::Voice* VoicePool::AcquireVoice(Pool& pool, int priority) {
+    Voice* victim = nullptr;
+    for (auto& voice : pool.voices) {
+        if (!m_backend->IsPlaying(voice.handle)) return &voice;
+        if (voice.priority > priority) continue;
+        if (!victim || voice.priority < victim->priority ||
+            (voice.priority == victim->priority && voice.startedAt < victim->startedAt)) {
+            victim = &voice;
+        }
+    }
+    if (victim) m_stolenCount++;
+    return victim;
+}
+
+void VoicePool::StopAll() {
+    for (auto& pool : m_pools) {
+        for (auto& voice : pool.voices) m_backend->Stop(voice.handle);
+    }
+    for (const Request& request : m_pending) m_sounds[request.sound].pendingIndex = -1;
+    m_pending.clear();
+}
+
+size_t VoicePool::GetVoiceCount() const {
+    size_t count = 0;
+    for (const auto& pool : m_pools) count += pool.voices.size();
+    return count;
+}
@@ -0,0 +1,79 @@
+﻿#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "AudioBackend.h"
+
+// 効果音のボイスプール
+// 形式ごとに決まった数のボイスを先に作っておき、鳴らすときは空きを使い回す
+// 空きが無ければ優先度の低い・古い音から奪う（自分より優先度の高い音は奪わない）
+// 同じフレームの同じ音は1回にまとめ、EndFrame でまとめて鳴らす
+class VoicePool {
+public:
+    static constexpr int INVALID_SOUND = -1;
+    static constexpr size_t DEFAULT_VOICES_PER_FORMAT = 16;
+
+    explicit VoicePool(IAudioBackend* backend, size_t voicesPerFormat = DEFAULT_VOICES_PER_FORMAT);
+    ~VoicePool();
+
+    VoicePool(const VoicePool&) = delete;
+    VoicePool& operator=(const VoicePool&) = delete;
+
+    // 新しい形式ならボイスをここでまとめて作る（data は VoicePool より長く保持する）
+    int RegisterSound(const AudioFormat& format, const uint8_t* data, size_t size, int priority);
+
+    // このフレームに鳴らす（同じ音が何度来ても1回、音量とパンは一番大きい要求のもの）
+    void Play(int sound, float volume, float pan = 0.0f);
+    // 溜めた要求を優先度の高い順に鳴らす（1フレームに1回）
+    void EndFrame();
+    void StopAll();
+
+    // 統計（累計）
+    uint32_t GetStartedCount() const { return m_startedCount; }
+    uint32_t GetCoalescedCount() const { return m_coalescedCount; }  // 同フレームの重複でまとめた数
+    uint32_t GetStolenCount() const { return m_stolenCount; }        // 鳴っている音を奪った数
+    uint32_t GetDroppedCount() const { return m_droppedCount; }      // ボイスが取れず鳴らさなかった数
+    size_t GetVoiceCount() const;
+
+private:
+    struct Sound {
+        size_t pool;
+        const uint8_t* data;
+        size_t size;
+        int priority;
+        int pendingIndex;  // このフレームの要求の位置（-1 = 要求なし）
+    };
+
+    struct Voice {
+        int handle;
+        int sound;
+        int priority;
+        uint64_t startedAt;  // 鳴らした順番（古い音を奪うため）
+    };
+
+    struct Pool {
+        AudioFormat format;
+        std::vector<Voice> voices;
+    };
+
+    struct Request {
+        int sound;
+        float volume;
+        float pan;
+    };
+
+    size_t FindOrCreatePool(const AudioFormat& format);
+    Voice* AcquireVoice(Pool& pool, int priority);
+
+    IAudioBackend* m_backend;
+    size_t m_voicesPerFormat;
+    std::vector<Pool> m_pools;
+    std::vector<Sound> m_sounds;
+    std::vector<Request> m_pending;
+    uint64_t m_sequence;
+    uint32_t m_startedCount;
+    uint32_t m_coalescedCount;
+    uint32_t m_stolenCount;
+    uint32_t m_droppedCount;
+};
@@ -1,6 +1,9 @@
 ﻿#include <windows.h>
+#include <shellapi.h>
 #include "Game.h"
 
+#pragma comment(lib, "shell32.lib")
+
 static bool g_fullscreen = false;
 
 // ウィンドウプロシージャ
@@ -79,6 +82,15 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
 
     // Initialize game
     Game game;
+
+    // --capture-audio <file.wav>: 効果音をWAVに書き出す（フレーム単位なので実時間に依存しない）
+    int argc = 0;
+    LPWSTR* argv = CommandLineToArgvW(GetCommandLineW(), &argc);
+    for (int i = 1; argv && i + 1 < argc; i++) {
+        if (wcscmp(argv[i], L"--capture-audio") == 0) game.SetAudioCapturePath(argv[i + 1]);
+    }
+    LocalFree(argv);
+
     if (!game.Initialize(hWnd, 1920, 1080)) {
         MessageBox(nullptr, L"ゲームの初期化に失敗しました", L"エラー", MB_OK | MB_ICONERROR);
         return -1;
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <filesystem>
+#include <vector>
+#include "AssetPack.h"
+
+namespace {
+std::vector<uint8_t> MakePixels(int width, int height, uint8_t seed) {
+    std::vector<uint8_t> pixels(static_cast<size_t>(width) * height * 4);
+    for (size_t i = 0; i < pixels.size(); i++) pixels[i] = static_cast<uint8_t>(i * 7 + seed);
+    return pixels;
+}
+}
+
+// 書き出したパックから名前で引くと、同じ寸法・同じ中身が返る
+TEST(AssetPackTest, RoundTripInMemory) {
+    std::vector<uint8_t> player = MakePixels(32, 16, 1);
+    std::vector<uint8_t> title = MakePixels(8, 8, 2);
+    std::vector<int16_t> pcm = { 0, 1000, -1000, 32767, -32768, 5 };
+
+    AssetPack::Writer writer;
+    writer.AddTexture("sprites/player.png", 32, 16, AssetPack::PixelFormat::RGBA8, 1, player.data(), player.size());
+    writer.AddAudio("sounds/shot.mp3", 2, 44100, 16, pcm.data(), pcm.size() * sizeof(int16_t));
+    writer.AddTexture("title_screen.jpg", 8, 8, AssetPack::PixelFormat::RGBA8, 1, title.data(), title.size());
+    std::vector<uint8_t> bytes = writer.Build();
+
+    AssetPack::Reader reader;
+    ASSERT_TRUE(reader.OpenMemory(bytes.data(), bytes.size()));
+    EXPECT_EQ(reader.GetCount(), 3u);
+
+    const AssetPack::PackEntry* entry = reader.Find("sprites/player.png");
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(entry->type, AssetPack::AssetType::Texture);
+    EXPECT_EQ(entry->width, 32u);
+    EXPECT_EQ(entry->height, 16u);
+    EXPECT_EQ(entry->dataOffset % AssetPack::DATA_ALIGNMENT, 0u);
+    ASSERT_EQ(entry->dataSize, player.size());
+    EXPECT_EQ(memcmp(reader.GetData(*entry), player.data(), player.size()), 0);
+
+    entry = reader.Find("sounds/shot.mp3");
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(entry->type, AssetPack::AssetType::Audio);
+    EXPECT_EQ(entry->channels, 2u);
+    EXPECT_EQ(entry->sampleRate, 44100u);
+    EXPECT_EQ(entry->bitsPerSample, 16u);
+    ASSERT_EQ(entry->dataSize, pcm.size() * sizeof(int16_t));
+    EXPECT_EQ(memcmp(reader.GetData(*entry), pcm.data(), entry->dataSize), 0);
+
+    EXPECT_NE(reader.Find("title_screen.jpg"), nullptr);
+    EXPECT_EQ(reader.Find("sprites/enemy.png"), nullptr);
+    EXPECT_EQ(reader.Find(""), nullptr);
+}
+
+// ファイルに書いてマップしても同じように読める
+TEST(AssetPackTest, OpensMappedFile) {
+    std::vector<uint8_t> pixels = MakePixels(64, 64, 3);
+    AssetPack::Writer writer;
+    writer.AddTexture("items/ice_cube.png", 64, 64, AssetPack::PixelFormat::RGBA8, 1, pixels.data(), pixels.size());
+
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "maltshoot_test_pack.pak";
+    ASSERT_TRUE(writer.WriteFile(path));
+    {
+        AssetPack::Reader reader;
+        ASSERT_TRUE(reader.Open(path));
+        const AssetPack::PackEntry* entry = reader.Find("items/ice_cube.png");
+        ASSERT_NE(entry, nullptr);
+        ASSERT_EQ(entry->dataSize, pixels.size());
+        EXPECT_EQ(memcmp(reader.GetData(*entry), pixels.data(), pixels.size()), 0);
+    }
+    std::filesystem::remove(path);
+
+    AssetPack::Reader missing;
+    EXPECT_FALSE(missing.Open(path));
+    EXPECT_FALSE(missing.IsOpen());
+}
+
+// 壊れた・途中で切れたパックは開かない（範囲外を読まない）
+TEST(AssetPackTest, RejectsCorruptPack) {
+    std::vector<uint8_t> pixels = MakePixels(4, 4, 4);
+    AssetPack::Writer writer;
+    writer.AddTexture("a.png", 4, 4, AssetPack::PixelFormat::RGBA8, 1, pixels.data(), pixels.size());
+    writer.AddTexture("b.png", 4, 4, AssetPack::PixelFormat::RGBA8, 1, pixels.data(), pixels.size());
+    std::vector<uint8_t> bytes = writer.Build();
+
+    AssetPack::Reader reader;
+    for (size_t size = 0; size < bytes.size(); size++) {
+        EXPECT_FALSE(reader.OpenMemory(bytes.data(), size)) << "truncated to " << size;
+    }
+
+    std::vector<uint8_t> badMagic = bytes;
+    badMagic[0] ^= 0xFF;
+    EXPECT_FALSE(reader.OpenMemory(badMagic.data(), badMagic.size()));
+
+    AssetPack::PackHeader header;
+    memcpy(&header, bytes.data(), sizeof(header));
+    std::vector<uint8_t> badEntry = bytes;
+    AssetPack::PackEntry entry;
+    memcpy(&entry, badEntry.data() + header.indexOffset, sizeof(entry));
+    entry.dataSize = bytes.size();
+    memcpy(badEntry.data() + header.indexOffset, &entry, sizeof(entry));
+    EXPECT_FALSE(reader.OpenMemory(badEntry.data(), badEntry.size()));
+
+    EXPECT_TRUE(reader.OpenMemory(bytes.data(), bytes.size()));
+}
+
+// 区切り文字と大文字小文字の違いは同じ名前にまとめる
+TEST(AssetPackTest, NormalizesNames) {
+    EXPECT_EQ(AssetPack::MakeName(L"Sprites\\Player.PNG"), "sprites/player.png");
+    EXPECT_EQ(AssetPack::MakeName("items/ice_cube.png"), "items/ice_cube.png");
+
+    std::vector<uint8_t> pixels = MakePixels(2, 2, 5);
+    AssetPack::Writer writer;
+    writer.AddTexture("UI\\Stage_Clear.png", 2, 2, AssetPack::PixelFormat::RGBA8, 1, pixels.data(), pixels.size());
+    writer.AddTexture("ui/stage_clear.png", 2, 2, AssetPack::PixelFormat::RGBA8, 1, pixels.data(), pixels.size());
+    EXPECT_EQ(writer.GetCount(), 1u);
+
+    std::vector<uint8_t> bytes = writer.Build();
+    AssetPack::Reader reader;
+    ASSERT_TRUE(reader.OpenMemory(bytes.data(), bytes.size()));
+    EXPECT_NE(reader.Find(AssetPack::MakeName(L"ui\\STAGE_CLEAR.png")), nullptr);
+}
@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+#include "AtlasPacker.h"
+
+namespace {
+bool Overlaps(const AtlasRect& a, const AtlasRect& b) {
+    return a.x < b.x + b.width && b.x < a.x + a.width &&
+           a.y < b.y + b.height && b.y < a.y + a.height;
+}
+}
+
+// 配置された矩形はアトラス内に収まり、互いに重ならない
+TEST(AtlasPackerTest, PackedRectsDoNotOverlap) {
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> side(8, 200);
+    std::vector<AtlasRect> sizes;
+    for (int i = 0; i < 60; i++) sizes.push_back({ 0, 0, side(rng), side(rng) });
+
+    AtlasLayout layout;
+    ASSERT_TRUE(PackAtlas(sizes, 4096, &layout));
+    ASSERT_EQ(layout.rects.size(), sizes.size());
+    for (size_t i = 0; i < sizes.size(); i++) {
+        const AtlasRect& r = layout.rects[i];
+        EXPECT_EQ(r.width, sizes[i].width);
+        EXPECT_EQ(r.height, sizes[i].height);
+        EXPECT_GE(r.x, 0);
+        EXPECT_GE(r.y, 0);
+        EXPECT_LE(r.x + r.width, layout.width);
+        EXPECT_LE(r.y + r.height, layout.height);
+        for (size_t j = 0; j < i; j++) {
+            EXPECT_FALSE(Overlaps(r, layout.rects[j])) << i << " / " << j;
+        }
+    }
+}
+
+// 同じ大きさの正方形16枚はちょうど4x4で埋まる
+TEST(AtlasPackerTest, FindsTightPowerOfTwoSize) {
+    std::vector<AtlasRect> sizes(16, AtlasRect{ 0, 0, 64, 64 });
+    AtlasLayout layout;
+    ASSERT_TRUE(PackAtlas(sizes, 4096, &layout));
+    EXPECT_EQ(layout.width, 256);
+    EXPECT_EQ(layout.height, 256);
+
+    MaxRectsPacker packer(128, 128);
+    AtlasRect r;
+    for (int i = 0; i < 4; i++) ASSERT_TRUE(packer.Insert(64, 64, &r));
+    EXPECT_FLOAT_EQ(packer.GetOccupancy(), 1.0f);
+    EXPECT_FALSE(packer.Insert(1, 1, &r));
+}
+
+// 上限サイズに収まらなければ失敗する
+TEST(AtlasPackerTest, FailsWhenLargerThanMaxSize) {
+    AtlasLayout layout;
+    EXPECT_FALSE(PackAtlas({ AtlasRect{ 0, 0, 300, 10 } }, 256, &layout));
+    EXPECT_FALSE(PackAtlas(std::vector<AtlasRect>(5, AtlasRect{ 0, 0, 128, 128 }), 256, &layout));
+}
+
+// パディングには端のピクセルが引き伸ばされる
+TEST(AtlasPackerTest, BlitExtrudesEdges) {
+    const uint8_t pixels[2 * 2 * 4] = {
+        1, 1, 1, 1,   2, 2, 2, 2,
+        3, 3, 3, 3,   4, 4, 4, 4,
+    };
+    std::vector<uint8_t> atlas(6 * 6 * 4, 0);
+    BlitWithExtrude(atlas.data(), 6, AtlasRect{ 1, 1, 4, 4 }, pixels, 2, 2, 1);
+
+    auto at = [&](int x, int y) { return atlas[(y * 6 + x) * 4]; };
+    EXPECT_EQ(at(0, 0), 0);   // rectの外は触らない
+    EXPECT_EQ(at(1, 1), 1);   // 左上の角
+    EXPECT_EQ(at(2, 2), 1);
+    EXPECT_EQ(at(3, 2), 2);
+    EXPECT_EQ(at(2, 3), 3);
+    EXPECT_EQ(at(3, 3), 4);
+    EXPECT_EQ(at(4, 4), 4);   // 右下の角
+    EXPECT_EQ(at(4, 2), 2);   // 右辺
+}
@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+#include "AudioMixer.h"
+#include "AudioOutput.h"
+#include "VoicePool.h"
+
+namespace {
+const AudioFormat MONO_16 = { 1, 1, 44100, 16 };
+const AudioFormat STEREO_FLOAT = { 3, 2, 44100, 32 };
+
+std::vector<int16_t> Constant16(size_t frames, int16_t value) {
+    return std::vector<int16_t>(frames, value);
+}
+
+const uint8_t* Bytes(const std::vector<int16_t>& v) { return reinterpret_cast<const uint8_t*>(v.data()); }
+size_t ByteSize(const std::vector<int16_t>& v) { return v.size() * sizeof(int16_t); }
+}
+
+// 音量・パンを掛けてステレオのバスに足し込む
+TEST(AudioMixerTest, MixesVoicesWithGainAndPan) {
+    AudioMixer mixer;
+    auto quarter = Constant16(64, 8192);  // 0.25
+    int a = mixer.CreateVoice(MONO_16);
+    int b = mixer.CreateVoice(MONO_16);
+    ASSERT_NE(a, IAudioBackend::INVALID_VOICE);
+    mixer.Start(a, Bytes(quarter), ByteSize(quarter), 1.0f, 0.0f);
+    mixer.Start(b, Bytes(quarter), ByteSize(quarter), 0.8f, 1.0f);  // 右いっぱい
+
+    std::vector<float> out(16 * AudioMixer::CHANNELS);
+    mixer.Render(out.data(), 16);
+    for (size_t i = 0; i < 16; i++) {
+        EXPECT_NEAR(out[i * 2], 0.25f, 1e-6f);
+        EXPECT_NEAR(out[i * 2 + 1], 0.25f + 0.2f, 1e-6f);
+    }
+}
+
+// 出力は -1〜1 に収める
+TEST(AudioMixerTest, ClampsMixBus) {
+    AudioMixer mixer;
+    std::vector<float> loud(8 * 2, 0.9f);
+    for (int i = 0; i < 3; i++) {
+        int v = mixer.CreateVoice(STEREO_FLOAT);
+        mixer.Start(v, reinterpret_cast<const uint8_t*>(loud.data()), loud.size() * sizeof(float), 1.0f, 0.0f);
+    }
+    std::vector<float> out(8 * AudioMixer::CHANNELS);
+    mixer.Render(out.data(), 8);
+    for (float s : out) EXPECT_FLOAT_EQ(s, 1.0f);
+}
+
+// レートの違う音は線形補間で出力レートに合わせ、鳴り終わったら止まる
+TEST(AudioMixerTest, ResamplesAndFinishes) {
+    AudioMixer mixer(44100);
+    const AudioFormat half = { 1, 1, 22050, 16 };
+    std::vector<int16_t> ramp = { 0, 16384, 0, -16384 };
+    int v = mixer.CreateVoice(half);
+    mixer.Start(v, Bytes(ramp), ByteSize(ramp), 1.0f, 0.0f);
+    EXPECT_TRUE(mixer.IsPlaying(v));
+
+    std::vector<float> out(16 * AudioMixer::CHANNELS, -2.0f);
+    mixer.Render(out.data(), 16);
+    const float expected[] = { 0.0f, 0.25f, 0.5f, 0.25f, 0.0f, -0.25f, -0.5f, -0.5f };
+    for (size_t i = 0; i < 8; i++) {
+        EXPECT_NEAR(out[i * 2], expected[i], 1e-4f) << i;
+        EXPECT_NEAR(out[i * 2 + 1], expected[i], 1e-4f) << i;
+    }
+    for (size_t i = 8; i < 16; i++) EXPECT_EQ(out[i * 2], 0.0f);
+    EXPECT_FALSE(mixer.IsPlaying(v));
+}
+
+// 対応していない形式のボイスは作らない
+TEST(AudioMixerTest, RejectsUnsupportedFormats) {
+    AudioMixer mixer;
+    EXPECT_EQ(mixer.CreateVoice({ 2, 2, 44100, 4 }), IAudioBackend::INVALID_VOICE);   // ADPCM
+    EXPECT_EQ(mixer.CreateVoice({ 1, 6, 48000, 16 }), IAudioBackend::INVALID_VOICE);  // 5.1ch
+}
+
+// オフライン出力: ゲームのフレームごとに 1/60 秒分をWAVに書く
+TEST(AudioMixerTest, CapturesFramesToWav) {
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "malt_shoot_capture_test.wav";
+    auto tone = Constant16(2000, 16384);
+    {
+        AudioMixer mixer;
+        VoicePool pool(&mixer, 4);
+        int sound = pool.RegisterSound(MONO_16, Bytes(tone), ByteSize(tone), 0);
+        WavFileOutput output(path);
+        ASSERT_TRUE(output.Start(&mixer));
+        pool.Play(sound, 1.0f);
+        for (int frame = 0; frame < 60; frame++) {
+            pool.EndFrame();
+            output.EndFrame();
+        }
+        EXPECT_EQ(output.GetWrittenFrames(), 44100u);
+        output.Stop();
+    }
+
+    std::ifstream file(path, std::ios::binary);
+    std::vector<char> wav((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    file.close();
+    std::filesystem::remove(path);
+
+    ASSERT_EQ(wav.size(), 44u + 44100u * 4u);
+    EXPECT_EQ(std::memcmp(wav.data(), "RIFF", 4), 0);
+    EXPECT_EQ(std::memcmp(wav.data() + 8, "WAVE", 4), 0);
+    uint32_t dataSize;
+    std::memcpy(&dataSize, wav.data() + 40, 4);
+    EXPECT_EQ(dataSize, 44100u * 4u);
+
+    // 最初は鳴っていて、音の長さ（2000フレーム）を過ぎたら無音
+    int16_t first, later;
+    std::memcpy(&first, wav.data() + 44, 2);
+    std::memcpy(&later, wav.data() + 44 + 2000 * 4, 2);
+    EXPECT_NEAR(first, 16383, 1);
+    EXPECT_EQ(later, 0);
+}
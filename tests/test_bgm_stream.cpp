@@ -0,0 +1,199 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+#include "AudioMixer.h"
+#include "AudioRingBuffer.h"
+#include "BGMPlayer.h"
+#include "StreamDecoder.h"
+
+namespace {
+
+// 16bit ステレオの WAV を書く（左右とも samples の値）
+void WriteWav(const std::filesystem::path& path, const std::vector<int16_t>& samples) {
+    std::ofstream file(path, std::ios::binary);
+    auto u32 = [&file](uint32_t v) { file.write(reinterpret_cast<const char*>(&v), 4); };
+    auto u16 = [&file](uint16_t v) { file.write(reinterpret_cast<const char*>(&v), 2); };
+    uint32_t dataSize = static_cast<uint32_t>(samples.size() * 4);
+    file.write("RIFF", 4);
+    u32(36 + dataSize);
+    file.write("WAVEfmt ", 8);
+    u32(16);
+    u16(1);
+    u16(2);
+    u32(44100);
+    u32(44100 * 4);
+    u16(4);
+    u16(16);
+    file.write("data", 4);
+    u32(dataSize);
+    for (int16_t s : samples) {
+        u16(static_cast<uint16_t>(s));
+        u16(static_cast<uint16_t>(s));
+    }
+}
+
+std::unique_ptr<IStreamDecoder> OpenWav(const std::filesystem::path& path, uint32_t) {
+    auto decoder = std::make_unique<WavStreamDecoder>();
+    if (!decoder->Open(path)) return nullptr;
+    return decoder;
+}
+
+class BGMStreamTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        m_dir = std::filesystem::temp_directory_path() / "malt_shoot_bgm_test";
+        std::filesystem::create_directories(m_dir);
+    }
+    void TearDown() override { std::filesystem::remove_all(m_dir); }
+
+    // 左チャンネルを frames 分取り出す（スレッドなしのときは1ブロックごとにデコードも回す）
+    std::vector<float> RenderLeft(AudioMixer& mixer, BGMPlayer& player, size_t frames) {
+        std::vector<float> left;
+        std::vector<float> block(AudioMixer::BLOCK_FRAMES * 2);
+        while (left.size() < frames) {
+            player.EndFrame();
+            mixer.Render(block.data(), AudioMixer::BLOCK_FRAMES);
+            for (size_t i = 0; i < AudioMixer::BLOCK_FRAMES && left.size() < frames; i++) left.push_back(block[i * 2]);
+        }
+        return left;
+    }
+
+    std::filesystem::path m_dir;
+};
+
+} // namespace
+
+// 折り返しをまたいで書いて読める・容量を超えては書かない
+TEST(AudioRingBufferTest, WrapsAroundAndRespectsCapacity) {
+    AudioRingBuffer ring(6);
+    EXPECT_EQ(ring.GetCapacity(), 8u);
+
+    std::vector<float> in(40);
+    for (size_t i = 0; i < in.size(); i++) in[i] = static_cast<float>(i);
+    std::vector<float> out(20, -1.0f);
+
+    EXPECT_EQ(ring.Write(in.data(), 5), 5u);
+    EXPECT_EQ(ring.Read(out.data(), 3), 3u);
+    EXPECT_EQ(ring.Write(in.data() + 10, 10), 6u);  // 空きは6フレーム
+    EXPECT_EQ(ring.GetFree(), 0u);
+    EXPECT_EQ(ring.Read(out.data(), 10), 8u);
+
+    const float expected[] = { 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21 };
+    for (size_t i = 0; i < 16; i++) EXPECT_EQ(out[i], expected[i]) << i;
+    EXPECT_EQ(ring.GetAvailable(), 0u);
+}
+
+// ループ終点から始点へ途切れなく戻る
+TEST_F(BGMStreamTest, LoopsSeamlesslyBetweenLoopPoints) {
+    std::vector<int16_t> ramp(3000);
+    for (size_t i = 0; i < ramp.size(); i++) ramp[i] = static_cast<int16_t>(i);
+    WriteWav(m_dir / "ramp.wav", ramp);
+
+    AudioMixer mixer;
+    BGMPlayer player;
+    ASSERT_TRUE(player.Initialize(&mixer, m_dir, OpenWav, false));
+    player.SetVolume(1000);
+    player.Play({ L"ramp.wav", 1000, 2000 }, 0.0f);
+
+    std::vector<float> left = RenderLeft(mixer, player, 6000);
+    for (size_t i = 0; i < left.size(); i++) {
+        size_t expected = i < 2000 ? i : 1000 + (i - 2000) % 1000;
+        ASSERT_EQ(static_cast<int>(std::lround(left[i] * 32768.0f)), static_cast<int>(expected)) << i;
+    }
+    EXPECT_EQ(player.GetUnderrunCount(), 0u);
+}
+
+// ループ点なしはファイルの終わりから頭へ戻る
+TEST_F(BGMStreamTest, LoopsWholeFileByDefault) {
+    std::vector<int16_t> ramp(700);
+    for (size_t i = 0; i < ramp.size(); i++) ramp[i] = static_cast<int16_t>(i + 1);
+    WriteWav(m_dir / "short.wav", ramp);
+
+    AudioMixer mixer;
+    BGMPlayer player;
+    ASSERT_TRUE(player.Initialize(&mixer, m_dir, OpenWav, false));
+    player.SetVolume(1000);
+    player.Play({ L"short.wav", 0, 0 }, 0.0f);
+
+    std::vector<float> left = RenderLeft(mixer, player, 2100);
+    for (size_t i = 0; i < left.size(); i++) {
+        ASSERT_EQ(static_cast<int>(std::lround(left[i] * 32768.0f)), static_cast<int>(i % 700 + 1)) << i;
+    }
+}
+
+// 曲の切り替えは前の曲を下げながら次の曲を上げる
+TEST_F(BGMStreamTest, CrossfadesBetweenTracks) {
+    WriteWav(m_dir / "a.wav", std::vector<int16_t>(44100, 16384));   // 0.5
+    WriteWav(m_dir / "b.wav", std::vector<int16_t>(44100, -8192));   // -0.25
+
+    AudioMixer mixer;
+    BGMPlayer player;
+    ASSERT_TRUE(player.Initialize(&mixer, m_dir, OpenWav, false));
+    player.SetVolume(1000);
+    player.Play({ L"a.wav", 0, 0 }, 0.0f);
+    std::vector<float> before = RenderLeft(mixer, player, 512);
+    EXPECT_FLOAT_EQ(before.back(), 0.5f);
+
+    const float crossfade = 441.0f / 44100.0f;  // 441フレーム
+    player.Play({ L"b.wav", 0, 0 }, crossfade);
+    player.EndFrame();
+    EXPECT_EQ(player.GetStreamCount(), 2u);
+
+    std::vector<float> left = RenderLeft(mixer, player, 1024);
+    EXPECT_LT(left[0], 0.5f);
+    EXPECT_GT(left[0], 0.49f);
+    for (size_t i = 1; i < 441; i++) EXPECT_LE(left[i], left[i - 1] + 1e-6f) << i;
+    for (size_t i = 445; i < left.size(); i++) EXPECT_NEAR(left[i], -0.25f, 1e-5f) << i;
+
+    player.EndFrame();
+    EXPECT_EQ(player.GetStreamCount(), 1u);
+}
+
+// 開けない曲なら今の曲を止めるだけ
+TEST_F(BGMStreamTest, MissingFileStopsCurrentTrack) {
+    WriteWav(m_dir / "a.wav", std::vector<int16_t>(4410, 1000));
+
+    AudioMixer mixer;
+    BGMPlayer player;
+    ASSERT_TRUE(player.Initialize(&mixer, m_dir, OpenWav, false));
+    player.Play({ L"a.wav", 0, 0 }, 0.0f);
+    player.EndFrame();
+    EXPECT_EQ(player.GetStreamCount(), 1u);
+
+    player.Play({ L"missing.wav", 0, 0 }, 0.0f);
+    player.EndFrame();
+    EXPECT_EQ(player.GetStreamCount(), 0u);
+    std::vector<float> left = RenderLeft(mixer, player, 64);
+    for (float s : left) EXPECT_EQ(s, 0.0f);
+}
+
+// スレッドありでも Play はすぐ戻り、ストリームスレッドが読み始める
+TEST_F(BGMStreamTest, StreamThreadDecodesInBackground) {
+    std::vector<int16_t> ramp(5000);
+    for (size_t i = 0; i < ramp.size(); i++) ramp[i] = static_cast<int16_t>(i);
+    WriteWav(m_dir / "ramp.wav", ramp);
+
+    AudioMixer mixer;
+    BGMPlayer player;
+    ASSERT_TRUE(player.Initialize(&mixer, m_dir, OpenWav, true));
+    player.SetVolume(1000);
+    player.Play({ L"ramp.wav", 0, 0 }, 0.0f);
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (player.GetStreamCount() == 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_EQ(player.GetStreamCount(), 1u);
+
+    std::vector<float> out(256 * 2);
+    mixer.Render(out.data(), 256);
+    for (size_t i = 0; i < 256; i++) {
+        EXPECT_EQ(static_cast<int>(std::lround(out[i * 2] * 32768.0f)), static_cast<int>(i));
+    }
+    player.Shutdown();
+}
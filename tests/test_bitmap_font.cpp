@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include "BitmapFont.h"
+
+namespace {
+
+// 1色で塗った文字画像
+GlyphImage SolidGlyph(wchar_t code, int width, int height, float advance, uint8_t alpha) {
+    GlyphImage image;
+    image.code = code;
+    image.width = width;
+    image.height = height;
+    image.advance = advance;
+    image.offsetX = -2.0f;
+    image.pixels.assign(static_cast<size_t>(width) * height * 4, 255);
+    for (size_t i = 3; i < image.pixels.size(); i += 4) image.pixels[i] = alpha;
+    return image;
+}
+
+std::vector<GlyphImage> Digits() {
+    std::vector<GlyphImage> images;
+    for (wchar_t c = L'0'; c <= L'9'; c++) {
+        images.push_back(SolidGlyph(c, 14, 24, 10.0f, static_cast<uint8_t>(100 + (c - L'0'))));
+    }
+    return images;
+}
+
+} // namespace
+
+// 全文字が重ならずにアトラスへ入り、UVの位置に元の画素が来る
+TEST(BitmapFontTest, PacksGlyphsIntoAtlas) {
+    BitmapFont font;
+    std::vector<uint8_t> atlas;
+    std::vector<GlyphImage> images = Digits();
+    images.push_back(SolidGlyph(0x3042, 14, 24, 10.0f, 255));  // ASCII外は入れない
+    ASSERT_TRUE(font.Build(images, 24.0f, &atlas));
+    ASSERT_EQ(atlas.size(), static_cast<size_t>(font.GetWidth()) * font.GetHeight() * 4);
+    EXPECT_EQ(font.Find(0x3042), nullptr);
+    EXPECT_EQ(font.Find(L'A'), nullptr);
+
+    std::vector<AtlasRect> placed;
+    for (wchar_t c = L'0'; c <= L'9'; c++) {
+        const FontGlyph* glyph = font.Find(c);
+        ASSERT_NE(glyph, nullptr);
+        int x0 = static_cast<int>(glyph->uv.x * font.GetWidth() + 0.5f);
+        int y0 = static_cast<int>(glyph->uv.y * font.GetHeight() + 0.5f);
+        int x1 = static_cast<int>(glyph->uv.z * font.GetWidth() + 0.5f);
+        int y1 = static_cast<int>(glyph->uv.w * font.GetHeight() + 0.5f);
+        EXPECT_EQ(x1 - x0, 14);
+        EXPECT_EQ(y1 - y0, 24);
+        size_t center = (static_cast<size_t>(y0 + 12) * font.GetWidth() + x0 + 7) * 4;
+        EXPECT_EQ(atlas[center + 3], 100 + (c - L'0'));
+
+        for (const AtlasRect& other : placed) {
+            bool overlap = x0 < other.x + other.width && other.x < x1 && y0 < other.y + other.height && other.y < y1;
+            EXPECT_FALSE(overlap) << static_cast<char>(c);
+        }
+        placed.push_back({ x0, y0, x1 - x0, y1 - y0 });
+    }
+}
+
+// 送り幅で並べ、無い文字は飛ばす
+TEST(BitmapFontTest, LaysOutTextByAdvance) {
+    BitmapFont font;
+    std::vector<uint8_t> atlas;
+    ASSERT_TRUE(font.Build(Digits(), 24.0f, &atlas));
+
+    EXPECT_FLOAT_EQ(font.Measure(L"1200", 1.0f), 40.0f);
+    EXPECT_FLOAT_EQ(font.Measure(L"1?2", 2.0f), 40.0f);
+
+    std::vector<float> xs;
+    font.Layout(L"9?87", 100.0f, 50.0f, 2.0f, [&xs](float x, float y, float w, float h, const DirectX::XMFLOAT4&) {
+        xs.push_back(x);
+        EXPECT_FLOAT_EQ(y, 50.0f);
+        EXPECT_FLOAT_EQ(w, 28.0f);
+        EXPECT_FLOAT_EQ(h, 48.0f);
+    });
+    ASSERT_EQ(xs.size(), 3u);
+    EXPECT_FLOAT_EQ(xs[0], 96.0f);   // 縁取り分だけ左へ
+    EXPECT_FLOAT_EQ(xs[1], 116.0f);
+    EXPECT_FLOAT_EQ(xs[2], 136.0f);
+
+    BitmapFont empty;
+    EXPECT_FALSE(empty.Build({}, 24.0f, &atlas));
+}
@@ -0,0 +1,262 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "BlockCompression.h"
+
+using AssetPack::PixelFormat;
+
+namespace {
+// なだらかなグラデーション＋円形のアルファ（イラストに近い入力）
+std::vector<uint8_t> MakeImage(uint32_t width, uint32_t height) {
+    std::vector<uint8_t> rgba(static_cast<size_t>(width) * height * 4);
+    for (uint32_t y = 0; y < height; y++) {
+        for (uint32_t x = 0; x < width; x++) {
+            uint8_t* p = &rgba[(static_cast<size_t>(y) * width + x) * 4];
+            float dx = x - width / 2.0f, dy = y - height / 2.0f;
+            p[0] = static_cast<uint8_t>(255 * x / (width - 1));
+            p[1] = static_cast<uint8_t>(255 * y / (height - 1));
+            p[2] = static_cast<uint8_t>(128 + 100 * std::sin(x * 0.1f));
+            p[3] = static_cast<uint8_t>(std::fmin(255.0f, std::sqrt(dx * dx + dy * dy) * 8.0f));
+        }
+    }
+    return rgba;
+}
+
+// BC7 モード6の4ビット補間値（端点 0 と 255、重み {0,4,9,...,60,64} / 64）
+const uint8_t BC7_RAMP[16] = { 0, 16, 36, 52, 68, 84, 104, 120, 135, 151, 171, 187, 203, 219, 239, 255 };
+
+void ExpectBytes(const uint8_t* actual, const uint8_t* expected, size_t count) {
+    for (size_t i = 0; i < count; i++) EXPECT_EQ(actual[i], expected[i]) << "byte " << i;
+}
+
+double Psnr(const std::vector<uint8_t>& a, const std::vector<uint8_t>& b, int channels) {
+    double sum = 0.0;
+    size_t count = 0;
+    for (size_t i = 0; i < a.size(); i += 4) {
+        for (int c = 0; c < channels; c++) {
+            double d = static_cast<double>(a[i + c]) - b[i + c];
+            sum += d * d;
+            count++;
+        }
+    }
+    double mse = sum / count;
+    return mse == 0.0 ? 99.0 : 10.0 * std::log10(255.0 * 255.0 / mse);
+}
+}
+
+// 単色ブロックは量子化誤差の範囲で戻る
+TEST(BlockCompressionTest, SolidBlocksRoundTrip) {
+    std::mt19937 rng(3);
+    for (int n = 0; n < 50; n++) {
+        uint8_t color[4] = { static_cast<uint8_t>(rng()), static_cast<uint8_t>(rng()),
+                             static_cast<uint8_t>(rng()), static_cast<uint8_t>(rng()) };
+        uint8_t block[64];
+        for (int i = 0; i < 16; i++) memcpy(block + i * 4, color, 4);
+
+        uint8_t encoded[16];
+        uint8_t decoded[64];
+        BlockCompression::EncodeBC1(block, encoded);
+        BlockCompression::DecodeBC1(encoded, decoded);
+        for (int i = 0; i < 16; i++) {
+            EXPECT_NEAR(decoded[i * 4 + 0], color[0], 4);
+            EXPECT_NEAR(decoded[i * 4 + 1], color[1], 2);
+            EXPECT_NEAR(decoded[i * 4 + 2], color[2], 4);
+            EXPECT_EQ(decoded[i * 4 + 3], 255);
+        }
+
+        BlockCompression::EncodeBC3(block, encoded);
+        BlockCompression::DecodeBC3(encoded, decoded);
+        for (int i = 0; i < 16; i++) EXPECT_EQ(decoded[i * 4 + 3], color[3]);
+
+        BlockCompression::EncodeBC7(block, encoded);
+        ASSERT_TRUE(BlockCompression::DecodeBC7(encoded, decoded));
+        for (int i = 0; i < 64; i++) EXPECT_NEAR(decoded[i], block[i], 1);
+    }
+}
+
+// 仕様のビット配置どおりに手で組んだブロック（エンコーダー・デコーダーの両方を外から確かめる）
+// BC1: c0, c1（RGB565 リトルエンディアン）、2ビット×16のインデックス（テクセル0が最下位）
+TEST(BlockCompressionTest, BC1KnownAnswer) {
+    // c0 = 赤 (0xF800) > c1 = 青 (0x001F) の4色モード、テクセル i はインデックス i % 4
+    const uint8_t fourColor[8] = { 0x00, 0xF8, 0x1F, 0x00, 0xE4, 0xE4, 0xE4, 0xE4 };
+    uint8_t decoded[64];
+    BlockCompression::DecodeBC1(fourColor, decoded);
+    for (int i = 0; i < 16; i += 4) {
+        const uint8_t* t = decoded + i * 4;
+        EXPECT_EQ(t[0], 255); EXPECT_EQ(t[1], 0); EXPECT_EQ(t[2], 0); EXPECT_EQ(t[3], 255);
+        EXPECT_EQ(t[4], 0); EXPECT_EQ(t[5], 0); EXPECT_EQ(t[6], 255); EXPECT_EQ(t[7], 255);
+        EXPECT_NEAR(t[8], 170, 1); EXPECT_EQ(t[9], 0); EXPECT_NEAR(t[10], 85, 1);   // 2/3 c0 + 1/3 c1
+        EXPECT_NEAR(t[12], 85, 1); EXPECT_EQ(t[13], 0); EXPECT_NEAR(t[14], 170, 1); // 1/3 c0 + 2/3 c1
+    }
+
+    // c0 <= c1 は3色モード、インデックス3は透明な黒
+    const uint8_t threeColor[8] = { 0x1F, 0x00, 0x00, 0xF8, 0xFF, 0xFF, 0xFF, 0xFF };
+    BlockCompression::DecodeBC1(threeColor, decoded);
+    for (int i = 0; i < 64; i++) EXPECT_EQ(decoded[i], 0);
+
+    // 赤と青の市松模様は端点そのままの4色モード（c0 > c1）になる
+    uint8_t block[64];
+    for (int i = 0; i < 16; i++) {
+        bool red = ((i & 3) + (i >> 2)) % 2 == 0;
+        uint8_t texel[4] = { static_cast<uint8_t>(red ? 255 : 0), 0, static_cast<uint8_t>(red ? 0 : 255), 255 };
+        memcpy(block + i * 4, texel, 4);
+    }
+    const uint8_t checker[8] = { 0x00, 0xF8, 0x1F, 0x00, 0x44, 0x11, 0x44, 0x11 };
+    uint8_t encoded[8];
+    BlockCompression::EncodeBC1(block, encoded);
+    ExpectBytes(encoded, checker, 8);
+}
+
+// BC3: アルファ0, アルファ1、3ビット×16のインデックス、続いてBC1と同じ色ブロック（常に4色モード）
+TEST(BlockCompressionTest, BC3KnownAnswer) {
+    // a0 = 255 > a1 = 0 の8段階、テクセル i はインデックス i % 8。色は白1色
+    const uint8_t ramp[16] = { 0xFF, 0x00, 0x88, 0xC6, 0xFA, 0x88, 0xC6, 0xFA,
+                               0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00 };
+    const int alphas[8] = { 255, 0, 218, 182, 145, 109, 72, 36 };  // (7-k)/7 a0 + k/7 a1
+    uint8_t decoded[64];
+    BlockCompression::DecodeBC3(ramp, decoded);
+    for (int i = 0; i < 16; i++) {
+        EXPECT_EQ(decoded[i * 4 + 0], 255);
+        EXPECT_EQ(decoded[i * 4 + 1], 255);
+        EXPECT_EQ(decoded[i * 4 + 2], 255);
+        EXPECT_NEAR(decoded[i * 4 + 3], alphas[i % 8], 1) << "texel " << i;
+    }
+
+    // 上半分が不透明・下半分が透明の白
+    uint8_t block[64];
+    for (int i = 0; i < 16; i++) {
+        uint8_t texel[4] = { 255, 255, 255, static_cast<uint8_t>(i < 8 ? 255 : 0) };
+        memcpy(block + i * 4, texel, 4);
+    }
+    const uint8_t halves[16] = { 0xFF, 0x00, 0x00, 0x00, 0x00, 0x49, 0x92, 0x24,
+                                 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00 };
+    uint8_t encoded[16];
+    BlockCompression::EncodeBC3(block, encoded);
+    ExpectBytes(encoded, halves, 16);
+}
+
+// BC7 モード6: モード(7ビット: 0000001) R0 R1 G0 G1 B0 B1 A0 A1(各7ビット) P0 P1、
+// インデックス（テクセル0は3ビット、残りは4ビット）。端点 = (7ビット << 1) | Pビット
+TEST(BlockCompressionTest, BC7Mode6KnownAnswer) {
+    // 端点がチャンネルごとに違うブロック（R/G/B/A の並びや端点0/1の取り違えを見分ける）
+    // e0 = (21, 41, 61, 81)（P0 = 1）、e1 = (200, 180, 160, 140)（P1 = 0）
+    // テクセル0はインデックス7、テクセル i (i ≥ 1) は 15 - i
+    const uint8_t mixed[16] = { 0x40, 0x05, 0x99, 0xA2, 0xF5, 0x40, 0x51, 0xC6,
+                                0xEE, 0xCD, 0xAB, 0x89, 0x67, 0x45, 0x23, 0x01 };
+    uint8_t decoded[64];
+    ASSERT_TRUE(BlockCompression::DecodeBC7(mixed, decoded));
+    const uint8_t texel0[4] = { 105, 106, 107, 109 };
+    const uint8_t texel1[4] = { 189, 171, 154, 136 };
+    const uint8_t texel15[4] = { 21, 41, 61, 81 };
+    ExpectBytes(decoded, texel0, 4);
+    ExpectBytes(decoded + 4, texel1, 4);
+    ExpectBytes(decoded + 60, texel15, 4);
+
+    // テクセル i が補間値 i 番の灰色 → 端点 0（P0 = 0）と 255（P1 = 1）、インデックス i
+    uint8_t block[64];
+    for (int i = 0; i < 16; i++) memset(block + i * 4, BC7_RAMP[i], 4);
+    const uint8_t rising[16] = { 0x40, 0xC0, 0x1F, 0xF0, 0x07, 0xFC, 0x01, 0x7F,
+                                 0x11, 0x32, 0x54, 0x76, 0x98, 0xBA, 0xDC, 0xFE };
+    uint8_t encoded[16];
+    BlockCompression::EncodeBC7(block, encoded);
+    ExpectBytes(encoded, rising, 16);
+
+    // 逆順だとテクセル0が255。アンカーの最上位ビットを0にするため端点が入れ替わる
+    for (int i = 0; i < 16; i++) memset(block + i * 4, BC7_RAMP[15 - i], 4);
+    const uint8_t falling[16] = { 0xC0, 0x3F, 0xE0, 0x0F, 0xF8, 0x03, 0xFE, 0x80,
+                                  0x10, 0x32, 0x54, 0x76, 0x98, 0xBA, 0xDC, 0xFE };
+    BlockCompression::EncodeBC7(block, encoded);
+    ExpectBytes(encoded, falling, 16);
+}
+
+// グラデーション画像の画質（PSNR）が各形式の目安を満たす
+// 縦横2方向のグラデーションは1本の線分では表せないので、どの形式も40dB弱になる
+TEST(BlockCompressionTest, GradientQuality) {
+    const uint32_t width = 64, height = 48;
+    std::vector<uint8_t> image = MakeImage(width, height);
+    std::vector<uint8_t> decoded;
+
+    std::vector<uint8_t> bc1 = BlockCompression::CompressImage(PixelFormat::BC1, image.data(), width, height);
+    ASSERT_EQ(bc1.size(), width * height / 2);
+    ASSERT_TRUE(BlockCompression::DecompressImage(PixelFormat::BC1, bc1.data(), width, height, &decoded));
+    EXPECT_GT(Psnr(image, decoded, 3), 35.0);
+
+    std::vector<uint8_t> bc3 = BlockCompression::CompressImage(PixelFormat::BC3, image.data(), width, height);
+    ASSERT_EQ(bc3.size(), width * height);
+    ASSERT_TRUE(BlockCompression::DecompressImage(PixelFormat::BC3, bc3.data(), width, height, &decoded));
+    EXPECT_GT(Psnr(image, decoded, 4), 35.0);
+
+    std::vector<uint8_t> bc7 = BlockCompression::CompressImage(PixelFormat::BC7, image.data(), width, height);
+    ASSERT_EQ(bc7.size(), width * height);
+    ASSERT_TRUE(BlockCompression::DecompressImage(PixelFormat::BC7, bc7.data(), width, height, &decoded));
+    EXPECT_GT(Psnr(image, decoded, 4), 35.0);
+}
+
+// ミップ段数・サイズ計算と、4の倍数でない端のブロック
+TEST(BlockCompressionTest, MipChainSizes) {
+    EXPECT_EQ(BlockCompression::CountMipLevels(1920, 1080), 11u);
+    EXPECT_EQ(BlockCompression::CountMipLevels(1024, 1024), 11u);
+    EXPECT_EQ(BlockCompression::CountMipLevels(1, 1), 1u);
+
+    EXPECT_EQ(BlockCompression::GetLevelSize(PixelFormat::BC1, 1920, 1080), 1920u * 1080 / 2);
+    EXPECT_EQ(BlockCompression::GetLevelSize(PixelFormat::BC7, 2, 1), 16u);
+    EXPECT_EQ(BlockCompression::GetLevelSize(PixelFormat::RGBA8, 3, 5), 60u);
+    EXPECT_EQ(BlockCompression::GetRowPitch(PixelFormat::BC3, 10), 48u);
+
+    const uint32_t width = 20, height = 12;
+    std::vector<uint8_t> image = MakeImage(width, height);
+    uint32_t levels = BlockCompression::CountMipLevels(width, height);
+    for (PixelFormat format : { PixelFormat::RGBA8, PixelFormat::BC1, PixelFormat::BC3, PixelFormat::BC7 }) {
+        std::vector<uint8_t> chain = BlockCompression::BuildMipChain(format, image.data(), width, height, levels);
+        EXPECT_EQ(chain.size(), BlockCompression::GetChainSize(format, width, height, levels));
+    }
+}
+
+// 縮小は2x2の平均。色はアルファで重み付けするので透明なテクセルの黒は混ざらない
+TEST(BlockCompressionTest, DownsampleAverages) {
+    std::vector<uint8_t> image = {
+        0, 0, 0, 0,       100, 0, 0, 255,
+        200, 0, 0, 255,   100, 40, 0, 255,
+    };
+    std::vector<uint8_t> half = BlockCompression::Downsample(image.data(), 2, 2);
+    ASSERT_EQ(half.size(), 4u);
+    EXPECT_EQ(half[0], 133);
+    EXPECT_EQ(half[1], 13);
+    EXPECT_EQ(half[3], 191);
+
+    // 半透明は不透明度に比例して効く。全部透明なら色はそのまま平均
+    std::vector<uint8_t> mixed = {
+        255, 255, 255, 255,   0, 0, 0, 85,
+        0, 0, 0, 0,           0, 0, 0, 0,
+    };
+    half = BlockCompression::Downsample(mixed.data(), 2, 2);
+    EXPECT_EQ(half[0], 191);  // 255 × 255 / (255 + 85)
+    EXPECT_EQ(half[3], 85);
+    std::vector<uint8_t> clear = {
+        40, 0, 0, 0,   80, 0, 0, 0,
+        40, 0, 0, 0,   80, 0, 0, 0,
+    };
+    half = BlockCompression::Downsample(clear.data(), 2, 2);
+    EXPECT_EQ(half[0], 60);
+    EXPECT_EQ(half[3], 0);
+}
+
+// 透明な黒に囲まれた白いスプライトは、縮小しても縁が暗くならない
+TEST(BlockCompressionTest, MipsDoNotBleedTransparentColor) {
+    const uint32_t size = 16;
+    std::vector<uint8_t> image(size * size * 4, 0);
+    for (uint32_t y = 4; y < 12; y++) {
+        for (uint32_t x = 5; x < 11; x++) memset(&image[(y * size + x) * 4], 255, 4);
+    }
+    std::vector<uint8_t> level = image;
+    for (uint32_t w = size; w > 1; w /= 2) {
+        level = BlockCompression::Downsample(level.data(), w, w);
+        for (size_t i = 0; i < level.size(); i += 4) {
+            if (level[i + 3] > 0) {
+                EXPECT_EQ(level[i], 255) << "mip " << w / 2 << " texel " << i / 4;
+            }
+        }
+    }
+}
@@ -1,5 +1,10 @@
 #include <gtest/gtest.h>
 #include <cmath>
+#include "EnemyIndex.h"
+#include "BulletMath.h"
+#include "BulletPalette.h"
+#include "BulletPool.h"
+#include "BulletManager.h"
 
 // BulletManagerのテスト用に必要な定義（Graphicsに依存しない部分）
 
@@ -114,3 +119,277 @@ TEST(CollisionTest, CircleCircleCollision) {
     collision = dist < (r1 + r2);
     EXPECT_FALSE(collision);
 }
+
+// ホーミング用空間インデックス：セルをまたいだ最寄り探索
+TEST(EnemyIndexTest, FindNearestAcrossCells) {
+    EnemyIndex index;
+    index.Begin(1200, 1080);
+    index.Add(1, { 100.0f, 100.0f }, true);
+    index.Add(2, { 600.0f, 500.0f }, true);
+    index.Add(3, { 1100.0f, 1000.0f }, true);
+    index.Add(4, { 590.0f, 490.0f }, false);  // 撃破済みは対象外
+    index.Build();
+
+    EXPECT_EQ(index.FindNearest({ 120.0f, 90.0f }), 0);
+    EXPECT_EQ(index.FindNearest({ 580.0f, 480.0f }), 1);
+    EXPECT_EQ(index.FindNearest({ 1190.0f, 1070.0f }), 2);
+    // 画面外（出撃直後のミサイル）からでも探索できる
+    EXPECT_EQ(index.FindNearest({ -40.0f, -40.0f }), 0);
+}
+
+// キャッシュしたスロットは敵の入れ替わりで無効になる
+TEST(EnemyIndexTest, ResolveRejectsStaleTarget) {
+    EnemyIndex index;
+    index.Begin(1200, 1080);
+    index.Add(7, { 300.0f, 300.0f }, true);
+    index.Build();
+    EXPECT_NE(index.Resolve(0, 7), nullptr);
+
+    index.Begin(1200, 1080);
+    index.Add(8, { 300.0f, 300.0f }, true);
+    index.Build();
+    EXPECT_EQ(index.Resolve(0, 7), nullptr);
+    EXPECT_EQ(index.Resolve(5, 8), nullptr);
+}
+
+// ホーミング旋回：Updateで最寄りの敵へ毎フレーム最大0.15ラジアンずつ向きを変え、
+// 角度差が上限以内になったら目標へまっすぐ向く（速さは変えない）
+TEST(BulletManagerTest, HomingTurnsTowardIndexedEnemy) {
+    EnemyIndex index;
+    index.Begin(1200, 1080);
+    index.Add(1, { 900.0f, 500.0f }, true);   // 右
+    index.Add(2, { 100.0f, 1000.0f }, true);  // 遠いので対象外
+    index.Build();
+
+    BulletManager manager;
+    manager.SetEnemyIndex(&index);
+    BulletHandle handle = manager.SpawnHomingMissile(500.0f, 500.0f, 0.0f, -100.0f);  // 上向き
+    ASSERT_TRUE(handle.IsValid());
+
+    manager.Update(0.001f, 1200, 1080);
+    const Bullet* bullet = manager.GetBullet(handle);
+    ASSERT_NE(bullet, nullptr);
+    float expected = -PI / 2.0f + 0.15f;
+    EXPECT_NEAR(bullet->velocity.x, cosf(expected) * 100.0f, 0.01f);
+    EXPECT_NEAR(bullet->velocity.y, sinf(expected) * 100.0f, 0.01f);
+    EXPECT_EQ(bullet->homingTarget, 0);
+
+    for (int frame = 0; frame < 20; frame++) {
+        manager.Update(0.001f, 1200, 1080);
+    }
+    bullet = manager.GetBullet(handle);
+    ASSERT_NE(bullet, nullptr);
+    float dx = 900.0f - bullet->position.x;
+    float dy = 500.0f - bullet->position.y;
+    float dist = sqrtf(dx * dx + dy * dy);
+    EXPECT_NEAR(bullet->velocity.x, dx / dist * 100.0f, 0.05f);
+    EXPECT_NEAR(bullet->velocity.y, dy / dist * 100.0f, 0.05f);
+
+    // 敵インデックスが空なら曲がらない
+    index.Begin(1200, 1080);
+    index.Build();
+    BulletHandle straight = manager.SpawnHomingMissile(500.0f, 500.0f, 0.0f, -100.0f);
+    manager.Update(0.001f, 1200, 1080);
+    EXPECT_EQ(manager.GetBullet(straight)->velocity.x, 0.0f);
+    EXPECT_EQ(manager.GetBullet(straight)->velocity.y, -100.0f);
+}
+
+// コンパイル時方向テーブルが三角関数と一致する
+TEST(BulletPatternTest, DirectionTableMatchesTrig) {
+    for (int count : { 4, 16, 20, 40 }) {
+        for (int i = 0; i < count; i++) {
+            float angle = (2.0f * PI * i) / count;
+            BulletMath::UnitDir dir = BulletMath::Direction(i, count);
+            EXPECT_NEAR(dir.x, cosf(angle), 1e-5f);
+            EXPECT_NEAR(dir.y, sinf(angle), 1e-5f);
+        }
+    }
+}
+
+// テーブルで割り切れない弾数（7発）でもオフセット付きリングが正しい
+TEST(BulletPatternTest, RingDirectionsWithOffset) {
+    const float offset = 0.3f;
+    for (int count : { 7, 40 }) {
+        int visited = 0;
+        BulletMath::ForEachRingDirection(count, offset, [&](int i, BulletMath::UnitDir dir) {
+            float angle = offset + (2.0f * PI * i) / count;
+            EXPECT_NEAR(dir.x, cosf(angle), 1e-4f);
+            EXPECT_NEAR(dir.y, sinf(angle), 1e-4f);
+            visited++;
+        });
+        EXPECT_EQ(visited, count);
+    }
+}
+
+// 同じ色は同じパレット番号になり、虹色LUTは先頭に固定されている
+TEST(BulletPaletteTest, InternReusesColors) {
+    BulletPalette palette;
+    EXPECT_EQ(palette.GetCount(), BulletMath::RAINBOW_LUT_SIZE);
+
+    uint8_t red = palette.Intern(DirectX::XMFLOAT4(1.0f, 0.2f, 0.2f, 1.0f));
+    uint8_t blue = palette.Intern(DirectX::XMFLOAT4(0.2f, 0.2f, 1.0f, 0.5f));
+    EXPECT_GE(red, BulletMath::RAINBOW_LUT_SIZE);
+    EXPECT_NE(red, blue);
+    EXPECT_EQ(palette.Intern(DirectX::XMFLOAT4(1.0f, 0.2f, 0.2f, 0.3f)), red);  // アルファは別管理
+    EXPECT_EQ(palette.GetCount(), BulletMath::RAINBOW_LUT_SIZE + 2);
+
+    const DirectX::XMFLOAT4& rainbow = BulletMath::RainbowColor(0.25f);
+    EXPECT_EQ(palette.Intern(rainbow), BulletPalette::RainbowIndex(0.25f));
+    EXPECT_NEAR(palette.GetColor(red).y, 0.2f, 1.0f / 255.0f);
+}
+
+// パレットが埋まったら最も近い色にまとめる
+TEST(BulletPaletteTest, FullPaletteFallsBackToNearest) {
+    BulletPalette palette;
+    for (int i = 0; palette.GetCount() < BulletPalette::SIZE; i++) {
+        palette.Intern(DirectX::XMFLOAT4(i / 255.0f, 0.0f, 1.0f, 1.0f));
+    }
+    palette.ClearDirty();
+
+    uint8_t index = palette.Intern(DirectX::XMFLOAT4(10.0f / 255.0f, 3.0f / 255.0f, 1.0f, 1.0f));
+    EXPECT_NEAR(palette.GetColor(index).x, 10.0f / 255.0f, 1e-6f);
+    EXPECT_EQ(palette.GetColor(index).y, 0.0f);
+    EXPECT_FALSE(palette.IsDirty());
+    EXPECT_EQ(BulletPalette::ToAlpha(0.7f), 179);
+}
+
+// プールはチャンク単位で伸び、既存の弾のアドレスは動かない
+TEST(BulletPoolTest, GrowsInChunksWithStablePointers) {
+    BulletPool pool;
+    BulletHandle firstHandle;
+    Bullet* first = pool.Allocate(&firstHandle);
+    ASSERT_NE(first, nullptr);
+    first->isActive = true;
+
+    for (uint32_t i = 1; i < BulletPool::CHUNK_SIZE * 3; i++) {
+        ASSERT_NE(pool.Allocate(), nullptr);
+    }
+    EXPECT_EQ(pool.Capacity(), BulletPool::CHUNK_SIZE * 3);
+    EXPECT_EQ(pool.Get(firstHandle), first);
+    EXPECT_EQ(pool.GetStats().active, BulletPool::CHUNK_SIZE * 3);
+    EXPECT_EQ(pool.GetStats().overBudget, BulletPool::CHUNK_SIZE * 3 - BulletPool::DEFAULT_BUDGET);
+
+    size_t visited = 0;
+    for (const Bullet& bullet : pool) {
+        (void)bullet;
+        visited++;
+    }
+    EXPECT_EQ(visited, pool.size());
+}
+
+// 削除したハンドルIDは再利用され、古いハンドルは無効になる
+TEST(BulletPoolTest, StaleHandleAfterReuse) {
+    BulletPool pool;
+    BulletHandle oldHandle;
+    pool.Allocate(&oldHandle);
+    pool.Release(oldHandle);
+    EXPECT_EQ(pool.Get(oldHandle), nullptr);
+
+    BulletHandle newHandle;
+    pool.Allocate(&newHandle);
+    EXPECT_EQ(newHandle.index, oldHandle.index);
+    EXPECT_NE(pool.Get(newHandle), nullptr);
+    EXPECT_EQ(pool.Get(oldHandle), nullptr);
+    EXPECT_EQ(pool.GetStats().active, 1u);
+}
+
+// ハード上限に達したら確保せずに破棄数を数える
+TEST(BulletPoolTest, DropsAtHardCap) {
+    BulletPool pool;
+    const size_t hardCap = static_cast<size_t>(BulletPool::CHUNK_SIZE) * BulletPool::MAX_CHUNKS;
+    for (size_t i = 0; i < hardCap; i++) {
+        ASSERT_NE(pool.Allocate(), nullptr);
+    }
+    EXPECT_EQ(pool.Allocate(), nullptr);
+    EXPECT_EQ(pool.GetStats().dropped, 1u);
+    EXPECT_EQ(pool.GetStats().peakActive, hardCap);
+
+    pool.RemoveAt(5);
+    EXPECT_NE(pool.Allocate(), nullptr);
+    EXPECT_EQ(pool.GetStats().dropped, 1u);
+}
+
+// 寿命を付けた弾は止まっていても期限でスロットを空け、付けない弾は無期限
+TEST(BulletManagerTest, LifetimeExpiryFreesSlot) {
+    BulletManager manager;
+    BulletHandle parked = manager.SpawnEnemyBullet(300.0f, 300.0f, 0.0f, 0.0f, BulletType::EnemySmall,
+                                                   DirectX::XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f));
+    BulletHandle forever = manager.SpawnEnemyBullet(400.0f, 300.0f, 0.0f, 0.0f, BulletType::EnemySmall,
+                                                    DirectX::XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f));
+    manager.SetBulletLifetime(parked, 0.5f);
+    ASSERT_EQ(manager.GetBullets().size(), 2u);
+    EXPECT_EQ(manager.GetBullet(forever)->lifetime, 0.0f);
+
+    for (int frame = 0; frame < 29; frame++) {
+        manager.Update(1.0f / 60.0f, 640, 960);
+    }
+    EXPECT_NE(manager.GetBullet(parked), nullptr);
+
+    manager.Update(1.0f / 60.0f, 640, 960);
+    manager.Update(1.0f / 60.0f, 640, 960);
+    EXPECT_EQ(manager.GetBullet(parked), nullptr);
+    ASSERT_EQ(manager.GetBullets().size(), 1u);
+    EXPECT_EQ(manager.GetStats().active, 1u);
+
+    for (int frame = 0; frame < 600; frame++) {
+        manager.Update(1.0f / 60.0f, 640, 960);
+    }
+    ASSERT_NE(manager.GetBullet(forever), nullptr);
+    EXPECT_EQ(manager.GetBullet(forever)->position.x, 400.0f);
+}
+
+// 画面の外へ50px出た弾だけを消し、残りは先頭に詰めて並ぶ
+TEST(BulletManagerTest, CullsOffscreenAndCompacts) {
+    const DirectX::XMFLOAT4 white(1.0f, 1.0f, 1.0f, 1.0f);
+    BulletManager manager;
+    BulletHandle left = manager.SpawnEnemyBullet(-45.0f, 100.0f, -600.0f, 0.0f, BulletType::EnemySmall, white);
+    BulletHandle inside = manager.SpawnEnemyBullet(320.0f, 480.0f, 0.0f, 60.0f, BulletType::EnemySmall, white);
+    BulletHandle margin = manager.SpawnEnemyBullet(-45.0f, 200.0f, -60.0f, 0.0f, BulletType::EnemySmall, white);
+    BulletHandle bottom = manager.SpawnEnemyBullet(100.0f, 1005.0f, 0.0f, 600.0f, BulletType::EnemySmall, white);
+
+    // 1フレームで left は -55、bottom は 1015 へ（境界は -50 と 960+50）、margin は -46 で残る
+    manager.Update(1.0f / 60.0f, 640, 960);
+    EXPECT_EQ(manager.GetBullet(left), nullptr);
+    EXPECT_EQ(manager.GetBullet(bottom), nullptr);
+    ASSERT_NE(manager.GetBullet(inside), nullptr);
+    ASSERT_NE(manager.GetBullet(margin), nullptr);
+    EXPECT_NEAR(manager.GetBullet(margin)->position.x, -46.0f, 1e-3f);
+
+    const BulletPool& bullets = manager.GetBullets();
+    ASSERT_EQ(bullets.size(), 2u);
+    for (const Bullet& bullet : bullets) {
+        EXPECT_TRUE(bullet.isActive);
+    }
+
+    // 空いたスロットは次の弾に使われ、プールは伸びない
+    size_t capacity = bullets.Capacity();
+    manager.SpawnEnemyBullet(320.0f, 480.0f, 0.0f, 0.0f, BulletType::EnemySmall, white);
+    EXPECT_EQ(bullets.Capacity(), capacity);
+    EXPECT_EQ(manager.GetStats().active, 3u);
+}
+
+// 削除は末尾との入れ替えで詰まり、移動した弾もハンドルで追える
+TEST(BulletPoolTest, SwapRemoveKeepsHandles) {
+    BulletPool pool;
+    BulletHandle handles[4];
+    for (int i = 0; i < 4; i++) {
+        Bullet* bullet = pool.Allocate(&handles[i]);
+        bullet->position = { static_cast<float>(i), 0.0f };
+        bullet->isActive = true;
+    }
+
+    pool.RemoveAt(1);
+    ASSERT_EQ(pool.size(), 3u);
+    EXPECT_EQ(pool[1].position.x, 3.0f);  // 末尾の弾が空いた位置へ
+    EXPECT_EQ(pool.Get(handles[1]), nullptr);
+    ASSERT_NE(pool.Get(handles[3]), nullptr);
+    EXPECT_EQ(pool.Get(handles[3])->position.x, 3.0f);
+
+    pool.Release(handles[3]);
+    ASSERT_EQ(pool.size(), 2u);
+    EXPECT_EQ(pool.Get(handles[2])->position.x, 2.0f);
+    for (const Bullet& bullet : pool) {
+        EXPECT_TRUE(bullet.isActive);
+    }
+    EXPECT_EQ(pool.GetStats().active, 2u);
+}
@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include "FileWatcher.h"
+#include "SpellCardTable.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+class FileWatcherTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        m_root = fs::temp_directory_path() /
+                 (std::string("maltshoot_watch_") + ::testing::UnitTest::GetInstance()->current_test_info()->name());
+        fs::remove_all(m_root);
+        fs::create_directories(m_root / "textures" / "sprites");
+    }
+    void TearDown() override { fs::remove_all(m_root); }
+
+    static void WriteFile(const fs::path& path, const std::string& text) {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file << text;
+    }
+
+    // 書き直して更新日時を確実に進める（ファイルシステムの時刻の粒度によらない）
+    static void RewriteFile(const fs::path& path, const std::string& text) {
+        fs::file_time_type before = fs::last_write_time(path);
+        WriteFile(path, text);
+        fs::last_write_time(path, before + std::chrono::seconds(2));
+    }
+
+    // settleTime を測る時計（Advance した分だけ進む）
+    FileWatcher::ClockFn ManualClock() {
+        return [this]() { return m_now; };
+    }
+    void Advance(int milliseconds) { m_now += std::chrono::milliseconds(milliseconds); }
+
+    // OSの通知が届くまで最大2秒待つ（待つのは通知の遅れだけで、settleTime は0にしておく）
+    static std::vector<fs::path> PollUntil(FileWatcher& watcher, size_t count) {
+        std::vector<fs::path> seen;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+        while (seen.size() < count && std::chrono::steady_clock::now() < deadline) {
+            for (auto& path : watcher.Poll()) seen.push_back(path);
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        return seen;
+    }
+
+    fs::path m_root;
+    FileWatcher::Clock::time_point m_now;
+};
+}
+
+// サブフォルダ内の書き込みが root からの相対パスで1回だけ報告される
+TEST_F(FileWatcherTest, ReportsChangedFileOnce) {
+    FileWatcher watcher(std::chrono::milliseconds(0));
+    ASSERT_TRUE(watcher.Watch(m_root));
+
+    WriteFile(m_root / "textures" / "sprites" / "player.png", "v1");
+    std::vector<fs::path> changed = PollUntil(watcher, 1);
+    ASSERT_EQ(changed.size(), 1u);
+    EXPECT_EQ(changed[0], fs::path("textures") / "sprites" / "player.png");
+    EXPECT_TRUE(watcher.Poll().empty());
+}
+
+// 監視開始後に作られたフォルダの中も拾う
+TEST_F(FileWatcherTest, WatchesNewDirectories) {
+    FileWatcher watcher(std::chrono::milliseconds(0));
+    ASSERT_TRUE(watcher.Watch(m_root));
+
+    fs::create_directories(m_root / "text");
+    watcher.Poll();  // フォルダ作成を処理させる
+    WriteFile(m_root / "text" / "spellcards_jp.txt", "a\n");
+
+    std::vector<fs::path> changed = PollUntil(watcher, 1);
+    ASSERT_FALSE(changed.empty());
+    EXPECT_NE(std::find(changed.begin(), changed.end(), fs::path("text") / "spellcards_jp.txt"), changed.end());
+}
+
+// 書き込みが続いている間は報告を待ち、最後の変更から settleTime 経ってから1回だけ報告する
+// （更新日時の走査で変更を拾い、時計は差し替えて進めるので実時間に依らない）
+TEST_F(FileWatcherTest, WaitsForWritesToSettle) {
+    FileWatcher watcher(std::chrono::milliseconds(200), ManualClock());
+    ASSERT_TRUE(watcher.Watch(m_root, FileWatcher::CreatePollingBackend()));
+
+    fs::path title = m_root / "textures" / "title_screen.jpg";
+    WriteFile(title, "v1");
+    EXPECT_TRUE(watcher.Poll().empty());
+    Advance(199);
+    EXPECT_TRUE(watcher.Poll().empty());
+
+    RewriteFile(title, "v2");  // 書き込みの続き → 待ち直し
+    EXPECT_TRUE(watcher.Poll().empty());
+    Advance(150);
+    EXPECT_TRUE(watcher.Poll().empty());
+    Advance(50);
+    std::vector<fs::path> changed = watcher.Poll();
+    ASSERT_EQ(changed.size(), 1u);
+    EXPECT_EQ(changed[0], fs::path("textures") / "title_screen.jpg");
+
+    Advance(1000);
+    EXPECT_TRUE(watcher.Poll().empty());
+}
+
+// 更新日時の走査: 監視前からあるファイルは報告せず、更新日時が変わったものと新しいものだけ報告する
+TEST_F(FileWatcherTest, PollingBackendReportsModifiedAndCreatedFiles) {
+    fs::path player = m_root / "textures" / "sprites" / "player.png";
+    WriteFile(player, "v1");
+    WriteFile(m_root / "textures" / "title_screen.jpg", "v1");
+
+    FileWatcher watcher(std::chrono::milliseconds(0), ManualClock());
+    ASSERT_TRUE(watcher.Watch(m_root, FileWatcher::CreatePollingBackend()));
+    EXPECT_TRUE(watcher.Poll().empty());
+
+    RewriteFile(player, "v2");
+    fs::create_directories(m_root / "text");
+    WriteFile(m_root / "text" / "spellcards_jp.txt", "a\n");
+
+    std::vector<fs::path> changed = watcher.Poll();
+    ASSERT_EQ(changed.size(), 2u);
+    EXPECT_EQ(changed[0], fs::path("text") / "spellcards_jp.txt");
+    EXPECT_EQ(changed[1], fs::path("textures") / "sprites" / "player.png");
+    EXPECT_TRUE(watcher.Poll().empty());
+}
+
+TEST(FileWatcherStandaloneTest, FailsOnMissingDirectory) {
+    FileWatcher watcher;
+    EXPECT_FALSE(watcher.Watch(fs::temp_directory_path() / "maltshoot_no_such_dir"));
+    EXPECT_FALSE(watcher.IsWatching());
+    EXPECT_TRUE(watcher.Poll().empty());
+}
+
+// UTF-8の1行1枚を読む（BOM・CRLF・空行を許す）。空なら組み込みの名前を残す
+TEST(SpellCardTableTest, ParsesUtf8Lines) {
+    SpellCardTable table;
+    ASSERT_EQ(table.GetCount(), 5u);
+    std::wstring builtin = table.Get(4);
+
+    EXPECT_FALSE(table.Parse("\n\r\n"));
+    EXPECT_EQ(table.Get(4), builtin);
+
+    ASSERT_TRUE(table.Parse("\xEF\xBB\xBF" "Single\r\n\n\xE7\xA6\x81\xE6\x96\xAD\r\n\xF0\x9F\xA5\x83"));
+    ASSERT_EQ(table.GetCount(), 3u);
+    EXPECT_EQ(std::wstring(table.Get(0)), L"Single");
+    EXPECT_EQ(std::wstring(table.Get(1)), L"\u7981\u65ad");
+    EXPECT_EQ(std::wstring(table.Get(2)), L"\U0001F943");
+    EXPECT_EQ(std::wstring(table.Get(3)), L"");
+    EXPECT_EQ(std::wstring(table.Get(-1)), L"");
+}
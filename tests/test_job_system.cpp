@@ -0,0 +1,178 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <vector>
+#include <thread>
+#include "AssetLoader.h"
+#include "JobSystem.h"
+#include "RenderSnapshot.h"
+
+// 全要素がちょうど1回ずつ処理される
+TEST(JobSystemTest, ParallelForVisitsEachIndexOnce) {
+    JobSystem jobs(3);
+    const uint32_t count = 10000;
+    std::vector<std::atomic<int>> visits(count);
+    for (auto& v : visits) v = 0;
+
+    jobs.ParallelFor(count, 64, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; i++) visits[i]++;
+    });
+
+    for (uint32_t i = 0; i < count; i++) {
+        ASSERT_EQ(visits[i].load(), 1) << "index " << i;
+    }
+}
+
+// チャンク別の結果を添字順に合成すれば、スレッド数に関係なく同じ値になる
+TEST(JobSystemTest, ChunkMergeIsDeterministic) {
+    const uint32_t count = 5000;
+    const uint32_t chunkSize = 128;
+    auto run = [&](unsigned workers) {
+        JobSystem jobs(workers);
+        std::vector<float> partial(JobSystem::ChunkCount(count, chunkSize), 0.0f);
+        jobs.ParallelFor(count, chunkSize, [&](uint32_t begin, uint32_t end) {
+            float sum = 0.0f;
+            for (uint32_t i = begin; i < end; i++) sum += 1.0f / (1.0f + i);
+            partial[begin / chunkSize] = sum;
+        });
+        float total = 0.0f;
+        for (float p : partial) total += p;
+        return total;
+    };
+
+    float serial = run(0);
+    EXPECT_EQ(run(1), serial);
+    EXPECT_EQ(run(4), serial);
+}
+
+// Run のタスクは並行に走り、中から ParallelFor を呼んでも終わる
+TEST(JobSystemTest, RunWithNestedParallelFor) {
+    JobSystem jobs(2);
+    std::atomic<int> a(0), b(0), c(0);
+    jobs.Run({
+        [&]() { jobs.ParallelFor(1000, 100, [&](uint32_t begin, uint32_t end) { a += static_cast<int>(end - begin); }); },
+        [&]() { b = 1; },
+        [&]() { jobs.ParallelFor(10, 1, [&](uint32_t, uint32_t) { c++; }); },
+    });
+    EXPECT_EQ(a.load(), 1000);
+    EXPECT_EQ(b.load(), 1);
+    EXPECT_EQ(c.load(), 10);
+}
+
+// 読み手は常に最後に公開されたスナップショットを受け取り、未公開の書きかけは見えない
+TEST(SnapshotBufferTest, ReaderSeesLatestPublished) {
+    SnapshotBuffer<int> buffer;
+    EXPECT_TRUE(buffer.AcquireLatest().empty());
+
+    buffer.BeginWrite().push_back(1);
+    buffer.Publish();
+    buffer.BeginWrite().push_back(2);
+    buffer.Publish();
+    buffer.BeginWrite().push_back(3);  // 未公開
+
+    const std::vector<int>& latest = buffer.AcquireLatest();
+    ASSERT_EQ(latest.size(), 1u);
+    EXPECT_EQ(latest[0], 2);
+    EXPECT_EQ(&buffer.AcquireLatest(), &latest);  // 新しい公開が無ければ同じバッファ
+    EXPECT_EQ(buffer.GetPublishedCount(), 2u);
+}
+
+// 別スレッドで書き続けても、読んだスナップショットは途中で変わらない
+TEST(SnapshotBufferTest, ConcurrentWriterNeverTouchesReadBuffer) {
+    SnapshotBuffer<int> buffer;
+    std::atomic<bool> done(false);
+    std::thread writer([&]() {
+        for (int frame = 1; frame <= 20000; frame++) {
+            std::vector<int>& out = buffer.BeginWrite();
+            out.assign(16, frame);
+            buffer.Publish();
+        }
+        done = true;
+    });
+
+    int last = 0;
+    while (!done) {
+        const std::vector<int>& snapshot = buffer.AcquireLatest();
+        if (snapshot.empty()) continue;
+        int frame = snapshot.front();
+        for (int v : snapshot) ASSERT_EQ(v, frame);
+        ASSERT_GE(frame, last);
+        last = frame;
+    }
+    writer.join();
+    EXPECT_EQ(buffer.AcquireLatest().front(), 20000);
+}
+
+// バックグラウンドタスクは待たずに戻り、WaitForBackgroundで完了する
+TEST(JobSystemTest, DispatchRunsInBackground) {
+    JobSystem jobs(2);
+    std::atomic<uint32_t> pending(0);
+    std::atomic<int> sum(0);
+    for (int i = 1; i <= 100; i++) {
+        jobs.Dispatch([&sum, i]() { sum += i; }, pending);
+    }
+    jobs.WaitForBackground(pending);
+    EXPECT_EQ(pending.load(), 0u);
+    EXPECT_EQ(sum.load(), 5050);
+}
+
+// フレーム中の ParallelFor はバックグラウンドの長いタスクを拾わない
+TEST(JobSystemTest, FrameWaitSkipsBackgroundTasks) {
+    JobSystem jobs(1);
+    std::atomic<uint32_t> pending(0);
+    std::atomic<bool> release(false);
+    std::atomic<bool> started(false);
+    // ワーカー1つを塞いでから、もう1つ積む（こちらは誰も実行できない状態になる）
+    jobs.Dispatch([&]() { started = true; while (!release) std::this_thread::yield(); }, pending);
+    while (!started) std::this_thread::yield();
+    std::atomic<bool> queuedRan(false);
+    jobs.Dispatch([&]() { queuedRan = true; }, pending);
+
+    // メインスレッドは自分でチャンクを処理して戻ってくる
+    std::atomic<int> visited(0);
+    jobs.ParallelFor(100, 10, [&](uint32_t begin, uint32_t end) { visited += static_cast<int>(end - begin); });
+    EXPECT_EQ(visited.load(), 100);
+    EXPECT_FALSE(queuedRan.load());
+
+    release = true;
+    jobs.WaitForBackground(pending);
+    EXPECT_TRUE(queuedRan.load());
+}
+
+// 別のインスタンスのワーカーから呼んでも、自分のキュー番号と取り違えない（キューの少ない側で範囲外にならない）
+TEST(JobSystemTest, WorkerOfAnotherInstanceUsesExternalQueue) {
+    JobSystem outer(4);
+    JobSystem inner(1);
+    std::atomic<int> visited(0);
+    outer.ParallelFor(64, 1, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; i++) {
+            inner.ParallelFor(8, 2, [&](uint32_t b, uint32_t e) { visited += static_cast<int>(e - b); });
+        }
+    });
+    EXPECT_EQ(visited.load(), 64 * 8);
+}
+
+// finish は登録順にメインスレッドで呼ばれる
+TEST(AssetLoaderTest, FinishRunsInOrderOnPumpThread) {
+    JobSystem jobs(3);
+    AssetLoader loader(&jobs);
+    std::vector<int> decoded(20, 0);
+    std::vector<int> finished;
+    std::thread::id mainThread = std::this_thread::get_id();
+    bool finishOnMain = true;
+
+    for (int i = 0; i < 20; i++) {
+        loader.Enqueue(
+            [&decoded, i]() { decoded[i] = i * i; },
+            [&, i]() {
+                finishOnMain = finishOnMain && std::this_thread::get_id() == mainThread;
+                finished.push_back(decoded[i]);
+            });
+    }
+    EXPECT_EQ(loader.GetPendingCount(), 20u);
+
+    loader.Flush();
+    EXPECT_TRUE(loader.IsIdle());
+    EXPECT_TRUE(finishOnMain);
+    ASSERT_EQ(finished.size(), 20u);
+    for (int i = 0; i < 20; i++) EXPECT_EQ(finished[i], i * i);
+}
@@ -0,0 +1,187 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include "JobSystem.h"
+#include "ParticleSystem.h"
+
+namespace {
+
+const XMFLOAT4 WHITE = { 1.0f, 1.0f, 1.0f, 1.0f };
+
+// 乱数を使わない1粒
+ParticleEmitter FixedEmitter(float life, float size) {
+    ParticleEmitter emitter;
+    emitter.count = 1;
+    emitter.sizeMin = size;
+    emitter.lifeMin = life;
+    return emitter;
+}
+
+} // namespace
+
+// 生成は空き探しなしで末尾に積み、上限を超えた分は捨てる
+TEST(ParticleSystemTest, SpawnFillsDenseRangeUpToCapacity) {
+    ParticleSystem particles;
+    particles.Initialize(50);
+    particles.Emit(ParticleEmitters::EXPLOSION, 0.0f, 0.0f, { 1.0f, 0.5f, 0.2f, 1.0f }, 40);
+    EXPECT_EQ(particles.GetActiveCount(), 40u);
+    particles.Emit(ParticleEmitters::EXPLOSION, 0.0f, 0.0f, { 1.0f, 0.5f, 0.2f, 1.0f }, 40);
+    EXPECT_EQ(particles.GetActiveCount(), 50u);
+
+    particles.Clear();
+    EXPECT_EQ(particles.GetActiveCount(), 0u);
+    particles.Emit(ParticleEmitters::HIT, 0.0f, 0.0f, WHITE);
+    EXPECT_EQ(particles.GetActiveCount(), 8u);
+    particles.SpawnScorePopup(0.0f, 0.0f, 5000);
+    EXPECT_EQ(particles.GetActiveCount(), 28u);
+}
+
+// 寿命の短いものだけが消え、残りは詰め直される
+TEST(ParticleSystemTest, UpdateCompactsExpiredParticles) {
+    ParticleSystem particles;
+    particles.Initialize(100);
+    for (int i = 0; i < 5; i++) {
+        particles.Emit(ParticleEmitters::TRAIL, 0.0f, 0.0f, WHITE);          // 寿命0.3秒
+        particles.Emit(ParticleEmitters::STAR_BURST, 0.0f, 0.0f, WHITE, 2);  // 寿命0.8秒
+    }
+    ASSERT_EQ(particles.GetActiveCount(), 15u);
+
+    particles.Update(0.4f);
+    EXPECT_EQ(particles.GetActiveCount(), 10u);
+    for (size_t i = 0; i < particles.GetActiveCount(); i++) {
+        EXPECT_NEAR(particles.GetLife(i), 0.4f, 1e-5f);
+    }
+
+    // 空いた分はそのまま再利用できる
+    particles.Emit(ParticleEmitters::HIT, 0.0f, 0.0f, WHITE);
+    EXPECT_EQ(particles.GetActiveCount(), 18u);
+
+    particles.Update(0.5f);
+    EXPECT_EQ(particles.GetActiveCount(), 0u);
+}
+
+// 縮み方はフレームレートによらない（寿命比の積分だけで決まる）
+TEST(ParticleSystemTest, ShrinkIsFrameRateIndependent) {
+    float sizes[3];
+    const int fps[3] = { 30, 60, 144 };
+    for (int k = 0; k < 3; k++) {
+        ParticleSystem particles;
+        particles.Initialize(4);
+        particles.Emit(FixedEmitter(2.0f, 10.0f), 0.0f, 0.0f, WHITE);
+        for (int frame = 0; frame < fps[k]; frame++) {
+            particles.Update(1.0f / fps[k]);
+        }
+        ASSERT_EQ(particles.GetActiveCount(), 1u);
+        sizes[k] = particles.GetSize(0);
+    }
+    // 1秒で寿命の半分 → 平均の尽き具合0.25、10 × exp(-3 × 0.25)
+    const float expected = 10.0f * std::exp(-0.75f);
+    for (int k = 0; k < 3; k++) {
+        EXPECT_NEAR(sizes[k], expected, 1e-3f) << fps[k] << "fps";
+    }
+
+    // 1ステップでも同じ式（寿命1秒で0.5秒 → 平均の尽き具合0.25）
+    ParticleSystem single;
+    single.Initialize(1);
+    single.Emit(FixedEmitter(1.0f, 10.0f), 0.0f, 0.0f, WHITE);
+    single.Update(0.5f);
+    EXPECT_NEAR(single.GetSize(0), 10.0f * std::exp(-3.0f * 0.5f * 0.25f), 1e-3f);
+}
+
+// 並列更新でもSIMDの端数でも、全チャンク分が消えて詰められる
+TEST(ParticleSystemTest, ParallelUpdateCompactsAcrossChunks) {
+    JobSystem jobs(3);
+    ParticleSystem particles;
+    particles.Initialize(80000);
+    for (int i = 0; i < 3001; i++) {
+        particles.Emit(ParticleEmitters::HIT, 0.0f, 0.0f, WHITE);            // 寿命0.25秒
+        particles.Emit(ParticleEmitters::STAR_BURST, 0.0f, 0.0f, WHITE, 5);  // 寿命0.8秒
+    }
+    ASSERT_EQ(particles.GetActiveCount(), 39013u);
+
+    particles.Update(0.3f, &jobs);
+    EXPECT_EQ(particles.GetActiveCount(), 15005u);
+    for (size_t i = 0; i < particles.GetActiveCount(); i++) {
+        ASSERT_NEAR(particles.GetLife(i), 0.5f, 1e-5f);
+    }
+    particles.PublishSnapshot();
+}
+
+// 処理時間が予算を超え続けると発生数とグロー段数が下がり、収まれば戻る
+TEST(ParticleSystemTest, GovernorScalesEmissionWithFrameCost) {
+    ParticleSystem particles;
+    particles.Initialize(1000);
+    EXPECT_EQ(particles.GetGovernor().GetGlowLayers(), 2);
+
+    for (int frame = 0; frame < 60; frame++) {
+        particles.SetFrameCost(0.03f);
+    }
+    EXPECT_FLOAT_EQ(particles.GetGovernor().GetCostScale(), ParticleGovernor::MIN_SCALE);
+    EXPECT_EQ(particles.GetGovernor().GetGlowLayers(), 1);
+    particles.Emit(ParticleEmitters::EXPLOSION, 0.0f, 0.0f, WHITE, 40);
+    EXPECT_EQ(particles.GetActiveCount(), 10u);
+
+    // 1個ずつの発生も間引かれる
+    particles.Clear();
+    for (int i = 0; i < 8; i++) {
+        particles.Emit(ParticleEmitters::TRAIL, 0.0f, 0.0f, WHITE);
+    }
+    EXPECT_EQ(particles.GetActiveCount(), 2u);
+
+    for (int frame = 0; frame < 200; frame++) {
+        particles.SetFrameCost(0.005f);
+    }
+    EXPECT_FLOAT_EQ(particles.GetGovernor().GetCostScale(), 1.0f);
+    EXPECT_EQ(particles.GetGovernor().GetGlowLayers(), 2);
+}
+
+// プールが埋まってくると絞り、あふれる分は目立たないものから消す
+TEST(ParticleSystemTest, PoolPressureEvictsLeastVisibleFirst) {
+    ParticleSystem particles;
+    particles.Initialize(100);
+    for (int i = 0; i < 50; i++) {
+        particles.Emit(FixedEmitter(1.0f, 1.0f), 0.0f, 0.0f, WHITE);   // 小さい
+    }
+    for (int i = 0; i < 50; i++) {
+        particles.Emit(FixedEmitter(1.0f, 20.0f), 0.0f, 0.0f, WHITE);  // 大きい
+    }
+    EXPECT_LT(particles.GetActiveCount(), 100u);  // 埋まるにつれて間引かれる
+    EXPECT_GT(particles.GetActiveCount(), 50u);
+
+    particles.Clear();
+    for (int i = 0; i < 50; i++) {
+        particles.Emit(FixedEmitter(1.0f, 1.0f), 0.0f, 0.0f, WHITE);
+    }
+    particles.Emit(FixedEmitter(1.0f, 20.0f), 0.0f, 0.0f, WHITE, 50);  // 50%ちょうどなので絞らない
+    ASSERT_EQ(particles.GetActiveCount(), 100u);
+    particles.Emit(ParticleEmitters::EXPLOSION, 0.0f, 0.0f, WHITE, 40);  // 埋まっているので最小倍率
+    EXPECT_EQ(particles.GetActiveCount(), 100u);
+    EXPECT_EQ(particles.GetEvictedCount(), 10u);
+
+    // 大きい50個は残り、消えたのは小さい方
+    size_t large = 0;
+    for (size_t i = 0; i < particles.GetActiveCount(); i++) {
+        if (particles.GetSize(i) == 20.0f) large++;
+    }
+    EXPECT_EQ(large, 50u);
+}
+
+// 得点の数字はパーティクルと別に浮かべ、寿命で消える
+TEST(ParticleSystemTest, ScorePopupAddsFloatingText) {
+    ParticleSystem particles;
+    particles.Initialize(100);
+    particles.SpawnScorePopup(10.0f, 10.0f, 100);
+    particles.SpawnScorePopup(20.0f, 10.0f, 300);
+    EXPECT_EQ(particles.GetScoreTextCount(), 2u);
+
+    particles.Update(ParticleSystem::SCORE_TEXT_LIFE * 0.5f);
+    EXPECT_EQ(particles.GetScoreTextCount(), 2u);
+    particles.Update(ParticleSystem::SCORE_TEXT_LIFE * 0.6f);
+    EXPECT_EQ(particles.GetScoreTextCount(), 0u);
+
+    for (size_t i = 0; i < ParticleSystem::MAX_SCORE_TEXTS + 10; i++) {
+        particles.SpawnScorePopup(0.0f, 0.0f, 100);
+    }
+    EXPECT_EQ(particles.GetScoreTextCount(), ParticleSystem::MAX_SCORE_TEXTS);
+    particles.Clear();
+    EXPECT_EQ(particles.GetScoreTextCount(), 0u);
+}
@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include "RenderQueue.h"
+
+namespace {
+const DirectX::XMFLOAT4 WHITE = { 1.0f, 1.0f, 1.0f, 1.0f };
+}
+
+// レイヤー順が最優先、同じレイヤー内はアルファ（記録順）→ 加算の順
+TEST(RenderQueueTest, SortsByLayerThenBlend) {
+    RenderQueue queue;
+    queue.SetLayer(RenderLayer::UI);
+    queue.PushQuad(RenderPipeline::Color, BlendMode::Alpha, RenderQueue::NO_TEXTURE, 1, 0, 1, 1, WHITE);
+    queue.SetLayer(RenderLayer::Bullets);
+    queue.PushFan(RenderPipeline::Palette, BlendMode::Additive, 2, 0, 1, WHITE, WHITE);
+    queue.PushFan(RenderPipeline::Palette, BlendMode::Alpha, 3, 0, 1, WHITE, WHITE);
+    queue.PushFan(RenderPipeline::Palette, BlendMode::Alpha, 4, 0, 1, WHITE, WHITE);
+    queue.SetLayer(RenderLayer::Backdrop);
+    queue.PushQuad(RenderPipeline::Color, BlendMode::Alpha, RenderQueue::NO_TEXTURE, 5, 0, 1, 1, WHITE);
+
+    queue.Sort();
+    ASSERT_EQ(queue.size(), 5u);
+    EXPECT_EQ(queue.GetSorted(0).x, 5.0f);
+    EXPECT_EQ(queue.GetSorted(1).x, 3.0f);
+    EXPECT_EQ(queue.GetSorted(2).x, 4.0f);
+    EXPECT_EQ(queue.GetSorted(3).x, 2.0f);
+    EXPECT_EQ(queue.GetSorted(4).x, 1.0f);
+}
+
+// 交互に記録した加算コマンドは状態ごとにまとまり、バッチ数が減る
+TEST(RenderQueueTest, AdditiveCommandsBatchByState) {
+    RenderQueue queue;
+    queue.SetLayer(RenderLayer::Particles);
+    int texA = 0, texB = 0;
+    for (int i = 0; i < 100; i++) {
+        queue.PushFan(RenderPipeline::Color, BlendMode::Additive, static_cast<float>(i), 0, 1, WHITE, WHITE);
+        queue.PushQuad(RenderPipeline::Textured, BlendMode::Additive, queue.TextureId(i % 2 ? &texA : &texB),
+                       static_cast<float>(i), 0, 1, 1, WHITE);
+    }
+    EXPECT_EQ(queue.CountBatches(), 200u);
+
+    queue.Sort();
+    EXPECT_EQ(queue.CountBatches(), 3u);
+    // 同じ状態の中は記録順
+    EXPECT_EQ(queue.GetSorted(0).x, 0.0f);
+    EXPECT_EQ(queue.GetSorted(99).x, 99.0f);
+    EXPECT_EQ(queue.GetTexture(queue.GetSorted(100).texture), &texB);
+    EXPECT_EQ(queue.GetTexture(queue.GetSorted(150).texture), &texA);
+}
+
+// アルファ合成は状態が交互でも記録順を崩さない
+TEST(RenderQueueTest, AlphaCommandsKeepSubmissionOrder) {
+    RenderQueue queue;
+    int tex = 0;
+    for (int i = 0; i < 10; i++) {
+        queue.PushQuad(RenderPipeline::Textured, BlendMode::Alpha, queue.TextureId(&tex),
+                       static_cast<float>(i * 2), 0, 1, 1, WHITE);
+        queue.PushFan(RenderPipeline::Color, BlendMode::Alpha, static_cast<float>(i * 2 + 1), 0, 1, WHITE, WHITE);
+    }
+    queue.Sort();
+    for (size_t i = 0; i < queue.size(); i++) {
+        EXPECT_EQ(queue.GetSorted(i).x, static_cast<float>(i));
+    }
+    EXPECT_EQ(queue.CountBatches(), 20u);
+}
+
+// Resetで空になり、GPUなしで中身を書き出せる
+// パーティクルの芯（アルファの扇）と混ざらないよう、得点の数字は専用レイヤーで1バッチになる
+TEST(RenderQueueTest, PopupTextIsOneBatch) {
+    RenderQueue queue;
+    int glyphs = 0;
+    for (int i = 0; i < 300; i++) {
+        queue.SetLayer(RenderLayer::Particles);
+        queue.PushFan(RenderPipeline::Color, BlendMode::Alpha, static_cast<float>(i), 0, 1, WHITE, WHITE);
+        queue.SetLayer(RenderLayer::Popups);
+        for (int digit = 0; digit < 4; digit++) {
+            queue.PushQuad(RenderPipeline::Textured, BlendMode::Alpha, queue.TextureId(&glyphs),
+                           static_cast<float>(i), 0, 1, 1, WHITE);
+        }
+    }
+    queue.Sort();
+    EXPECT_EQ(queue.CountBatches(), 2u);
+    EXPECT_EQ(queue.GetSorted(queue.size() - 1).layer, RenderLayer::Popups);
+}
+
+// 星空は星の数に関わらず1コマンド・1バッチで、背景レイヤーの位置に入る
+TEST(RenderQueueTest, StarfieldIsOneCommand) {
+    RenderQueue queue;
+    queue.SetLayer(RenderLayer::Backdrop);
+    queue.PushQuad(RenderPipeline::Color, BlendMode::Alpha, RenderQueue::NO_TEXTURE, 0, 0, 8, 8, WHITE);
+    queue.SetLayer(RenderLayer::Enemies);
+    queue.PushQuad(RenderPipeline::Color, BlendMode::Alpha, RenderQueue::NO_TEXTURE, 0, 0, 8, 8, WHITE);
+    queue.SetLayer(RenderLayer::Background);
+    queue.PushStarfield(2.5f, 1920.0f, 1080.0f);
+    queue.Sort();
+
+    ASSERT_EQ(queue.size(), 3u);
+    EXPECT_EQ(queue.CountBatches(), 3u);
+    const RenderCommand& stars = queue.GetSorted(1);
+    EXPECT_EQ(stars.layer, RenderLayer::Background);
+    EXPECT_EQ(stars.primitive, RenderPrimitive::Instances);
+    EXPECT_EQ(stars.pipeline, RenderPipeline::Starfield);
+    EXPECT_FLOAT_EQ(stars.x, 2.5f);
+
+    std::ostringstream out;
+    queue.Dump(out);
+    EXPECT_NE(out.str().find("Background add Starfield instances"), std::string::npos);
+}
+
+TEST(RenderQueueTest, ResetAndDump) {
+    RenderQueue queue;
+    queue.SetLayer(RenderLayer::Enemies);
+    queue.PushQuad(RenderPipeline::Color, BlendMode::Alpha, RenderQueue::NO_TEXTURE, 0, 0, 8, 8, WHITE);
+    queue.Sort();
+
+    std::ostringstream out;
+    queue.Dump(out);
+    EXPECT_NE(out.str().find("1 commands, 1 batches"), std::string::npos);
+    EXPECT_NE(out.str().find("Enemies alpha Color quad"), std::string::npos);
+
+    queue.Reset();
+    EXPECT_EQ(queue.size(), 0u);
+    EXPECT_EQ(queue.CountBatches(), 0u);
+    EXPECT_EQ(queue.GetLayer(), RenderLayer::Backdrop);
+}
@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include "FramePacket.h"
+#include "RenderThread.h"
+
+namespace {
+const DirectX::XMFLOAT4 WHITE = { 1.0f, 1.0f, 1.0f, 1.0f };
+
+// Game::Render と同じ形で1フレームを記録する（サイドバーの差分パス＋ゲーム画面＋文字）
+// どのコマンドにもフレーム番号を入れておき、受け取った側で混ざっていないか確かめる
+void RecordFrame(FramePacket& frame, int index) {
+    frame.Reset();
+    float id = static_cast<float>(index);
+    if (index % 3 == 0) {
+        RenderPass& sidebar = frame.AddPass(PassTarget::SidebarLayer, PassClip{ 640, index, 880, index + 30 });
+        sidebar.queue.PushQuad(RenderPipeline::Color, BlendMode::Alpha, RenderQueue::NO_TEXTURE, id, 0, 1, 1, WHITE);
+        sidebar.text.DrawTextWithValue(L"スコア", index, 660, 90);
+    }
+    RenderPass& scene = frame.AddPass();
+    // 上のレイヤーから順に記録（提出側のソートで並べ直される）
+    for (int layer = static_cast<int>(RenderLayer::UI); layer >= 0; layer--) {
+        scene.queue.SetLayer(static_cast<RenderLayer>(layer));
+        scene.queue.PushQuad(RenderPipeline::Color, BlendMode::Alpha, RenderQueue::NO_TEXTURE, id, 0, 1, 1, WHITE);
+        scene.queue.PushFan(RenderPipeline::Palette, BlendMode::Additive, id, 0, 1, WHITE, WHITE);
+    }
+    scene.text.DrawText(std::to_wstring(index), 0, 0, 100, 30);
+}
+
+struct SubmitLog {
+    std::vector<int> frames;
+    std::set<std::thread::id> threads;
+    int errors = 0;
+};
+
+// 描画スレッド側: Graphics::Submit と同じくパスごとにソートしてから中身を確かめる
+void CheckFrame(FramePacket& frame, SubmitLog& log) {
+    log.threads.insert(std::this_thread::get_id());
+    size_t scenePass = frame.GetPassCount() - 1;
+    RenderPass& scene = frame.GetPass(scenePass);
+    scene.queue.Sort();
+    int index = static_cast<int>(scene.queue.GetSorted(0).x);
+    for (size_t p = 0; p < frame.GetPassCount(); p++) {
+        RenderPass& pass = frame.GetPass(p);
+        pass.queue.Sort();
+        for (size_t i = 0; i < pass.queue.size(); i++) {
+            const RenderCommand& command = pass.queue.GetSorted(i);
+            if (static_cast<int>(command.x) != index) log.errors++;
+            if (i > 0 && command.layer < pass.queue.GetSorted(i - 1).layer) log.errors++;
+        }
+    }
+    if (frame.GetPassCount() == 2) {
+        const RenderPass& sidebar = frame.GetPass(0);
+        if (sidebar.target != PassTarget::SidebarLayer || sidebar.clip.top != index) log.errors++;
+        if (sidebar.text.size() != 1 || std::wstring(sidebar.text.GetText(sidebar.text[0])) != L"スコア: " + std::to_wstring(index)) log.errors++;
+    } else if (index % 3 == 0) {
+        log.errors++;
+    }
+    if (scene.text.size() != 1 || std::wstring(scene.text.GetText(scene.text[0])) != std::to_wstring(index)) log.errors++;
+    log.frames.push_back(index);
+}
+}
+
+// メインが記録したフレームが丸ごと・順番どおり・1つも欠けずに描画スレッドで提出される
+TEST(RenderThreadTest, HandsOffWholeFramesInOrder) {
+    SubmitLog log;
+    const int FRAME_COUNT = 2000;
+    {
+        RenderThread<FramePacket> renderThread([&](FramePacket& frame) { CheckFrame(frame, log); });
+        for (int i = 0; i < FRAME_COUNT; i++) {
+            RecordFrame(renderThread.BeginFrame(), i);
+            renderThread.Publish();
+        }
+        renderThread.WaitIdle();
+        EXPECT_EQ(renderThread.GetSubmittedCount(), static_cast<uint64_t>(FRAME_COUNT));
+    }
+
+    EXPECT_EQ(log.errors, 0);
+    ASSERT_EQ(log.frames.size(), static_cast<size_t>(FRAME_COUNT));
+    for (int i = 0; i < FRAME_COUNT; i++) EXPECT_EQ(log.frames[i], i);
+    ASSERT_EQ(log.threads.size(), 1u);
+    EXPECT_NE(*log.threads.begin(), std::this_thread::get_id());
+}
+
+// 提出が止まっている間もメインは次のフレームを記録して渡せる（記録先は提出中のフレームと別）
+// 渡したフレームが受け取られるまで、その次の Publish は待つ
+TEST(RenderThreadTest, RecordsNextFrameWhileSubmitting) {
+    std::mutex mutex;
+    std::condition_variable released;
+    bool release = false;
+    std::vector<const FramePacket*> submitted;
+    std::vector<int> order;
+
+    RenderThread<FramePacket> renderThread([&](FramePacket& frame) {
+        std::unique_lock<std::mutex> lock(mutex);
+        released.wait(lock, [&]() { return release; });
+        submitted.push_back(&frame);
+        order.push_back(static_cast<int>(frame.GetPass(0).queue.GetSorted(0).x));
+    });
+
+    FramePacket* recorded[3];
+    for (int i = 0; i < 2; i++) {
+        recorded[i] = &renderThread.BeginFrame();
+        RecordFrame(*recorded[i], i);
+        renderThread.Publish();  // 1回目は即、2回目は0番が受け取られた時点で戻る
+    }
+    recorded[2] = &renderThread.BeginFrame();
+    RecordFrame(*recorded[2], 2);
+    EXPECT_EQ(renderThread.GetSubmittedCount(), 0u);  // 0番の提出中に2フレーム先まで記録できた
+    EXPECT_NE(recorded[0], recorded[1]);
+    EXPECT_NE(recorded[1], recorded[2]);
+    EXPECT_NE(recorded[0], recorded[2]);
+
+    std::atomic<bool> published(false);
+    std::thread publisher([&]() {
+        renderThread.Publish();  // 1番がまだ受け取られていないので待つ
+        published = true;
+    });
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        EXPECT_TRUE(order.empty());
+        release = true;
+    }
+    released.notify_all();
+    publisher.join();
+    EXPECT_TRUE(published.load());
+    renderThread.WaitIdle();
+
+    ASSERT_EQ(order.size(), 3u);
+    for (int i = 0; i < 3; i++) {
+        EXPECT_EQ(order[i], i);
+        EXPECT_EQ(submitted[i], recorded[i]);
+    }
+}
@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include "SidebarCache.h"
+
+namespace {
+
+// Game と同じく毎フレーム全項目を渡し、変わっていれば合成する
+bool RunFrame(SidebarCache& cache, int64_t score, int64_t lives, int64_t fps) {
+    cache.Set(SidebarWidget::HiScore, 100000);
+    cache.Set(SidebarWidget::Score, score);
+    cache.Set(SidebarWidget::Lives, lives);
+    cache.Set(SidebarWidget::Bombs, 3);
+    cache.Set(SidebarWidget::Power, 0);
+    cache.Set(SidebarWidget::Graze, 0);
+    cache.Set(SidebarWidget::Fps, fps);
+    if (!cache.IsDirty()) return false;
+    cache.MarkComposed();
+    return true;
+}
+
+} // namespace
+
+// 最初は全体を合成し、その後は値が変わったフレームだけ合成する
+TEST(SidebarCacheTest, ComposesOnlyWhenValuesChange) {
+    SidebarCache cache;
+    cache.Reset(720);
+
+    int top = 0, bottom = 0;
+    ASSERT_TRUE(cache.GetDirtyBand(&top, &bottom));
+    EXPECT_EQ(top, 0);
+    EXPECT_EQ(bottom, 720);
+
+    // 10秒分: スコアは30フレームごと、FPSは1秒ごと（うち同じ値が続く秒もある）、残機は1回だけ変わる
+    int composedFrames = 0;
+    for (int frame = 0; frame < 600; frame++) {
+        int64_t score = (frame / 30) * 100;
+        int64_t lives = frame < 300 ? 3 : 2;
+        int64_t fps = (frame / 60) % 2 == 0 ? 600 : 598;
+        if (RunFrame(cache, score, lives, fps)) composedFrames++;
+    }
+    // 最初の1回 + スコアが変わる19回（FPS・残機の変化はすべてスコアの変化と同じフレーム）
+    EXPECT_EQ(composedFrames, 20);
+    EXPECT_EQ(cache.GetComposeCount(), 20u);
+
+    // 値が変わらなければ何フレーム回しても合成しない
+    for (int frame = 0; frame < 120; frame++) {
+        EXPECT_FALSE(RunFrame(cache, 1900, 2, 598));
+    }
+    EXPECT_EQ(cache.GetComposeCount(), 20u);
+
+    cache.Invalidate();
+    EXPECT_TRUE(RunFrame(cache, 1900, 2, 598));
+    EXPECT_EQ(cache.GetComposeCount(), 21u);
+}
+
+// 描き直す範囲は変わった項目の帯だけをまとめたもの
+TEST(SidebarCacheTest, DirtyBandCoversChangedWidgets) {
+    SidebarCache cache;
+    cache.Reset(720);
+    cache.SetBand(SidebarWidget::Score, 90, 120);
+    cache.SetBand(SidebarWidget::Bombs, 176, 244);
+    cache.SetBand(SidebarWidget::Fps, 410, 505);
+    cache.MarkComposed();
+
+    int top = 0, bottom = 0;
+    EXPECT_FALSE(cache.GetDirtyBand(&top, &bottom));
+
+    cache.Set(SidebarWidget::Score, 500);
+    ASSERT_TRUE(cache.GetDirtyBand(&top, &bottom));
+    EXPECT_EQ(top, 90);
+    EXPECT_EQ(bottom, 120);
+    EXPECT_TRUE(cache.IsDirty(SidebarWidget::Score));
+    EXPECT_FALSE(cache.IsDirty(SidebarWidget::Fps));
+
+    cache.Set(SidebarWidget::Bombs, 2);
+    ASSERT_TRUE(cache.GetDirtyBand(&top, &bottom));
+    EXPECT_EQ(top, 90);
+    EXPECT_EQ(bottom, 244);
+
+    cache.MarkComposed();
+    cache.Set(SidebarWidget::Fps, 599);
+    ASSERT_TRUE(cache.GetDirtyBand(&top, &bottom));
+    EXPECT_EQ(top, 410);
+    EXPECT_EQ(bottom, 505);
+}
@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstring>
+#include <vector>
+#include "AssetLoader.h"
+#include "JobSystem.h"
+#include "SoundCache.h"
+
+namespace {
+
+std::vector<uint8_t> Pcm16(const std::vector<int16_t>& samples) {
+    std::vector<uint8_t> bytes(samples.size() * 2);
+    memcpy(bytes.data(), samples.data(), bytes.size());
+    return bytes;
+}
+
+int16_t SampleAt(const uint8_t* data, size_t index) {
+    int16_t v;
+    memcpy(&v, data + index * 2, 2);
+    return v;
+}
+
+SoundCache::DecodeFn CountingDecoder(std::atomic<int>* calls, std::vector<int16_t> samples) {
+    return [calls, samples](std::vector<uint8_t>* pcm, AudioFormat* format) {
+        (*calls)++;
+        *pcm = Pcm16(samples);
+        *format = SoundCache::SFX_FORMAT;
+        return true;
+    };
+}
+
+} // namespace
+
+// モノラル・低いレートの音も 16bit ステレオ 44.1kHz にそろう
+TEST(SoundCacheTest, NormalizesToSfxFormat) {
+    const AudioFormat mono8 = { 1, 1, 22050, 8 };
+    std::vector<uint8_t> src = { 128, 192, 128, 64 };  // 0, 0.5, 0, -0.5
+    std::vector<uint8_t> out;
+    ASSERT_TRUE(SoundCache::Normalize(mono8, src.data(), src.size(), &out));
+    ASSERT_EQ(out.size(), 8u * 2u * 2u);  // 2倍のフレーム数 × ステレオ × 16bit
+
+    const int expected[] = { 0, 8192, 16384, 8192, 0, -8192, -16384, -16384 };
+    for (size_t i = 0; i < 8; i++) {
+        EXPECT_NEAR(SampleAt(out.data(), i * 2), expected[i], 1) << i;
+        EXPECT_EQ(SampleAt(out.data(), i * 2), SampleAt(out.data(), i * 2 + 1));
+    }
+
+    EXPECT_FALSE(SoundCache::Normalize({ 2, 2, 44100, 4 }, src.data(), src.size(), &out));
+}
+
+// 登録しただけではデコードせず、最初の Request で1回だけデコードする
+TEST(SoundCacheTest, DecodesLazilyOnFirstRequest) {
+    SoundCache cache;
+    std::atomic<int> calls{ 0 };
+    std::vector<int> ready;
+    cache.SetReadyCallback([&ready](int sound) { ready.push_back(sound); });
+
+    int a = cache.Add(CountingDecoder(&calls, { 1, 2, 3, 4 }));
+    int b = cache.Add(CountingDecoder(&calls, { 5, 6 }));
+    EXPECT_EQ(calls, 0);
+    EXPECT_EQ(cache.GetState(a), SoundCache::State::Unloaded);
+
+    cache.Request(b);
+    cache.Request(b);
+    EXPECT_EQ(calls, 1);
+    EXPECT_EQ(cache.GetState(a), SoundCache::State::Unloaded);
+    ASSERT_EQ(cache.GetState(b), SoundCache::State::Ready);
+    EXPECT_EQ(ready, std::vector<int>{ b });
+    ASSERT_EQ(cache.GetSize(b), 4u);
+    EXPECT_EQ(SampleAt(cache.GetData(b), 1), 6);
+
+    // デコードに失敗した音は何度頼んでもやり直さない
+    int broken = cache.Add([&calls](std::vector<uint8_t>*, AudioFormat*) { calls++; return false; });
+    cache.Request(broken);
+    cache.Request(broken);
+    EXPECT_EQ(cache.GetState(broken), SoundCache::State::Failed);
+    EXPECT_EQ(calls, 2);
+}
+
+// そろった形式のパックはコピーせずに指し、違う形式は使うときに変換する
+TEST(SoundCacheTest, MappedPcmIsUsedInPlace) {
+    SoundCache cache;
+    std::vector<uint8_t> packed = Pcm16({ 100, 100, 200, 200 });
+    int direct = cache.AddMapped(SoundCache::SFX_FORMAT, packed.data(), packed.size());
+    EXPECT_EQ(cache.GetState(direct), SoundCache::State::Ready);
+    EXPECT_EQ(cache.GetData(direct), packed.data());
+    EXPECT_EQ(cache.GetArenaUsed(), 0u);
+
+    std::vector<uint8_t> mono = Pcm16({ 300, 400 });
+    int converted = cache.AddMapped({ 1, 1, 44100, 16 }, mono.data(), mono.size());
+    EXPECT_EQ(cache.GetState(converted), SoundCache::State::Unloaded);
+    cache.Request(converted);
+    ASSERT_EQ(cache.GetState(converted), SoundCache::State::Ready);
+    ASSERT_EQ(cache.GetSize(converted), 8u);
+    EXPECT_EQ(SampleAt(cache.GetData(converted), 0), 300);
+    EXPECT_EQ(SampleAt(cache.GetData(converted), 1), 300);
+    EXPECT_EQ(SampleAt(cache.GetData(converted), 2), 400);
+}
+
+// PCM は1つのブロックに順に詰める（ブロックより大きい音だけ別）
+TEST(SoundCacheTest, PacksPcmIntoArenaBlocks) {
+    SoundCache cache;
+    std::atomic<int> calls{ 0 };
+    std::vector<int> sounds;
+    for (int i = 0; i < 20; i++) {
+        sounds.push_back(cache.Add(CountingDecoder(&calls, std::vector<int16_t>(1000 + i, static_cast<int16_t>(i)))));
+        cache.Request(sounds.back());
+    }
+    EXPECT_EQ(cache.GetArenaBlockCount(), 1u);
+    for (size_t i = 1; i < sounds.size(); i++) {
+        size_t previous = (cache.GetSize(sounds[i - 1]) + 15) & ~static_cast<size_t>(15);
+        EXPECT_EQ(cache.GetData(sounds[i]), cache.GetData(sounds[i - 1]) + previous);
+        EXPECT_EQ(SampleAt(cache.GetData(sounds[i]), 0), static_cast<int16_t>(i));
+    }
+
+    int large = cache.Add(CountingDecoder(&calls, std::vector<int16_t>(SoundCache::ARENA_BLOCK_SIZE, 7)));
+    cache.Request(large);
+    EXPECT_EQ(cache.GetArenaBlockCount(), 2u);
+
+    // 大きい音の後も元のブロックの続きに詰める
+    int small = cache.Add(CountingDecoder(&calls, { 9, 9 }));
+    cache.Request(small);
+    EXPECT_EQ(cache.GetArenaBlockCount(), 2u);
+    EXPECT_EQ(SampleAt(cache.GetData(small), 0), 9);
+}
+
+// loader があればデコードはワーカーで、登録は Pump で
+TEST(SoundCacheTest, DecodesOnLoaderWorkers) {
+    JobSystem jobs(2);
+    AssetLoader loader(&jobs);
+    SoundCache cache(&loader);
+    std::atomic<int> calls{ 0 };
+    int readyCount = 0;
+    cache.SetReadyCallback([&readyCount](int) { readyCount++; });
+
+    int sound = cache.Add(CountingDecoder(&calls, { 1, 2, 3, 4 }));
+    cache.Request(sound);
+    EXPECT_EQ(cache.GetState(sound), SoundCache::State::Decoding);
+    loader.Flush();
+    EXPECT_EQ(cache.GetState(sound), SoundCache::State::Ready);
+    EXPECT_EQ(calls, 1);
+    EXPECT_EQ(readyCount, 1);
+}
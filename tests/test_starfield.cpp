@@ -0,0 +1,44 @@
+#include <gtest/gtest.h>
+#include "Starfield.h"
+
+namespace {
+constexpr float WIDTH = 1920.0f;
+constexpr float HEIGHT = 1080.0f;
+}
+
+// 同じ種なら同じ星空になり、どの時刻でも画面の上下の余白内に収まる
+TEST(StarfieldTest, PositionsAreDeterministicAndBounded) {
+    std::vector<StarInstance> a = Starfield::Generate(2000, WIDTH, HEIGHT, 42);
+    std::vector<StarInstance> b = Starfield::Generate(2000, WIDTH, HEIGHT, 42);
+    ASSERT_EQ(a.size(), 2000u);
+
+    for (float time : { 0.0f, 1.0f / 60.0f, 3.7f, 125.0f, 3600.0f }) {
+        for (size_t i = 0; i < a.size(); i++) {
+            DirectX::XMFLOAT2 pa = Starfield::Position(a[i], time, WIDTH, HEIGHT);
+            DirectX::XMFLOAT2 pb = Starfield::Position(b[i], time, WIDTH, HEIGHT);
+            EXPECT_EQ(pa.x, pb.x);
+            EXPECT_EQ(pa.y, pb.y);
+            EXPECT_GE(pa.y, -Starfield::WRAP_MARGIN);
+            EXPECT_LE(pa.y, HEIGHT + Starfield::WRAP_MARGIN);
+            EXPECT_GE(pa.x, -2.0f);
+            EXPECT_LE(pa.x, WIDTH + 2.0f);
+        }
+    }
+}
+
+// 下に抜けたら上の余白から出直し、xは周回ごとに振り直す
+TEST(StarfieldTest, WrapsToTopWithNewColumn) {
+    StarInstance star = { 100.0f, 0.0f, 1.0f, 7u, { 1.0f, 1.0f, 1.0f, 1.0f } };
+    float span = HEIGHT + Starfield::WRAP_MARGIN * 2.0f;
+    float wrapTime = (span - Starfield::WRAP_MARGIN) / Starfield::Speed(star.depth);
+
+    DirectX::XMFLOAT2 before = Starfield::Position(star, wrapTime - 0.01f, WIDTH, HEIGHT);
+    DirectX::XMFLOAT2 after = Starfield::Position(star, wrapTime + 0.01f, WIDTH, HEIGHT);
+    EXPECT_GT(before.y, HEIGHT);
+    EXPECT_LT(after.y, 0.0f);
+    EXPECT_NEAR(before.x, 100.0f, 2.0f);
+    EXPECT_NEAR(after.x, Starfield::HashUnit(star.seed + 1) * WIDTH, 2.0f);
+
+    // 遠い星ほど遅い
+    EXPECT_LT(Starfield::Speed(0.0f), Starfield::Speed(1.0f));
+}
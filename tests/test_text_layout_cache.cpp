@@ -0,0 +1,45 @@
+#include <gtest/gtest.h>
+#include "TextLayoutCache.h"
+
+// 同じ文字列・書式・枠なら作り直さず、どれかが違えば別のレイアウトになる
+TEST(TextLayoutCacheTest, ReusesLayoutForSameKey) {
+    TextLayoutCache<int> cache;
+    int builds = 0;
+    auto build = [&builds]() { return ++builds; };
+
+    for (int frame = 0; frame < 10; frame++) {
+        EXPECT_EQ(cache.Get(L"Score: 1200", 1, 300.0f, 30.0f, build), 1);
+        EXPECT_EQ(cache.Get(L"Lives: 3", 1, 300.0f, 30.0f, build), 2);
+        cache.EndFrame();
+    }
+    EXPECT_EQ(builds, 2);
+
+    EXPECT_EQ(cache.Get(L"Score: 1300", 1, 300.0f, 30.0f, build), 3);
+    EXPECT_EQ(cache.Get(L"Lives: 3", 2, 300.0f, 30.0f, build), 4);
+    EXPECT_EQ(cache.Get(L"Lives: 3", 1, 200.0f, 30.0f, build), 5);
+    EXPECT_EQ(cache.Get(L"Lives: 3", 1, 300.0f, 30.0f, build), 2);
+    EXPECT_EQ(cache.GetCreatedCount(), 5u);
+}
+
+// 使われなくなった文字列（変わる前の数値など）は一定フレーム後に捨てる
+TEST(TextLayoutCacheTest, EvictsIdleEntries) {
+    TextLayoutCache<int> cache;
+    int builds = 0;
+    auto build = [&builds]() { return ++builds; };
+
+    wchar_t buffer[32];
+    for (int frame = 0; frame < 300; frame++) {
+        swprintf(buffer, 32, L"FPS: %d", frame / 30);  // 30フレームごとに変わる
+        cache.Get(buffer, 1, 200.0f, 30.0f, build);
+        cache.Get(L"static", 0, 200.0f, 20.0f, build);
+        cache.EndFrame();
+        EXPECT_LE(cache.size(), 4u);
+    }
+    EXPECT_EQ(builds, 11);
+
+    for (uint32_t frame = 0; frame <= TextLayoutCache<int>::MAX_IDLE_FRAMES; frame++) {
+        cache.EndFrame();
+    }
+    EXPECT_EQ(cache.size(), 0u);
+    EXPECT_EQ(cache.Get(L"static", 0, 200.0f, 20.0f, build), 12);
+}
@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "AssetLoader.h"
+#include "BlockCompression.h"
+#include "JobSystem.h"
+#include "TextureSlots.h"
+
+namespace {
+// テクスチャの代わりに番号を入れる（0 は未作成）
+using Slots = TextureSlots<int>;
+
+TextureHandle Load(Slots& slots, const std::wstring& path, int texture) {
+    TextureHandle handle = slots.Allocate(Slots::NormalizeKey(path));
+    *slots.Resolve(handle) = texture;
+    return handle;
+}
+}
+
+// 区切り文字と大文字小文字が違っても同じスロットを引き、参照が増える
+TEST(TextureRegistryTest, NormalizedPathsShareOneSlot) {
+    Slots slots;
+    TextureHandle first = Load(slots, L"Cutin/Hinata.PNG", 7);
+
+    TextureHandle second = slots.Acquire(Slots::NormalizeKey(L"cutin\\hinata.png"));
+    ASSERT_TRUE(second.IsValid());
+    EXPECT_EQ(second.index, first.index);
+    EXPECT_EQ(second.generation, first.generation);
+    EXPECT_EQ(slots.GetRefCount(first), 2u);
+    EXPECT_EQ(slots.GetLiveCount(), 1u);
+
+    EXPECT_FALSE(slots.Acquire(Slots::NormalizeKey(L"cutin/kai.png")).IsValid());
+}
+
+// 最後の参照を手放すまで中身は残り、手放したらパスでも引けなくなる
+TEST(TextureRegistryTest, ReleaseFreesOnLastReference) {
+    Slots slots;
+    TextureHandle handle = Load(slots, L"title.png", 3);
+    slots.AddRef(handle);
+
+    EXPECT_FALSE(slots.Release(handle));
+    ASSERT_NE(slots.Resolve(handle), nullptr);
+    EXPECT_EQ(*slots.Resolve(handle), 3);
+
+    EXPECT_TRUE(slots.Release(handle));
+    EXPECT_EQ(slots.Resolve(handle), nullptr);
+    EXPECT_FALSE(slots.Find(Slots::NormalizeKey(L"title.png")).IsValid());
+    EXPECT_EQ(slots.GetLiveCount(), 0u);
+}
+
+// 再利用したスロットは世代が進み、古いハンドルでは新しい中身に触れない
+TEST(TextureRegistryTest, ReusedSlotRejectsStaleHandle) {
+    Slots slots;
+    TextureHandle stale = Load(slots, L"a.png", 1);
+    slots.Release(stale);
+
+    TextureHandle fresh = Load(slots, L"b.png", 2);
+    EXPECT_EQ(fresh.index, stale.index);
+    EXPECT_NE(fresh.generation, stale.generation);
+    EXPECT_EQ(slots.GetSlotCount(), 1u);
+
+    EXPECT_EQ(slots.Resolve(stale), nullptr);
+    slots.AddRef(stale);
+    EXPECT_FALSE(slots.Release(stale));
+    EXPECT_EQ(slots.GetRefCount(fresh), 1u);
+    ASSERT_NE(slots.Resolve(fresh), nullptr);
+    EXPECT_EQ(*slots.Resolve(fresh), 2);
+}
+
+// 無効ハンドルと範囲外の番号は nullptr（描画側はスキップする）
+TEST(TextureRegistryTest, InvalidHandleResolvesToNull) {
+    Slots slots;
+    Load(slots, L"a.png", 1);
+
+    EXPECT_EQ(slots.Resolve(TextureHandle{}), nullptr);
+    EXPECT_EQ(slots.Resolve(TextureHandle{ 5, 0 }), nullptr);
+    EXPECT_FALSE(slots.Release(TextureHandle{}));
+    EXPECT_EQ(slots.GetRefCount(TextureHandle{}), 0u);
+}
+
+// 非同期読み込み：デコードに失敗したら今のテクスチャを残し、読み込み中に解放されたら結果を捨てる
+TEST(TextureRegistryTest, AsyncDecodeFallsBackToCurrentTexture) {
+    JobSystem jobs(2);
+    AssetLoader loader(&jobs);
+    Slots slots;
+
+    // TextureRegistry::EnqueueDecode と同じ流れ（ワーカーでデコード、Pump で差し替え）
+    auto enqueue = [&](TextureHandle handle, bool decodeSucceeds, int texture) {
+        auto decoded = std::make_shared<bool>(false);
+        loader.Enqueue(
+            [decoded, decodeSucceeds]() { *decoded = decodeSucceeds; },
+            [&slots, decoded, handle, texture]() {
+                int* slot = slots.Resolve(handle);
+                if (!slot || !*decoded) return;
+                *slot = texture;
+            });
+    };
+
+    TextureHandle pending = slots.Allocate(Slots::NormalizeKey(L"boss.png"));
+    EXPECT_EQ(*slots.Resolve(pending), 0);  // Pump まではテクスチャ無し
+    enqueue(pending, true, 10);
+    loader.Flush();
+    EXPECT_EQ(*slots.Resolve(pending), 10);
+
+    // リロード：保存途中などで読めなければ前のまま、読めたら同じハンドルで差し替わる
+    TextureHandle reload = slots.Find(Slots::NormalizeKey(L"BOSS.png"));
+    ASSERT_TRUE(reload.IsValid());
+    enqueue(reload, false, 20);
+    loader.Flush();
+    EXPECT_EQ(*slots.Resolve(pending), 10);
+    enqueue(reload, true, 30);
+    loader.Flush();
+    EXPECT_EQ(*slots.Resolve(pending), 30);
+
+    // 読み込み中に解放され、スロットが別のパスに再利用されても上書きしない
+    TextureHandle released = Load(slots, L"cutin.png", 0);
+    enqueue(released, true, 40);
+    slots.Release(released);
+    TextureHandle reused = Load(slots, L"stage.png", 50);
+    EXPECT_EQ(reused.index, released.index);
+    loader.Flush();
+    EXPECT_EQ(*slots.Resolve(reused), 50);
+}
+
+// パックのテクスチャはミップ数とデータサイズが合うときだけそのまま転送し、合わなければ画像ファイルから読む
+TEST(TextureRegistryTest, PackChainMustMatchBeforeUpload) {
+    using AssetPack::PixelFormat;
+    size_t full = BlockCompression::GetChainSize(PixelFormat::BC7, 64, 32, 7);
+
+    EXPECT_TRUE(BlockCompression::IsValidChain(PixelFormat::BC7, 64, 32, 7, full));
+    EXPECT_TRUE(BlockCompression::IsValidChain(PixelFormat::RGBA8, 8, 8, 1, 8 * 8 * 4));
+    EXPECT_FALSE(BlockCompression::IsValidChain(PixelFormat::BC7, 64, 32, 7, full - 16));  // 途中で切れている
+    EXPECT_FALSE(BlockCompression::IsValidChain(PixelFormat::BC7, 64, 32, 8, full + 16));  // 1x1より先のミップ
+    EXPECT_FALSE(BlockCompression::IsValidChain(PixelFormat::BC7, 64, 32, 0, 0));
+    EXPECT_FALSE(BlockCompression::IsValidChain(PixelFormat::BC1, 0, 32, 1, 0));
+}
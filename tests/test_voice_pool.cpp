@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "AudioBackend.h"
+#include "VoicePool.h"
+
+namespace {
+const AudioFormat STEREO_44K = { 1, 2, 44100, 16 };
+const AudioFormat MONO_22K = { 1, 1, 22050, 16 };
+const uint8_t SAMPLES[64] = {};
+}
+
+// ボイスは登録時に形式ごとにまとめて作り、鳴らすときは作らない
+TEST(VoicePoolTest, PreallocatesVoicesPerFormat) {
+    NullAudioBackend backend;
+    VoicePool pool(&backend, 4);
+    int shot = pool.RegisterSound(STEREO_44K, SAMPLES, sizeof(SAMPLES), 0);
+    int hit = pool.RegisterSound(STEREO_44K, SAMPLES, 32, 0);
+    int voice = pool.RegisterSound(MONO_22K, SAMPLES, 16, 1);
+    ASSERT_NE(shot, VoicePool::INVALID_SOUND);
+    ASSERT_NE(hit, VoicePool::INVALID_SOUND);
+    ASSERT_NE(voice, VoicePool::INVALID_SOUND);
+    EXPECT_EQ(backend.GetCreateCount(), 8u);
+    EXPECT_EQ(pool.GetVoiceCount(), 8u);
+
+    for (int frame = 0; frame < 10; frame++) {
+        pool.Play(shot, 1.0f);
+        pool.Play(voice, 1.0f);
+        pool.EndFrame();
+        backend.CompleteAll();
+    }
+    EXPECT_EQ(backend.GetCreateCount(), 8u);
+    EXPECT_EQ(pool.GetStartedCount(), 20u);
+
+    // 形式に合ったボイスで鳴る
+    for (size_t i = 0; i < backend.GetVoiceCount(); i++) {
+        const NullAudioBackend::Voice& v = backend.GetVoice(static_cast<int>(i));
+        if (v.startCount == 0) continue;
+        EXPECT_EQ(v.format, v.size == 16 ? MONO_22K : STEREO_44K);
+    }
+}
+
+// 同じフレームの同じ音は1回（音量は最大）にまとまる
+TEST(VoicePoolTest, CoalescesSameSoundWithinFrame) {
+    NullAudioBackend backend;
+    VoicePool pool(&backend, 8);
+    int hit = pool.RegisterSound(STEREO_44K, SAMPLES, sizeof(SAMPLES), 0);
+    int destroy = pool.RegisterSound(STEREO_44K, SAMPLES, 32, 1);
+
+    for (int i = 0; i < 40; i++) pool.Play(hit, i == 7 ? 0.9f : 0.4f);
+    pool.Play(destroy, 0.8f);
+    pool.EndFrame();
+
+    EXPECT_EQ(backend.GetStartCount(), 2u);
+    EXPECT_EQ(pool.GetCoalescedCount(), 39u);
+    float hitVolume = 0.0f;
+    for (size_t i = 0; i < backend.GetVoiceCount(); i++) {
+        const NullAudioBackend::Voice& v = backend.GetVoice(static_cast<int>(i));
+        if (v.isPlaying && v.size == sizeof(SAMPLES)) hitVolume = v.volume;
+    }
+    EXPECT_FLOAT_EQ(hitVolume, 0.9f);
+
+    // 次のフレームはまた鳴る
+    pool.Play(hit, 0.5f);
+    pool.EndFrame();
+    EXPECT_EQ(backend.GetStartCount(), 3u);
+}
+
+// 空きが無ければ優先度の低い・古い音を奪い、高い音は奪わない
+TEST(VoicePoolTest, StealsLowestPriorityOldestVoice) {
+    NullAudioBackend backend;
+    VoicePool pool(&backend, 2);
+    int shot = pool.RegisterSound(STEREO_44K, SAMPLES, 8, 0);
+    int graze = pool.RegisterSound(STEREO_44K, SAMPLES, 16, 0);
+    int bomb = pool.RegisterSound(STEREO_44K, SAMPLES, 24, 3);
+    int spell = pool.RegisterSound(STEREO_44K, SAMPLES, 32, 3);
+
+    pool.Play(shot, 1.0f);
+    pool.EndFrame();
+    pool.Play(bomb, 1.0f);
+    pool.EndFrame();
+    // 両方鳴っている: 低優先度の音は高優先度の音を奪えない
+    pool.Play(graze, 1.0f);
+    pool.EndFrame();
+    EXPECT_EQ(pool.GetDroppedCount(), 0u);
+    EXPECT_EQ(pool.GetStolenCount(), 1u);  // shot を奪った
+
+    pool.Play(shot, 1.0f);
+    pool.EndFrame();
+    EXPECT_EQ(pool.GetStolenCount(), 2u);  // graze を奪った（同じ優先度で一番古い）
+
+    pool.Play(spell, 1.0f);
+    pool.EndFrame();
+    EXPECT_EQ(pool.GetStolenCount(), 3u);  // 優先度の低い shot を奪う（bomb は残る）
+    bool bombPlaying = false, spellPlaying = false;
+    for (size_t i = 0; i < backend.GetVoiceCount(); i++) {
+        const NullAudioBackend::Voice& v = backend.GetVoice(static_cast<int>(i));
+        if (v.isPlaying && v.size == 24) bombPlaying = true;
+        if (v.isPlaying && v.size == 32) spellPlaying = true;
+    }
+    EXPECT_TRUE(bombPlaying);
+    EXPECT_TRUE(spellPlaying);
+
+    // 全部高優先度で埋まっていれば低優先度の音は鳴らさない
+    pool.Play(shot, 1.0f);
+    pool.EndFrame();
+    EXPECT_EQ(pool.GetDroppedCount(), 1u);
+}
+
+// 同じフレームでは優先度の高い要求が先にボイスを取る
+TEST(VoicePoolTest, HighPriorityRequestsGoFirst) {
+    NullAudioBackend backend;
+    VoicePool pool(&backend, 1);
+    int hit = pool.RegisterSound(STEREO_44K, SAMPLES, 8, 0);
+    int playerHit = pool.RegisterSound(STEREO_44K, SAMPLES, 16, 3);
+
+    pool.Play(hit, 1.0f);
+    pool.Play(playerHit, 1.0f);
+    pool.EndFrame();
+
+    EXPECT_EQ(pool.GetDroppedCount(), 1u);
+    EXPECT_EQ(backend.GetVoice(0).size, 16u);
+    EXPECT_TRUE(backend.GetVoice(0).isPlaying);
+}
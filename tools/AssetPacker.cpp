@@ -0,0 +1,101 @@
+﻿// ビルド時のアセット変換ツール
+// 画像はRGBA8に、音声は効果音の共通形式（16bit ステレオ 44.1kHz）のPCMにして1つのパックファイルにまとめる
+//
+//   AssetPacker <assetsディレクトリ> <出力.pak>
+#include <windows.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "AssetManifest.h"
+#include "AssetPack.h"
+#include "AudioManager.h"
+#include "TextureAtlas.h"
+#include "TextureLoader.h"
+
+namespace {
+
+bool PackTexture(AssetPack::Writer& writer, TextureLoader& loader, const std::wstring& textureDir,
+                 const std::wstring& relativePath, const std::string& name, int maxSize) {
+    std::vector<BYTE> pixels;
+    int width = 0, height = 0;
+    if (!loader.LoadPixels(textureDir + relativePath, maxSize, &pixels, &width, &height)) {
+        fwprintf(stderr, L"AssetPacker: failed to decode %ls\n", relativePath.c_str());
+        return false;
+    }
+    writer.AddTexture(name, static_cast<uint32_t>(width), static_cast<uint32_t>(height),
+                      AssetPack::PixelFormat::RGBA8, 1, pixels.data(), pixels.size());
+    return true;
+}
+
+// 効果音は SoundCache と同じ形式にそろえて入れる（ランタイムはコピーせずにそのまま鳴らせる）
+bool PackSound(AssetPack::Writer& writer, const std::wstring& soundDir, const std::wstring& file) {
+    AudioData audio;
+    std::vector<uint8_t> pcm;
+    if (!AudioManager::DecodeAudio(soundDir + file, true, &audio) ||
+        !SoundCache::Normalize(AudioManager::ToAudioFormat(audio.format), audio.buffer.data(), audio.buffer.size(), &pcm)) {
+        fwprintf(stderr, L"AssetPacker: failed to decode %ls\n", file.c_str());
+        return false;
+    }
+    const AudioFormat& format = SoundCache::SFX_FORMAT;
+    writer.AddAudio(AssetManifest::SoundName(file), format.channels, format.sampleRate, format.bitsPerSample,
+                    pcm.data(), pcm.size());
+    return true;
+}
+
+} // namespace
+
+int wmain(int argc, wchar_t* argv[]) {
+    if (argc < 3) {
+        fwprintf(stderr, L"usage: AssetPacker <assets dir> <output.pak>\n");
+        return 1;
+    }
+    std::wstring assetDir = argv[1];
+    if (assetDir.back() != L'\\' && assetDir.back() != L'/') assetDir += L'\\';
+    std::wstring textureDir = assetDir + L"textures\\";
+    std::wstring soundDir = assetDir + L"sounds\\";
+
+    CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+    MFStartup(MF_VERSION);
+
+    TextureLoader loader;
+    loader.Initialize(nullptr);  // デコードだけなのでデバイスは要らない
+
+    // 読めないファイルがあってもパックは作る（ランタイムは無いものを元ファイルから読む）
+    AssetPack::Writer writer;
+    int failures = 0;
+
+    // 1枚絵は元の解像度のまま
+    std::vector<const wchar_t*> textures = {
+        AssetManifest::TITLE_TEXTURE,
+        AssetManifest::PORTRAIT_HINATA,
+        AssetManifest::PORTRAIT_KAI,
+        AssetManifest::STAGE_CLEAR_TEXTURE,
+    };
+    textures.insert(textures.end(), std::begin(AssetManifest::CUTIN_TEXTURES), std::end(AssetManifest::CUTIN_TEXTURES));
+    for (const wchar_t* path : textures) {
+        if (!PackTexture(writer, loader, textureDir, path, AssetManifest::TextureName(path), 0)) failures++;
+    }
+
+    // アトラス用スプライトは実行時と同じ大きさに縮小しておく
+    for (size_t i = 0; i < static_cast<size_t>(SpriteId::Count); i++) {
+        const wchar_t* path = TextureAtlas::GetSpritePath(static_cast<SpriteId>(i));
+        if (!PackTexture(writer, loader, textureDir, path, AssetManifest::SpriteName(path),
+                         TextureAtlas::MAX_SPRITE_SIZE)) {
+            failures++;
+        }
+    }
+
+    for (const auto& sound : AssetManifest::SOUND_EFFECTS) {
+        if (!PackSound(writer, soundDir, sound.file)) failures++;
+    }
+
+    MFShutdown();
+    CoUninitialize();
+
+    if (!writer.WriteFile(argv[2])) {
+        fwprintf(stderr, L"AssetPacker: failed to write %ls\n", argv[2]);
+        return 1;
+    }
+    wprintf(L"AssetPacker: %zu assets packed, %d skipped\n", writer.GetCount(), failures);
+    return 0;
+}
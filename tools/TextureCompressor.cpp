@@ -0,0 +1,118 @@
+﻿// パック内の1枚絵をBC圧縮＋ミップ付きに変換するオフラインツール（Windows以外でも動く）
+// AssetPacker が書いたRGBA8のパックを読み、同じ名前のまま書き直す
+//
+//   TextureCompressor <入力.pak> <出力.pak> [--format auto|bc1|bc3|bc7] [--no-mips]
+//
+// auto は不透明ならBC1、アルファがあればBC7
+// アトラス用スプライト（atlas/）は実行時にCPUで詰め直すのでRGBA8のまま残す
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "AssetPack.h"
+#include "BlockCompression.h"
+
+using AssetPack::PixelFormat;
+
+namespace {
+
+enum class FormatChoice { Auto, BC1, BC3, BC7 };
+
+bool HasAlpha(const uint8_t* rgba, size_t size) {
+    for (size_t i = 3; i < size; i += 4) {
+        if (rgba[i] != 255) return true;
+    }
+    return false;
+}
+
+PixelFormat ChooseFormat(FormatChoice choice, const uint8_t* rgba, size_t size) {
+    switch (choice) {
+    case FormatChoice::BC1: return PixelFormat::BC1;
+    case FormatChoice::BC3: return PixelFormat::BC3;
+    case FormatChoice::BC7: return PixelFormat::BC7;
+    default: return HasAlpha(rgba, size) ? PixelFormat::BC7 : PixelFormat::BC1;
+    }
+}
+
+const char* FormatName(PixelFormat format) {
+    switch (format) {
+    case PixelFormat::BC1: return "BC1";
+    case PixelFormat::BC3: return "BC3";
+    case PixelFormat::BC7: return "BC7";
+    default: return "RGBA8";
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        fprintf(stderr, "usage: TextureCompressor <in.pak> <out.pak> [--format auto|bc1|bc3|bc7] [--no-mips]\n");
+        return 1;
+    }
+    FormatChoice choice = FormatChoice::Auto;
+    bool generateMips = true;
+    for (int i = 3; i < argc; i++) {
+        if (strcmp(argv[i], "--no-mips") == 0) {
+            generateMips = false;
+        } else if (strcmp(argv[i], "--format") == 0 && i + 1 < argc) {
+            std::string_view name = argv[++i];
+            if (name == "bc1") choice = FormatChoice::BC1;
+            else if (name == "bc3") choice = FormatChoice::BC3;
+            else if (name == "bc7") choice = FormatChoice::BC7;
+            else if (name != "auto") {
+                fprintf(stderr, "TextureCompressor: unknown format %s\n", argv[i]);
+                return 1;
+            }
+        }
+    }
+
+    AssetPack::Reader reader;
+    if (!reader.Open(argv[1])) {
+        fprintf(stderr, "TextureCompressor: failed to open %s\n", argv[1]);
+        return 1;
+    }
+
+    AssetPack::Writer writer;
+    uint64_t sizeBefore = 0, sizeAfter = 0;
+    for (uint32_t i = 0; i < reader.GetCount(); i++) {
+        const AssetPack::PackEntry& entry = *reader.GetEntry(i);
+        std::string_view name = reader.GetName(entry);
+        const uint8_t* data = reader.GetData(entry);
+        size_t size = static_cast<size_t>(entry.dataSize);
+
+        if (entry.type == AssetPack::AssetType::Audio) {
+            writer.AddAudio(name, entry.channels, entry.sampleRate, entry.bitsPerSample, data, size);
+            continue;
+        }
+
+        // D3D11のBCテクスチャはミップ0の縦横が4の倍数である必要がある
+        bool compress = entry.format == PixelFormat::RGBA8 && entry.mipLevels == 1 &&
+                        name.substr(0, 6) != "atlas/" &&
+                        entry.width % BlockCompression::BLOCK_DIM == 0 && entry.height % BlockCompression::BLOCK_DIM == 0 &&
+                        size == static_cast<size_t>(entry.width) * entry.height * 4;
+        if (!compress) {
+            writer.AddTexture(name, entry.width, entry.height, entry.format, entry.mipLevels, data, size);
+            continue;
+        }
+
+        PixelFormat format = ChooseFormat(choice, data, size);
+        uint32_t mipLevels = generateMips ? BlockCompression::CountMipLevels(entry.width, entry.height) : 1;
+        std::vector<uint8_t> chain = BlockCompression::BuildMipChain(format, data, entry.width, entry.height, mipLevels);
+        writer.AddTexture(name, entry.width, entry.height, format, mipLevels, chain.data(), chain.size());
+
+        printf("%.*s: %ux%u %s, %u mips, %zu KB -> %zu KB\n", static_cast<int>(name.size()), name.data(),
+               entry.width, entry.height, FormatName(format), mipLevels, size / 1024, chain.size() / 1024);
+        sizeBefore += size;
+        sizeAfter += chain.size();
+    }
+
+    if (!writer.WriteFile(argv[2])) {
+        fprintf(stderr, "TextureCompressor: failed to write %s\n", argv[2]);
+        return 1;
+    }
+    printf("TextureCompressor: textures %llu KB -> %llu KB\n",
+           static_cast<unsigned long long>(sizeBefore / 1024), static_cast<unsigned long long>(sizeAfter / 1024));
+    return 0;
+}